@@ -0,0 +1,245 @@
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/operators.h>
+#include <nanobind/trampoline.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/unordered_map.h>
+#include <nanobind/stl/vector.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nb = nanobind;
+using namespace nb::literals;
+
+using clock_type = std::chrono::steady_clock;
+
+/// Run 'f' 'iterations' times and return the elapsed time in nanoseconds
+template <typename Func> static int64_t measure(size_t iterations, Func &&f) {
+    auto start = clock_type::now();
+    for (size_t i = 0; i < iterations; ++i)
+        f();
+    auto end = clock_type::now();
+    return (int64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+               end - start).count();
+}
+
+struct Point {
+    double x, y;
+    Point(double x, double y) : x(x), y(y) { }
+};
+
+struct Counter {
+    int64_t value = 0;
+    int64_t inc() { return ++value; }
+};
+
+/// Two otherwise identical types bound with and without operators.h
+template <int I> struct Vec3 {
+    double x, y, z;
+    Vec3(double x, double y, double z) : x(x), y(y), z(z) { }
+    Vec3 operator+(const Vec3 &v) const { return { x + v.x, y + v.y, z + v.z }; }
+    bool operator==(const Vec3 &v) const { return x == v.x && y == v.y && z == v.z; }
+};
+
+/// Nested structures bound with and without nb::member_cache()
+template <int I> struct Inner { double x = 1.0; };
+template <int I> struct Outer { Inner<I> inner; };
+
+/// Large return value (constructed in the instance storage)
+struct Matrix4 {
+    double m[16];
+    Matrix4(double value) { for (double &v : m) v = value; }
+};
+
+/// Dictionary keys bound with __hash__/__eq__ methods and nb::hashable()
+template <int I> struct Key {
+    int64_t value;
+    Key(int64_t value) : value(value) { }
+    bool operator==(const Key &k) const { return value == k.value; }
+};
+
+template <int I> struct std::hash<Key<I>> {
+    size_t operator()(const Key<I> &k) const { return (size_t) k.value; }
+};
+
+struct Celsius {
+    double value;
+    Celsius(double value) : value(value) { }
+};
+
+/// Distinct types for overload resolution benchmarks
+template <int I> struct Tag { };
+
+struct Shape {
+    virtual ~Shape() = default;
+    virtual double area() const { return 0.0; }
+};
+
+struct PyShape : Shape {
+    NB_TRAMPOLINE(Shape, 1);
+
+    double area() const override {
+        NB_OVERRIDE(area);
+    }
+};
+
+template <int I> static void bind_tag(nb::module_ &m) {
+    std::string name = "Tag" + std::to_string(I);
+    nb::class_<Tag<I>>(m, name.c_str()).def(nb::init<>());
+    m.def("overloaded", [](const Tag<I> &) { return I; });
+}
+
+/// The stable ABI build of the benchmarks uses a different module name
+#if !defined(NB_BENCHMARK_MODULE)
+#  define NB_BENCHMARK_MODULE nanobind_benchmarks_ext
+#endif
+
+NB_MODULE(NB_BENCHMARK_MODULE, m) {
+#if defined(Py_LIMITED_API)
+    m.attr("stable_abi") = true;
+#else
+    m.attr("stable_abi") = false;
+#endif
+
+    // Function calls (simple and complex vectorcall paths)
+    m.def("call_noargs", []() { });
+    m.def("call_simple", [](int64_t a, int64_t b) { return a + b; });
+    m.def("call_complex",
+          [](int64_t a, int64_t b, int64_t c) { return a + b + c; },
+          "a"_a, "b"_a = 1, "c"_a = 2);
+
+    // Overload resolution: calling overloaded(TagN()) tries N-1 overloads first
+    bind_tag<1>(m);
+    bind_tag<2>(m);
+    bind_tag<3>(m);
+    bind_tag<4>(m);
+    bind_tag<5>(m);
+    bind_tag<6>(m);
+    bind_tag<7>(m);
+    bind_tag<8>(m);
+
+    // Bound methods, instance creation and destruction
+    nb::class_<Counter>(m, "Counter")
+        .def(nb::init<>())
+        .def("inc", &Counter::inc);
+
+    nb::class_<Point>(m, "Point")
+        .def(nb::init<double, double>())
+        .def_rw("x", &Point::x)
+        .def_rw("y", &Point::y);
+
+    // Operators (type slots vs. generic special method dispatch)
+    nb::class_<Vec3<0>>(m, "Vec3")
+        .def(nb::init<double, double, double>())
+        .def(nb::self + nb::self)
+        .def(nb::self == nb::self);
+
+    using Vec3Generic = Vec3<1>;
+    nb::class_<Vec3Generic>(m, "Vec3Generic")
+        .def(nb::init<double, double, double>())
+        .def("__add__",
+             [](const Vec3Generic &a, const Vec3Generic &b) { return a + b; },
+             nb::is_operator())
+        .def("__eq__",
+             [](const Vec3Generic &a, const Vec3Generic &b) { return a == b; },
+             nb::is_operator());
+
+    // Chained member access (reference_internal wrappers)
+    nb::class_<Inner<0>>(m, "Inner")
+        .def_rw("x", &Inner<0>::x);
+    nb::class_<Inner<1>>(m, "InnerCached", nb::member_cache())
+        .def_rw("x", &Inner<1>::x);
+    nb::class_<Outer<0>>(m, "Outer")
+        .def(nb::init<>())
+        .def_rw("inner", &Outer<0>::inner);
+    nb::class_<Outer<1>>(m, "OuterCached", nb::member_cache())
+        .def(nb::init<>())
+        .def_rw("inner", &Outer<1>::inner);
+
+    // Return values of bound types
+    nb::class_<Matrix4>(m, "Matrix4");
+    m.def("return_value", []() { return Matrix4(1.0); });
+
+    // Hashing and comparison of set/dict keys
+    nb::class_<Key<0>>(m, "Key")
+        .def(nb::init<int64_t>())
+        .def("__hash__", [](const Key<0> &k) { return std::hash<Key<0>>()(k); })
+        .def("__eq__", [](const Key<0> &a, const Key<0> &b) { return a == b; });
+    nb::class_<Key<1>>(m, "KeyHashable", nb::hashable())
+        .def(nb::init<int64_t>());
+
+    // Implicit conversions
+    nb::class_<Celsius>(m, "Celsius")
+        .def(nb::init_implicit<double>());
+    m.def("take_celsius", [](const Celsius &c) { return c.value; });
+
+    // STL casting
+    m.def("list_in", [](const std::vector<double> &v) { return v.size(); });
+    m.def("list_out", [](size_t n) { return std::vector<double>(n, 1.0); });
+    m.def("obj_list_out", [](size_t n) {
+        return std::vector<Point>(n, Point(1.0, 2.0));
+    });
+    m.def("str_list_in", [](const std::vector<std::string> &v) { return v.size(); });
+    m.def("str_list_out", [](size_t n) {
+        return std::vector<std::string>(n, "token");
+    });
+    m.def("str_table_out", [](size_t n) {
+        return nb::string_table<>(std::vector<std::string>(n, "token"));
+    });
+    m.def("dict_in", [](const std::unordered_map<std::string, int64_t> &d) {
+        return d.size();
+    });
+    m.def("dict_out", [](size_t n) {
+        std::unordered_map<std::string, int64_t> d;
+        for (size_t i = 0; i < n; ++i)
+            d.emplace(std::to_string(i), (int64_t) i);
+        return d;
+    });
+
+    // ndarray_import() and ndarray_wrap()
+    m.def("ndarray_in", [](nb::ndarray<const double, nb::shape<nb::any>> a) {
+        return a.shape(0);
+    });
+    m.def("ndarray_out", [](size_t n) {
+        static std::vector<double> buf;
+        if (buf.size() < n)
+            buf.resize(n);
+        size_t shape[1] = { n };
+        return nb::ndarray<double, nb::shape<nb::any>>(buf.data(), 1, shape);
+    });
+
+    // Trampolines: C++ loops that dispatch to Python overrides
+    nb::class_<Shape, PyShape>(m, "Shape")
+        .def(nb::init<>())
+        .def("area", &Shape::area);
+
+    // C++ driver: these functions return the elapsed time of 'iterations' calls
+    m.def("cpp_trampoline", [](const Shape &s, size_t iterations) {
+        double sum = 0.0;
+        int64_t result = measure(iterations, [&] { sum += s.area(); });
+        (void) sum;
+        return result;
+    }, "shape"_a, "iterations"_a);
+
+    m.def("cpp_cast_list", [](size_t n, size_t iterations) {
+        std::vector<double> v(n, 1.0);
+        return measure(iterations, [&] { nb::cast(v); });
+    }, "n"_a, "iterations"_a);
+
+    m.def("cpp_call_python", [](nb::callable f, size_t iterations) {
+        return measure(iterations, [&] { f(1, 2); });
+    }, "f"_a, "iterations"_a);
+
+    m.def("cpp_call_python_kw", [](nb::callable f, size_t iterations) {
+        return measure(iterations, [&] { f(1, "b"_a = 2); });
+    }, "f"_a, "iterations"_a);
+
+    m.def("cpp_prepared_call_kw", [](nb::callable f, size_t iterations) {
+        nb::prepared_call call(f, { "b" });
+        return measure(iterations, [&] { call(1, 2); });
+    }, "f"_a, "iterations"_a);
+}
@@ -0,0 +1,212 @@
+"""
+Microbenchmarks of nanobind's hot paths.
+
+Each benchmark runs a number of repetitions of a timed loop and reports
+percentiles of the per-operation time in nanoseconds. The results are
+written as JSON, which makes it possible to compare two nanobind versions:
+
+    $ python run_benchmarks.py --output before.json
+    $ python run_benchmarks.py --output after.json
+
+The same benchmarks compiled against the stable ABI are run via
+'--module nanobind_benchmarks_ext_abi3'.
+"""
+
+import argparse
+import array
+import importlib
+import json
+import os
+import platform
+import subprocess
+import sys
+import time
+
+SIZES = (1, 16, 256, 4096)
+
+
+def percentile(values, q):
+    """Percentile of sorted 'values' with linear interpolation"""
+    pos = (len(values) - 1) * q / 100
+    lo = int(pos)
+    hi = min(lo + 1, len(values) - 1)
+    return values[lo] + (values[hi] - values[lo]) * (pos - lo)
+
+
+def summarize(name, params, samples):
+    samples = sorted(samples)
+    return {
+        "name": name,
+        "params": params,
+        "unit": "ns",
+        "repeats": len(samples),
+        "min": samples[0],
+        "p50": percentile(samples, 50),
+        "p90": percentile(samples, 90),
+        "p99": percentile(samples, 99),
+        "max": samples[-1],
+        "mean": sum(samples) / len(samples),
+    }
+
+
+def bench_python(f, iterations, repeats):
+    """Per-call time of 'f()' measured by the Python driver"""
+    samples = []
+    loop = range(iterations)
+    for _ in range(repeats):
+        start = time.perf_counter_ns()
+        for _ in loop:
+            f()
+        samples.append((time.perf_counter_ns() - start) / iterations)
+    return samples
+
+
+def bench_cpp(f, iterations, repeats):
+    """Per-call time reported by a C++ driver 'f(iterations)'"""
+    return [f(iterations) / iterations for _ in range(repeats)]
+
+
+def bench_import(m, repeats):
+    """Time to import the extension in a fresh interpreter"""
+    code = (
+        "import time; t = time.perf_counter_ns(); "
+        "import %s; "
+        "print(time.perf_counter_ns() - t)" % m.__name__
+    )
+    env = dict(os.environ)
+    path = os.path.dirname(os.path.abspath(m.__file__))
+    env["PYTHONPATH"] = os.pathsep.join(
+        p for p in (path, env.get("PYTHONPATH")) if p)
+    samples = []
+    for _ in range(repeats):
+        out = subprocess.run([sys.executable, "-c", code], env=env,
+                             check=True, capture_output=True, text=True)
+        samples.append(float(out.stdout.strip()))
+    return samples
+
+
+def benchmarks(m, scale):
+    """Yield (name, params, driver, callable, iterations) tuples"""
+    n = max(1, int(10000 * scale))
+
+    class PyShape(m.Shape):
+        def area(self):
+            return 1.0
+
+    yield "call_noargs", {}, bench_python, m.call_noargs, n
+    yield "call_simple", {}, bench_python, lambda: m.call_simple(1, 2), n
+    yield "call_complex", {}, bench_python, \
+        lambda: m.call_complex(1, c=3), n
+
+    for depth in (1, 4, 8):
+        tag = getattr(m, "Tag%i" % depth)()
+        yield "overload_resolution", {"depth": depth}, bench_python, \
+            lambda tag=tag: m.overloaded(tag), n
+
+    counter = m.Counter()
+    yield "bound_method", {}, bench_python, counter.inc, n
+    yield "instance_lifecycle", {}, bench_python, lambda: m.Point(1.0, 2.0), n
+    yield "return_value", {}, bench_python, m.return_value, n
+    yield "implicit_conversion", {}, bench_python, \
+        lambda: m.take_celsius(1.0), n
+
+    for name in ("Outer", "OuterCached"):
+        outer = getattr(m, name)()
+        yield "member_access", {"type": name}, bench_python, \
+            lambda outer=outer: outer.inner.x, n
+
+    for name in ("Key", "KeyHashable"):
+        keys = [getattr(m, name)(i % 128) for i in range(256)]
+        yield "set_keys", {"type": name}, bench_python, \
+            lambda keys=keys: set(keys), max(1, n // 256)
+
+    for name in ("Vec3", "Vec3Generic"):
+        u, v = getattr(m, name)(1, 2, 3), getattr(m, name)(4, 5, 6)
+        params = {"type": name}
+        yield "operator_add", params, bench_python, lambda u=u, v=v: u + v, n
+        yield "operator_eq", params, bench_python, lambda u=u, v=v: u == v, n
+
+    for size in SIZES:
+        k = max(1, n // size)
+        lst = [1.0] * size
+        dct = {str(i): i for i in range(size)}
+        arr = array.array("d", lst)
+        params = {"size": size}
+        yield "list_in", params, bench_python, lambda v=lst: m.list_in(v), k
+        yield "list_out", params, bench_python, \
+            lambda size=size: m.list_out(size), k
+        yield "obj_list_out", params, bench_python, \
+            lambda size=size: m.obj_list_out(size), k
+        yield "str_list_in", params, bench_python, \
+            lambda v=list(dct): m.str_list_in(v), k
+        yield "str_list_out", params, bench_python, \
+            lambda size=size: m.str_list_out(size), k
+        yield "str_table_out", params, bench_python, \
+            lambda size=size: m.str_table_out(size), k
+        yield "dict_in", params, bench_python, lambda v=dct: m.dict_in(v), k
+        yield "dict_out", params, bench_python, \
+            lambda size=size: m.dict_out(size), k
+        yield "ndarray_import", params, bench_python, \
+            lambda v=arr: m.ndarray_in(v), n
+        yield "ndarray_wrap", params, bench_python, \
+            lambda size=size: m.ndarray_out(size), n
+        yield "cpp_cast_list", params, bench_cpp, \
+            lambda it, size=size: m.cpp_cast_list(size, it), k
+
+    shape = PyShape()
+    yield "trampoline", {}, bench_cpp, \
+        lambda it: m.cpp_trampoline(shape, it), n
+    yield "cpp_call_python", {}, bench_cpp, \
+        lambda it: m.cpp_call_python(lambda a, b: None, it), n
+    yield "cpp_call_python_kw", {}, bench_cpp, \
+        lambda it: m.cpp_call_python_kw(lambda a, b: None, it), n
+    yield "cpp_prepared_call_kw", {}, bench_cpp, \
+        lambda it: m.cpp_prepared_call_kw(lambda a, b: None, it), n
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split("\n")[0])
+    parser.add_argument("--output", "-o", help="JSON output file (default: stdout)")
+    parser.add_argument("--repeats", "-r", type=int, default=25,
+                        help="number of timed repetitions per benchmark")
+    parser.add_argument("--scale", "-s", type=float, default=1.0,
+                        help="scale factor of the iteration counts")
+    parser.add_argument("--filter", "-k", default="",
+                        help="only run benchmarks whose name contains this string")
+    parser.add_argument("--module", "-m", default="nanobind_benchmarks_ext",
+                        help="extension to benchmark (e.g., its stable ABI build "
+                             "'nanobind_benchmarks_ext_abi3')")
+    args = parser.parse_args()
+    m = importlib.import_module(args.module)
+
+    results = []
+    for name, params, driver, f, iterations in benchmarks(m, args.scale):
+        if args.filter not in name:
+            continue
+        driver(f, max(1, iterations // 10), 1)  # warm up
+        results.append(summarize(name, params,
+                                 driver(f, iterations, args.repeats)))
+
+    if args.filter in "import_time":
+        results.append(summarize("import_time", {}, bench_import(
+            m, max(1, args.repeats // 5))))
+
+    report = {
+        "module": args.module,
+        "stable_abi": m.stable_abi,
+        "python": sys.version,
+        "implementation": platform.python_implementation(),
+        "platform": platform.platform(),
+        "benchmarks": results,
+    }
+
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+
+if __name__ == "__main__":
+    main()
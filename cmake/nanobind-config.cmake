@@ -19,6 +19,15 @@ endif()
 
 set(NB_SUFFIX ${NB_SUFFIX} CACHE INTERNAL "")
 
+# Check if the interpreter is a free-threaded build (PEP 703)
+execute_process(
+  COMMAND "${Python_EXECUTABLE}" "-c"
+    "import sysconfig; print(sysconfig.get_config_var('Py_GIL_DISABLED') or 0)"
+  OUTPUT_VARIABLE NB_PY_GIL_DISABLED
+  OUTPUT_STRIP_TRAILING_WHITESPACE)
+
+set(NB_PY_GIL_DISABLED ${NB_PY_GIL_DISABLED} CACHE INTERNAL "")
+
 get_filename_component(NB_DIR "${CMAKE_CURRENT_LIST_FILE}" PATH)
 get_filename_component(NB_DIR "${NB_DIR}" PATH)
 
@@ -58,6 +67,7 @@ function (nanobind_build_library TARGET_NAME)
 
   add_library(${TARGET_NAME} ${TARGET_TYPE}
     EXCLUDE_FROM_ALL
+    ${NB_DIR}/include/nanobind/async.h
     ${NB_DIR}/include/nanobind/make_iterator.h
     ${NB_DIR}/include/nanobind/nanobind.h
     ${NB_DIR}/include/nanobind/nb_accessor.h
@@ -77,12 +87,14 @@ function (nanobind_build_library TARGET_NAME)
     ${NB_DIR}/include/nanobind/nb_tuple.h
     ${NB_DIR}/include/nanobind/nb_types.h
     ${NB_DIR}/include/nanobind/ndarray.h
+    ${NB_DIR}/include/nanobind/parallel.h
     ${NB_DIR}/include/nanobind/trampoline.h
     ${NB_DIR}/include/nanobind/operators.h
     ${NB_DIR}/include/nanobind/stl/array.h
     ${NB_DIR}/include/nanobind/stl/bind_map.h
     ${NB_DIR}/include/nanobind/stl/bind_vector.h
     ${NB_DIR}/include/nanobind/stl/detail
+    ${NB_DIR}/include/nanobind/stl/detail/container_slots.h
     ${NB_DIR}/include/nanobind/stl/detail/nb_array.h
     ${NB_DIR}/include/nanobind/stl/detail/nb_dict.h
     ${NB_DIR}/include/nanobind/stl/detail/nb_list.h
@@ -90,6 +102,7 @@ function (nanobind_build_library TARGET_NAME)
     ${NB_DIR}/include/nanobind/stl/detail/traits.h
     ${NB_DIR}/include/nanobind/stl/filesystem.h
     ${NB_DIR}/include/nanobind/stl/function.h
+    ${NB_DIR}/include/nanobind/stl/future.h
     ${NB_DIR}/include/nanobind/stl/list.h
     ${NB_DIR}/include/nanobind/stl/map.h
     ${NB_DIR}/include/nanobind/stl/optional.h
@@ -114,7 +127,10 @@ function (nanobind_build_library TARGET_NAME)
     ${NB_DIR}/src/nb_type.cpp
     ${NB_DIR}/src/nb_enum.cpp
     ${NB_DIR}/src/nb_ndarray.cpp
+    ${NB_DIR}/src/nb_parallel.cpp
     ${NB_DIR}/src/nb_static_property.cpp
+    ${NB_DIR}/src/nb_member.cpp
+    ${NB_DIR}/src/nb_casters.cpp
     ${NB_DIR}/src/common.cpp
     ${NB_DIR}/src/error.cpp
     ${NB_DIR}/src/trampoline.cpp
@@ -152,6 +168,25 @@ function (nanobind_build_library TARGET_NAME)
     endif()
   endif()
 
+  # The thread pool of nb::parallel_for() is based on std::thread
+  find_package(Threads REQUIRED)
+  target_link_libraries(${TARGET_NAME} PUBLIC Threads::Threads)
+
+  # shm_open() used by nb::ndarray_shm() resides in librt on glibc < 2.34
+  if (CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    target_link_libraries(${TARGET_NAME} PUBLIC rt)
+  endif()
+
+  # Profiling builds collect per-function call statistics (see NB_PROFILE)
+  if (TARGET_NAME MATCHES "-profile")
+    target_compile_definitions(${TARGET_NAME} PUBLIC NB_PROFILE)
+  endif()
+
+  # Free-threaded builds protect internal data structures using locks
+  if (TARGET_NAME MATCHES "-ft")
+    target_compile_definitions(${TARGET_NAME} PUBLIC NB_FREE_THREADED)
+  endif()
+
   # Nanobind performs many assertion checks -- detailed error messages aren't
   # included in Release/MinSizeRel modes
   target_compile_definitions(${TARGET_NAME} PRIVATE
@@ -224,7 +259,7 @@ endfunction()
 
 function(nanobind_add_module name)
   cmake_parse_arguments(PARSE_ARGV 1 ARG
-    "STABLE_ABI;NB_STATIC;NB_SHARED;PROTECT_STACK;LTO;NOMINSIZE;NOSTRIP;NOTRIM" "" "")
+    "STABLE_ABI;FREE_THREADED;MULTIPLE_INTERPRETERS;NB_STATIC;NB_SHARED;PROTECT_STACK;LTO;NOMINSIZE;NOSTRIP;NOTRIM;PROFILE" "" "")
 
   add_library(${name} MODULE ${ARG_UNPARSED_ARGUMENTS})
 
@@ -258,6 +293,16 @@ function(nanobind_add_module name)
     set(ARG_STABLE_ABI OFF)
   endif()
 
+  # Free-threaded mode is only meaningful on free-threaded interpreters
+  if (ARG_FREE_THREADED AND NOT NB_PY_GIL_DISABLED)
+    set(ARG_FREE_THREADED OFF)
+  endif()
+
+  # The stable ABI is not available on free-threaded interpreters
+  if (ARG_STABLE_ABI AND NB_PY_GIL_DISABLED)
+    set(ARG_STABLE_ABI OFF)
+  endif()
+
   set(libname "nanobind")
   if (ARG_NB_STATIC)
     set(libname "${libname}-static")
@@ -267,6 +312,14 @@ function(nanobind_add_module name)
     set(libname "${libname}-abi3")
   endif()
 
+  if (ARG_FREE_THREADED)
+    set(libname "${libname}-ft")
+  endif()
+
+  if (ARG_PROFILE)
+    set(libname "${libname}-profile")
+  endif()
+
   nanobind_build_library(${libname})
 
   if (ARG_STABLE_ABI)
@@ -278,6 +331,11 @@ function(nanobind_add_module name)
 
   target_link_libraries(${name} PRIVATE ${libname})
 
+  # Use multi-phase initialization so that each interpreter gets its own copy
+  if (ARG_MULTIPLE_INTERPRETERS)
+    target_compile_definitions(${name} PRIVATE NB_MULTIPLE_INTERPRETERS)
+  endif()
+
   if (NOT ARG_PROTECT_STACK)
     nanobind_disable_stack_protector(${name})
   endif()
@@ -0,0 +1,135 @@
+/*
+    nanobind/async.h: run C++ functions on the thread pool and return
+    asyncio futures that complete with their result
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <exception>
+#include <optional>
+#include <tuple>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Pending call of an nb::async_() function along with its arguments
+template <typename Func, typename Return, typename... Args> struct async_task {
+    Func func;
+    std::tuple<Args...> args;
+    PyObject *loop, *future;
+    std::exception_ptr error;
+
+    static void run(void *p) noexcept {
+        async_task *task = (async_task *) p;
+        std::optional<std::conditional_t<std::is_void_v<Return>, bool, Return>> value;
+
+        try {
+            if constexpr (std::is_void_v<Return>) {
+                std::apply(task->func, std::move(task->args));
+                value.emplace(true);
+            } else {
+                value.emplace(std::apply(task->func, std::move(task->args)));
+            }
+        } catch (...) {
+            task->error = std::current_exception();
+        }
+
+        gil_scoped_acquire guard;
+        PyObject *result = nullptr;
+
+        if (value) {
+            try {
+                if constexpr (std::is_void_v<Return>)
+                    result = none().release().ptr();
+                else
+                    result = make_caster<Return>::from_cpp(
+                        std::move(*value), rv_policy::move, nullptr).ptr();
+            } catch (...) {
+                task->error = std::current_exception();
+            }
+        }
+
+        if (!result) {
+            if (task->error) {
+                try {
+                    std::rethrow_exception(task->error);
+                } catch (...) {
+                    translate_exception();
+                }
+            } else if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_TypeError,
+                                "nanobind::async_(): could not convert the "
+                                "return value to a Python object!");
+            }
+        }
+
+        PyObject *loop = task->loop, *future = task->future;
+        value.reset();
+        delete task; // arguments may hold Python objects
+        async_future_set(loop, future, result);
+    }
+};
+
+template <typename Func, typename Return, typename... Args> struct async_helper {
+    Func func;
+
+    object operator()(Args... args) const {
+        using Task = async_task<Func, Return, Args...>;
+
+        PyObject *loop = nullptr;
+        object future = steal(async_future_new(&loop));
+
+        Task *task = new Task{ func, { std::move(args)... }, loop,
+                               future.inc_ref().ptr(), nullptr };
+        try {
+            async_submit(Task::run, task);
+        } catch (...) {
+            future.dec_ref();
+            Py_DECREF(loop);
+            delete task;
+            throw;
+        }
+
+        return future;
+    }
+};
+
+template <typename Func, typename Return, typename... Args>
+auto async_make(Func &&f, Return (*)(Args...)) {
+    return async_helper<std::decay_t<Func>, std::decay_t<Return>,
+                        std::decay_t<Args>...>{ (forward_t<Func>) f };
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * Wrap a C++ function so that calling it from Python returns an
+ * ``asyncio.Future`` of the running event loop. The arguments are converted
+ * and copied while holding the GIL, and the function then runs on the shared
+ * thread pool of ``nb::parallel_for()`` without it. Its return value (or
+ * exception) completes the future on the event loop thread.
+ *
+ * Arguments taken by reference are copied. Instances passed via pointers
+ * are not kept alive by the pending call, which is the caller's
+ * responsibility.
+ */
+template <typename Return, typename... Args>
+auto async_(Return (*f)(Args...)) {
+    return detail::async_make(f, (Return (*)(Args...)) nullptr);
+}
+
+template <typename Func,
+          detail::enable_if_t<detail::is_lambda_v<std::remove_reference_t<Func>>> = 0>
+auto async_(Func &&f) {
+    using am = detail::analyze_method<decltype(&std::remove_reference_t<Func>::operator())>;
+    return detail::async_make((detail::forward_t<Func>) f,
+                              (typename am::func *) nullptr);
+}
+
+NAMESPACE_END(NB_NAMESPACE)
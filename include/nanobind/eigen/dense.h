@@ -28,6 +28,18 @@ NAMESPACE_BEGIN(detail)
 template <typename T>
 constexpr int NumDimensions = bool(T::IsVectorAtCompileTime) ? 1 : 2;
 
+/**
+ * Return the attribute 'name' of 'module' imported by the current interpreter.
+ * This doesn't share Python objects between interpreters, and the import
+ * system reports missing or sabotaged modules as usual.
+ */
+inline object eigen_import_attr(const interned &module, const interned &name) {
+    object m = steal(PyImport_Import(module.ptr()));
+    if (!m.is_valid())
+        raise_python_error();
+    return m.attr(name);
+}
+
 template <typename T>
 using array_for_eigen_t = ndarray<
     typename T::Scalar,
@@ -65,6 +77,11 @@ template <typename T> constexpr bool is_eigen_xpr_v =
     is_eigen_v<T> && !is_eigen_plain_v<T> && !is_eigen_sparse_v<T> &&
     !std::is_base_of_v<Eigen::MapBase<T, Eigen::ReadOnlyAccessors>, T>;
 
+/// Expressions, maps, and references may point into the function arguments
+template <typename T>
+struct is_view_value<T, enable_if_t<is_eigen_v<T> && !is_eigen_plain_v<T> &&
+                                    !is_eigen_sparse_v<T>>> : std::true_type { };
+
 template <typename T> struct type_caster<T, enable_if_t<is_eigen_plain_v<T>>> {
     using Scalar = typename T::Scalar;
     using NDArray = array_for_eigen_t<T>;
@@ -72,7 +89,18 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_plain_v<T>>> {
 
     NB_TYPE_CASTER(T, NDArrayCaster::Name);
 
+    /// Small fixed-size types are converted without going through an ndarray
+    static constexpr bool IsSmall =
+        T::SizeAtCompileTime != Eigen::Dynamic && is_member_scalar_v<Scalar> &&
+        !std::is_same_v<Scalar, bool> &&
+        T::SizeAtCompileTime * sizeof(Scalar) <= 128;
+
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if constexpr (IsSmall) {
+            if (from_python_small(src, flags, cleanup))
+                return true;
+        }
+
         NDArrayCaster caster;
         if (!caster.from_python(src, flags, cleanup))
             return false;
@@ -91,15 +119,120 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_plain_v<T>>> {
         return true;
     }
 
+    /// Load a tuple, list, or 1D buffer element by element
+    bool from_python_small(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        PyObject *o = src.ptr();
+        bool convert = flags & (uint8_t) cast_flags::convert;
+
+        if (PyTuple_CheckExact(o) || PyList_CheckExact(o)) {
+            // Sequences were previously only accepted via implicit conversion
+            if (!convert)
+                return false;
+
+            make_caster<Scalar> caster;
+
+            if constexpr (NumDimensions<T> == 1) {
+                PyObject *temp, **items =
+                    seq_get_with_size(o, (size_t) T::SizeAtCompileTime, &temp);
+                bool success = items != nullptr;
+
+                for (Eigen::Index i = 0; success && i < T::SizeAtCompileTime; ++i) {
+                    success = caster.from_python(items[i], flags, cleanup);
+                    if (success)
+                        value(i) = caster.value;
+                }
+
+                Py_XDECREF(temp);
+                return success;
+            } else {
+                PyObject *temp, **rows =
+                    seq_get_with_size(o, (size_t) T::RowsAtCompileTime, &temp);
+                bool success = rows != nullptr;
+
+                for (Eigen::Index i = 0; success && i < T::RowsAtCompileTime; ++i) {
+                    PyObject *temp2, **cols = seq_get_with_size(
+                        rows[i], (size_t) T::ColsAtCompileTime, &temp2);
+                    success = cols != nullptr;
+
+                    for (Eigen::Index j = 0; success && j < T::ColsAtCompileTime; ++j) {
+                        success = caster.from_python(cols[j], flags, cleanup);
+                        if (success)
+                            value(i, j) = caster.value;
+                    }
+
+                    Py_XDECREF(temp2);
+                }
+
+                Py_XDECREF(temp);
+                return success;
+            }
+        }
+
+        if constexpr (NumDimensions<T> == 1) {
+            auto alloc = [](void *p, size_t size) -> void * {
+                return size == (size_t) T::SizeAtCompileTime ? ((T *) p)->data()
+                                                             : nullptr;
+            };
+
+            return seq_load_array(o, member_kind_of<Scalar>(), convert, alloc,
+                                  &value);
+        } else {
+            return false;
+        }
+    }
+
+    /// Copy into a NumPy array created via numpy.frombuffer()
+    static handle from_cpp_small(const T &v) noexcept {
+        constexpr char dtype_name[] = {
+            std::is_floating_point_v<Scalar> ? 'f'
+                : (std::is_signed_v<Scalar> ? 'i' : 'u'),
+            (char) ('0' + sizeof(Scalar)), '\0'
+        };
+
+        static const interned numpy_name("numpy"), frombuffer_name("frombuffer");
+
+        try {
+            object frombuffer = eigen_import_attr(numpy_name, frombuffer_name);
+
+            Scalar data[T::SizeAtCompileTime];
+            if constexpr (NumDimensions<T> == 1 || bool(T::IsRowMajor)) {
+                memcpy(data, v.data(), sizeof(data));
+            } else {
+                for (Eigen::Index i = 0; i < v.rows(); ++i)
+                    for (Eigen::Index j = 0; j < v.cols(); ++j)
+                        data[i * v.cols() + j] = v(i, j);
+            }
+
+            object buf = steal(PyByteArray_FromStringAndSize(
+                (const char *) data, (Py_ssize_t) sizeof(data)));
+            if (!buf.is_valid())
+                raise_python_error();
+
+            object result = frombuffer(buf, dtype_name);
+            if constexpr (NumDimensions<T> == 2)
+                result = result.attr("reshape")(v.rows(), v.cols());
+
+            return result.release();
+        } catch (python_error &) {
+            return handle();
+        }
+    }
+
     static handle from_cpp(T &&v, rv_policy policy, cleanup_list *cleanup) noexcept {
         if (policy == rv_policy::automatic ||
             policy == rv_policy::automatic_reference)
             policy = rv_policy::move;
 
-        return from_cpp((const T &) v, policy, cleanup);
+        return from_cpp_impl(v, &v, policy, cleanup);
     }
 
     static handle from_cpp(const T &v, rv_policy policy, cleanup_list *cleanup) noexcept {
+        return from_cpp_impl(v, nullptr, policy, cleanup);
+    }
+
+    /// Shared implementation, 'movable' refers to 'v' if it is a temporary
+    static handle from_cpp_impl(const T &v, T *movable, rv_policy policy,
+                                cleanup_list *cleanup) noexcept {
         size_t shape[NumDimensions<T>];
         int64_t strides[NumDimensions<T>];
 
@@ -135,9 +268,24 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_plain_v<T>>> {
                 break;
         }
 
+        if constexpr (IsSmall) {
+            if (policy == rv_policy::copy) {
+                handle h = from_cpp_small(v);
+                if (h.is_valid())
+                    return h;
+            }
+        }
+
         object owner;
         if (policy == rv_policy::move) {
-            T *temp = new T(std::move(v));
+            // Moving a temporary transfers its heap storage to the capsule
+            T *temp;
+            try {
+                temp = movable ? new T(std::move(*movable)) : new T(v);
+            } catch (const std::bad_alloc &) {
+                PyErr_NoMemory();
+                return handle();
+            }
             owner = capsule(temp, [](void *p) noexcept { delete (T *) p; });
             ptr = temp->data();
         } else if (policy == rv_policy::reference_internal) {
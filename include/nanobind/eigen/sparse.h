@@ -27,15 +27,18 @@ template <typename T> constexpr bool is_eigen_sparse_matrix_v =
     !std::is_base_of_v<Eigen::SparseMapBase<T, Eigen::ReadOnlyAccessors>, T>;
 
 
-/// Caster for Eigen::SparseMatrix
-template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v<T>>> {
+/// Return scipy.sparse.csr_matrix or csc_matrix of the current interpreter
+template <bool RowMajor> object scipy_sparse_type() {
+    static const interned module("scipy.sparse"),
+        name(RowMajor ? "csr_matrix" : "csc_matrix");
+    return eigen_import_attr(module, name);
+}
+
+/// Shared functionality of the Eigen::SparseMatrix and Eigen::Map casters
+template <typename T> struct sparse_caster_base {
     using Scalar = typename T::Scalar;
     using StorageIndex = typename T::StorageIndex;
     using Index = typename T::Index;
-    using SparseMap = Eigen::Map<T>;
-
-    static_assert(std::is_same_v<T, Eigen::SparseMatrix<Scalar, T::Options, StorageIndex>>,
-                  "nanobind: Eigen sparse caster only implemented for matrices");
 
     static constexpr bool RowMajor = T::IsRowMajor;
 
@@ -45,17 +48,20 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v
     using ScalarCaster = make_caster<ScalarNDArray>;
     using StorageIndexCaster = make_caster<StorageIndexNDArray>;
 
-    NB_TYPE_CASTER(T, const_name<RowMajor>("scipy.sparse.csr_matrix[",
-                                           "scipy.sparse.csc_matrix[")
-                   + make_caster<Scalar>::Name + const_name("]"));
+    static constexpr auto Name =
+        const_name<RowMajor>("scipy.sparse.csr_matrix[",
+                             "scipy.sparse.csc_matrix[") +
+        make_caster<Scalar>::Name + const_name("]");
 
     ScalarCaster data_caster;
     StorageIndexCaster indices_caster, indptr_caster;
+    Index rows, cols, nnz;
 
-    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+    /// Reference the data, indices, and indptr arrays of a SciPy matrix
+    bool load(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
         object obj = borrow(src);
         try {
-            object matrix_type = module_::import_("scipy.sparse").attr(RowMajor ? "csr_matrix" : "csc_matrix");
+            object matrix_type = scipy_sparse_type<RowMajor>();
             if (!obj.type().is(matrix_type))
                 obj = matrix_type(obj);
         } catch (const python_error &) {
@@ -64,18 +70,14 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v
 
         if (object data_o = obj.attr("data"); !data_caster.from_python(data_o, flags, cleanup))
             return false;
-        ScalarNDArray& values = data_caster.value;
 
         if (object indices_o = obj.attr("indices"); !indices_caster.from_python(indices_o, flags, cleanup))
             return false;
-        StorageIndexNDArray& inner_indices = indices_caster.value;
 
         if (object indptr_o = obj.attr("indptr"); !indptr_caster.from_python(indptr_o, flags, cleanup))
             return false;
-        StorageIndexNDArray& outer_indices = indptr_caster.value;
 
         object shape_o = obj.attr("shape"), nnz_o = obj.attr("nnz");
-        Index rows, cols, nnz;
         try {
             if (len(shape_o) != 2)
                 return false;
@@ -86,7 +88,54 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v
             return false;
         }
 
-        value = SparseMap(rows, cols, nnz, outer_indices.data(), inner_indices.data(), values.data());
+        return true;
+    }
+
+    /// Create a SciPy matrix whose arrays reference the storage of 'v'
+    template <typename V>
+    static handle wrap(V &v, handle owner) noexcept {
+        const Index rows = v.rows(), cols = v.cols();
+        const size_t data_shape[] = { (size_t) v.nonZeros() };
+        const size_t outer_indices_shape[] = { (size_t) ((RowMajor ? rows : cols) + 1) };
+
+        ScalarNDArray data((void *) v.valuePtr(), 1, data_shape, owner);
+        StorageIndexNDArray outer_indices((void *) v.outerIndexPtr(), 1, outer_indices_shape, owner);
+        StorageIndexNDArray inner_indices((void *) v.innerIndexPtr(), 1, data_shape, owner);
+
+        try {
+            return scipy_sparse_type<RowMajor>()(
+                       make_tuple(std::move(data), std::move(inner_indices),
+                                  std::move(outer_indices)),
+                       make_tuple(rows, cols), arg("copy") = false)
+                .release();
+        } catch (python_error &e) {
+            e.restore();
+            return handle();
+        }
+    }
+};
+
+/// Caster for Eigen::SparseMatrix
+template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v<T>>>
+    : sparse_caster_base<T> {
+    using Base = sparse_caster_base<T>;
+    using Scalar = typename T::Scalar;
+    using StorageIndex = typename T::StorageIndex;
+    using SparseMap = Eigen::Map<T>;
+
+    static_assert(std::is_same_v<T, Eigen::SparseMatrix<Scalar, T::Options, StorageIndex>>,
+                  "nanobind: Eigen sparse caster only implemented for matrices");
+
+    NB_TYPE_CASTER(T, Base::Name)
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if (!Base::load(src, flags, cleanup))
+            return false;
+
+        value = SparseMap(Base::rows, Base::cols, Base::nnz,
+                          Base::indptr_caster.value.data(),
+                          Base::indices_caster.value.data(),
+                          Base::data_caster.value.data());
 
         return true;
     }
@@ -99,7 +148,7 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v
         return from_cpp((const T &) v, policy, cleanup);
     }
 
-    static handle from_cpp(const T &v, rv_policy policy, cleanup_list *) noexcept {
+    static handle from_cpp(const T &v, rv_policy policy, cleanup_list *cleanup) noexcept {
         if (!v.isCompressed()) {
             PyErr_SetString(PyExc_ValueError,
                             "nanobind: unable to return an Eigen sparse matrix that is not in a compressed format. "
@@ -107,53 +156,71 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v
             return handle();
         }
 
-        object matrix_type;
-        try {
-            matrix_type = module_::import_("scipy.sparse").attr(RowMajor ? "csr_matrix" : "csc_matrix");
-        } catch (python_error &e) {
-            e.restore();
-            return handle();
-        }
-
-        const Index rows = v.rows(), cols = v.cols();
-        const size_t data_shape[] = { (size_t) v.nonZeros() };
-        const size_t outer_indices_shape[] = { (size_t) ((RowMajor ? rows : cols) + 1) };
-
         T *src = std::addressof(const_cast<T &>(v));
         object owner;
-        if (policy == rv_policy::move) {
-            src = new T(std::move(v));
-            owner = capsule(src, [](void *p) noexcept { delete (T *) p; });
-        }
-
-        ScalarNDArray data(src->valuePtr(), 1, data_shape, owner);
-        StorageIndexNDArray outer_indices(src->outerIndexPtr(), 1, outer_indices_shape, owner);
-        StorageIndexNDArray inner_indices(src->innerIndexPtr(), 1, data_shape, owner);
 
+        /* Avoid copies of the (potentially large) index and value arrays. The
+           SciPy matrix either owns a moved or copied instance via a capsule,
+           or references the original storage. */
         try {
-            return matrix_type(make_tuple(
-                                   std::move(data), std::move(inner_indices), std::move(outer_indices)),
-                               make_tuple(rows, cols))
-                .release();
-        } catch (python_error &e) {
-            e.restore();
+            switch (policy) {
+                case rv_policy::automatic:
+                case rv_policy::copy:
+                    src = new T(v);
+                    owner = capsule(src, [](void *p) noexcept { delete (T *) p; });
+                    break;
+
+                case rv_policy::move:
+                    src = new T(std::move(*src));
+                    owner = capsule(src, [](void *p) noexcept { delete (T *) p; });
+                    break;
+
+                case rv_policy::reference_internal:
+                    if (!cleanup || !cleanup->self())
+                        return handle();
+                    owner = borrow(cleanup->self());
+                    break;
+
+                default:
+                    break;
+            }
+        } catch (const std::bad_alloc &) {
+            PyErr_NoMemory();
             return handle();
         }
+
+        return Base::wrap(*src, owner);
     }
 };
 
 
-/// Caster for Eigen::Map<Eigen::SparseMatrix>, still needs to be implemented.
+/// Caster for Eigen::Map<Eigen::SparseMatrix>, which references SciPy's arrays
 template <typename T>
-struct type_caster<Eigen::Map<T>, enable_if_t<is_eigen_sparse_matrix_v<T>>> {
+struct type_caster<Eigen::Map<T>, enable_if_t<is_eigen_sparse_matrix_v<T>>>
+    : sparse_caster_base<T> {
+    using Base = sparse_caster_base<T>;
     using Map = Eigen::Map<T>;
-    using SparseMatrixCaster = type_caster<T>;
-    static constexpr auto Name = SparseMatrixCaster::Name;
+    static constexpr auto Name = Base::Name;
     template <typename T_> using Cast = Map;
 
-    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept = delete;
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        return Base::load(src, flags, cleanup);
+    }
+
+    static handle from_cpp(const Map &v, rv_policy policy, cleanup_list *cleanup) noexcept {
+        object owner;
+        if (policy == rv_policy::reference_internal && cleanup && cleanup->self())
+            owner = borrow(cleanup->self());
 
-    static handle from_cpp(const Map &v, rv_policy policy, cleanup_list *cleanup) noexcept = delete;
+        return Base::wrap(v, owner);
+    }
+
+    operator Map() {
+        return Map(Base::rows, Base::cols, Base::nnz,
+                   Base::indptr_caster.value.data(),
+                   Base::indices_caster.value.data(),
+                   Base::data_caster.value.data());
+    }
 };
 
 
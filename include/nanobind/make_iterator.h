@@ -42,6 +42,96 @@ template <typename Iterator> struct iterator_value_access {
     result_type operator()(Iterator &it) const { return (*it).second; }
 };
 
+/// Convert the current element of an iterator state, returns nullptr on failure
+template <typename Access, rv_policy Policy, typename ValueType, typename State>
+PyObject *iterator_convert(State &s, cleanup_list *cleanup) {
+    PyObject *result =
+        make_caster<ValueType>::from_cpp(Access()(s.it), Policy, cleanup).ptr();
+
+    if (!result && !PyErr_Occurred())
+        PyErr_SetString(PyExc_TypeError, "nanobind::make_iterator(): unable "
+                                         "to convert an element to Python!");
+
+    return result;
+}
+
+/// Native 'tp_iternext' slot: no function dispatch, and no StopIteration
+/// exception when the range is exhausted
+template <typename Access, rv_policy Policy, typename ValueType, typename State>
+PyObject *iterator_next(PyObject *self) noexcept {
+    State *s;
+    if (!nb_type_get(&typeid(State), self, 0, nullptr, (void **) &s)) {
+        PyErr_SetString(PyExc_TypeError, "nanobind::make_iterator(): invalid "
+                                         "iterator state!");
+        return nullptr;
+    }
+
+    cleanup_list cleanup(self);
+    PyObject *result = nullptr;
+
+    try {
+        if (!s->first_or_done)
+            ++s->it;
+        else
+            s->first_or_done = false;
+
+        if (s->it == s->end) {
+            s->first_or_done = true;
+        } else {
+            result = iterator_convert<Access, Policy, ValueType>(*s, &cleanup);
+        }
+    } catch (...) {
+        translate_exception();
+    }
+
+    cleanup.release();
+    return result;
+}
+
+/// Iterator state of make_chunked_iterator()
+template <typename Access, rv_policy Policy, typename Iterator,
+          typename Sentinel, typename ValueType>
+struct chunked_iterator_state {
+    Iterator it;
+    Sentinel end;
+    size_t chunk_size;
+};
+
+/// 'tp_iternext' slot producing lists of up to 'chunk_size' elements
+template <typename Access, rv_policy Policy, typename ValueType, typename State>
+PyObject *chunked_iterator_next(PyObject *self) noexcept {
+    State *s;
+    if (!nb_type_get(&typeid(State), self, 0, nullptr, (void **) &s)) {
+        PyErr_SetString(PyExc_TypeError, "nanobind::make_chunked_iterator(): "
+                                         "invalid iterator state!");
+        return nullptr;
+    }
+
+    if (s->it == s->end)
+        return nullptr;
+
+    cleanup_list cleanup(self);
+    PyObject *result = PyList_New(0);
+
+    try {
+        for (size_t i = 0; result && i < s->chunk_size && s->it != s->end;
+             ++i, ++s->it) {
+            PyObject *o =
+                iterator_convert<Access, Policy, ValueType>(*s, &cleanup);
+            if (!o || PyList_Append(result, o)) {
+                Py_CLEAR(result);
+            }
+            Py_XDECREF(o);
+        }
+    } catch (...) {
+        translate_exception();
+        Py_CLEAR(result);
+    }
+
+    cleanup.release();
+    return result;
+}
+
 template <typename Access, rv_policy Policy, typename Iterator,
           typename Sentinel, typename ValueType, typename... Extra>
 iterator make_iterator_impl(handle scope, const char *name,
@@ -50,30 +140,69 @@ iterator make_iterator_impl(handle scope, const char *name,
     using State = iterator_state<Access, Policy, Iterator, Sentinel, ValueType, Extra...>;
 
     if (!type<State>().is_valid()) {
-        class_<State>(scope, name)
-            .def("__iter__", [](handle h) { return h; })
-            .def("__next__",
-                 [](State &s) -> ValueType {
-                     if (!s.first_or_done)
-                         ++s.it;
-                     else
-                         s.first_or_done = false;
-
-                     if (s.it == s.end) {
-                         s.first_or_done = true;
-                         throw stop_iteration();
-                     }
-
-                     return Access()(s.it);
-                 },
-                 std::forward<Extra>(extra)...,
-                 Policy);
+        if constexpr (sizeof...(Extra) == 0) {
+            static PyType_Slot slots[] = {
+                { Py_tp_iter, (void *) PyObject_SelfIter },
+                { Py_tp_iternext,
+                  (void *) iterator_next<Access, Policy, ValueType, State> },
+                { 0, nullptr }
+            };
+
+            class_<State>(scope, name, type_slots(slots));
+        } else {
+            // Annotations apply to a regular '__next__' method
+            class_<State>(scope, name)
+                .def("__iter__", [](handle h) { return h; })
+                .def("__next__",
+                     [](State &s) -> ValueType {
+                         if (!s.first_or_done)
+                             ++s.it;
+                         else
+                             s.first_or_done = false;
+
+                         if (s.it == s.end) {
+                             s.first_or_done = true;
+                             throw stop_iteration();
+                         }
+
+                         return Access()(s.it);
+                     },
+                     std::forward<Extra>(extra)...,
+                     Policy);
+        }
     }
 
     return borrow<iterator>(cast(State{ std::forward<Iterator>(first),
                                         std::forward<Sentinel>(last), true }));
 }
 
+template <typename Access, rv_policy Policy, typename Iterator,
+          typename Sentinel, typename ValueType>
+iterator make_chunked_iterator_impl(handle scope, const char *name,
+                                    Iterator &&first, Sentinel &&last,
+                                    size_t chunk_size) {
+    using State = chunked_iterator_state<Access, Policy, Iterator, Sentinel, ValueType>;
+
+    if (chunk_size == 0)
+        throw value_error("nanobind::make_chunked_iterator(): the chunk size "
+                          "must be positive!");
+
+    if (!type<State>().is_valid()) {
+        static PyType_Slot slots[] = {
+            { Py_tp_iter, (void *) PyObject_SelfIter },
+            { Py_tp_iternext,
+              (void *) chunked_iterator_next<Access, Policy, ValueType, State> },
+            { 0, nullptr }
+        };
+
+        class_<State>(scope, name, type_slots(slots));
+    }
+
+    return borrow<iterator>(cast(State{ std::forward<Iterator>(first),
+                                        std::forward<Sentinel>(last),
+                                        chunk_size }));
+}
+
 NAMESPACE_END(detail)
 
 /// Makes a python iterator from a first and past-the-end C++ InputIterator.
@@ -120,6 +249,21 @@ iterator make_value_iterator(handle scope, const char *name, Iterator &&first, S
         std::forward<Sentinel>(last), std::forward<Extra>(extra)...);
 }
 
+/// Like make_iterator(), but every step returns a list with up to `chunk_size`
+/// converted elements, which reduces the per-element overhead of a Python loop.
+template <rv_policy Policy = rv_policy::reference_internal,
+          typename Iterator,
+          typename Sentinel,
+          typename ValueType = typename detail::iterator_access<Iterator>::result_type>
+iterator make_chunked_iterator(handle scope, const char *name, Iterator &&first,
+                               Sentinel &&last, size_t chunk_size) {
+    return detail::make_chunked_iterator_impl<detail::iterator_access<Iterator>,
+                                              Policy, Iterator, Sentinel,
+                                              ValueType>(
+        scope, name, std::forward<Iterator>(first),
+        std::forward<Sentinel>(last), chunk_size);
+}
+
 /// Makes an iterator over values of a container supporting `std::begin()`/`std::end()`
 template <rv_policy Policy = rv_policy::reference_internal,
           typename Type,
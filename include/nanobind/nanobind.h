@@ -31,8 +31,10 @@
 #include <stdexcept>
 #include <type_traits>
 #include <typeinfo>
+#include <typeindex>
 #include <utility>
 #include <new>
+#include <initializer_list>
 
 // Implementation. The nb_*.h files should only be included through nanobind.h
 #include "nb_python.h"
@@ -157,6 +157,11 @@ template <typename D> accessor<str_attr> api<D>::attr(const char *key) const {
     return { derived(), key };
 }
 
+template <typename D>
+accessor<obj_attr> api<D>::attr(const interned &key) const {
+    return { derived(), handle(key.ptr()) };
+}
+
 template <typename D> accessor<str_attr> api<D>::doc() const {
     return { derived(), "__doc__" };
 }
@@ -169,6 +174,11 @@ template <typename D> accessor<str_item> api<D>::operator[](const char *key) con
     return { derived(), key };
 }
 
+template <typename D>
+accessor<obj_item> api<D>::operator[](const interned &key) const {
+    return { derived(), handle(key.ptr()) };
+}
+
 template <typename D>
 template <typename T, enable_if_t<std::is_arithmetic_v<T>>>
 accessor<num_item> api<D>::operator[](T index) const {
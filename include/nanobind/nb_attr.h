@@ -47,19 +47,36 @@ template <typename... Ts> struct call_guard {
     using type = detail::tuple<Ts...>;
 };
 
+struct release_gil {
+    NB_INLINE constexpr explicit release_gil(bool value = true) : value(value) {}
+    bool value;
+};
+
 struct dynamic_attr {};
 struct is_method {};
 struct is_implicit {};
 struct is_operator {};
 struct is_arithmetic {};
+struct is_flag {};
 struct is_final {};
+struct pooled {};
+struct no_identity {};
+struct inline_keep_alive {};
+struct trivial_pickle {};
+struct member_cache {};
+struct hashable {};
+struct intern_strings {};
+struct cfunc {};
+struct direct_call {};
 
 template <size_t /* Nurse */, size_t /* Patient */> struct keep_alive {};
 template <typename T> struct supplement {};
 template <typename T> struct intrusive_ptr {
-    intrusive_ptr(void (*set_self_py)(T *, PyObject *) noexcept)
-        : set_self_py(set_self_py) { }
+    intrusive_ptr(void (*set_self_py)(T *, PyObject *) noexcept,
+                  PyObject *(*get_self_py)(T *) noexcept = nullptr)
+        : set_self_py(set_self_py), get_self_py(get_self_py) { }
     void (*set_self_py)(T *, PyObject *) noexcept;
+    PyObject *(*get_self_py)(T *) noexcept;
 };
 
 struct type_slots {
@@ -113,7 +130,17 @@ enum class func_flags : uint32_t {
     /// Should the func_new() call return a new reference?
     return_ref = (1 << 15),
     /// Does this overload specify a raw docstring that should take precedence?
-    raw_doc = (1 << 16)
+    raw_doc = (1 << 16),
+    /// Can the function be called from C++ via func_data_prelim::direct?
+    has_direct = (1 << 17),
+    /// Release the GIL between argument conversion and return value casting?
+    release_gil = (1 << 18),
+    /// Did the user specify nb::release_gil() for this function?
+    has_release_gil = (1 << 19),
+    /// Does the function signature permit releasing the GIL?
+    can_release_gil = (1 << 20),
+    /// Does 'capture' hold a C entry point and its signature (see nb::cfunc)?
+    has_cfunc = (1 << 21)
 };
 
 struct arg_data {
@@ -135,6 +162,12 @@ template <size_t Size> struct func_data_prelim {
     PyObject *(*impl)(void *, PyObject **, uint8_t *, rv_policy,
                       cleanup_list *);
 
+    /// Type-erased C++ entry point 'Return (*)(void *capture, Args...)'
+    void (*direct)(void);
+
+    /// Signature 'Return (*)(Args...)' of the 'direct' entry point
+    const std::type_info *direct_sig;
+
     /// Function signature description
     const char *descr;
 
@@ -225,10 +258,26 @@ NB_INLINE void func_extra_apply(F &f, const arg_v &a, size_t &index) {
 template <typename F, typename... Ts>
 NB_INLINE void func_extra_apply(F &, call_guard<Ts...>, size_t &) {}
 
+template <typename F>
+NB_INLINE void func_extra_apply(F &f, release_gil r, size_t &) {
+    f.flags |= (uint32_t) func_flags::has_release_gil;
+    if (r.value)
+        f.flags |= (uint32_t) func_flags::release_gil;
+}
+
 template <typename F, size_t Nurse, size_t Patient>
 NB_INLINE void func_extra_apply(F &, nanobind::keep_alive<Nurse, Patient>,
                                 size_t &) {}
 
+template <typename F>
+NB_INLINE void func_extra_apply(F &, intern_strings, size_t &) {}
+
+template <typename F>
+NB_INLINE void func_extra_apply(F &, cfunc, size_t &) {}
+
+template <typename F>
+NB_INLINE void func_extra_apply(F &, direct_call, size_t &) {}
+
 template <typename... Ts> struct extract_guard { using type = void; };
 
 template <typename T, typename... Ts> struct extract_guard<T, Ts...> {
@@ -93,11 +93,12 @@ NB_INLINE void call_init(PyObject **args, PyObject *kwnames, size_t &nargs,
         args_p = args + 1;                                                     \
     }                                                                          \
     nargs |= NB_VECTORCALL_ARGUMENTS_OFFSET;                                   \
-    return steal(obj_vectorcall(base, args_p, nargs, kwnames, method_call))
+    return steal((Try ? obj_try_vectorcall : obj_vectorcall)(                  \
+        base, args_p, nargs, kwnames, method_call))
 
 template <typename Derived>
-template <rv_policy policy, typename... Args>
-object api<Derived>::operator()(Args &&...args_) const {
+template <bool Try, rv_policy policy, typename... Args>
+object api<Derived>::call_impl(Args &&...args_) const {
     static constexpr bool method_call =
         std::is_same_v<Derived, accessor<obj_attr>> ||
         std::is_same_v<Derived, accessor<str_attr>>;
@@ -140,9 +141,103 @@ object api<Derived>::operator()(Args &&...args_) const {
 
 #undef NB_DO_VECTORCALL
 
+template <typename Derived>
+template <rv_policy policy, typename... Args>
+object api<Derived>::operator()(Args &&...args) const {
+    return call_impl<false, policy>((forward_t<Args>) args...);
+}
+
+template <typename Derived>
+template <rv_policy policy, typename... Args>
+object api<Derived>::try_call(Args &&...args) const {
+    return call_impl<true, policy>((forward_t<Args>) args...);
+}
+
 #if defined(_MSC_VER)
 #  pragma warning(pop)
 #endif
 
 NAMESPACE_END(detail)
+
+/**
+ * Python function or method call that is prepared once and then performed
+ * many times. The callable (or the receiver and method name) and the names
+ * of keyword arguments are converted into Python objects when the instance
+ * is created, and each call only converts its arguments.
+ *
+ * The last ``kwnames.size()`` arguments of each call are passed as keyword
+ * arguments with the names given to the constructor, e.g.
+ *
+ *     nb::prepared_call step(policy, "step", { "reward" });
+ *     for (...)
+ *         nb::object action = step(state, reward); // policy.step(state, reward=reward)
+ */
+class prepared_call {
+public:
+    /// Prepare calls of the callable 'func'
+    prepared_call(handle func, std::initializer_list<const char *> kwnames = {})
+        : m_base(borrow(func)),
+          m_kwnames(steal(detail::kwnames_new(kwnames.begin(), kwnames.size()))),
+          m_nkwargs(kwnames.size()) { }
+
+    /// Prepare calls of the method 'name' of 'self'
+    prepared_call(handle self, const char *name,
+                  std::initializer_list<const char *> kwnames = {})
+        : m_base(steal(PyUnicode_InternFromString(name))), m_self(borrow(self)),
+          m_kwnames(steal(detail::kwnames_new(kwnames.begin(), kwnames.size()))),
+          m_nkwargs(kwnames.size()) {
+        if (!m_base.is_valid())
+            detail::raise_python_error();
+    }
+
+    template <rv_policy policy = rv_policy::automatic_reference, typename... Args>
+    object operator()(Args &&...args) const {
+        return call_impl<false, policy>((detail::forward_t<Args>) args...);
+    }
+
+    /// Like operator(), but return an invalid object if the call raises
+    template <rv_policy policy = rv_policy::automatic_reference, typename... Args>
+    object try_call(Args &&...args) const {
+        return call_impl<true, policy>((detail::forward_t<Args>) args...);
+    }
+
+private:
+    template <bool Try, rv_policy policy, typename... Args>
+    object call_impl(Args &&...args_) const {
+        constexpr size_t n = sizeof...(Args);
+        if (NB_UNLIKELY(n < m_nkwargs))
+            detail::raise("nanobind::prepared_call: expected at least %zu "
+                          "arguments!", m_nkwargs);
+
+        PyObject *args[n + 1];
+        size_t i = 1;
+        ((args[i++] = detail::make_caster<Args>::from_cpp(
+                          (detail::forward_t<Args>) args_, policy, nullptr)
+                          .ptr()),
+         ...);
+        (void) i;
+
+        bool method_call = m_self.is_valid();
+        size_t nargs = n - m_nkwargs;
+        PyObject **args_p = args + 1;
+        if (method_call) {
+            args[0] = m_self.inc_ref().ptr();
+            args_p = args;
+            nargs++;
+        } else {
+            args[0] = nullptr;
+        }
+
+        return steal((Try ? detail::obj_try_vectorcall : detail::obj_vectorcall)(
+            m_base.inc_ref().ptr(), args_p,
+            nargs | NB_VECTORCALL_ARGUMENTS_OFFSET, m_kwnames.inc_ref().ptr(),
+            method_call));
+    }
+
+    object m_base;    // callable or method name
+    object m_self;    // receiver of method calls
+    object m_kwnames; // tuple of keyword argument names (or null)
+    size_t m_nkwargs;
+};
+
 NAMESPACE_END(NB_NAMESPACE)
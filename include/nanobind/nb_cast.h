@@ -35,7 +35,11 @@ enum cast_flags : uint8_t {
     convert = (1 << 0),
 
     // Passed to the 'self' argument in a constructor call (__init__)
-    construct = (1 << 1)
+    construct = (1 << 1),
+
+    // No other overload sees the argument if the conversion fails, hence
+    // single-pass inputs like iterators may be consumed
+    consume = (1 << 2)
 };
 
 template <typename T> using cast_t = typename make_caster<T>::template Cast<T>;
@@ -309,6 +313,10 @@ template <typename Type_> struct type_caster_base {
         else
             ptr = (Type *) &value;
 
+        // Enumerations map to the unique instance representing each entry
+        if constexpr (std::is_enum_v<Type> && !is_pointer_v<T>)
+            return nb_enum_from_cpp(&typeid(Type), ptr);
+
         policy = infer_policy<T>(policy);
         const std::type_info *type = &typeid(Type);
 
@@ -343,7 +351,18 @@ private:
 };
 
 template <typename Type, typename SFINAE>
-struct type_caster : type_caster_base<Type> { };
+struct type_caster : type_caster_base<Type> {
+    /// Bound types returned by value can be constructed in the instance
+    static constexpr bool Inplace =
+        std::is_base_of_v<std::false_type, type_hook<Type>>;
+};
+
+/// Can 'Caster' construct return values directly in the instance storage?
+template <typename Caster, typename SFINAE = int>
+struct is_inplace_caster : std::false_type { };
+template <typename Caster>
+struct is_inplace_caster<Caster, enable_if_t<Caster::Inplace>>
+    : std::true_type { };
 
 NAMESPACE_END(detail)
 
@@ -362,7 +381,8 @@ T cast(const detail::api<Derived> &value, bool convert = true) {
 
         Caster caster;
         if (!caster.from_python(value.derived().ptr(),
-                                convert ? (uint8_t) detail::cast_flags::convert
+                                convert ? (uint8_t) (detail::cast_flags::convert |
+                                                     detail::cast_flags::consume)
                                         : (uint8_t) 0, nullptr))
             detail::raise_cast_error();
 
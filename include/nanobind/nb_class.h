@@ -52,8 +52,23 @@ enum class type_flags : uint32_t {
     /// If so, type_data::keep_shared_from_this_alive is also set.
     has_shared_from_this     = (1 << 13),
 
-    // Five more flag bits available (14 through 18) without needing
-    // a larger reorganization
+    /// Internal: does the type have deferred function bindings?
+    has_lazy_funcs           = (1 << 14),
+
+    /// Instances are allocated from a pool of recycled memory blocks
+    is_pooled                = (1 << 15),
+
+    // Instances are not registered in the C++ -> Python instance map
+    no_identity              = (1 << 16),
+
+    // Instances reserve an inline slot for one keep_alive patient
+    has_inline_keep_alive    = (1 << 17),
+
+    // Instances are pickled and copied via memcpy() of their payload
+    is_trivial_pickle        = (1 << 18),
+
+    // Instances cache the wrappers of their members (see nb::member_cache)
+    has_member_cache         = (1 << 19)
 };
 
 /// Flags about a type that are only relevant when it is being created.
@@ -62,29 +77,32 @@ enum class type_flags : uint32_t {
 /// out of flags.
 enum class type_init_flags : uint32_t {
     /// Is the 'supplement' field of the type_init_data structure set?
-    has_supplement           = (1 << 19),
+    has_supplement           = (1 << 20),
 
     /// Is the 'doc' field of the type_init_data structure set?
-    has_doc                  = (1 << 20),
+    has_doc                  = (1 << 21),
 
     /// Is the 'base' field of the type_init_data structure set?
-    has_base                 = (1 << 21),
+    has_base                 = (1 << 22),
 
     /// Is the 'base_py' field of the type_init_data structure set?
-    has_base_py              = (1 << 22),
+    has_base_py              = (1 << 23),
 
     /// This type provides extra PyType_Slot fields via the 'type_slots'
     /// and/or 'type_slots_callback' members of type_init_data
-    has_type_slots           = (1 << 23),
+    has_type_slots           = (1 << 24),
+
+    /// Are the 'hash' and 'richcompare' fields of type_init_data set?
+    is_hashable              = (1 << 25),
 
-    all_init_flags           = (0x1f << 19)
+    all_init_flags           = (0x3f << 20)
 };
 
 /// Information about a type that persists throughout its lifetime
 struct type_data {
     uint32_t size;
-    uint32_t align : 8;
-    uint32_t flags : 24;
+    uint32_t flags;
+    uint8_t align;
     const char *name;
     const std::type_info *type;
     PyTypeObject *type_py;
@@ -93,8 +111,12 @@ struct type_data {
     void (*move)(void *, void *) noexcept;
     const std::type_info **implicit;
     bool (**implicit_py)(PyTypeObject *, PyObject *, cleanup_list *) noexcept;
+    bool (**implicit_native)(PyObject *, void *) noexcept;
     void (*set_self_py)(void *, PyObject *) noexcept;
+    PyObject *(*get_self_py)(void *) noexcept;
     bool (*keep_shared_from_this_alive)(PyObject *) noexcept;
+    /// Internal: cache of Python method overrides (see trampoline.cpp)
+    void *overrides;
 #if defined(Py_LIMITED_API)
     size_t dictoffset;
 #endif
@@ -109,6 +131,8 @@ struct type_init_data : type_data {
     const PyType_Slot *type_slots;
     void (*type_slots_callback)(const type_init_data *d, PyType_Slot *&slots, size_t max_slots);
     size_t supplement;
+    hashfunc hash;
+    richcmpfunc richcompare;
 };
 
 NB_INLINE void type_extra_apply(type_init_data &t, const handle &h) {
@@ -141,6 +165,7 @@ template <typename T>
 NB_INLINE void type_extra_apply(type_init_data &t, intrusive_ptr<T> ip) {
     t.flags |= (uint32_t) type_flags::intrusive_ptr;
     t.set_self_py = (void (*)(void *, PyObject *) noexcept) ip.set_self_py;
+    t.get_self_py = (PyObject *(*)(void *) noexcept) ip.get_self_py;
 }
 
 NB_INLINE void type_extra_apply(type_init_data &t, is_final) {
@@ -151,6 +176,72 @@ NB_INLINE void type_extra_apply(type_init_data &t, dynamic_attr) {
     t.flags |= (uint32_t) type_flags::has_dynamic_attr;
 }
 
+NB_INLINE void type_extra_apply(type_init_data &t, pooled) {
+    t.flags |= (uint32_t) type_flags::is_pooled;
+}
+
+NB_INLINE void type_extra_apply(type_init_data &t, no_identity) {
+    t.flags |= (uint32_t) type_flags::no_identity;
+}
+
+NB_INLINE void type_extra_apply(type_init_data &t, inline_keep_alive) {
+    t.flags |= (uint32_t) type_flags::has_inline_keep_alive;
+}
+
+NB_INLINE void type_extra_apply(type_init_data &t, trivial_pickle) {
+    t.flags |= (uint32_t) type_flags::is_trivial_pickle;
+}
+
+NB_INLINE void type_extra_apply(type_init_data &t, member_cache) {
+    t.flags |= (uint32_t) type_flags::has_member_cache |
+               (uint32_t) type_flags::has_inline_keep_alive;
+}
+
+// nb::hashable() installs slots specific to the bound type (see class_)
+NB_INLINE void type_extra_apply(type_init_data &, hashable) { }
+
+/**
+ * 'tp_hash' and 'tp_richcompare' slots of types bound with nb::hashable(),
+ * which call std::hash<T> and operator== on the instance payload. Only
+ * instances of exactly the same type compare equal.
+ */
+template <typename T> struct hashable_slots {
+    static Py_hash_t hash(PyObject *self) noexcept {
+        if (!nb_inst_state(self).first) {
+            PyErr_SetString(PyExc_TypeError, "nanobind: attempted to hash an "
+                                             "uninitialized instance!");
+            return -1;
+        }
+
+        try {
+            Py_hash_t h =
+                (Py_hash_t) std::hash<T>()(*(const T *) nb_inst_ptr(self));
+            return h == -1 ? -2 : h; // -1 indicates an error
+        } catch (...) {
+            translate_exception();
+            return -1;
+        }
+    }
+
+    static PyObject *richcompare(PyObject *a, PyObject *b, int op) noexcept {
+        if ((op != Py_EQ && op != Py_NE) || Py_TYPE(a) != Py_TYPE(b) ||
+            !nb_inst_state(a).first || !nb_inst_state(b).first) {
+            Py_INCREF(Py_NotImplemented);
+            return Py_NotImplemented;
+        }
+
+        try {
+            bool eq = *(const T *) nb_inst_ptr(a) == *(const T *) nb_inst_ptr(b);
+            PyObject *result = eq == (op == Py_EQ) ? Py_True : Py_False;
+            Py_INCREF(result);
+            return result;
+        } catch (...) {
+            translate_exception();
+            return nullptr;
+        }
+    }
+};
+
 template <typename T>
 NB_INLINE void type_extra_apply(type_init_data &t, supplement<T>) {
     static_assert(std::is_trivially_default_constructible_v<T>,
@@ -166,18 +257,31 @@ struct enum_supplement {
     bool is_signed = false;
     PyObject* entries = nullptr;
     PyObject* scope = nullptr;
+    /// Entries indexed by 'value - key_min' (empty if the values are sparse)
+    PyObject* dense = nullptr;
+    /// Range of entry values (shifted so that unsigned comparison works)
+    uint64_t key_min = 0, key_max = 0;
+    /// Flag enumerations: union of the entry bits and cached combinations
+    bool is_flag = false;
+    uint64_t flag_mask = 0;
+    PyObject* composites = nullptr;
 };
 
 /// Information needed to create an enum
 struct enum_init_data : type_init_data {
     bool is_signed = false;
     bool is_arithmetic = false;
+    bool is_flag = false;
 };
 
 NB_INLINE void type_extra_apply(enum_init_data &ed, is_arithmetic) {
     ed.is_arithmetic = true;
 }
 
+NB_INLINE void type_extra_apply(enum_init_data &ed, is_flag) {
+    ed.is_flag = true;
+}
+
 // Enums can't have base classes or supplements or be intrusive, and
 // are always final. They can't use type_slots_callback because that is
 // used by the enum mechanism internally, but can provide additional
@@ -188,6 +292,12 @@ void type_extra_apply(enum_init_data &, intrusive_ptr<T>) = delete;
 template <typename T>
 void type_extra_apply(enum_init_data &, supplement<T>) = delete;
 void type_extra_apply(enum_init_data &, is_final) = delete;
+void type_extra_apply(enum_init_data &, pooled) = delete;
+void type_extra_apply(enum_init_data &, no_identity) = delete;
+void type_extra_apply(enum_init_data &, inline_keep_alive) = delete;
+void type_extra_apply(enum_init_data &, trivial_pickle) = delete;
+void type_extra_apply(enum_init_data &, member_cache) = delete;
+void type_extra_apply(enum_init_data &, hashable) = delete;
 void type_extra_apply(enum_init_data &, type_slots_callback) = delete;
 
 template <typename T> void wrap_copy(void *dst, const void *src) {
@@ -235,6 +345,42 @@ struct is_copy_constructible : std::is_copy_constructible<T> { };
 template <typename T>
 constexpr bool is_copy_constructible_v = is_copy_constructible<T>::value;
 
+/// Can def_rw() / def_ro() install a direct accessor for a field of type 'D'?
+template <typename D>
+constexpr bool is_member_scalar_v =
+    std::is_arithmetic_v<D> && !is_std_char_v<D> &&
+    (!std::is_floating_point_v<D> || sizeof(D) == 4 || sizeof(D) == 8);
+
+template <typename D> constexpr member_kind member_kind_of() {
+    if constexpr (std::is_same_v<D, bool>) {
+        return member_kind::bool_;
+    } else if constexpr (std::is_floating_point_v<D>) {
+        return sizeof(D) == 8 ? member_kind::f64 : member_kind::f32;
+    } else {
+        constexpr int index = sizeof(D) == 1 ? 0 : sizeof(D) == 2 ? 1
+                            : sizeof(D) == 4 ? 2 : 3;
+        return (member_kind) ((int) member_kind::i8 + 2 * index +
+                              (std::is_signed_v<D> ? 0 : 1));
+    }
+}
+
+/// Direct accessors only support an optional docstring as extra argument
+template <typename... Extra>
+constexpr bool is_member_extra_v =
+    sizeof...(Extra) == 0 ||
+    (sizeof...(Extra) == 1 &&
+     (std::is_convertible_v<const Extra &, const char *> && ...));
+
+NB_INLINE const char *member_doc() { return nullptr; }
+NB_INLINE const char *member_doc(const char *doc) { return doc; }
+
+/// Byte offset of a data member within its class
+template <typename T, typename D> size_t member_offset(D T::*p) {
+    // Placeholder address, no memory is accessed
+    const T *t = reinterpret_cast<const T *>(alignof(T) * 256);
+    return (size_t) ((const char *) &(t->*p) - (const char *) t);
+}
+
 NAMESPACE_END(detail)
 
 // Low level access to nanobind type objects
@@ -409,6 +555,22 @@ public:
             };
         }
 
+        if constexpr ((std::is_same_v<Extra, trivial_pickle> || ...)) {
+            static_assert(std::is_trivially_copyable_v<T> &&
+                              std::is_same_v<Alias, T>,
+                          "nb::trivial_pickle() requires a trivially copyable "
+                          "type without a trampoline!");
+        }
+
+        if constexpr ((std::is_same_v<Extra, hashable> || ...)) {
+            static_assert(std::is_default_constructible_v<std::hash<T>>,
+                          "nb::hashable() requires a std::hash<T> "
+                          "specialization!");
+            d.flags |= (uint32_t) detail::type_init_flags::is_hashable;
+            d.hash = detail::hashable_slots<T>::hash;
+            d.richcompare = detail::hashable_slots<T>::richcompare;
+        }
+
         (detail::type_extra_apply(d, extra), ...);
 
         m_ptr = detail::nb_type_new(&d);
@@ -499,12 +661,21 @@ public:
         static_assert(std::is_base_of_v<C, T>,
                       "def_rw() requires a (base) class member!");
 
-        using Q = std::conditional_t<detail::make_caster<D>::IsClass, const D &, D &&>;
-
-        def_prop_rw(name,
-            [p](const T &c) -> const D & { return c.*p; },
-            [p](T &c, Q value) { c.*p = (Q) value; },
-            extra...);
+        if constexpr (std::is_same_v<C, T> && !std::is_const_v<D> &&
+                      detail::is_member_scalar_v<D> &&
+                      detail::is_member_extra_v<Extra...>) {
+            // Read and write arithmetic fields without function dispatch
+            detail::member_install(m_ptr, name, detail::member_offset(p),
+                                   detail::member_kind_of<D>(), false,
+                                   detail::member_doc(extra...));
+        } else {
+            using Q = std::conditional_t<detail::make_caster<D>::IsClass, const D &, D &&>;
+
+            def_prop_rw(name,
+                [p](const T &c) -> const D & { return c.*p; },
+                [p](T &c, Q value) { c.*p = (Q) value; },
+                extra...);
+        }
 
         return *this;
     }
@@ -527,8 +698,17 @@ public:
         static_assert(std::is_base_of_v<C, T>,
                       "def_ro() requires a (base) class member!");
 
-        def_prop_ro(name,
-            [p](const T &c) -> const D & { return c.*p; }, extra...);
+        using D0 = std::remove_const_t<D>;
+
+        if constexpr (std::is_same_v<C, T> && detail::is_member_scalar_v<D0> &&
+                      detail::is_member_extra_v<Extra...>) {
+            detail::member_install(m_ptr, name, detail::member_offset(p),
+                                   detail::member_kind_of<D0>(), true,
+                                   detail::member_doc(extra...));
+        } else {
+            def_prop_ro(name,
+                [p](const T &c) -> const D & { return c.*p; }, extra...);
+        }
 
         return *this;
     }
@@ -588,6 +768,7 @@ public:
 
         detail::enum_supplement &supp = type_supplement<detail::enum_supplement>(*this);
         supp.is_signed = d.is_signed;
+        supp.is_flag = d.is_flag;
         supp.scope = d.scope;
     }
 
@@ -615,4 +796,12 @@ template <typename Source, typename Target> void implicitly_convertible() {
     }
 }
 
+template <typename Target>
+void implicitly_convertible(bool (*convert)(PyObject *src, void *out) noexcept) {
+    static_assert(std::is_destructible_v<Target>,
+                  "nb::implicitly_convertible(): the target type must be "
+                  "destructible!");
+    detail::implicitly_convertible(convert, &typeid(Target));
+}
+
 NAMESPACE_END(NB_NAMESPACE)
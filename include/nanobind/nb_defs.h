@@ -137,6 +137,7 @@
     extern "C" [[maybe_unused]] NB_EXPORT PyObject *PyInit_##name();           \
     extern "C" NB_EXPORT PyObject *PyInit_##name()
 
+#if !defined(NB_MULTIPLE_INTERPRETERS)
 #define NB_MODULE(name, variable)                                              \
     static PyModuleDef NB_CONCAT(nanobind_module_def_, name);                  \
     [[maybe_unused]] static void NB_CONCAT(nanobind_init_,                     \
@@ -154,4 +155,33 @@
         }                                                                      \
     }                                                                          \
     void NB_CONCAT(nanobind_init_, name)(::nanobind::module_ & (variable))
+#else
+/* Multi-phase initialization (PEP 489): the module body runs once per
+   interpreter that imports the extension */
+#define NB_MODULE(name, variable)                                              \
+    static PyModuleDef NB_CONCAT(nanobind_module_def_, name);                  \
+    static PyModuleDef_Slot NB_CONCAT(nanobind_module_slots_, name)[4];        \
+    [[maybe_unused]] static void NB_CONCAT(nanobind_init_,                     \
+                                           name)(::nanobind::module_ &);       \
+    static int NB_CONCAT(nanobind_exec_, name)(PyObject *m_) {                 \
+        if (!nanobind::detail::module_exec_begin(                              \
+                m_, &NB_CONCAT(nanobind_module_def_, name)))                   \
+            return -1;                                                         \
+        nanobind::module_ m = nanobind::borrow<nanobind::module_>(m_);         \
+        try {                                                                  \
+            NB_CONCAT(nanobind_init_, name)(m);                                \
+            return 0;                                                          \
+        } catch (const std::exception &e) {                                    \
+            PyErr_SetString(PyExc_ImportError, e.what());                      \
+            return -1;                                                         \
+        }                                                                      \
+    }                                                                          \
+    NB_MODULE_IMPL(name) {                                                     \
+        return nanobind::detail::module_def_init(                              \
+            NB_TOSTRING(name), &NB_CONCAT(nanobind_module_def_, name),         \
+            NB_CONCAT(nanobind_module_slots_, name),                           \
+            NB_CONCAT(nanobind_exec_, name));                                  \
+    }                                                                          \
+    void NB_CONCAT(nanobind_init_, name)(::nanobind::module_ & (variable))
+#endif
 
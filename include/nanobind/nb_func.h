@@ -10,6 +10,170 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
+/// Reuse string objects while converting the result of nb::intern_strings()
+template <bool Enable> struct str_intern_scope { };
+template <> struct str_intern_scope<true> {
+    str_intern_scope() : prev(str_intern_set(true)) { }
+    ~str_intern_scope() { str_intern_set(prev); }
+    bool prev;
+};
+
+/**
+ * Values of type 'T' reference Python objects, which requires the GIL. The
+ * element types of containers, tuples, and other templates are inspected
+ * recursively, e.g. ``std::vector<nb::object>`` is a Python value.
+ */
+template <typename T, typename SFINAE = int>
+struct is_python_value : std::is_base_of<handle, T> { };
+
+template <template <typename...> class C, typename... Ts>
+struct is_python_value<C<Ts...>>
+    : std::bool_constant<std::is_base_of_v<handle, C<Ts...>> ||
+                         (is_python_value<intrinsic_t<Ts>>::value || ...)> { };
+
+template <template <typename, size_t> class C, typename T, size_t N>
+struct is_python_value<C<T, N>> : is_python_value<intrinsic_t<T>> { };
+
+template <typename Return, typename... Args>
+struct is_python_value<Return(Args...)>
+    : std::bool_constant<is_python_value<intrinsic_t<Return>>::value ||
+                         (is_python_value<intrinsic_t<Args>>::value || ...)> { };
+
+/**
+ * Values of type 'T' may reference the arguments of the function returning
+ * them (e.g., expression templates and non-owning views). Such functions
+ * cannot be called through nb::direct_call(), whose arguments are destroyed
+ * when it returns.
+ */
+template <typename T, typename SFINAE = int>
+struct is_view_value : std::is_pointer<T> { };
+
+/// By-value parameters of class type are constructed before releasing the GIL
+template <typename T>
+constexpr bool is_gil_materialized_v = std::is_class_v<T>;
+
+/**
+ * Release the GIL while a function runs if its 'release_gil' flag is set.
+ *
+ * The GIL is released once the last by-value parameter of class type was
+ * constructed: 'arg<T>()' produces each parameter, and 'release(p, n)'
+ * releases the GIL right away if there are no such parameters (n == 0).
+ * 'reacquire(value)' passes through the return value of the function, so that
+ * it can be converted in the same full-expression as the call (by-value
+ * arguments, which the result may reference, are destroyed at its end)
+ */
+template <bool Enable> struct func_gil_release {
+    NB_INLINE void release(const void *, size_t) { }
+    NB_INLINE void reacquire() { }
+    template <typename T> NB_INLINE T &&reacquire(T &&value) {
+        return (T &&) value;
+    }
+    template <typename T, typename Caster>
+    NB_INLINE cast_t<T> arg(const void *, Caster &caster) {
+        return ((Caster &&) caster).operator cast_t<T>();
+    }
+};
+template <> struct func_gil_release<true> {
+    NB_INLINE void release(const void *p) {
+        if (((const func_data_prelim<0> *) p)->flags &
+            (uint32_t) func_flags::release_gil)
+            state = PyEval_SaveThread();
+    }
+    NB_INLINE void release(const void *p, size_t n) {
+        pending = n;
+        if (n == 0)
+            release(p);
+    }
+    template <typename T, typename Caster>
+    NB_INLINE std::conditional_t<is_gil_materialized_v<T>, T, cast_t<T>>
+    arg(const void *p, Caster &caster) {
+        if constexpr (is_gil_materialized_v<T>) {
+            // Runs once the parameter was constructed from the return value
+            struct last {
+                func_gil_release &g;
+                const void *p;
+                NB_INLINE ~last() {
+                    if (--g.pending == 0 && std::uncaught_exceptions() == 0)
+                        g.release(p);
+                }
+            } guard { *this, p };
+            (void) guard;
+            return ((Caster &&) caster).operator cast_t<T>();
+        } else {
+            return ((Caster &&) caster).operator cast_t<T>();
+        }
+    }
+    NB_INLINE void reacquire() {
+        if (state) {
+            PyEval_RestoreThread(state);
+            state = nullptr;
+        }
+    }
+    template <typename T> NB_INLINE T &&reacquire(T &&value) {
+        reacquire();
+        return (T &&) value;
+    }
+    NB_INLINE ~func_gil_release() { reacquire(); }
+    PyThreadState *state = nullptr;
+    size_t pending = 0;
+};
+
+/// Types that can be exchanged with a plain C entry point (see nb::cfunc)
+template <typename T, typename U = std::remove_cv_t<T>>
+constexpr bool is_cfunc_scalar_v =
+    std::is_same_v<U, bool> ||
+    (std::is_integral_v<U> && sizeof(U) <= 8) ||
+    (std::is_floating_point_v<U> && (sizeof(U) == 4 || sizeof(U) == 8));
+
+/// Opaque pointers are exchanged with Python as capsules
+template <typename T, typename U = std::remove_cv_t<T>>
+constexpr bool is_cfunc_arg_v =
+    is_cfunc_scalar_v<U> ||
+    (std::is_pointer_v<U> && std::is_void_v<std::remove_pointer_t<U>>);
+
+/// C declaration of such a type, e.g. 'long' or 'const void *'
+template <typename T> constexpr auto cfunc_name() {
+    using U = std::remove_cv_t<T>;
+
+    if constexpr (std::is_void_v<U>) {
+        return const_name("void");
+    } else if constexpr (std::is_same_v<U, bool>) {
+        return const_name("bool");
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return const_name<sizeof(U) == 4>("float", "double");
+    } else if constexpr (std::is_same_v<U, char>) {
+        return const_name("char");
+    } else if constexpr (std::is_same_v<U, signed char>) {
+        return const_name("signed char");
+    } else if constexpr (std::is_same_v<U, unsigned char>) {
+        return const_name("unsigned char");
+    } else if constexpr (std::is_same_v<U, short>) {
+        return const_name("short");
+    } else if constexpr (std::is_same_v<U, unsigned short>) {
+        return const_name("unsigned short");
+    } else if constexpr (std::is_same_v<U, int>) {
+        return const_name("int");
+    } else if constexpr (std::is_same_v<U, unsigned int>) {
+        return const_name("unsigned int");
+    } else if constexpr (std::is_same_v<U, long>) {
+        return const_name("long");
+    } else if constexpr (std::is_same_v<U, unsigned long>) {
+        return const_name("unsigned long");
+    } else if constexpr (std::is_same_v<U, long long>) {
+        return const_name("long long");
+    } else if constexpr (std::is_same_v<U, unsigned long long>) {
+        return const_name("unsigned long long");
+    } else if constexpr (std::is_integral_v<U>) {
+        // Character types without a C spelling (char16_t, etc.)
+        return const_name<std::is_signed_v<U>>("int", "uint") +
+               const_name<sizeof(U) * 8>() + const_name("_t");
+    } else {
+        using P = std::remove_pointer_t<U>;
+        return const_name<std::is_const_v<P>>("const ", "") +
+               cfunc_name<P>() + const_name(" *");
+    }
+}
+
 template <bool ReturnRef, bool CheckGuard, typename Func, typename Return,
           typename... Args, size_t... Is, typename... Extra>
 NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
@@ -29,6 +193,31 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
 
     (void) is;
 
+    /* Functions annotated with nb::cfunc capture a plain function pointer,
+       which is also their C entry point */
+    constexpr bool has_cfunc = (std::is_same_v<cfunc, Extra> + ... + 0) != 0;
+
+    if constexpr (has_cfunc) {
+        static_assert(std::is_same_v<Guard, void>,
+            "nb::cfunc() cannot be combined with nb::call_guard<>!");
+        static_assert((is_cfunc_arg_v<Return> || std::is_void_v<Return>) &&
+                      (is_cfunc_arg_v<Args> && ... && true),
+            "nb::cfunc() requires a function that only takes and returns "
+            "arithmetic values and 'void *' pointers!");
+        static_assert(std::is_nothrow_invocable_v<Func &, Args...>,
+            "nb::cfunc() requires a 'noexcept' function, since native callers "
+            "cannot handle C++ exceptions!");
+
+        using CFunc = Return (*)(Args...) noexcept;
+        static_assert(std::is_convertible_v<Func, CFunc>,
+            "nb::cfunc() requires a function pointer or a lambda function "
+            "without captures!");
+
+        if constexpr (!std::is_same_v<std::decay_t<Func>, CFunc>)
+            return func_create<ReturnRef, false>(
+                (CFunc) func, (Return (*)(Args...)) nullptr, is, extra...);
+    }
+
     // Detect locations of nb::args / nb::kwargs (if exists)
     static constexpr size_t
         args_pos_1 = index_1_v<std::is_same_v<intrinsic_t<Args>, args>...>,
@@ -43,6 +232,15 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
     constexpr bool is_method_det =
         (std::is_same_v<is_method, Extra> + ... + 0) != 0;
 
+    /* Functions that don't exchange Python objects can release the GIL
+       while running (see nb::release_gil) */
+    constexpr bool pure_cpp =
+        !(is_python_value<intrinsic_t<Args>>::value || ... ||
+          is_python_value<intrinsic_t<Return>>::value);
+    constexpr bool has_release_gil =
+        (std::is_same_v<release_gil, Extra> + ... + 0) != 0;
+    constexpr bool can_release_gil = pure_cpp && std::is_same_v<Guard, void>;
+
     /// A few compile-time consistency checks
     static_assert(args_pos_1 == args_pos_n && kwargs_pos_1 == kwargs_pos_n,
         "Repeated use of nb::kwargs or nb::args in the function signature!");
@@ -52,6 +250,24 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
         "nb::kwargs must be the last element of the function signature!");
     static_assert(args_pos_1 == nargs || args_pos_1 + 1 == kwargs_pos_1,
         "nb::args must follow positional arguments and precede nb::kwargs!");
+    static_assert(!has_release_gil || std::is_same_v<Guard, void>,
+        "nb::release_gil() cannot be combined with nb::call_guard<>!");
+    static_assert(!has_release_gil || pure_cpp,
+        "nb::release_gil() requires a function that doesn't take or return "
+        "Python objects!");
+
+    constexpr bool has_direct =
+        (std::is_same_v<direct_call, Extra> + ... + 0) != 0;
+    if constexpr (has_direct) {
+        static_assert(pure_cpp && std::is_same_v<Guard, void>,
+            "nb::direct_call() requires a function that doesn't take or "
+            "return Python objects and cannot be combined with "
+            "nb::call_guard<>!");
+        static_assert(!std::is_reference_v<Return> &&
+                      !is_view_value<std::remove_cv_t<Return>>::value,
+            "nb::direct_call() requires a function that returns an owning "
+            "value (not a reference, pointer, view, or expression template)!");
+    }
 
     // Collect function signature information for the docstring
     using cast_out = make_caster<
@@ -78,7 +294,8 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
     f.flags = (args_pos_1   < nargs ? (uint32_t) func_flags::has_var_args   : 0) |
               (kwargs_pos_1 < nargs ? (uint32_t) func_flags::has_var_kwargs : 0) |
               (nargs_provided       ? (uint32_t) func_flags::has_args       : 0) |
-              (ReturnRef            ? (uint32_t) func_flags::return_ref     : 0);
+              (ReturnRef            ? (uint32_t) func_flags::return_ref     : 0) |
+              (can_release_gil      ? (uint32_t) func_flags::can_release_gil : 0);
 
     /* Store captured function inside 'func_data_prelim' if there is space. Issues
        with aliasing are resolved via separate compilation of libnanobind. */
@@ -102,6 +319,17 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
         };
     }
 
+    if constexpr (has_cfunc) {
+        static constexpr auto cfunc_descr =
+            cfunc_name<Return>() + const_name(" (") +
+            const_name<sizeof...(Args) == 0>(
+                const_name("void"), concat(cfunc_name<Args>()...)) +
+            const_name(")");
+
+        f.capture[1] = (void *) cfunc_descr.text;
+        f.flags |= (uint32_t) func_flags::has_cfunc;
+    }
+
     f.impl = [](void *p, PyObject **args, uint8_t *args_flags, rv_policy policy,
                 cleanup_list *cleanup) NB_INLINE_LAMBDA -> PyObject * {
         (void)p; (void)args; (void)args_flags; (void)policy; (void)cleanup;
@@ -119,16 +347,61 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
                                                 cleanup) || ...))
             return NB_NEXT_OVERLOAD;
 
+        /* The GIL (if released) is reacquired before casting the return value
+           and before the by-value parameters are destroyed */
+        func_gil_release<can_release_gil> gil_guard;
+        constexpr size_t nmaterialize =
+            (is_gil_materialized_v<Args> + ... + 0);
+
         PyObject *result;
         if constexpr (std::is_void_v<Return>) {
-            cap->func(((make_caster<Args>&&) in.template get<Is>()).operator cast_t<Args>()...);
+            gil_guard.release(p, nmaterialize);
+            (cap->func(gil_guard.template arg<Args>(p, in.template get<Is>())...),
+             gil_guard.reacquire());
             result = Py_None;
             Py_INCREF(result);
         } else {
-            result = cast_out::from_cpp(
-                       cap->func(((make_caster<Args> &&) in.template get<Is>())
-                                     .operator cast_t<Args>()...),
-                       policy, cleanup).ptr();
+            str_intern_scope<(std::is_same_v<Extra, intern_strings> || ...)>
+                intern_guard;
+            (void) intern_guard;
+
+            /* Construct bound types returned by value directly in the storage
+               of a new instance instead of moving them there (this also
+               permits returning non-movable types) */
+            constexpr bool inplace =
+                std::is_class_v<Return> &&
+                is_inplace_caster<cast_out>::value;
+
+            result = nullptr;
+            if constexpr (inplace) {
+                void *storage = nullptr;
+                if (infer_policy<Return>(policy) == rv_policy::move)
+                    result = nb_inst_alloc_inplace(&typeid(Return), &storage);
+
+                if (result) {
+                    try {
+                        gil_guard.release(p, nmaterialize);
+                        (new (storage) std::remove_cv_t<Return>(cap->func(
+                             gil_guard.template arg<Args>(
+                                 p, in.template get<Is>())...)),
+                         gil_guard.reacquire());
+                    } catch (...) {
+                        gil_guard.reacquire();
+                        Py_DECREF(result);
+                        throw;
+                    }
+                    nb_inst_set_state(result, true, true);
+                }
+            }
+
+            if (!result) {
+                gil_guard.release(p, nmaterialize);
+                result = cast_out::from_cpp(
+                    gil_guard.reacquire(cap->func(
+                        gil_guard.template arg<Args>(
+                            p, in.template get<Is>())...)),
+                    policy, cleanup).ptr();
+            }
         }
 
         (process_keep_alive(args, result, (Extra *) nullptr), ...);
@@ -136,6 +409,23 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
         return result;
     };
 
+    /* Functions annotated with nb::direct_call() can also be called from C++
+       without going through Python (e.g., by the std::function caster) */
+    if constexpr (has_direct) {
+        f.flags |= (uint32_t) func_flags::has_direct;
+        f.direct = (void (*)(void)) (Return (*)(void *, Args...))
+            [](void *p, Args... args) -> Return {
+                const capture *cap;
+                if constexpr (sizeof(capture) <= sizeof(f.capture))
+                    cap = (capture *) p;
+                else
+                    cap = (capture *) ((void **) p)[0];
+
+                return cap->func((forward_t<Args>) args...);
+            };
+        f.direct_sig = &typeid(Return (*)(Args...));
+    }
+
     f.descr = descr.text;
     f.descr_types = descr_types;
     f.nargs = nargs;
@@ -162,6 +452,22 @@ NB_INLINE void cpp_function_def(Return (*f)(Args...), const Extra&... extra) {
         f, f, std::make_index_sequence<sizeof...(Args)>(), extra...);
 }
 
+/* Overloads for 'noexcept' function pointers, which preserve the exception
+   specification for nb::cfunc() */
+template <typename Return, typename... Args, typename... Extra>
+NB_INLINE object cpp_function(Return (*f)(Args...) noexcept, const Extra&... extra) {
+    return steal(detail::func_create<true, true>(
+        f, (Return (*)(Args...)) nullptr,
+        std::make_index_sequence<sizeof...(Args)>(), extra...));
+}
+
+template <typename Return, typename... Args, typename... Extra>
+NB_INLINE void cpp_function_def(Return (*f)(Args...) noexcept, const Extra&... extra) {
+    detail::func_create<false, true>(
+        f, (Return (*)(Args...)) nullptr,
+        std::make_index_sequence<sizeof...(Args)>(), extra...);
+}
+
 /// Construct a cpp_function from a lambda function (pot. with internal state)
 template <
     typename Func, typename... Extra,
@@ -22,6 +22,9 @@ struct ndarray_req;
  * Helper class to clean temporaries created by function dispatch.
  * The first element serves a special role: it stores the 'self'
  * object of method calls (for rv_policy::reference_internal).
+ *
+ * Storage beyond the first 'Small' entries and scratch memory requested via
+ * alloc() come from a per-thread bump allocator that is rewound by release().
  */
 struct NB_CORE cleanup_list {
 public:
@@ -30,7 +33,8 @@ public:
     cleanup_list(PyObject *self) :
         m_size{1},
         m_capacity{Small},
-        m_data{m_local} {
+        m_data{m_local},
+        m_arena_used{(size_t) -1} {
         m_local[0] = self;
     }
 
@@ -50,15 +54,32 @@ public:
     /// Decrease the reference count of all appended objects
     void release() noexcept;
 
+    /// Like release(), but keep the list usable for a subsequent call
+    void reset() noexcept;
+
+    /**
+     * Allocate 'size' bytes of scratch memory (aligned to 16 bytes) that
+     * remain valid until release() or reset(). Returns nullptr when out of
+     * memory.
+     */
+    void *alloc(size_t size) noexcept;
+
 protected:
     /// Out of memory, expand..
     void expand() noexcept;
 
+    /// Rewind the scratch arena to its state before the first alloc()
+    void rewind() noexcept;
+
 protected:
     uint32_t m_size;
     uint32_t m_capacity;
     PyObject **m_data;
     PyObject *m_local[Small];
+
+    /// Arena position preceding the first alloc() ('m_arena_used == -1': unused)
+    void *m_arena_chunk;
+    size_t m_arena_used;
 };
 
 // ========================================================================
@@ -99,17 +120,39 @@ NB_CORE PyObject *str_from_cstr(const char *c);
 /// Convert an UTF8 C string + size into a Python unicode string
 NB_CORE PyObject *str_from_cstr_and_size(const char *c, size_t n);
 
+/**
+ * Convert an UTF8 C string + size into a Python unicode string (used by type
+ * casters). While enabled via str_intern_set(), this returns the same object
+ * for repeated content using a bounded cache. Returns nullptr on failure.
+ */
+NB_CORE PyObject *str_from_cpp(const char *c, size_t n) noexcept;
+
+/// Enable/disable caching in str_from_cpp() for this thread, returns old state
+NB_CORE bool str_intern_set(bool value) noexcept;
+
 // ========================================================================
 
 /// Convert a Python object into a Python byte string
 NB_CORE PyObject *bytes_from_obj(PyObject *o);
 
+/**
+ * Return a pointer to the contents of a 'bytes', 'bytearray', or contiguous
+ * 'memoryview' object without copying them. The cleanup list keeps a buffer
+ * export of mutable objects alive. Returns nullptr if not supported.
+ */
+NB_CORE const char *bytes_view(PyObject *o, Py_ssize_t *size,
+                               cleanup_list *cleanup) noexcept;
+
 /// Convert an UTF8 null-terminated C string into a Python byte string
 NB_CORE PyObject *bytes_from_cstr(const char *c);
 
 /// Convert an UTF8 C string + size into a Python byte string
 NB_CORE PyObject *bytes_from_cstr_and_size(const char *c, size_t n);
 
+/// Expose 'size' bytes at 'data' via a 'memoryview' that keeps 'owner' alive
+NB_CORE PyObject *memoryview_from_buffer(const void *data, size_t size,
+                                         PyObject *owner, bool readonly);
+
 // ========================================================================
 
 /// Convert a Python object into a Python integer
@@ -175,6 +218,14 @@ NB_CORE PyObject *obj_vectorcall(PyObject *base, PyObject *const *args,
                                  size_t nargsf, PyObject *kwnames,
                                  bool method_call);
 
+/// Like obj_vectorcall(), but return nullptr with a Python error set on failure
+NB_CORE PyObject *obj_try_vectorcall(PyObject *base, PyObject *const *args,
+                                     size_t nargsf, PyObject *kwnames,
+                                     bool method_call);
+
+/// Create a tuple of interned keyword argument names (null if 'size' is zero)
+NB_CORE PyObject *kwnames_new(const char *const *names, size_t size);
+
 /// Create an iterator from 'o', raise an exception in case of errors
 NB_CORE PyObject *obj_iter(PyObject *o);
 
@@ -211,6 +262,12 @@ NB_CORE PyObject **seq_get_with_size(PyObject *seq, size_t size,
 NB_CORE PyObject **seq_get(PyObject *seq, size_t *size,
                            PyObject **temp) noexcept;
 
+// Return an iterator if the elements of 'seq' should be converted one by one
+// instead of via seq_get() (i.e., for sequences other than lists and tuples,
+// and for iterators when 'consume' is set), and store a length hint
+NB_CORE PyObject *seq_iter(PyObject *seq, bool consume,
+                           size_t *size_hint) noexcept;
+
 // ========================================================================
 
 /// Create a new capsule object with a name
@@ -222,6 +279,16 @@ NB_CORE PyObject *capsule_new(const void *ptr, const char *name,
 /// Create a Python function object for the given function record
 NB_CORE PyObject *nb_func_new(const void *data) noexcept;
 
+/// Check if 'o' is a function with a single overload callable as 'sig'
+NB_CORE bool nb_func_has_direct(PyObject *o, const std::type_info *sig) noexcept;
+
+/**
+ * Return the capture and C++ entry point of a function previously accepted
+ * by nb_func_has_direct(), or nullptr if its overloads have changed since.
+ * Does not require the GIL.
+ */
+NB_CORE void *nb_func_direct(PyObject *o, void (**direct)(void)) noexcept;
+
 // ========================================================================
 
 /// Create a Python type object for the given type record
@@ -254,6 +321,15 @@ NB_CORE PyObject *nb_type_put_unique_p(const std::type_info *cpp_type,
                                        void *value, cleanup_list *cleanup,
                                        bool cpp_delete) noexcept;
 
+/**
+ * \brief Cast 'size' instances spaced 'stride' bytes apart (e.g., the
+ * contents of a std::vector) into a Python list using the 'copy' or 'move'
+ * policy. Equivalent to a sequence of nb_type_put() calls.
+ */
+NB_CORE PyObject *nb_type_put_seq(const std::type_info *cpp_type, void *value,
+                                  size_t stride, size_t size, rv_policy rvp,
+                                  cleanup_list *cleanup) noexcept;
+
 /// Try to reliquish ownership from Python object to a unique_ptr
 NB_CORE void nb_type_relinquish_ownership(PyObject *o, bool cpp_delete);
 
@@ -284,6 +360,15 @@ NB_CORE PyObject *nb_type_lookup(const std::type_info *t) noexcept;
 /// Allocate an instance of type 't'
 NB_CORE PyObject *nb_inst_alloc(PyTypeObject *t);
 
+/**
+ * Allocate an instance of the bound C++ type 't' whose storage will receive
+ * a return value constructed in place. Stores the storage pointer in
+ * '*storage' and returns the (not yet ready) instance, or returns nullptr
+ * without raising an error if the type isn't suitable.
+ */
+NB_CORE PyObject *nb_inst_alloc_inplace(const std::type_info *t,
+                                        void **storage) noexcept;
+
 /// Allocate an instance of type 't' referencing the existing 'ptr'
 NB_CORE PyObject *nb_inst_wrap(PyTypeObject *t, void *ptr);
 
@@ -317,6 +402,35 @@ NB_CORE void nb_inst_set_state(PyObject *o, bool ready, bool destruct) noexcept;
 /// Query the 'ready' and 'destruct' flags of an instance
 NB_CORE std::pair<bool, bool> nb_inst_state(PyObject *o) noexcept;
 
+/// Note that a buffer references the instance data, returns false on overflow
+NB_CORE bool nb_inst_export(PyObject *o) noexcept;
+
+/// Undo a previous nb_inst_export() call
+NB_CORE void nb_inst_unexport(PyObject *o) noexcept;
+
+/// Return the number of buffers referencing the instance data
+NB_CORE size_t nb_inst_exports(PyObject *o) noexcept;
+
+/// Type slot implementation of an operator bound via operators.h
+struct op_slot_info {
+    /// Function bound as the special method (identifies the overload)
+    void *func;
+
+    /// Type slot ('Py_nb_add', ..., 'Py_tp_richcompare') and comparison ('Py_LT', ...)
+    int slot, op;
+
+    /// Slot function along with storage for the one it replaces
+    void *impl;
+    void **fallback;
+
+    /// Comparisons: table of 6 operators consulted by 'impl', and this entry
+    void **table;
+    void *entry;
+};
+
+/// Register 'info' and install operator slot implementations of 'type'
+NB_CORE void type_set_op_slots(PyObject *type, const op_slot_info *info) noexcept;
+
 // ========================================================================
 
 // Create and install a Python property object
@@ -327,6 +441,84 @@ NB_CORE void property_install_static(PyObject *scope, const char *name,
                                      PyObject *getter,
                                      PyObject *setter) noexcept;
 
+/// Scalar field types supported by member_install()
+enum class member_kind : uint8_t {
+    bool_, i8, u8, i16, u16, i32, u32, i64, u64, f32, f64
+};
+
+/**
+ * Install a descriptor that directly reads (and, unless 'readonly' is set,
+ * writes) a scalar field at byte offset 'offset' of the instances of 'scope'
+ */
+NB_CORE void member_install(PyObject *scope, const char *name, size_t offset,
+                            member_kind kind, bool readonly,
+                            const char *doc) noexcept;
+
+/**
+ * Fill 'view' with a one-dimensional buffer of 'count' instances of the bound
+ * C++ type 'type' starting at 'data'. Its format is a PEP 3118 struct
+ * ('T{...}') listing the scalar fields installed by member_install() on the
+ * type and its bound base classes in the order of their offsets. The buffer
+ * is read-only if any of them is read-only. The shape, strides, and format
+ * share an allocation that must be released using PyMem_Free(view->shape).
+ */
+NB_CORE int record_getbuffer(PyObject *exporter, Py_buffer *view, int flags,
+                             const std::type_info *type, void *data,
+                             size_t count) noexcept;
+
+/**
+ * Copy the elements of a one-dimensional CPU array (buffer protocol or DLPack)
+ * into storage for values of type 'kind' obtained from 'alloc(payload, size)'.
+ * Returns 'false' if 'seq' is not such an array, if its dtype differs and
+ * 'convert' is not set, or if it cannot be converted without loss.
+ */
+NB_CORE bool seq_load_array(PyObject *seq, member_kind kind, bool convert,
+                            void *(*alloc)(void *, size_t),
+                            void *payload) noexcept;
+
+// ========================================================================
+
+/// Function processing the index range [start, end) of a parallel loop
+using parallel_fn = void (*)(void *payload, size_t start, size_t end);
+
+/**
+ * Process the index range [0, size) in chunks of at least 'grain' indices
+ * using a shared thread pool. Must be called while holding the GIL, which is
+ * released meanwhile. Raises the first exception thrown by 'fn', or
+ * KeyboardInterrupt.
+ */
+NB_CORE void parallel_for(size_t size, size_t grain, parallel_fn fn,
+                          void *payload);
+
+/// Set the number of threads used by parallel_for() (0: one per core)
+NB_CORE void parallel_set_threads(size_t threads);
+
+/// Return the number of threads used by parallel_for()
+NB_CORE size_t parallel_threads() noexcept;
+
+/// Run 'fn(payload)' on a worker thread of the pool without holding the GIL
+NB_CORE void async_submit(void (*fn)(void *), void *payload);
+
+/**
+ * Hook SIGINT (once) and store the current interruption count in 'armed'.
+ * Returns the address of the count, which SIGINT increments. 'observed'
+ * receives the address of a flag that the function dispatcher of the calling
+ * thread checks once the current call returns, if set before that.
+ */
+NB_CORE const uint32_t *interrupt_arm(uint32_t *armed,
+                                      uint32_t **observed) noexcept;
+
+/// Create a future of the running asyncio event loop (also returned in 'loop')
+NB_CORE PyObject *async_future_new(PyObject **loop);
+
+/**
+ * Complete an asyncio future from any thread holding the GIL. Its value is
+ * 'value', or the current Python error if 'value' is NULL. The completion is
+ * forwarded via 'loop.call_soon_threadsafe()'. Steals all references.
+ */
+NB_CORE void async_future_set(PyObject *loop, PyObject *future,
+                              PyObject *value) noexcept;
+
 // ========================================================================
 
 NB_CORE PyObject *get_override(void *ptr, const std::type_info *type,
@@ -341,6 +533,11 @@ NB_CORE void keep_alive(PyObject *nurse, PyObject *patient);
 NB_CORE void keep_alive(PyObject *nurse, void *payload,
                         void (*deleter)(void *) noexcept) noexcept;
 
+// Return the most recent payload registered with the above function and
+// 'deleter' for the nanobind instance 'nurse', or NULL if there is none
+NB_CORE void *keep_alive_payload(PyObject *nurse,
+                                 void (*deleter)(void *) noexcept) noexcept;
+
 // ========================================================================
 
 /// Indicate to nanobind that an implicit constructor can convert 'src' -> 'dst'
@@ -353,6 +550,10 @@ NB_CORE void implicitly_convertible(bool (*predicate)(PyTypeObject *,
                                                       cleanup_list *),
                                     const std::type_info *dst) noexcept;
 
+/// Register a function that constructs 'dst' in-place from a Python object
+NB_CORE void implicitly_convertible(bool (*convert)(PyObject *, void *) noexcept,
+                                    const std::type_info *dst) noexcept;
+
 // ========================================================================
 
 /// Fill in slots for an enum type being built
@@ -366,6 +567,10 @@ NB_CORE void nb_enum_put(PyObject *type, const char *name, const void *value,
 /// Export enum entries to the parent scope
 NB_CORE void nb_enum_export(PyObject *type);
 
+/// Return the enum entry associated with a C++ enumeration value
+NB_CORE PyObject *nb_enum_from_cpp(const std::type_info *type,
+                                   const void *value) noexcept;
+
 // ========================================================================
 
 /// Try to import a Python extension module, raises an exception upon failure
@@ -374,6 +579,17 @@ NB_CORE PyObject *module_import(const char *name);
 /// Create a new extension module with the given name
 NB_CORE PyObject *module_new(const char *name, PyModuleDef *def) noexcept;
 
+/**
+ * Prepare a module definition for multi-phase initialization. 'slots' must
+ * have room for 4 entries.
+ */
+NB_CORE PyObject *module_def_init(const char *name, PyModuleDef *def,
+                                  PyModuleDef_Slot *slots,
+                                  int (*exec)(PyObject *)) noexcept;
+
+/// Bind the internals of the current interpreter before running a module body
+NB_CORE bool module_exec_begin(PyObject *m, PyModuleDef *def) noexcept;
+
 /// Create a submodule of an existing module
 NB_CORE PyObject *module_new_submodule(PyObject *base, const char *name,
                                        const char *doc) noexcept;
@@ -392,13 +608,45 @@ NB_CORE ndarray_handle *ndarray_create(void *value, size_t ndim,
                                        dlpack::dtype *dtype, int32_t device,
                                        int32_t device_id);
 
+/// Create an ndarray backed by a pooled, 64-byte aligned buffer
+NB_CORE ndarray_handle *ndarray_alloc(size_t ndim, const size_t *shape,
+                                      dlpack::dtype *dtype);
+
+/// Map a file into memory and describe its contents as an ndarray
+NB_CORE ndarray_handle *ndarray_mmap(const char *path, uint64_t offset,
+                                     size_t ndim, const size_t *shape,
+                                     dlpack::dtype *dtype, int mode,
+                                     int advice);
+
+/// Create an ndarray in a new shared memory segment
+NB_CORE ndarray_handle *ndarray_shm(size_t ndim, const size_t *shape,
+                                    dlpack::dtype *dtype);
+
+/// Map an existing shared memory segment created by ndarray_shm()
+NB_CORE ndarray_handle *ndarray_shm_open(const char *name, size_t ndim,
+                                         const size_t *shape,
+                                         dlpack::dtype *dtype);
+
+/// Register the reconstructor of pickled ndarray_shm() arrays in 'module'
+NB_CORE void ndarray_shm_pickle(PyObject *module);
+
 /// Increase the reference count of the given ndarray object; returns a pointer
 /// to the underlying DLTensor
 NB_CORE dlpack::dltensor *ndarray_inc_ref(ndarray_handle *) noexcept;
 
-/// Decrease the reference count of the given ndarray object
+/**
+ * Decrease the reference count of the given ndarray object. When the last
+ * reference is released by a thread that doesn't hold the GIL, the associated
+ * Python objects are released later on when the GIL is held.
+ */
 NB_CORE void ndarray_dec_ref(ndarray_handle *) noexcept;
 
+/// Value of ndarray_stream_swap() that denotes the absence of a stream
+constexpr intptr_t ndarray_no_stream = INTPTR_MIN;
+
+/// Set the stream used by the current thread to import arrays (returns the old value)
+NB_CORE intptr_t ndarray_stream_swap(intptr_t stream) noexcept;
+
 /// Wrap a ndarray_handle* into a PyCapsule
 NB_CORE PyObject *ndarray_wrap(ndarray_handle *, int framework,
                                rv_policy policy) noexcept;
@@ -418,6 +666,9 @@ NB_CORE void register_exception_translator(exception_translator translator,
 NB_CORE PyObject *exception_new(PyObject *mod, const char *name,
                                 PyObject *base);
 
+/// Convert the C++ exception being handled into a Python error (call from 'catch')
+NB_CORE void translate_exception() noexcept;
+
 // ========================================================================
 
 NB_CORE bool load_i8 (PyObject *o, uint8_t flags, int8_t *out) noexcept;
@@ -439,10 +690,34 @@ NB_CORE void incref_checked(PyObject *o) noexcept;
 /// Decrease the reference count of 'o', and check that the GIL is held
 NB_CORE void decref_checked(PyObject *o) noexcept;
 
+/**
+ * Decrease the reference count of 'o' from any thread. Without the GIL, the
+ * reference is queued and released later by the interpreter if enabled via
+ * set_deferred_decref(). Otherwise, the function acquires the GIL.
+ */
+NB_CORE void decref_deferred(PyObject *o) noexcept;
+
 // ========================================================================
 
 NB_CORE void set_leak_warnings(bool value) noexcept;
 NB_CORE void set_implicit_cast_warnings(bool value) noexcept;
+NB_CORE void set_lazy_functions(bool value) noexcept;
+NB_CORE void set_release_gil_default(bool value) noexcept;
+NB_CORE void set_deferred_decref(bool value) noexcept;
+NB_CORE void set_tracemalloc(bool value) noexcept;
+NB_CORE void set_perf_map(bool value) noexcept;
+
+/// Pre-size the type and function tables for the given number of new entries
+NB_CORE void reserve_bindings(size_t types, size_t funcs) noexcept;
+
+/// Per-interpreter storage used by <nanobind/stl/chrono.h>
+NB_CORE void **datetime_cache() noexcept;
+
+/// Return a dictionary with statistics about nanobind's internal hash tables
+NB_CORE PyObject *internals_stats();
+
+/// Return the Python string of an nb::interned key, 'cache' is its lookup cache
+NB_CORE PyObject *interned_get(const char *value, void **cache) noexcept;
 
 // ========================================================================
 
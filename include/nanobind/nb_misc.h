@@ -31,6 +31,85 @@ private:
     PyThreadState *state;
 };
 
+class lazy_functions {
+public:
+    lazy_functions() noexcept { detail::set_lazy_functions(true); }
+    ~lazy_functions() { detail::set_lazy_functions(false); }
+    lazy_functions(const lazy_functions &) = delete;
+    lazy_functions& operator=(const lazy_functions &) = delete;
+};
+
+/**
+ * Cooperative interruption of long-running C++ code. Tokens observe SIGINT
+ * (Ctrl-C) and their own cancel() requests without holding the GIL, and
+ * polling them is a pair of relaxed loads. When a token reports an
+ * interruption, nanobind raises the corresponding Python exception once the
+ * bound function that created the token returns. Tokens must therefore not
+ * outlive that function.
+ */
+class interrupt_token {
+public:
+    interrupt_token() noexcept
+        : m_count(detail::interrupt_arm(&m_armed, &m_observed)) { }
+    interrupt_token(const interrupt_token &) = delete;
+    interrupt_token &operator=(const interrupt_token &) = delete;
+
+    ~interrupt_token() {
+        // Report an observed interruption to the creating thread
+#if defined(_MSC_VER)
+        if (*(const volatile uint32_t *) &m_requested)
+            *(volatile uint32_t *) m_observed = 1;
+#else
+        if (__atomic_load_n(&m_requested, __ATOMIC_RELAXED))
+            __atomic_store_n(m_observed, 1, __ATOMIC_RELAXED);
+#endif
+    }
+
+    /// Was an interruption requested since the token was created?
+    NB_INLINE bool requested() const noexcept {
+#if defined(_MSC_VER)
+        uint32_t count = *(const volatile uint32_t *) m_count,
+                 cancelled = *(const volatile uint32_t *) &m_cancelled;
+#else
+        uint32_t count = __atomic_load_n(m_count, __ATOMIC_RELAXED),
+                 cancelled = __atomic_load_n(&m_cancelled, __ATOMIC_RELAXED);
+#endif
+        if (NB_LIKELY(count == m_armed && !cancelled))
+            return false;
+
+#if defined(_MSC_VER)
+        *(volatile uint32_t *) &m_requested = 1;
+#else
+        __atomic_store_n(&m_requested, 1, __ATOMIC_RELAXED);
+#endif
+        return true;
+    }
+
+    /// Interrupt the function polling this token (callable without the GIL)
+    void cancel() noexcept {
+#if defined(_MSC_VER)
+        *(volatile uint32_t *) &m_cancelled = 1;
+#else
+        __atomic_store_n(&m_cancelled, 1, __ATOMIC_RELAXED);
+#endif
+    }
+
+private:
+    const uint32_t *m_count;
+    uint32_t *m_observed;
+    uint32_t m_armed;
+    uint32_t m_cancelled = 0;
+    mutable uint32_t m_requested = 0;
+};
+
+class release_gil_default {
+public:
+    release_gil_default() noexcept { detail::set_release_gil_default(true); }
+    ~release_gil_default() { detail::set_release_gil_default(false); }
+    release_gil_default(const release_gil_default &) = delete;
+    release_gil_default& operator=(const release_gil_default &) = delete;
+};
+
 inline void set_leak_warnings(bool value) noexcept {
     detail::set_leak_warnings(value);
 }
@@ -39,4 +118,24 @@ inline void set_implicit_cast_warnings(bool value) noexcept {
     detail::set_implicit_cast_warnings(value);
 }
 
+inline void set_deferred_decref(bool value) noexcept {
+    detail::set_deferred_decref(value);
+}
+
+inline void set_tracemalloc(bool value) noexcept {
+    detail::set_tracemalloc(value);
+}
+
+inline void set_perf_map(bool value) noexcept {
+    detail::set_perf_map(value);
+}
+
+inline void reserve_bindings(size_t types, size_t functions) noexcept {
+    detail::reserve_bindings(types, functions);
+}
+
+inline dict internals_stats() {
+    return steal<dict>(detail::internals_stats());
+}
+
 NAMESPACE_END(NB_NAMESPACE)
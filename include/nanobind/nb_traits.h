@@ -142,6 +142,20 @@ template <typename T>
 constexpr bool has_shared_from_this_v =
     decltype(has_shared_from_this_impl((T *) nullptr))::value;
 
+// Detect movable containers of bytes with a mutable 'data()' (e.g., std::string)
+template <typename T>
+auto is_byte_container_impl(T *ptr) -> decltype(
+    ptr->size(),
+    std::bool_constant<sizeof(*ptr->data()) == 1 &&
+                       !std::is_const_v<std::remove_reference_t<
+                           decltype(*ptr->data())>>>{});
+std::false_type is_byte_container_impl(...);
+
+template <typename T>
+constexpr bool is_byte_container_v =
+    !std::is_lvalue_reference_v<T> &&
+    decltype(is_byte_container_impl((std::decay_t<T> *) nullptr))::value;
+
 NAMESPACE_END(detail)
 
 template <typename... Args>
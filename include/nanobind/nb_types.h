@@ -75,6 +75,7 @@ public:                                                                        \
 class object;
 class handle;
 class iterator;
+class interned;
 
 template <typename T = object> NB_INLINE T borrow(handle h);
 template <typename T = object> NB_INLINE T steal(handle h);
@@ -115,10 +116,12 @@ public:
 
     accessor<obj_attr> attr(handle key) const;
     accessor<str_attr> attr(const char *key) const;
+    accessor<obj_attr> attr(const interned &key) const;
     accessor<str_attr> doc() const;
 
     accessor<obj_item> operator[](handle key) const;
     accessor<str_item> operator[](const char *key) const;
+    accessor<obj_item> operator[](const interned &key) const;
     template <typename T, enable_if_t<std::is_arithmetic_v<T>> = 1>
     accessor<num_item> operator[](T key) const;
     args_proxy operator*() const;
@@ -127,6 +130,16 @@ public:
               typename... Args>
     object operator()(Args &&...args) const;
 
+    /// Like operator(), but return an invalid object if the call raises
+    template <rv_policy policy = rv_policy::automatic_reference,
+              typename... Args>
+    object try_call(Args &&...args) const;
+
+private:
+    template <bool Try, rv_policy policy, typename... Args>
+    object call_impl(Args &&...args) const;
+
+public:
     NB_DECL_COMP(equal)
     NB_DECL_COMP(not_equal)
     NB_DECL_COMP(operator<)
@@ -177,7 +190,7 @@ public:
     NB_INLINE handle(const PyTypeObject *ptr) : m_ptr((PyObject *) ptr) { }
 
     const handle& inc_ref() const & noexcept {
-#if defined(NDEBUG) && !defined(Py_LIMITED_API)
+#if defined(NDEBUG) || defined(Py_LIMITED_API)
         Py_XINCREF(m_ptr);
 #else
         detail::incref_checked(m_ptr);
@@ -186,7 +199,7 @@ public:
     }
 
     const handle& dec_ref() const & noexcept {
-#if defined(NDEBUG) && !defined(Py_LIMITED_API)
+#if defined(NDEBUG) || defined(Py_LIMITED_API)
         Py_XDECREF(m_ptr);
 #else
         detail::decref_checked(m_ptr);
@@ -359,6 +372,30 @@ class int_ : public object {
     }
 };
 
+/**
+ * String key whose Python object is created once per interpreter and then
+ * reused. Passing it to ``.attr()`` or ``operator[]`` avoids the creation
+ * of a temporary Python string per access. Declare it as a static variable:
+ *
+ *     static const nb::interned on_event("on_event");
+ *     callback.attr(on_event)(...);
+ */
+class interned {
+public:
+    constexpr explicit interned(const char *value) noexcept : m_value(value) { }
+
+    /// Borrowed reference to the string (valid until interpreter shutdown)
+    PyObject *ptr() const noexcept {
+        return detail::interned_get(m_value, &m_cache);
+    }
+
+    const char *c_str() const noexcept { return m_value; }
+
+private:
+    const char *m_value;
+    mutable void *m_cache = nullptr;
+};
+
 class str : public object {
     NB_OBJECT_DEFAULT(str, object, "str", PyUnicode_Check)
 
@@ -393,6 +430,34 @@ class bytes : public object {
     size_t size() const { return (size_t) PyBytes_Size(m_ptr); }
 };
 
+class memoryview : public object {
+    NB_OBJECT_DEFAULT(memoryview, object, "memoryview", PyMemoryView_Check)
+
+    /// Expose 'size' bytes at 'data' without copying them, keeping 'owner' alive
+    memoryview(const void *data, size_t size, handle owner = handle(),
+               bool readonly = true)
+        : object(detail::memoryview_from_buffer(data, size, owner.ptr(),
+                                                readonly),
+                 detail::steal_t{}) { }
+
+    /// Move a byte container (e.g., std::string) into the view
+    template <typename T,
+              detail::enable_if_t<detail::is_byte_container_v<T>> = 0>
+    explicit memoryview(T &&value, bool readonly = true) {
+        using Container = std::decay_t<T>;
+        Container *ptr = new Container((T &&) value);
+        capsule owner;
+        try {
+            owner = capsule(ptr, [](void *p) noexcept { delete (Container *) p; });
+        } catch (...) {
+            delete ptr;
+            throw;
+        }
+        m_ptr = detail::memoryview_from_buffer(ptr->data(), ptr->size(),
+                                               owner.ptr(), readonly);
+    }
+};
+
 class tuple : public object {
     NB_OBJECT_DEFAULT(tuple, object, "tuple", PyTuple_Check)
     size_t size() const { return (size_t) NB_TUPLE_GET_SIZE(m_ptr); }
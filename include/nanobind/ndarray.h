@@ -13,6 +13,8 @@
 #pragma once
 
 #include <nanobind/nanobind.h>
+#include <cstring>
+#include <vector>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 
@@ -73,20 +75,144 @@ template <size_t... Is> struct shape {
 struct c_contig { };
 struct f_contig { };
 struct any_contig { };
+struct ro { };
 struct numpy { };
 struct tensorflow { };
 struct pytorch { };
 struct jax { };
+struct buffer { };
+
+NAMESPACE_BEGIN(detail)
+
+NB_INLINE float bits_to_float(uint32_t bits) noexcept {
+    float result;
+    memcpy(&result, &bits, sizeof(float));
+    return result;
+}
+
+NB_INLINE uint32_t float_to_bits(float f) noexcept {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(float));
+    return bits;
+}
+
+inline float half_to_float(uint16_t h) noexcept {
+    uint32_t sign = (uint32_t) (h & 0x8000u) << 16,
+             exp = (h >> 10) & 0x1fu,
+             mant = h & 0x3ffu;
+
+    if (exp == 0x1f) // Inf/NaN
+        return bits_to_float(sign | 0x7f800000u | (mant << 13));
+    if (exp != 0) // Normalized
+        return bits_to_float(sign | ((exp + 112) << 23) | (mant << 13));
+    if (mant == 0)
+        return bits_to_float(sign);
+
+    // Denormalized
+    exp = 113;
+    while (!(mant & 0x400u)) {
+        mant <<= 1;
+        exp--;
+    }
+    return bits_to_float(sign | (exp << 23) | ((mant & 0x3ffu) << 13));
+}
+
+/// Convert to half precision (round to nearest, ties to even)
+inline uint16_t float_to_half(float f) noexcept {
+    uint32_t bits = float_to_bits(f);
+    uint16_t sign = (uint16_t) ((bits >> 16) & 0x8000u);
+    uint32_t abs = bits & 0x7fffffffu;
+
+    if (abs >= 0x7f800000u) // Inf/NaN
+        return sign | (abs > 0x7f800000u ? 0x7e00u : 0x7c00u);
+    if (abs >= 0x477ff000u) // Overflow
+        return sign | 0x7c00u;
+
+    if (abs < 0x38800000u) { // Denormalized or zero
+        if (abs < 0x33000000u)
+            return sign;
+        uint32_t exp = abs >> 23, mant = (abs & 0x7fffffu) | 0x800000u,
+                 shift = 126 - exp, value = mant >> shift,
+                 rest = mant & ((1u << shift) - 1), half = 1u << (shift - 1);
+        if (rest > half || (rest == half && (value & 1)))
+            value++;
+        return sign | (uint16_t) value;
+    }
+
+    uint32_t value = abs - 0x38000000u;
+    value += 0xfffu + ((value >> 13) & 1);
+    return sign | (uint16_t) (value >> 13);
+}
+
+/// Convert to bfloat16 (round to nearest, ties to even)
+inline uint16_t float_to_bfloat16(float f) noexcept {
+    uint32_t bits = float_to_bits(f);
+    if ((bits & 0x7fffffffu) > 0x7f800000u) // NaN, keep it quiet
+        return (uint16_t) ((bits >> 16) | 0x40u);
+    bits += 0x7fffu + ((bits >> 16) & 1);
+    return (uint16_t) (bits >> 16);
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * IEEE 754 half precision number. This is a storage type that can be used as
+ * the scalar type of an ``nb::ndarray<..>`` and that converts to and from
+ * ``float`` explicitly. It doesn't provide any arithmetic operations.
+ */
+struct float16 {
+    uint16_t value = 0;
+
+    float16() = default;
+    explicit float16(float f) noexcept : value(detail::float_to_half(f)) { }
+    explicit operator float() const noexcept { return detail::half_to_float(value); }
+
+    static float16 from_bits(uint16_t bits) noexcept {
+        float16 result;
+        result.value = bits;
+        return result;
+    }
+};
+
+/// Brain floating point number (the upper half of a ``float``), see nb::float16
+struct bfloat16 {
+    uint16_t value = 0;
+
+    bfloat16() = default;
+    explicit bfloat16(float f) noexcept : value(detail::float_to_bfloat16(f)) { }
+    explicit operator float() const noexcept {
+        return detail::bits_to_float((uint32_t) value << 16);
+    }
+
+    static bfloat16 from_bits(uint16_t bits) noexcept {
+        bfloat16 result;
+        result.value = bits;
+        return result;
+    }
+};
+
+NAMESPACE_BEGIN(detail)
+template <typename T>
+constexpr bool is_half_v =
+    std::is_same_v<T, float16> || std::is_same_v<T, bfloat16>;
+
+/// Types that can be used as the scalar type of an ndarray
+template <typename T>
+constexpr bool is_ndarray_scalar_v = std::is_scalar_v<T> || is_half_v<T>;
+NAMESPACE_END(detail)
 
 template <typename T> constexpr dlpack::dtype dtype() {
     static_assert(
-        std::is_floating_point_v<T> || std::is_integral_v<T>,
+        std::is_floating_point_v<T> || std::is_integral_v<T> ||
+            detail::is_half_v<T>,
         "nanobind::dtype<T>: T must be a floating point or integer variable!"
     );
 
     dlpack::dtype result;
 
-    if constexpr (std::is_floating_point_v<T>)
+    if constexpr (std::is_same_v<T, bfloat16>)
+        result.code = (uint8_t) dlpack::dtype_code::Bfloat;
+    else if constexpr (std::is_floating_point_v<T> || std::is_same_v<T, float16>)
         result.code = (uint8_t) dlpack::dtype_code::Float;
     else if constexpr (std::is_signed_v<T>)
         result.code = (uint8_t) dlpack::dtype_code::Int;
@@ -104,7 +230,7 @@ template <typename T> constexpr dlpack::dtype dtype() {
 
 NAMESPACE_BEGIN(detail)
 
-enum class ndarray_framework : int { none, numpy, tensorflow, pytorch, jax };
+enum class ndarray_framework : int { none, numpy, tensorflow, pytorch, jax, buffer };
 
 struct ndarray_req {
     dlpack::dtype dtype;
@@ -114,6 +240,7 @@ struct ndarray_req {
     bool req_dtype = false;
     char req_order = '\0';
     uint8_t req_device = 0;
+    bool readonly = false; // accept read-only arrays
 };
 
 template <typename T, typename = int> struct ndarray_arg {
@@ -147,6 +274,18 @@ template <typename T> struct ndarray_arg<T, enable_if_t<std::is_integral_v<T> &&
     }
 };
 
+template <typename T> struct ndarray_arg<T, enable_if_t<is_half_v<T>>> {
+    static constexpr size_t size = 0;
+
+    static constexpr auto name =
+        const_name<std::is_same_v<T, float16>>("dtype=float16", "dtype=bfloat16");
+
+    static void apply(ndarray_req &tr) {
+        tr.dtype = dtype<T>();
+        tr.req_dtype = true;
+    }
+};
+
 template <typename T> struct ndarray_arg<T, enable_if_t<std::is_same_v<T, bool>>> {
     static constexpr size_t size = 0;
 
@@ -191,6 +330,12 @@ template <> struct ndarray_arg<any_contig> {
     static void apply(ndarray_req &tr) { tr.req_order = '\0'; }
 };
 
+template <> struct ndarray_arg<ro> {
+    static constexpr size_t size = 0;
+    static constexpr auto name = const_name("writable=False");
+    static void apply(ndarray_req &tr) { tr.readonly = true; }
+};
+
 template <typename T> struct ndarray_arg<T, enable_if_t<T::is_device>> {
     static constexpr size_t size = 0;
     static constexpr auto name = const_name("device='") + T::name + const_name('\'');
@@ -202,11 +347,12 @@ template <typename... Ts> struct ndarray_info {
     using shape_type = void;
     constexpr static auto name = const_name("ndarray");
     constexpr static ndarray_framework framework = ndarray_framework::none;
+    constexpr static char order = '\0';
 };
 
 template <typename T, typename... Ts> struct ndarray_info<T, Ts...>  : ndarray_info<Ts...> {
     using scalar_type =
-        std::conditional_t<std::is_scalar_v<T>, T,
+        std::conditional_t<is_ndarray_scalar_v<T>, T,
                            typename ndarray_info<Ts...>::scalar_type>;
 };
 
@@ -214,6 +360,14 @@ template <size_t... Is, typename... Ts> struct ndarray_info<shape<Is...>, Ts...>
     using shape_type = shape<Is...>;
 };
 
+template <typename... Ts> struct ndarray_info<c_contig, Ts...> : ndarray_info<Ts...> {
+    constexpr static char order = 'C';
+};
+
+template <typename... Ts> struct ndarray_info<f_contig, Ts...> : ndarray_info<Ts...> {
+    constexpr static char order = 'F';
+};
+
 template <typename... Ts> struct ndarray_info<numpy, Ts...> : ndarray_info<Ts...> {
     constexpr static auto name = const_name("numpy.ndarray");
     constexpr static ndarray_framework framework = ndarray_framework::numpy;
@@ -234,6 +388,114 @@ template <typename... Ts> struct ndarray_info<jax, Ts...> : ndarray_info<Ts...>
     constexpr static ndarray_framework framework = ndarray_framework::jax;
 };
 
+template <typename... Ts> struct ndarray_info<buffer, Ts...> : ndarray_info<Ts...> {
+    constexpr static auto name = const_name("nanobind.nb_ndarray");
+    constexpr static ndarray_framework framework = ndarray_framework::buffer;
+};
+
+template <typename Shape> struct shape_tail;
+template <size_t I, size_t... Is> struct shape_tail<shape<I, Is...>> {
+    using type = shape<Is...>;
+};
+
+template <typename Scalar, typename Shape, char Order> class ndarray_view;
+
+/**
+ * Lightweight accessor returned by ``nb::ndarray<..>::view()``. It holds the
+ * data pointer, shape, and strides by value. Static shape entries and the
+ * strides of contiguous arrays ('C'/'F' order) that follow from them are
+ * compile-time constants, which helps the compiler vectorize element loops.
+ */
+template <typename Scalar, size_t... Is, char Order>
+class ndarray_view<Scalar, shape<Is...>, Order> {
+public:
+    static constexpr size_t Dim = sizeof...(Is);
+
+    ndarray_view() = default;
+
+    ndarray_view(Scalar *data, const int64_t *shape, const int64_t *strides)
+        : m_data(data) {
+        for (size_t i = 0; i < Dim; ++i)
+            m_shape[i] = Shape[i] == any ? shape[i] : (int64_t) Shape[i];
+
+        if constexpr (Order == 'C') {
+            int64_t prod = 1;
+            for (size_t i = Dim; i-- > 0; ) {
+                m_strides[i] = prod;
+                prod *= m_shape[i];
+            }
+        } else if constexpr (Order == 'F') {
+            int64_t prod = 1;
+            for (size_t i = 0; i < Dim; ++i) {
+                m_strides[i] = prod;
+                prod *= m_shape[i];
+            }
+        } else {
+            for (size_t i = 0; i < Dim; ++i)
+                m_strides[i] = strides[i];
+        }
+    }
+
+    template <typename... Ts> NB_INLINE Scalar &operator()(Ts... indices) const {
+        static_assert(sizeof...(Ts) == Dim,
+                      "nb::ndarray_view::operator(): invalid number of arguments");
+        return access(std::make_index_sequence<Dim>(), indices...);
+    }
+
+    /// Return a view of the slice at position 'i' of the first dimension
+    NB_INLINE auto row(size_t i) const {
+        static_assert(Dim > 1, "nb::ndarray_view::row(): requires ndim > 1");
+        return ndarray_view<Scalar, typename shape_tail<nanobind::shape<Is...>>::type,
+                            Order == 'C' ? 'C' : '\0'>(
+            m_data + (int64_t) i * stride_at<0>(), m_shape + 1, m_strides + 1);
+    }
+
+    constexpr size_t ndim() const { return Dim; }
+    NB_INLINE size_t shape(size_t i) const { return (size_t) m_shape[i]; }
+    NB_INLINE int64_t stride(size_t i) const { return m_strides[i]; }
+    NB_INLINE Scalar *data() const { return m_data; }
+
+private:
+    static constexpr size_t Shape[Dim > 0 ? Dim : 1] = { Is... };
+
+    /// Stride of dimension 'i' if it is known at compile time, otherwise 'any'
+    static constexpr size_t static_stride(size_t i) {
+        size_t prod = 1;
+        if (Order == 'C') {
+            for (size_t j = i + 1; j < Dim; ++j) {
+                if (Shape[j] == any)
+                    return any;
+                prod *= Shape[j];
+            }
+        } else if (Order == 'F') {
+            for (size_t j = 0; j < i; ++j) {
+                if (Shape[j] == any)
+                    return any;
+                prod *= Shape[j];
+            }
+        } else {
+            return any;
+        }
+        return prod;
+    }
+
+    template <size_t I> NB_INLINE int64_t stride_at() const {
+        if constexpr (static_stride(I) != any)
+            return (int64_t) static_stride(I);
+        else
+            return m_strides[I];
+    }
+
+    template <size_t... Ids, typename... Ts>
+    NB_INLINE Scalar &access(std::index_sequence<Ids...>, Ts... indices) const {
+        return m_data[(0 + ... + ((int64_t) indices * stride_at<Ids>()))];
+    }
+
+    Scalar *m_data = nullptr;
+    int64_t m_shape[Dim > 0 ? Dim : 1] { };
+    int64_t m_strides[Dim > 0 ? Dim : 1] { };
+};
+
 NAMESPACE_END(detail)
 
 template <typename... Args> class ndarray {
@@ -339,6 +601,28 @@ public:
             index * sizeof(typename Info::scalar_type));
     }
 
+    /**
+     * Return a lightweight accessor for element loops (see
+     * ``detail::ndarray_view``). Further annotations (e.g., the scalar type or
+     * ``nb::shape<..>``) can be given as template arguments if the ndarray
+     * type lacks them. They are not checked at runtime.
+     */
+    template <typename... Extra> NB_INLINE auto view() const {
+        using Info2 = detail::ndarray_info<Args..., Extra...>;
+        using Scalar2 = typename Info2::scalar_type;
+        using Shape2 = typename Info2::shape_type;
+
+        static_assert(!std::is_void_v<Scalar2>,
+                      "nb::ndarray::view(): requires a scalar type annotation "
+                      "(e.g. 'float').");
+        static_assert(!std::is_void_v<Shape2>,
+                      "nb::ndarray::view(): requires a nb::shape<> annotation.");
+
+        return detail::ndarray_view<Scalar2, Shape2, Info2::order>(
+            (Scalar2 *) ((uint8_t *) m_dltensor.data + m_dltensor.byte_offset),
+            m_dltensor.shape, m_dltensor.strides);
+    }
+
 private:
     detail::ndarray_handle *m_handle = nullptr;
     dlpack::dltensor m_dltensor;
@@ -346,6 +630,26 @@ private:
 
 NAMESPACE_BEGIN(detail)
 
+template <typename T> struct type_caster<T, enable_if_t<is_half_v<T>>> {
+    NB_TYPE_CASTER(T, const_name("float"))
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *) noexcept {
+        float f;
+        if (!load_f32(src.ptr(), flags, &f))
+            return false;
+        value = T(f);
+        return true;
+    }
+
+    static handle from_cpp(T src, rv_policy, cleanup_list *) noexcept {
+        return PyFloat_FromDouble((double) (float) src);
+    }
+};
+
+/// Arrays hold a reference to their owner, which requires the GIL
+template <typename... Args>
+struct is_python_value<ndarray<Args...>> : std::true_type { };
+
 template <typename... Args> struct type_caster<ndarray<Args...>> {
     NB_TYPE_CASTER(ndarray<Args...>, Value::Info::name + const_name("[") +
                                         concat_maybe(detail::ndarray_arg<Args>::name...) +
@@ -368,5 +672,267 @@ template <typename... Args> struct type_caster<ndarray<Args...>> {
     }
 };
 
+NAMESPACE_END(detail)
+
+/**
+ * RAII helper that announces the stream on which the current thread consumes
+ * device arrays (e.g., a ``cudaStream_t`` cast to ``intptr_t``, or one of the
+ * special values defined by the DLPack protocol). While it is active,
+ * nanobind passes the stream to ``__dlpack__(stream=...)`` when importing
+ * arrays that don't reside in host memory, so that the producer can order its
+ * work with respect to the stream instead of synchronizing the device.
+ */
+class ndarray_stream {
+public:
+    explicit ndarray_stream(intptr_t stream)
+        : m_prev(detail::ndarray_stream_swap(stream)) { }
+    ~ndarray_stream() { detail::ndarray_stream_swap(m_prev); }
+    ndarray_stream(const ndarray_stream &) = delete;
+    ndarray_stream &operator=(const ndarray_stream &) = delete;
+
+private:
+    intptr_t m_prev;
+};
+
+/**
+ * Create a C-contiguous array of the given shape and dtype with uninitialized
+ * contents. The 64-byte aligned buffer is owned by the array, hence no
+ * separate owner object is needed. Buffers of up to 4 MiB are recycled when
+ * the array expires, which avoids repeated heap allocations when functions
+ * return arrays of similar sizes.
+ */
+template <typename... Args>
+ndarray<Args...> ndarray_alloc(
+    size_t ndim, const size_t *shape,
+    dlpack::dtype dtype = nanobind::dtype<typename ndarray<Args...>::Scalar>()) {
+    return ndarray<Args...>(detail::ndarray_alloc(ndim, shape, &dtype));
+}
+
+/// Access mode of ndarray_mmap()
+enum class mmap_mode : int {
+    /// Shared read-only mapping, the array doesn't permit writes
+    read_only,
+    /// Private mapping, writes are never carried through to the file
+    copy_on_write
+};
+
+/// Expected access pattern of a mapping (ignored on Windows)
+enum class mmap_advice : int { normal, sequential, random, will_need };
+
+/**
+ * Map the C-contiguous array of the given shape and dtype stored at byte
+ * offset ``offset`` of the file ``path`` into memory. Pages are loaded
+ * lazily and shared with other processes mapping the same file. The mapping
+ * is released together with the last reference to the array.
+ */
+template <typename... Args>
+ndarray<Args...> ndarray_mmap(
+    const char *path, size_t ndim, const size_t *shape, uint64_t offset = 0,
+    mmap_mode mode = mmap_mode::read_only,
+    mmap_advice advice = mmap_advice::normal,
+    dlpack::dtype dtype = nanobind::dtype<typename ndarray<Args...>::Scalar>()) {
+    return ndarray<Args...>(detail::ndarray_mmap(
+        path, offset, ndim, shape, &dtype, (int) mode, (int) advice));
+}
+
+/**
+ * Create a C-contiguous array of the given shape and dtype with
+ * zero-initialized contents in a new named POSIX shared memory segment.
+ * When returned with the ``nb::buffer`` framework, the array pickles as a
+ * handle referencing the segment instead of copying the contents, and the
+ * unpickling process maps the segment into its address space (see
+ * ndarray_shm_pickle()). Raises an exception on Windows.
+ */
+template <typename... Args>
+ndarray<Args...> ndarray_shm(
+    size_t ndim, const size_t *shape,
+    dlpack::dtype dtype = nanobind::dtype<typename ndarray<Args...>::Scalar>()) {
+    return ndarray<Args...>(detail::ndarray_shm(ndim, shape, &dtype));
+}
+
+/// Map the shared memory segment ``name`` created by ndarray_shm()
+template <typename... Args>
+ndarray<Args...> ndarray_shm_open(
+    const char *name, size_t ndim, const size_t *shape,
+    dlpack::dtype dtype = nanobind::dtype<typename ndarray<Args...>::Scalar>()) {
+    return ndarray<Args...>(detail::ndarray_shm_open(name, ndim, shape, &dtype));
+}
+
+/**
+ * Enable pickling of ndarray_shm() arrays by adding their reconstructor to the
+ * extension module ``m``. Pickles reference this module, which the unpickling
+ * process imports.
+ */
+inline void ndarray_shm_pickle(handle m) { detail::ndarray_shm_pickle(m.ptr()); }
+
+/**
+ * Wrapper around a ``std::vector`` with arithmetic elements that is returned
+ * as a one-dimensional ndarray. The vector is moved into a heap-allocated
+ * owner that is released by a capsule, hence neither the contents are copied
+ * nor are Python objects created per element. The remaining template
+ * arguments (e.g., ``nb::numpy``) are forwarded to ``nb::ndarray<..>``.
+ */
+template <typename T, typename... Args> struct vector_ndarray {
+    static_assert(detail::is_member_scalar_v<T> && !std::is_same_v<T, bool>,
+                  "nanobind::vector_ndarray<T>: T must be an arithmetic type!");
+
+    std::vector<T> value;
+
+    vector_ndarray() = default;
+    vector_ndarray(std::vector<T> &&value) : value(std::move(value)) { }
+    vector_ndarray(const std::vector<T> &value) : value(value) { }
+};
+
+NAMESPACE_BEGIN(detail)
+
+template <typename T, typename... Args>
+struct type_caster<vector_ndarray<T, Args...>> {
+    using Array = ndarray<Args..., T, shape<any>>;
+    using type = vector_ndarray<T, Args...>;
+
+    NB_TYPE_CASTER(type, make_caster<Array>::Name)
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *) noexcept {
+        auto alloc = [](void *p, size_t size) -> void * {
+            std::vector<T> &v = *(std::vector<T> *) p;
+            v.resize(size);
+            return v.data();
+        };
+
+        return seq_load_array(src.ptr(), member_kind_of<T>(),
+                              flags & (uint8_t) cast_flags::convert, alloc,
+                              &value.value);
+    }
+
+    template <typename T_>
+    static handle from_cpp(T_ &&src, rv_policy, cleanup_list *) noexcept {
+        std::vector<T> *vec =
+            new std::vector<T>(forward_like<T_>(src.value));
+
+        capsule owner(vec, [](void *p) noexcept {
+            delete (std::vector<T> *) p;
+        });
+
+        size_t shape[1] = { vec->size() };
+        Array array(vec->data(), 1, shape, owner);
+
+        // The capsule keeps the data alive, there is no need to copy it
+        return ndarray_wrap(array.handle(), int(Array::Info::framework),
+                            rv_policy::reference);
+    }
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * Packed table of strings, which is returned as a tuple ``(offsets, data)``
+ * of one-dimensional arrays instead of a list of ``str`` objects. The UTF-8
+ * encoded string ``i`` occupies the bytes ``data[offsets[i]:offsets[i+1]]``.
+ * This avoids creating and decoding a Python string per entry. The template
+ * arguments (e.g., ``nb::numpy``) are forwarded to ``nb::ndarray<..>``.
+ */
+template <typename... Args> struct string_table {
+    std::vector<int64_t> offsets { 0 };
+    std::vector<char> data;
+
+    string_table() = default;
+
+    /// Pack a container of strings (e.g., ``std::vector<std::string>``)
+    template <typename Container> explicit string_table(const Container &strings) {
+        offsets.reserve(strings.size() + 1);
+        for (const auto &s : strings)
+            append(s.data(), s.size());
+    }
+
+    void append(const char *str, size_t size) {
+        data.insert(data.end(), str, str + size);
+        offsets.push_back((int64_t) data.size());
+    }
+
+    size_t size() const { return offsets.size() - 1; }
+};
+
+NAMESPACE_BEGIN(detail)
+
+template <typename... Args> struct type_caster<string_table<Args...>> {
+    using Offsets = ndarray<Args..., int64_t, shape<any>>;
+    using Data = ndarray<Args..., uint8_t, shape<any>>;
+    using type = string_table<Args...>;
+
+    NB_TYPE_CASTER(type, const_name("tuple[") + make_caster<Offsets>::Name +
+                             const_name(", ") + make_caster<Data>::Name +
+                             const_name("]"))
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        using InOffsets = ndarray<const int64_t, shape<any>, c_contig, device::cpu>;
+        using InData = ndarray<const uint8_t, shape<any>, c_contig, device::cpu>;
+
+        PyObject *o = src.ptr();
+        if (!PyTuple_Check(o) || NB_TUPLE_GET_SIZE(o) != 2)
+            return false;
+
+        make_caster<InOffsets> offsets_c;
+        make_caster<InData> data_c;
+        if (!offsets_c.from_python(NB_TUPLE_GET_ITEM(o, 0), flags, cleanup) ||
+            !data_c.from_python(NB_TUPLE_GET_ITEM(o, 1), flags, cleanup))
+            return false;
+
+        const int64_t *offsets = offsets_c.value.data();
+        const char *data = (const char *) data_c.value.data();
+        size_t size = offsets_c.value.shape(0),
+               data_size = data_c.value.shape(0);
+        if (size == 0 || offsets[0] != 0 ||
+            (uint64_t) offsets[size - 1] != (uint64_t) data_size)
+            return false;
+        for (size_t i = 1; i < size; ++i) {
+            if (offsets[i] < offsets[i - 1])
+                return false;
+        }
+
+        value.offsets.assign(offsets, offsets + size);
+        value.data.assign(data, data + data_size);
+        return true;
+    }
+
+    template <typename T_>
+    static handle from_cpp(T_ &&src, rv_policy, cleanup_list *) noexcept {
+        type *table = nullptr;
+
+        try {
+            table = new type(forward_like<T_>(src));
+            capsule owner(table, [](void *p) noexcept { delete (type *) p; });
+            type *t = table;
+            table = nullptr; // now owned by the capsule
+
+            size_t offsets_shape[1] = { t->offsets.size() },
+                   data_shape[1] = { t->data.size() };
+            Offsets offsets(t->offsets.data(), 1, offsets_shape, owner);
+            Data data((uint8_t *) t->data.data(), 1, data_shape, owner);
+
+            // The capsule keeps the data alive, there is no need to copy it
+            object result = steal(PyTuple_New(2));
+            PyObject *o0 = ndarray_wrap(offsets.handle(),
+                                        int(Offsets::Info::framework),
+                                        rv_policy::reference),
+                     *o1 = ndarray_wrap(data.handle(),
+                                        int(Data::Info::framework),
+                                        rv_policy::reference);
+            if (!result.is_valid() || !o0 || !o1) {
+                Py_XDECREF(o0);
+                Py_XDECREF(o1);
+                return handle();
+            }
+
+            NB_TUPLE_SET_ITEM(result.ptr(), 0, o0);
+            NB_TUPLE_SET_ITEM(result.ptr(), 1, o1);
+            return result.release();
+        } catch (...) {
+            delete table;
+            translate_exception();
+            return handle();
+        }
+    }
+};
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -0,0 +1,250 @@
+/*
+    nanobind/ndarray_iterator.h: nb::make_ndarray_iterator(), which streams
+    chunks produced by a background thread as reusable ndarray buffers
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * Ring of chunk buffers shared by the producer thread, the Python iterator,
+ * and the arrays handed out by it. Buffer indices cycle from 'free' (owned
+ * by the producer) to 'ready' (filled, waiting for the iterator) to the
+ * owner capsule of an array, whose destruction returns them to 'free'.
+ */
+template <typename T, typename Producer> struct ndarray_ring {
+    Producer producer;
+    size_t chunk_size;
+    std::vector<std::unique_ptr<T[]>> buffers;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<size_t> free;
+    std::deque<std::pair<size_t, size_t>> ready; // (buffer, element count)
+    std::exception_ptr error;
+    bool done = false, stop = false, busy = false;
+
+    ndarray_ring(Producer &&producer, size_t chunk_size, size_t count)
+        : producer(std::move(producer)), chunk_size(chunk_size) {
+        for (size_t i = 0; i < count; ++i) {
+            buffers.emplace_back(new T[chunk_size]);
+            free.push_back(i);
+        }
+    }
+
+    /// Body of the producer thread, which runs without the GIL
+    void run() {
+        while (true) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&] { return stop || !free.empty(); });
+                if (stop)
+                    return;
+                index = free.front();
+                free.pop_front();
+                busy = true;
+            }
+
+            size_t count = 0;
+            std::exception_ptr e;
+            try {
+                count = producer(buffers[index].get(), chunk_size);
+                if (count > chunk_size)
+                    throw std::out_of_range(
+                        "nanobind::make_ndarray_iterator(): the producer "
+                        "returned more elements than the chunk size!");
+            } catch (...) {
+                e = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+            if (e || count == 0) {
+                error = e;
+                done = true;
+                free.push_back(index);
+                cv.notify_all();
+                return;
+            }
+
+            ready.emplace_back(index, count);
+            cv.notify_all();
+        }
+    }
+
+    /// Return a buffer to the producer (called when an array is released)
+    void recycle(size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        free.push_back(index);
+        cv.notify_all();
+    }
+};
+
+/// Owner of an array that references a buffer of an ndarray_ring
+template <typename Ring> struct ndarray_ring_ref {
+    std::shared_ptr<Ring> ring;
+    size_t index;
+
+    static void release(void *p) noexcept {
+        ndarray_ring_ref *r = (ndarray_ring_ref *) p;
+        r->ring->recycle(r->index);
+        delete r;
+    }
+};
+
+/* There are apparently unused template arguments because each combination
+   requires a separate nb::class_ registration. */
+template <typename Array, typename T, typename Producer>
+struct ndarray_iterator_state {
+    using Ring = ndarray_ring<T, Producer>;
+
+    std::shared_ptr<Ring> ring;
+    std::thread thread;
+
+    ndarray_iterator_state(std::shared_ptr<Ring> ring)
+        : ring(std::move(ring)) {
+        thread = std::thread([r = this->ring] { r->run(); });
+    }
+
+    ndarray_iterator_state(ndarray_iterator_state &&) = default;
+
+    // Runs during instance deallocation, hence with the GIL held
+    ~ndarray_iterator_state() {
+        if (!thread.joinable())
+            return;
+
+        // Waiting for the producer to finish its current chunk can take a while
+        gil_scoped_release guard;
+        {
+            std::lock_guard<std::mutex> lock(ring->mutex);
+            ring->stop = true;
+            ring->cv.notify_all();
+        }
+        thread.join();
+    }
+};
+
+/// 'tp_iternext' slot returning the next filled buffer
+template <typename Array, typename State>
+PyObject *ndarray_iterator_next(PyObject *self) noexcept {
+    State *s;
+    if (!nb_type_get(&typeid(State), self, 0, nullptr, (void **) &s)) {
+        PyErr_SetString(PyExc_TypeError, "nanobind::make_ndarray_iterator(): "
+                                         "invalid iterator state!");
+        return nullptr;
+    }
+
+    using Ring = typename State::Ring;
+    Ring &r = *s->ring;
+    std::pair<size_t, size_t> chunk;
+    std::exception_ptr error;
+    bool stalled = false;
+
+    {
+        gil_scoped_release guard;
+        std::unique_lock<std::mutex> lock(r.mutex);
+        r.cv.wait(lock, [&] {
+            return r.done || !r.ready.empty() || (!r.busy && r.free.empty());
+        });
+
+        if (r.ready.empty()) {
+            if (r.done)
+                std::swap(error, r.error);
+            else
+                stalled = true;
+            chunk.second = 0;
+        } else {
+            chunk = r.ready.front();
+            r.ready.pop_front();
+        }
+    }
+
+    try {
+        if (error)
+            std::rethrow_exception(error);
+        else if (stalled)
+            throw std::runtime_error(
+                "nanobind::make_ndarray_iterator(): all buffers are referenced "
+                "by arrays returned in previous steps!");
+        else if (chunk.second == 0)
+            return nullptr; // exhausted (no StopIteration exception needed)
+
+        ndarray_ring_ref<Ring> *ref =
+            new ndarray_ring_ref<Ring>{ s->ring, chunk.first };
+        capsule owner(ref, ndarray_ring_ref<Ring>::release);
+        size_t shape[1] = { chunk.second };
+
+        Array array(r.buffers[chunk.first].get(), 1, shape, owner);
+        return make_caster<Array>::from_cpp(array, rv_policy::reference,
+                                            nullptr).ptr();
+    } catch (...) {
+        translate_exception();
+        return nullptr;
+    }
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * Makes a Python iterator over chunks of up to `chunk_size` elements of type
+ * `T`. A background thread calls `producer(T *buffer, size_t chunk_size)`
+ * without holding the GIL to fill the next free buffer, which returns the
+ * number of elements written. A return value of zero ends the stream, and
+ * exceptions are raised by the next step of the iteration.
+ *
+ * Each step returns a one-dimensional `nb::ndarray<T, Extra...>` referencing
+ * a buffer of a ring of `buffers` preallocated buffers. A buffer is reused
+ * once the array (and any views of it, e.g. in NumPy) is released, hence at
+ * most `buffers` chunks are in memory at once. A step raises a
+ * ``RuntimeError`` when the consumer holds on to all of them.
+ */
+template <typename T, typename... Extra, typename Producer>
+iterator make_ndarray_iterator(handle scope, const char *name,
+                               Producer &&producer, size_t chunk_size,
+                               size_t buffers = 2) {
+    using Array = ndarray<T, shape<any>, c_contig, Extra...>;
+    using State = detail::ndarray_iterator_state<Array, T,
+                                                 std::decay_t<Producer>>;
+
+    if (chunk_size == 0 || buffers == 0)
+        throw value_error("nanobind::make_ndarray_iterator(): the chunk size "
+                          "and number of buffers must be positive!");
+
+    if (!type<State>().is_valid()) {
+        static PyType_Slot slots[] = {
+            { Py_tp_iter, (void *) PyObject_SelfIter },
+            { Py_tp_iternext,
+              (void *) detail::ndarray_iterator_next<Array, State> },
+            { 0, nullptr }
+        };
+
+        class_<State>(scope, name, type_slots(slots));
+    }
+
+    auto ring = std::make_shared<typename State::Ring>(
+        std::decay_t<Producer>((detail::forward_t<Producer>) producer),
+        chunk_size, buffers);
+
+    return borrow<iterator>(cast(State(std::move(ring)), rv_policy::move));
+}
+
+NAMESPACE_END(NB_NAMESPACE)
@@ -38,14 +38,201 @@ struct undefined_t { };
 /// base template of operator implementations
 template <op_id, op_type, typename B, typename L, typename R> struct op_impl { };
 
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+/// Type slot of an operator of the form 'self <op> self', 'self <op>= self', or '<op> self'
+constexpr int op_slot_id(op_id id) {
+    switch (id) {
+        case op_add: return Py_nb_add;
+        case op_sub: return Py_nb_subtract;
+        case op_mul: return Py_nb_multiply;
+        case op_truediv: return Py_nb_true_divide;
+        case op_mod: return Py_nb_remainder;
+        case op_lshift: return Py_nb_lshift;
+        case op_rshift: return Py_nb_rshift;
+        case op_and: return Py_nb_and;
+        case op_xor: return Py_nb_xor;
+        case op_or: return Py_nb_or;
+        case op_iadd: return Py_nb_inplace_add;
+        case op_isub: return Py_nb_inplace_subtract;
+        case op_imul: return Py_nb_inplace_multiply;
+        case op_itruediv: return Py_nb_inplace_true_divide;
+        case op_imod: return Py_nb_inplace_remainder;
+        case op_ilshift: return Py_nb_inplace_lshift;
+        case op_irshift: return Py_nb_inplace_rshift;
+        case op_iand: return Py_nb_inplace_and;
+        case op_ixor: return Py_nb_inplace_xor;
+        case op_ior: return Py_nb_inplace_or;
+        case op_neg: return Py_nb_negative;
+        case op_pos: return Py_nb_positive;
+        case op_invert: return Py_nb_invert;
+        case op_abs: return Py_nb_absolute;
+        case op_bool: return Py_nb_bool;
+        case op_lt: case op_le: case op_eq:
+        case op_ne: case op_gt: case op_ge: return Py_tp_richcompare;
+        default: return 0;
+    }
+}
+
+constexpr int op_compare_id(op_id id) {
+    switch (id) {
+        case op_lt: return Py_LT;
+        case op_le: return Py_LE;
+        case op_eq: return Py_EQ;
+        case op_ne: return Py_NE;
+        case op_gt: return Py_GT;
+        default: return Py_GE;
+    }
+}
+
+/// Return the instance pointer if 'o' is ready to be passed to a function
+NB_INLINE void *op_slot_ptr(PyObject *o) noexcept {
+    return nb_inst_state(o).first ? nb_inst_ptr(o) : nullptr;
+}
+
+/// Call an operator and convert its result like the function binding would
+template <typename Ret, typename Func> PyObject *op_slot_call(Func &&f) noexcept {
+    try {
+        if constexpr (std::is_void_v<Ret>) {
+            f();
+            return none().release().ptr();
+        } else {
+            PyObject *result =
+                make_caster<Ret>::from_cpp(f(), infer_policy<Ret>(rv_policy::automatic),
+                                           nullptr).ptr();
+            if (!result && !PyErr_Occurred())
+                PyErr_SetString(PyExc_TypeError,
+                                "nanobind::detail::op_slot_call(): could not "
+                                "convert the return value to a Python object!");
+            return result;
+        }
+    } catch (...) {
+        translate_exception();
+        return nullptr;
+    }
+}
+
+/**
+ * Slot functions that call the operator 'Fn' directly when all arguments are
+ * ready instances of the same type. Otherwise, they defer to the generic
+ * implementation of CPython, which looks up the special method and performs
+ * overload resolution. CPython only invokes the slot of the left operand when
+ * both operands have the same type, which is therefore either the bound type
+ * or a subclass that didn't override the operator.
+ */
+template <auto Fn, typename Sig = decltype(Fn)> struct op_slot;
+
+template <auto Fn, typename Ret, typename A1, typename A2>
+struct op_slot<Fn, Ret (*)(A1, A2)> {
+    using T1 = intrinsic_t<A1>;
+    using T2 = intrinsic_t<A2>;
+
+    static inline void *fallback = nullptr;
+
+    static PyObject *call(PyObject *a, PyObject *b) noexcept {
+        void *pa = op_slot_ptr(a), *pb = op_slot_ptr(b);
+        if (!pa || !pb)
+            return nullptr;
+        return op_slot_call<Ret>([&]() -> Ret { return Fn(*(T1 *) pa, *(T2 *) pb); });
+    }
+
+    static PyObject *binary(PyObject *a, PyObject *b) noexcept {
+        if (Py_TYPE(a) == Py_TYPE(b)) {
+            PyObject *result = call(a, b);
+            if (result || PyErr_Occurred())
+                return result;
+        }
+        return ((binaryfunc) fallback)(a, b);
+    }
+};
+
+template <auto Fn, typename Ret, typename A1>
+struct op_slot<Fn, Ret (*)(A1)> {
+    using T1 = intrinsic_t<A1>;
+
+    static inline void *fallback = nullptr;
+
+    static PyObject *unary(PyObject *a) noexcept {
+        void *pa = op_slot_ptr(a);
+        if (!pa)
+            return ((unaryfunc) fallback)(a);
+        return op_slot_call<Ret>([&]() -> Ret { return Fn(*(T1 *) pa); });
+    }
+
+    static int inquiry(PyObject *a) noexcept {
+        void *pa = op_slot_ptr(a);
+        if (!pa)
+            return ((::inquiry) fallback)(a);
+        try {
+            return Fn(*(T1 *) pa) ? 1 : 0;
+        } catch (...) {
+            translate_exception();
+            return -1;
+        }
+    }
+};
+
+/// All comparisons of a type share 'tp_richcompare', which dispatches via a table
+template <typename T> struct op_compare {
+    static inline void *fallback = nullptr;
+    static inline void *table[6] { };
+
+    static PyObject *richcompare(PyObject *a, PyObject *b, int op) noexcept {
+        void *entry = op >= 0 && op < 6 ? table[op] : nullptr;
+        if (entry && Py_TYPE(a) == Py_TYPE(b)) {
+            PyObject *result = ((binaryfunc) entry)(a, b);
+            if (result || PyErr_Occurred())
+                return result;
+        }
+        return ((richcmpfunc) fallback)(a, b, op);
+    }
+};
+
+template <op_id id, auto Fn> void op_slot_install(handle cl) {
+    constexpr int slot = op_slot_id(id);
+
+    if constexpr (slot == Py_tp_richcompare) {
+        using Slot = op_slot<Fn>;
+        using Compare = op_compare<typename Slot::T1>;
+        static const op_slot_info info {
+            (void *) Fn, slot, op_compare_id(id),
+            (void *) Compare::richcompare, &Compare::fallback,
+            Compare::table, (void *) Slot::call
+        };
+        type_set_op_slots(cl.ptr(), &info);
+    } else if constexpr (slot != 0) {
+        using Slot = op_slot<Fn>;
+        void *impl;
+        if constexpr (id == op_bool)
+            impl = (void *) Slot::inquiry;
+        else if constexpr (id == op_neg || id == op_pos || id == op_invert ||
+                           id == op_abs)
+            impl = (void *) Slot::unary;
+        else
+            impl = (void *) Slot::binary;
+        static const op_slot_info info { (void *) Fn, slot, 0, impl,
+                                         &Slot::fallback, nullptr, nullptr };
+        type_set_op_slots(cl.ptr(), &info);
+    }
+}
+#endif
+
 /// Operator implementation generator
 template <op_id id, op_type ot, typename L, typename R> struct op_ {
+    /// Operators on two instances of the bound type (or one) also fill its type slot
+    static constexpr bool has_slot =
+        std::is_same_v<L, self_t> &&
+        (ot == op_u || (ot == op_l && std::is_same_v<R, self_t>));
+
     template <typename Class, typename... Extra> void execute(Class &cl, const Extra&... extra) const {
         using Type = typename Class::Type;
         using Lt = std::conditional_t<std::is_same_v<L, self_t>, Type, L>;
         using Rt = std::conditional_t<std::is_same_v<R, self_t>, Type, R>;
         using Op = op_impl<id, ot, Type, Lt, Rt>;
         cl.def(Op::name(), &Op::execute, is_operator(), extra...);
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        if constexpr (has_slot && sizeof...(Extra) == 0)
+            op_slot_install<id, &Op::execute>(cl);
+#endif
     }
 
     template <typename Class, typename... Extra> void execute_cast(Class &cl, const Extra&... extra) const {
@@ -54,6 +241,10 @@ template <op_id id, op_type ot, typename L, typename R> struct op_ {
         using Rt = std::conditional_t<std::is_same_v<R, self_t>, Type, R>;
         using Op = op_impl<id, ot, Type, Lt, Rt>;
         cl.def(Op::name(), &Op::execute_cast, is_operator(), extra...);
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        if constexpr (has_slot && sizeof...(Extra) == 0)
+            op_slot_install<id, &Op::execute_cast>(cl);
+#endif
     }
 };
 
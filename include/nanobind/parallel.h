@@ -0,0 +1,53 @@
+/*
+    nanobind/parallel.h: parallel loops over index ranges and ndarrays that
+    run on a shared thread pool while the GIL is released
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+
+/**
+ * Invoke ``f(start, end)`` on disjoint subranges that cover the index range
+ * ``[0, size)``. The subranges contain at least ``grain`` indices (except
+ * for the last one) and are processed in parallel by a shared thread pool,
+ * including the calling thread.
+ *
+ * The function must be called while holding the GIL, which is released
+ * while the loop runs. ``f`` must therefore not access Python objects. The
+ * first exception thrown by ``f`` cancels the remaining subranges and is
+ * rethrown by ``parallel_for()``. The same happens when the calling thread
+ * receives a ``KeyboardInterrupt``, which is raised as a ``python_error``.
+ */
+template <typename Func>
+void parallel_for(size_t size, Func &&f, size_t grain = 1) {
+    using F = std::remove_reference_t<Func>;
+
+    detail::parallel_for(
+        size, grain,
+        [](void *p, size_t start, size_t end) { (*(F *) p)(start, end); },
+        (void *) &f);
+}
+
+/// Parallel loop over the first dimension of an ndarray (see above)
+template <typename... Args, typename Func>
+void parallel_for(const ndarray<Args...> &array, Func &&f, size_t grain = 1) {
+    parallel_for(array.ndim() > 0 ? array.shape(0) : 1, (Func &&) f, grain);
+}
+
+/// Set the number of threads of parallel_for() including the caller (0: one per core)
+inline void set_parallel_threads(size_t threads) {
+    detail::parallel_set_threads(threads);
+}
+
+/// Return the number of threads used by parallel_for()
+inline size_t parallel_threads() { return detail::parallel_threads(); }
+
+NAMESPACE_END(NB_NAMESPACE)
@@ -11,6 +11,8 @@
 #include <nanobind/make_iterator.h>
 #include <nanobind/operators.h>
 #include <nanobind/stl/detail/traits.h>
+#include <nanobind/stl/detail/nb_dict.h>
+#include <nanobind/stl/detail/container_slots.h>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -35,6 +37,176 @@ inline void map_set(Map &m, const Key &k, const Value &v) {
     }
 }
 
+/// Convert a dictionary using the STL dict caster, or try the next overload
+template <typename Map, typename Key, typename Value>
+Map map_from_dict(handle d) {
+    dict_caster<Map, Key, Value> caster;
+    cleanup_list cleanup(nullptr);
+    bool success;
+
+    try {
+        success = caster.from_python(d, (uint8_t) cast_flags::convert, &cleanup);
+    } catch (...) {
+        cleanup.release();
+        throw;
+    }
+
+    // The converted entries were copied into the map, release temporaries
+    cleanup.release();
+    if (!success)
+        throw next_overload();
+    return std::move(caster.value);
+}
+
+#if defined(NB_CONTAINER_SLOTS)
+/// Direct mapping slots of a bound map (see container_slots.h)
+template <typename Map> struct map_slots {
+    using Key = typename Map::key_type;
+    using Value = typename Map::mapped_type;
+
+    static constexpr bool has_setitem =
+        is_copy_assignable_v<Value> || is_copy_constructible_v<Value>;
+
+    static inline lenfunc length_fallback = nullptr, mp_length_fallback = nullptr;
+    static inline binaryfunc subscript_fallback = nullptr;
+    static inline objobjargproc ass_subscript_fallback = nullptr;
+    static inline objobjproc contains_fallback = nullptr;
+    static inline getiterfunc iter_fallback = nullptr;
+
+    static Py_ssize_t length(PyObject *self) noexcept {
+        Map *m = container_ptr<Map>(self);
+        return m ? (Py_ssize_t) m->size() : length_fallback(self);
+    }
+
+    static Py_ssize_t mp_length(PyObject *self) noexcept {
+        Map *m = container_ptr<Map>(self);
+        return m ? (Py_ssize_t) m->size() : mp_length_fallback(self);
+    }
+
+    static PyObject *subscript(PyObject *self, PyObject *key) noexcept {
+        Map *m = container_ptr<Map>(self);
+        if (m) {
+            make_caster<Key> kc;
+            cleanup_list cleanup(self);
+            bool found = false;
+            typename Map::iterator it;
+
+            try {
+                if (kc.from_python(key, (uint8_t) cast_flags::convert, &cleanup)) {
+                    it = m->find(kc.operator cast_t<const Key &>());
+                    found = it != m->end();
+                }
+            } catch (...) {
+                cleanup.release();
+                translate_exception();
+                return nullptr;
+            }
+
+            cleanup.release();
+            PyErr_Clear();
+            if (found)
+                return container_cast<Value &>(it->second, self);
+        }
+
+        return subscript_fallback(self, key);
+    }
+
+    static int ass_subscript(PyObject *self, PyObject *key, PyObject *value) noexcept {
+        Map *m = container_ptr<Map>(self);
+        if (m && (value == nullptr || has_setitem)) {
+            make_caster<Key> kc;
+            make_caster<Value> vc;
+            cleanup_list cleanup(self);
+            bool done = false;
+
+            try {
+                if (kc.from_python(key, (uint8_t) cast_flags::convert, &cleanup)) {
+                    if (!value) {
+                        auto it = m->find(kc.operator cast_t<const Key &>());
+                        if (it != m->end()) {
+                            m->erase(it);
+                            done = true;
+                        }
+                    } else if constexpr (has_setitem) {
+                        if (vc.from_python(value, (uint8_t) cast_flags::convert,
+                                           &cleanup)) {
+                            map_set<Map, Key, Value>(
+                                *m, kc.operator cast_t<const Key &>(),
+                                vc.operator cast_t<const Value &>());
+                            done = true;
+                        }
+                    }
+                }
+            } catch (...) {
+                cleanup.release();
+                translate_exception();
+                return -1;
+            }
+
+            cleanup.release();
+            if (done)
+                return 0;
+            PyErr_Clear();
+        }
+
+        return ass_subscript_fallback(self, key, value);
+    }
+
+    static int contains(PyObject *self, PyObject *key) noexcept {
+        Map *m = container_ptr<Map>(self);
+        if (!m)
+            return contains_fallback(self, key);
+
+        make_caster<Key> kc;
+        cleanup_list cleanup(self);
+        int result = 0;
+
+        try {
+            if (kc.from_python(key, (uint8_t) cast_flags::convert, &cleanup))
+                result = m->find(kc.operator cast_t<const Key &>()) != m->end();
+            else
+                PyErr_Clear();
+        } catch (...) {
+            translate_exception();
+            result = -1;
+        }
+
+        cleanup.release();
+        return result;
+    }
+
+    static PyObject *iter(PyObject *self) noexcept {
+        Map *m = container_ptr<Map>(self);
+        if (!m)
+            return iter_fallback(self);
+
+        try {
+            object it = make_key_iterator(type<Map>(), "KeyIterator",
+                                          m->begin(), m->end());
+            keep_alive(it.ptr(), self);
+            return it.release().ptr();
+        } catch (...) {
+            translate_exception();
+            return nullptr;
+        }
+    }
+
+    /// Replace the generic slots installed by the special methods
+    static void install(handle cl) noexcept {
+        PyTypeObject *tp = (PyTypeObject *) cl.ptr();
+        PySequenceMethods *sq = tp->tp_as_sequence;
+        PyMappingMethods *mp = tp->tp_as_mapping;
+
+        container_slot_set(sq->sq_length, length, length_fallback);
+        container_slot_set(mp->mp_length, mp_length, mp_length_fallback);
+        container_slot_set(mp->mp_subscript, subscript, subscript_fallback);
+        container_slot_set(mp->mp_ass_subscript, ass_subscript, ass_subscript_fallback);
+        container_slot_set(sq->sq_contains, contains, contains_fallback);
+        container_slot_set(tp->tp_iter, iter, iter_fallback);
+    }
+};
+#endif
+
 NAMESPACE_END(detail)
 
 template <typename Map, typename... Args>
@@ -97,11 +269,18 @@ class_<Map> bind_map(handle scope, const char *name, Args &&...args) {
         cl.def(init<const Map &>(), "Copy constructor");
 
         cl.def("__init__", [](Map *m, typed<dict, detail::dict_type_id<Key, Value>> &d) {
-            new (m) Map();
-            for (auto [k, v] : d.value)
-                m->emplace(cast<Key>(k), cast<Value>(v));
+            new (m) Map(detail::map_from_dict<Map, Key, Value>(d.value));
+        }, "Construct from a dictionary");
+
+        cl.def_static("from_dict", [](typed<dict, detail::dict_type_id<Key, Value>> &d) {
+            return detail::map_from_dict<Map, Key, Value>(d.value);
         }, "Construct from a dictionary");
 
+        cl.def("to_dict", [](const Map &m) {
+            return steal<dict>(detail::dict_caster<Map, Key, Value>::from_cpp(
+                m, rv_policy::copy, nullptr));
+        }, "Return a dictionary with copies of the keys and values");
+
         implicitly_convertible<dict, Map>();
     }
 
@@ -117,6 +296,17 @@ class_<Map> bind_map(handle scope, const char *name, Args &&...args) {
                 detail::map_set<Map, Key, Value>(m, kv.first, kv.second);
         },
         "Update the map with element from `arg`");
+
+        if constexpr (detail::is_copy_constructible_v<Map>) {
+            cl.def("update", [](Map &m, typed<dict, detail::dict_type_id<Key, Value>> &d) {
+                Map m2 = detail::map_from_dict<Map, Key, Value>(d.value);
+                if constexpr (detail::has_reserve_v<Map>)
+                    m.reserve(m.size() + m2.size());
+                for (auto &kv : m2)
+                    detail::map_set<Map, Key, Value>(m, kv.first, kv.second);
+            },
+            "Update the map with the elements of a dictionary");
+        }
     }
 
     if constexpr (detail::is_equality_comparable_v<Map>) {
@@ -165,6 +355,10 @@ class_<Map> bind_map(handle scope, const char *name, Args &&...args) {
     cl.def("items",  [](Map &m) { return new ItemView{m};  }, keep_alive<0, 1>(),
            "Returns an iterable view of the map's items.");
 
+#if defined(NB_CONTAINER_SLOTS)
+    detail::map_slots<Map>::install(cl);
+#endif
+
     return cl;
 }
 
@@ -12,7 +12,9 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/operators.h>
 #include <nanobind/make_iterator.h>
+#include <nanobind/ndarray.h>
 #include <nanobind/stl/detail/traits.h>
+#include <nanobind/stl/detail/container_slots.h>
 #include <vector>
 #include <algorithm>
 
@@ -40,6 +42,310 @@ template <typename Value> struct iterable_type_id {
                                  const_name("]");
 };
 
+/// Can the contents of a bound vector be exposed as a strided array?
+template <typename Value>
+constexpr bool is_vector_buffer_v =
+    is_member_scalar_v<Value> && !std::is_same_v<Value, bool>;
+
+/// Can the contents be exposed as a record array of the fields bound via def_rw()?
+template <typename Value>
+constexpr bool is_vector_record_v =
+    std::is_class_v<Value> && std::is_standard_layout_v<Value> &&
+    std::is_trivially_copyable_v<Value>;
+
+template <typename Value> constexpr const char *vector_buffer_format() {
+    if constexpr (std::is_floating_point_v<Value>) {
+        return sizeof(Value) == 4 ? "f" : "d";
+    } else {
+        constexpr bool s = std::is_signed_v<Value>;
+        switch (sizeof(Value)) {
+            case 1: return s ? "b" : "B";
+            case 2: return s ? "h" : "H";
+            case 4: return s ? "i" : "I";
+            default: return s ? "q" : "Q";
+        }
+    }
+}
+
+template <typename Vector>
+int vector_getbuffer(PyObject *exporter, Py_buffer *view, int) noexcept {
+    using Value = typename Vector::value_type;
+    static Value empty { };
+
+    Vector *v;
+    if (!nb_type_get(&typeid(Vector), exporter, 0, nullptr, (void **) &v)) {
+        PyErr_SetString(PyExc_BufferError, "Cannot export the contents of an "
+                                           "uninitialized vector!");
+        view->obj = nullptr;
+        return -1;
+    }
+
+    // A single allocation holds the shape and stride
+    Py_ssize_t *shape = (Py_ssize_t *) PyMem_Malloc(2 * sizeof(Py_ssize_t));
+    if (!shape) {
+        PyErr_NoMemory();
+        view->obj = nullptr;
+        return -1;
+    }
+
+    if (!nb_inst_export(exporter)) {
+        PyMem_Free(shape);
+        view->obj = nullptr;
+        return -1;
+    }
+
+    shape[0] = (Py_ssize_t) v->size();
+    shape[1] = (Py_ssize_t) sizeof(Value);
+
+    view->buf = v->empty() ? (void *) &empty : (void *) v->data();
+    view->obj = exporter;
+    view->len = shape[0] * shape[1];
+    view->itemsize = shape[1];
+    view->readonly = false;
+    view->format = (char *) vector_buffer_format<Value>();
+    view->ndim = 1;
+    view->shape = shape;
+    view->strides = shape + 1;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    Py_INCREF(exporter);
+
+    return 0;
+}
+
+inline void vector_releasebuffer(PyObject *exporter, Py_buffer *view) {
+    PyMem_Free(view->shape);
+    nb_inst_unexport(exporter);
+}
+
+template <typename Vector>
+int vector_record_getbuffer(PyObject *exporter, Py_buffer *view,
+                            int flags) noexcept {
+    using Value = typename Vector::value_type;
+    alignas(Value) static char empty[sizeof(Value)];
+
+    Vector *v;
+    if (!nb_type_get(&typeid(Vector), exporter, 0, nullptr, (void **) &v)) {
+        PyErr_SetString(PyExc_BufferError, "Cannot export the contents of an "
+                                           "uninitialized vector!");
+        view->obj = nullptr;
+        return -1;
+    }
+
+    if (!nb_inst_export(exporter))
+        return -1;
+
+    int rv = record_getbuffer(exporter, view, flags, &typeid(Value),
+                              v->empty() ? (void *) empty : (void *) v->data(),
+                              v->size());
+    if (rv != 0)
+        nb_inst_unexport(exporter);
+    return rv;
+}
+
+template <typename Vector>
+void vector_buffer_slots(const type_init_data *t, PyType_Slot *&slots,
+                         size_t max_slots) noexcept {
+    if (max_slots < 2)
+        fail("nanobind::bind_vector(\"%s\"): ran out of type slots!", t->name);
+
+    using Value = typename Vector::value_type;
+    int (*getbuffer)(PyObject *, Py_buffer *, int);
+    if constexpr (is_vector_buffer_v<Value>)
+        getbuffer = vector_getbuffer<Vector>;
+    else
+        getbuffer = vector_record_getbuffer<Vector>;
+
+#if PY_VERSION_HEX >= 0x03090000
+    *slots++ = { Py_bf_getbuffer, (void *) getbuffer };
+    *slots++ = { Py_bf_releasebuffer, (void *) vector_releasebuffer };
+#else
+    // nb_type_new() installs these slots manually on Python 3.8
+    *slots++ = { 1 /* Py_bf_getbuffer */, (void *) getbuffer };
+    *slots++ = { 2 /* Py_bf_releasebuffer */, (void *) vector_releasebuffer };
+#endif
+}
+
+/// Fetch a vector that is about to be resized, which would invalidate buffers
+template <typename Vector> Vector &vector_resizable(pointer_and_handle<Vector> v) {
+    using Value = typename Vector::value_type;
+    if constexpr (is_vector_buffer_v<Value> || is_vector_record_v<Value>) {
+        if (nb_inst_exports(v.h.ptr()))
+            throw buffer_error("Cannot resize a vector while buffers or "
+                               "DLPack tensors reference its contents!");
+    }
+    return *v.p;
+}
+
+/// Append the contents of a 1D buffer using a single copy, or leave 'v' unchanged
+template <typename Vector> bool vector_extend_buffer(Vector &v, PyObject *o) noexcept {
+    using Value = typename Vector::value_type;
+
+    auto alloc = [](void *p, size_t size) -> void * {
+        Vector &v2 = *(Vector *) p;
+        size_t offset = v2.size();
+        if (size == 0)
+            return p; // not written to, but must be non-null
+        v2.resize(offset + size);
+        return v2.data() + offset;
+    };
+
+    size_t size = v.size();
+    if (seq_load_array(o, member_kind_of<Value>(), true, alloc, &v))
+        return true;
+
+    v.resize(size);
+    return false;
+}
+
+/// Vectors of arithmetic types and records expose their contents via the buffer protocol
+template <typename Vector, typename Value, typename... Args>
+class_<Vector> vector_class(handle scope, const char *name, Args &&...args) {
+    if constexpr (is_vector_buffer_v<Value> || is_vector_record_v<Value>)
+        return class_<Vector>(scope, name,
+                              type_slots_callback(vector_buffer_slots<Vector>),
+                              (forward_t<Args>) args...);
+    else
+        return class_<Vector>(scope, name, (forward_t<Args>) args...);
+}
+
+/// Signature of arguments that must support the buffer protocol
+struct buffer_type_id {
+    static constexpr auto Name = const_name("collections.abc.Buffer");
+};
+
+#if defined(NB_CONTAINER_SLOTS)
+/// Direct sequence and mapping slots of a bound vector (see container_slots.h)
+template <typename Vector> struct vector_slots {
+    using ValueRef = typename iterator_access<typename Vector::iterator>::result_type;
+    using Value = std::decay_t<ValueRef>;
+
+    static constexpr bool is_mutable = is_copy_constructible_v<Value>;
+
+    static inline lenfunc length_fallback = nullptr, mp_length_fallback = nullptr;
+    static inline ssizeargfunc item_fallback = nullptr;
+    static inline binaryfunc subscript_fallback = nullptr;
+    static inline objobjargproc ass_subscript_fallback = nullptr;
+    static inline objobjproc contains_fallback = nullptr;
+    static inline getiterfunc iter_fallback = nullptr;
+
+    static Py_ssize_t length(PyObject *self) noexcept {
+        Vector *v = container_ptr<Vector>(self);
+        return v ? (Py_ssize_t) v->size() : length_fallback(self);
+    }
+
+    static Py_ssize_t mp_length(PyObject *self) noexcept {
+        Vector *v = container_ptr<Vector>(self);
+        return v ? (Py_ssize_t) v->size() : mp_length_fallback(self);
+    }
+
+    static PyObject *item(PyObject *self, Py_ssize_t i) noexcept {
+        Vector *v = container_ptr<Vector>(self);
+        if (!v || i < 0 || (size_t) i >= v->size())
+            return item_fallback(self, i);
+        return container_cast<ValueRef>((*v)[(size_t) i], self);
+    }
+
+    static PyObject *subscript(PyObject *self, PyObject *key) noexcept {
+        Vector *v = container_ptr<Vector>(self);
+        size_t i;
+        if (!v || !container_index(key, v->size(), i))
+            return subscript_fallback(self, key);
+        return container_cast<ValueRef>((*v)[i], self);
+    }
+
+    static int ass_subscript(PyObject *self, PyObject *key, PyObject *value) noexcept {
+        if constexpr (is_mutable) {
+            Vector *v = container_ptr<Vector>(self);
+            size_t i;
+            if (v && container_index(key, v->size(), i)) {
+                make_caster<Value> caster;
+                cleanup_list cleanup(self);
+                bool done = false;
+
+                try {
+                    if (!value) {
+                        vector_resizable<Vector>({ v, self })
+                            .erase(v->begin() + (ptrdiff_t) i);
+                        done = true;
+                    } else if (caster.from_python(
+                                   value, (uint8_t) cast_flags::convert,
+                                   &cleanup)) {
+                        (*v)[i] = caster.operator cast_t<const Value &>();
+                        done = true;
+                    }
+                } catch (...) {
+                    cleanup.release();
+                    translate_exception();
+                    return -1;
+                }
+
+                cleanup.release();
+                if (done)
+                    return 0;
+                PyErr_Clear();
+            }
+        }
+        return ass_subscript_fallback(self, key, value);
+    }
+
+    static int contains(PyObject *self, PyObject *value) noexcept {
+        Vector *v = container_ptr<Vector>(self);
+        if (!v)
+            return contains_fallback(self, value);
+
+        make_caster<Value> caster;
+        cleanup_list cleanup(self);
+        int result = 0;
+
+        try {
+            if (caster.from_python(value, (uint8_t) cast_flags::convert, &cleanup))
+                result = std::find(v->begin(), v->end(),
+                                   caster.operator cast_t<const Value &>()) != v->end();
+            else
+                PyErr_Clear();
+        } catch (...) {
+            translate_exception();
+            result = -1;
+        }
+
+        cleanup.release();
+        return result;
+    }
+
+    static PyObject *iter(PyObject *self) noexcept {
+        Vector *v = container_ptr<Vector>(self);
+        if (!v)
+            return iter_fallback(self);
+
+        try {
+            object it = make_iterator(type<Vector>(), "Iterator", v->begin(), v->end());
+            keep_alive(it.ptr(), self);
+            return it.release().ptr();
+        } catch (...) {
+            translate_exception();
+            return nullptr;
+        }
+    }
+
+    /// Replace the generic slots installed by the special methods above
+    static void install(handle cl) noexcept {
+        PyTypeObject *tp = (PyTypeObject *) cl.ptr();
+        PySequenceMethods *sq = tp->tp_as_sequence;
+        PyMappingMethods *mp = tp->tp_as_mapping;
+
+        container_slot_set(sq->sq_length, length, length_fallback);
+        container_slot_set(sq->sq_item, item, item_fallback);
+        container_slot_set(mp->mp_length, mp_length, mp_length_fallback);
+        container_slot_set(mp->mp_subscript, subscript, subscript_fallback);
+        container_slot_set(mp->mp_ass_subscript, ass_subscript, ass_subscript_fallback);
+        if constexpr (is_equality_comparable_v<Value>)
+            container_slot_set(sq->sq_contains, contains, contains_fallback);
+        container_slot_set(tp->tp_iter, iter, iter_fallback);
+    }
+};
+#endif
+
 NAMESPACE_END(detail)
 
 
@@ -48,7 +354,8 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
     using ValueRef = typename detail::iterator_access<typename Vector::iterator>::result_type;
     using Value = std::decay_t<ValueRef>;
 
-    auto cl = class_<Vector>(scope, name, std::forward<Args>(args)...)
+    auto cl = detail::vector_class<Vector, Value>(scope, name,
+                                                  std::forward<Args>(args)...)
         .def(init<>(), "Default constructor")
 
         .def("__len__", [](const Vector &v) { return v.size(); })
@@ -74,7 +381,10 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
              },
              rv_policy::reference_internal)
 
-        .def("clear", [](Vector &v) { v.clear(); },
+        .def("clear",
+             [](pointer_and_handle<Vector> v) {
+                 detail::vector_resizable(v).clear();
+             },
              "Remove all items from list.");
 
     if constexpr (detail::is_copy_constructible_v<Value>) {
@@ -83,6 +393,10 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
 
         cl.def("__init__", [](Vector *v, typed<iterable, detail::iterable_type_id<Value>> &seq) {
             new (v) Vector();
+            if constexpr (detail::is_vector_buffer_v<Value>) {
+                if (detail::vector_extend_buffer(*v, seq.value.ptr()))
+                    return;
+            }
             v->reserve(len_hint(seq.value));
             for (handle h : seq.value)
                 v->push_back(cast<Value>(h));
@@ -91,11 +405,14 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
         implicitly_convertible<iterable, Vector>();
 
         cl.def("append",
-               [](Vector &v, const Value &value) { v.push_back(value); },
+               [](pointer_and_handle<Vector> v, const Value &value) {
+                   detail::vector_resizable(v).push_back(value);
+               },
                "Append `arg` to the end of the list.")
 
           .def("insert",
-               [](Vector &v, Py_ssize_t i, const Value &x) {
+               [](pointer_and_handle<Vector> vh, Py_ssize_t i, const Value &x) {
+                   Vector &v = detail::vector_resizable(vh);
                    if (i < 0)
                        i += (Py_ssize_t) v.size();
                    if (i < 0 || (size_t) i > v.size())
@@ -105,7 +422,8 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                "Insert object `arg1` before index `arg0`.")
 
            .def("pop",
-                [](Vector &v, Py_ssize_t i) {
+                [](pointer_and_handle<Vector> vh, Py_ssize_t i) {
+                    Vector &v = detail::vector_resizable(vh);
                     size_t index = detail::wrap(i, v.size());
                     Value result = std::move(v[index]);
                     v.erase(v.begin() + index);
@@ -115,7 +433,8 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                 "Remove and return item at `index` (default last).")
 
           .def("extend",
-               [](Vector &v, const Vector &src) {
+               [](pointer_and_handle<Vector> vh, const Vector &src) {
+                   Vector &v = detail::vector_resizable(vh);
                    v.insert(v.end(), src.begin(), src.end());
                },
                "Extend `self` by appending elements from `arg`.")
@@ -126,7 +445,8 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                })
 
           .def("__delitem__",
-               [](Vector &v, Py_ssize_t i) {
+               [](pointer_and_handle<Vector> vh, Py_ssize_t i) {
+                   Vector &v = detail::vector_resizable(vh);
                    v.erase(v.begin() + detail::wrap(i, v.size()));
                })
 
@@ -160,7 +480,8 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                })
 
           .def("__delitem__",
-               [](Vector &v, const slice &slice) {
+               [](pointer_and_handle<Vector> vh, const slice &slice) {
+                   Vector &v = detail::vector_resizable(vh);
                    auto [start, stop, step, length] = slice.compute(v.size());
                    if (length == 0)
                        return;
@@ -182,6 +503,36 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                });
     }
 
+    if constexpr (detail::is_vector_buffer_v<Value>) {
+        cl.def("extend",
+               [](pointer_and_handle<Vector> v,
+                  typed<object, detail::buffer_type_id> &buf) {
+                   if (!detail::vector_extend_buffer(detail::vector_resizable(v),
+                                                     buf.value.ptr()))
+                       throw next_overload();
+               },
+               "Extend `self` by copying the elements of a 1D buffer.")
+
+          .def("__dlpack__",
+               [](pointer_and_handle<Vector> v, kwargs) {
+                   // The vector can't be resized while the tensor is alive
+                   if (!detail::nb_inst_export(v.h.ptr()))
+                       detail::raise_python_error();
+                   capsule owner(v.h.inc_ref().ptr(), [](void *p) noexcept {
+                       detail::nb_inst_unexport((PyObject *) p);
+                       Py_DECREF((PyObject *) p);
+                   });
+                   size_t shape[1] = { v.p->size() };
+                   ndarray<Value> array(v.p->data(), 1, shape, owner);
+                   return cast(array, rv_policy::reference);
+               },
+               "Return a DLPack capsule referencing the vector contents.")
+
+          .def("__dlpack_device__", [](handle) {
+              return make_tuple((int) device::cpu::value, 0);
+          });
+    }
+
     if constexpr (detail::is_equality_comparable_v<Value>) {
         cl.def(self == self)
           .def(self != self)
@@ -200,7 +551,8 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                }, "Return number of occurrences of `arg`.")
 
           .def("remove",
-               [](Vector &v, const Value &x) {
+               [](pointer_and_handle<Vector> vh, const Value &x) {
+                   Vector &v = detail::vector_resizable(vh);
                    auto p = std::find(v.begin(), v.end(), x);
                    if (p != v.end())
                        v.erase(p);
@@ -210,6 +562,10 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                "Remove first occurrence of `arg`.");
     }
 
+#if defined(NB_CONTAINER_SLOTS)
+    detail::vector_slots<Vector>::install(cl);
+#endif
+
     return cl;
 }
 
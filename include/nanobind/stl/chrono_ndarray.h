@@ -0,0 +1,146 @@
+/*
+    nanobind/stl/chrono_ndarray.h: bulk conversion between vectors of
+    std::chrono::time_point and NumPy datetime64[ns] arrays
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/chrono.h>
+#include <nanobind/stl/detail/nb_list.h>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+
+/**
+ * Wrapper around a ``std::vector`` of system clock time points that is
+ * exchanged with Python as a one-dimensional NumPy ``datetime64[ns]`` array.
+ * Neither direction creates Python objects per element. Time points are
+ * interpreted as nanoseconds since the epoch, as in NumPy.
+ */
+template <typename Duration = std::chrono::system_clock::duration>
+struct vector_datetime64 {
+    using time_point =
+        std::chrono::time_point<std::chrono::system_clock, Duration>;
+
+    std::vector<time_point> value;
+
+    vector_datetime64() = default;
+    vector_datetime64(std::vector<time_point> &&value) : value(std::move(value)) { }
+    vector_datetime64(const std::vector<time_point> &value) : value(value) { }
+};
+
+NAMESPACE_BEGIN(detail)
+
+template <typename Duration> struct type_caster<vector_datetime64<Duration>> {
+    using type = vector_datetime64<Duration>;
+    using time_point = typename type::time_point;
+    using Array = ndarray<numpy, int64_t, shape<any>>;
+
+    NB_TYPE_CASTER(type, const_name("numpy.ndarray[dtype=datetime64[ns], shape=(*)]"))
+
+    /// Can the time points be reinterpreted as int64 nanoseconds?
+    static constexpr bool IsNanoseconds =
+        std::is_same_v<typename Duration::rep, int64_t> &&
+        std::is_same_v<typename Duration::period, std::nano>;
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        namespace ch = std::chrono;
+
+        object ns;
+        try {
+            object dtype = getattr(src, "dtype", handle());
+            if (dtype.is_valid() && str(dtype.attr("kind")).equal(str("M")))
+                ns = src.attr("astype")("datetime64[ns]").attr("view")("int64");
+        } catch (python_error &) {
+            return false;
+        }
+
+        if (!ns.is_valid()) {
+            // Fall back to an element-wise conversion of datetime objects
+            list_caster<std::vector<time_point>, time_point> caster;
+            if (!caster.from_python(src, flags, cleanup))
+                return false;
+            value.value = std::move(caster.value);
+            return true;
+        }
+
+        if constexpr (IsNanoseconds) {
+            auto alloc = [](void *p, size_t size) -> void * {
+                std::vector<time_point> &v = *(std::vector<time_point> *) p;
+                v.resize(size);
+                return v.data();
+            };
+
+            return seq_load_array(ns.ptr(), member_kind::i64, false, alloc,
+                                  &value.value);
+        } else {
+            auto alloc = [](void *p, size_t size) -> void * {
+                std::vector<int64_t> &v = *(std::vector<int64_t> *) p;
+                v.resize(size);
+                return v.data();
+            };
+
+            std::vector<int64_t> temp;
+            if (!seq_load_array(ns.ptr(), member_kind::i64, false, alloc, &temp))
+                return false;
+
+            value.value.resize(temp.size());
+            for (size_t i = 0; i < temp.size(); ++i)
+                value.value[i] = time_point(
+                    ch::duration_cast<Duration>(ch::nanoseconds(temp[i])));
+            return true;
+        }
+    }
+
+    template <typename T_>
+    static handle from_cpp(T_ &&src, rv_policy, cleanup_list *) noexcept {
+        namespace ch = std::chrono;
+
+        try {
+            void *ptr;
+            size_t size = src.value.size();
+            capsule owner;
+
+            if constexpr (IsNanoseconds) {
+                std::vector<time_point> *vec =
+                    new std::vector<time_point>(forward_like<T_>(src.value));
+                owner = capsule(vec, [](void *p) noexcept {
+                    delete (std::vector<time_point> *) p;
+                });
+                ptr = vec->data();
+            } else {
+                std::vector<int64_t> *vec = new std::vector<int64_t>(size);
+                owner = capsule(vec, [](void *p) noexcept {
+                    delete (std::vector<int64_t> *) p;
+                });
+                for (size_t i = 0; i < size; ++i)
+                    (*vec)[i] = ch::duration_cast<ch::nanoseconds>(
+                                    src.value[i].time_since_epoch()).count();
+                ptr = vec->data();
+            }
+
+            size_t shape[1] = { size };
+            Array array((int64_t *) ptr, 1, shape, owner);
+
+            object result = steal(ndarray_wrap(
+                array.handle(), int(Array::Info::framework), rv_policy::reference));
+            if (!result.is_valid())
+                return handle();
+
+            return result.attr("view")("datetime64[ns]").release();
+        } catch (python_error &e) {
+            e.restore();
+        } catch (const std::exception &e) {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+        }
+        return handle();
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
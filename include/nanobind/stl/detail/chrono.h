@@ -68,33 +68,33 @@ struct datetime_types_t {
     handle time;
     handle date;
     handle timedelta;
+};
 
-    // Ensure that the above four handles point to valid Python objects.
-    // If unable, throw nb::python_error.
-    void ensure_ready() {
-        if (datetime.is_valid())
-            return;
+// Return the types of the datetime module, which are imported once per
+// interpreter and cached in the nanobind internals. If unable, throw
+// nb::python_error.
+NB_NOINLINE inline datetime_types_t datetime_types() {
+    void **cache = datetime_cache();
 
+    if (NB_UNLIKELY(!cache[1])) {
         object mod = module_::import_("datetime");
         object datetime_o = mod.attr("datetime");
         object time_o = mod.attr("time");
         object date_o = mod.attr("date");
         object timedelta_o = mod.attr("timedelta");
 
-        // Leak references to these datetime types. We could improve upon
-        // this by storing them in the internals structure and decref'ing
-        // in internals_cleanup(), but it doesn't seem worthwhile for
-        // something this fundamental. We can't store nb::object in this
-        // structure because it might be destroyed after the Python
+        // Leak references to these datetime types. We can't release them
+        // during internals cleanup, which runs after the Python
         // interpreter has finalized.
-        datetime = datetime_o.release();
-        time = time_o.release();
-        date = date_o.release();
-        timedelta = timedelta_o.release();
+        cache[2] = time_o.release().ptr();
+        cache[3] = date_o.release().ptr();
+        cache[4] = timedelta_o.release().ptr();
+        cache[1] = datetime_o.release().ptr();
     }
-};
 
-inline datetime_types_t datetime_types;
+    return { (PyObject *) cache[1], (PyObject *) cache[2],
+             (PyObject *) cache[3], (PyObject *) cache[4] };
+}
 
 // Set *dest to the integer value of getattr(o, name). Returns true
 // on success, false and sets the Python error indicator on failure.
@@ -125,9 +125,9 @@ NB_NOINLINE inline bool set_from_int_attr(int *dest, PyObject *o,
 
 NB_NOINLINE inline bool unpack_timedelta(PyObject *o, int *days,
                                          int *secs, int *usecs) {
-    datetime_types.ensure_ready();
+    datetime_types_t types = datetime_types();
     if (PyType_IsSubtype(Py_TYPE(o),
-                         (PyTypeObject *) datetime_types.timedelta.ptr())) {
+                         (PyTypeObject *) types.timedelta.ptr())) {
         if (!set_from_int_attr(days, o, "days") ||
             !set_from_int_attr(secs, o, "seconds") ||
             !set_from_int_attr(usecs, o, "microseconds")) {
@@ -142,9 +142,9 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
                                         int *year, int *month, int *day,
                                         int *hour, int *minute, int *second,
                                         int *usec) {
-    datetime_types.ensure_ready();
+    datetime_types_t types = datetime_types();
     if (PyType_IsSubtype(Py_TYPE(o),
-                         (PyTypeObject *) datetime_types.datetime.ptr())) {
+                         (PyTypeObject *) types.datetime.ptr())) {
         if (!set_from_int_attr(usec, o, "microsecond") ||
             !set_from_int_attr(second, o, "second") ||
             !set_from_int_attr(minute, o, "minute") ||
@@ -157,7 +157,7 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
         return true;
     }
     if (PyType_IsSubtype(Py_TYPE(o),
-                         (PyTypeObject *) datetime_types.date.ptr())) {
+                         (PyTypeObject *) types.date.ptr())) {
         *usec = *second = *minute = *hour = 0;
         if (!set_from_int_attr(day, o, "day") ||
             !set_from_int_attr(month, o, "month") ||
@@ -167,7 +167,7 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
         return true;
     }
     if (PyType_IsSubtype(Py_TYPE(o),
-                         (PyTypeObject *) datetime_types.time.ptr())) {
+                         (PyTypeObject *) types.time.ptr())) {
         *day = 1;
         *month = 1;
         *year = 1970;
@@ -184,8 +184,7 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
 
 inline PyObject* pack_timedelta(int days, int secs, int usecs) noexcept {
     try {
-        datetime_types.ensure_ready();
-        return datetime_types.timedelta(days, secs, usecs).release().ptr();
+        return datetime_types().timedelta(days, secs, usecs).release().ptr();
     } catch (python_error& e) {
         e.restore();
         return nullptr;
@@ -196,8 +195,7 @@ inline PyObject* pack_datetime(int year, int month, int day,
                                int hour, int minute, int second,
                                int usec) noexcept {
     try {
-        datetime_types.ensure_ready();
-        return datetime_types.datetime(
+        return datetime_types().datetime(
                 year, month, day, hour, minute, second, usec).release().ptr();
     } catch (python_error& e) {
         e.restore();
@@ -207,14 +205,26 @@ inline PyObject* pack_datetime(int year, int month, int day,
 
 #else // !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
 
+// Return the datetime C API, which is imported once per interpreter and
+// cached in the nanobind internals. Returns nullptr and sets the Python error
+// indicator on failure.
+NB_NOINLINE inline PyDateTime_CAPI *datetime_api() noexcept {
+    void **cache = datetime_cache();
+
+    if (NB_UNLIKELY(!cache[0]))
+        cache[0] = PyCapsule_Import(PyDateTime_CAPSULE_NAME, 0);
+
+    // Also make the macros from <datetime.h> usable in this translation unit
+    PyDateTimeAPI = (PyDateTime_CAPI *) cache[0];
+    return PyDateTimeAPI;
+}
+
 NB_NOINLINE inline bool unpack_timedelta(PyObject *o, int *days,
                                          int *secs, int *usecs) {
-    if (!PyDateTimeAPI) {
-        PyDateTime_IMPORT;
-        if (!PyDateTimeAPI)
-            raise_python_error();
-    }
-    if (PyDelta_Check(o)) {
+    PyDateTime_CAPI *api = datetime_api();
+    if (!api)
+        raise_python_error();
+    if (PyObject_TypeCheck(o, api->DeltaType)) {
         *days = PyDateTime_DELTA_GET_DAYS(o);
         *secs = PyDateTime_DELTA_GET_SECONDS(o);
         *usecs = PyDateTime_DELTA_GET_MICROSECONDS(o);
@@ -227,12 +237,10 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
                                         int *year, int *month, int *day,
                                         int *hour, int *minute, int *second,
                                         int *usec) {
-    if (!PyDateTimeAPI) {
-        PyDateTime_IMPORT;
-        if (!PyDateTimeAPI)
-            raise_python_error();
-    }
-    if (PyDateTime_Check(o)) {
+    PyDateTime_CAPI *api = datetime_api();
+    if (!api)
+        raise_python_error();
+    if (PyObject_TypeCheck(o, api->DateTimeType)) {
         *usec = PyDateTime_DATE_GET_MICROSECOND(o);
         *second = PyDateTime_DATE_GET_SECOND(o);
         *minute = PyDateTime_DATE_GET_MINUTE(o);
@@ -242,7 +250,7 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
         *year = PyDateTime_GET_YEAR(o);
         return true;
     }
-    if (PyDate_Check(o)) {
+    if (PyObject_TypeCheck(o, api->DateType)) {
         *usec = 0;
         *second = 0;
         *minute = 0;
@@ -252,7 +260,7 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
         *year = PyDateTime_GET_YEAR(o);
         return true;
     }
-    if (PyTime_Check(o)) {
+    if (PyObject_TypeCheck(o, api->TimeType)) {
         *usec = PyDateTime_TIME_GET_MICROSECOND(o);
         *second = PyDateTime_TIME_GET_SECOND(o);
         *minute = PyDateTime_TIME_GET_MINUTE(o);
@@ -266,24 +274,21 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
 }
 
 inline PyObject* pack_timedelta(int days, int secs, int usecs) noexcept {
-    if (!PyDateTimeAPI) {
-        PyDateTime_IMPORT;
-        if (!PyDateTimeAPI)
-            return nullptr;
-    }
-    return PyDelta_FromDSU(days, secs, usecs);
+    PyDateTime_CAPI *api = datetime_api();
+    if (!api)
+        return nullptr;
+    return api->Delta_FromDelta(days, secs, usecs, 1, api->DeltaType);
 }
 
 inline PyObject* pack_datetime(int year, int month, int day,
                                int hour, int minute, int second,
                                int usec) noexcept {
-    if (!PyDateTimeAPI) {
-        PyDateTime_IMPORT;
-        if (!PyDateTimeAPI)
-            return nullptr;
-    }
-    return PyDateTime_FromDateAndTime(year, month, day,
-                                      hour, minute, second, usec);
+    PyDateTime_CAPI *api = datetime_api();
+    if (!api)
+        return nullptr;
+    return api->DateTime_FromDateAndTime(year, month, day, hour, minute,
+                                         second, usec, Py_None,
+                                         api->DateTimeType);
 }
 
 #endif // !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
@@ -0,0 +1,91 @@
+/*
+    nanobind/stl/detail/container_slots.h: helpers for the direct sequence
+    and mapping slots of bind_vector() and bind_map()
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/* The special methods of bound containers are also registered as regular
+   methods, which CPython calls through generic slot functions that look up
+   and invoke them. The slots below implement the common cases directly and
+   defer to the replaced generic slot function otherwise (e.g., for slices,
+   arguments requiring overload resolution, or errors). */
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+#  define NB_CONTAINER_SLOTS
+#endif
+
+/// Return the payload of 'o' if it is ready to be passed to a function
+template <typename T> NB_INLINE T *container_ptr(PyObject *o) noexcept {
+    return nb_inst_state(o).first ? (T *) nb_inst_ptr(o) : nullptr;
+}
+
+/// Install the slot function 'impl' if the slot exists, and remember the previous one
+template <typename Func, typename Impl>
+void container_slot_set(Func &field, Impl *impl, Func &fallback) noexcept {
+    Func f = impl; // drops 'noexcept' from the function pointer type
+    if (!field || field == f)
+        return;
+    fallback = field;
+    field = f;
+}
+
+/**
+ * Interpret 'key' as an index into a container of size 'size'. Only exact
+ * Python 'int' objects within bounds are handled, other keys (including
+ * out-of-range indices, which raise an exception) take the generic path.
+ */
+inline bool container_index(PyObject *key, size_t size, size_t &index) noexcept {
+    if (!PyLong_CheckExact(key))
+        return false;
+
+    Py_ssize_t i = PyLong_AsSsize_t(key);
+    if (i == -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+        return false;
+    }
+
+    if (i < 0)
+        i += (Py_ssize_t) size;
+
+    if (i < 0 || (size_t) i >= size)
+        return false;
+
+    index = (size_t) i;
+    return true;
+}
+
+/// Convert a container element like a 'reference_internal' method would
+template <typename T>
+PyObject *container_cast(T &&value, PyObject *self) noexcept {
+    cleanup_list cleanup(self);
+    PyObject *result;
+
+    try {
+        result = make_caster<T>::from_cpp((forward_t<T>) value,
+                                          rv_policy::reference_internal,
+                                          &cleanup).ptr();
+        if (!result && !PyErr_Occurred())
+            PyErr_SetString(PyExc_TypeError,
+                            "nanobind::detail::container_cast(): could not "
+                            "convert the element to a Python object!");
+    } catch (...) {
+        translate_exception();
+        result = nullptr;
+    }
+
+    cleanup.release();
+    return result;
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
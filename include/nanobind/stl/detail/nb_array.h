@@ -11,7 +11,30 @@ template <typename Value_, typename Entry, size_t Size> struct array_caster {
 
     using Caster = make_caster<Entry>;
 
+    /// Arithmetic elements can be bulk-copied from arrays (NumPy, etc.)
+    static constexpr bool IsArray =
+        is_member_scalar_v<Entry> && !std::is_same_v<Entry, bool>;
+
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if constexpr (IsArray) {
+            auto alloc = [](void *p, size_t size) -> void * {
+                return size == Size ? (void *) ((Value_ *) p)->data() : nullptr;
+            };
+
+            if (seq_load_array(src.ptr(), member_kind_of<Entry>(),
+                               flags & (uint8_t) cast_flags::convert, alloc,
+                               &value))
+                return true;
+        }
+
+        size_t size_hint;
+        PyObject *iter = seq_iter(src.ptr(), flags & (uint8_t) cast_flags::consume,
+                                  &size_hint);
+
+        // Convert generic iterables on the fly without a temporary list
+        if (iter)
+            return from_iter(iter, flags, cleanup);
+
         PyObject *temp;
 
         /* Will initialize 'temp' (NULL in the case of a failure.) */
@@ -36,6 +59,45 @@ template <typename Value_, typename Entry, size_t Size> struct array_caster {
         return success;
     }
 
+    bool from_iter(PyObject *iter, uint8_t flags, cleanup_list *cleanup) noexcept {
+        Caster caster;
+        bool success = true;
+
+        for (size_t i = 0; i < Size; ++i) {
+            PyObject *item = PyIter_Next(iter);
+            if (!item) {
+                success = false;
+                break;
+            }
+
+            success = caster.from_python(item, flags, cleanup);
+            Py_DECREF(item);
+
+            if (!success)
+                break;
+
+            value[i] = ((Caster &&) caster).operator cast_t<Entry &&>();
+        }
+
+        // The iterable must not have any further elements
+        if (success) {
+            PyObject *item = PyIter_Next(iter);
+            if (item) {
+                Py_DECREF(item);
+                success = false;
+            }
+        }
+
+        if (PyErr_Occurred()) {
+            PyErr_Clear();
+            success = false;
+        }
+
+        Py_DECREF(iter);
+
+        return success;
+    }
+
     template <typename T>
     static handle from_cpp(T &&src, rv_policy policy, cleanup_list *cleanup) {
         object ret = steal(PyList_New(Size));
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <nanobind/nanobind.h>
+#include "traits.h"
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -25,6 +26,31 @@ template <typename Value_, typename Key, typename Element> struct dict_caster {
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
         value.clear();
 
+        // Iterate over dictionaries directly instead of creating a list of items
+        if (PyDict_CheckExact(src.ptr())) {
+            if constexpr (has_reserve_v<Value_>)
+                value.reserve((size_t) PyDict_Size(src.ptr()));
+
+            KeyCaster key_caster;
+            ElementCaster element_caster;
+            Py_ssize_t pos = 0;
+            PyObject *key, *element;
+
+            while (PyDict_Next(src.ptr(), &pos, &key, &element)) {
+                // Conversions may run Python code, keep the entry alive
+                object k = borrow(key), e = borrow(element);
+
+                if (!key_caster.from_python(k, flags, cleanup) ||
+                    !element_caster.from_python(e, flags, cleanup))
+                    return false;
+
+                value.emplace(((KeyCaster &&) key_caster).operator cast_t<Key &&>(),
+                              ((ElementCaster &&) element_caster).operator cast_t<Element &&>());
+            }
+
+            return true;
+        }
+
         PyObject *items = PyMapping_Items(src.ptr());
         if (items == nullptr) {
             PyErr_Clear();
@@ -34,6 +60,11 @@ template <typename Value_, typename Key, typename Element> struct dict_caster {
         Py_ssize_t size = NB_LIST_GET_SIZE(items);
         bool success = (size >= 0);
 
+        if constexpr (has_reserve_v<Value_>) {
+            if (success)
+                value.reserve((size_t) size);
+        }
+
         KeyCaster key_caster;
         ElementCaster element_caster;
         for (Py_ssize_t i = 0; i < size; ++i) {
@@ -21,9 +21,40 @@ template <typename Value_, typename Entry> struct list_caster {
     using Caster = make_caster<Entry>;
 
     template <typename T> using has_reserve = decltype(std::declval<T>().reserve(0));
+    template <typename T> using has_data = decltype(std::declval<T>().data());
+
+    /// Arithmetic elements can be bulk-copied from arrays (NumPy, etc.)
+    static constexpr bool IsArray =
+        is_member_scalar_v<Entry> && !std::is_same_v<Entry, bool> &&
+        is_detected_v<has_data, Value_>;
+
+    /// Contiguous bound-type elements are returned via a single nb_type_put_seq() call
+    static constexpr bool IsClassArray =
+        is_inplace_caster<Caster>::value && !std::is_enum_v<Entry> &&
+        !is_pointer_v<Entry> && is_detected_v<has_data, Value_>;
 
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if constexpr (IsArray) {
+            auto alloc = [](void *p, size_t size) -> void * {
+                Value_ &v = *(Value_ *) p;
+                v.resize(size);
+                return v.data();
+            };
+
+            if (seq_load_array(src.ptr(), member_kind_of<Entry>(),
+                               flags & (uint8_t) cast_flags::convert, alloc,
+                               &value))
+                return true;
+        }
+
         size_t size;
+        PyObject *iter = seq_iter(src.ptr(), flags & (uint8_t) cast_flags::consume,
+                                  &size);
+
+        // Convert generic iterables on the fly without a temporary list
+        if (iter)
+            return from_iter(iter, size, flags, cleanup);
+
         PyObject *temp;
 
         /* Will initialize 'size' and 'temp'. All return values and
@@ -52,8 +83,47 @@ template <typename Value_, typename Entry> struct list_caster {
         return success;
     }
 
+    bool from_iter(PyObject *iter, size_t size_hint, uint8_t flags,
+                   cleanup_list *cleanup) noexcept {
+        value.clear();
+
+        if constexpr (is_detected_v<has_reserve, Value_>)
+            value.reserve(size_hint);
+
+        Caster caster;
+        bool success = true;
+        PyObject *item;
+
+        while ((item = PyIter_Next(iter)) != nullptr) {
+            success = caster.from_python(item, flags, cleanup);
+            Py_DECREF(item);
+
+            if (!success)
+                break;
+
+            value.push_back(((Caster &&) caster).operator cast_t<Entry &&>());
+        }
+
+        if (PyErr_Occurred()) {
+            PyErr_Clear();
+            success = false;
+        }
+
+        Py_DECREF(iter);
+
+        return success;
+    }
+
     template <typename T>
     static handle from_cpp(T &&src, rv_policy policy, cleanup_list *cleanup) {
+        if constexpr (IsClassArray) {
+            rv_policy p = infer_policy<forwarded_type<T, Entry>>(policy);
+
+            if (p == rv_policy::copy || p == rv_policy::move)
+                return nb_type_put_seq(&typeid(Entry), (void *) src.data(),
+                                       sizeof(Entry), src.size(), p, cleanup);
+        }
+
         object ret = steal(PyList_New(src.size()));
 
         if (ret.is_valid()) {
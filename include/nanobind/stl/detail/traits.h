@@ -87,6 +87,12 @@ struct is_equality_comparable<std::pair<T1, T2>> {
 template <typename T>
 constexpr bool is_equality_comparable_v = is_equality_comparable<T>::value;
 
+// Detect containers that can preallocate storage (e.g. std::unordered_map)
+template <typename T> using reserve_test = decltype(std::declval<T &>().reserve(0));
+
+template <typename T>
+constexpr bool has_reserve_v = is_detected_v<reserve_test, T>;
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
 
@@ -10,7 +10,9 @@
 #pragma once
 
 #include <nanobind/nanobind.h>
+#include <atomic>
 #include <functional>
+#include <tuple>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -34,10 +36,7 @@ struct pyfunc_wrapper {
     }
 
     ~pyfunc_wrapper() {
-        if (f) {
-            gil_scoped_acquire acq;
-            Py_DECREF(f);
-        }
+        decref_deferred(f);
     }
 
     pyfunc_wrapper &operator=(const pyfunc_wrapper) = delete;
@@ -55,12 +54,25 @@ struct type_caster<std::function<Return(Args...)>> {
                        ReturnCaster::Name + const_name("]"));
 
     struct pyfunc_wrapper_t : pyfunc_wrapper {
-        using pyfunc_wrapper::pyfunc_wrapper;
+        explicit pyfunc_wrapper_t(PyObject *f)
+            : pyfunc_wrapper(f),
+              direct(nb_func_has_direct(f, &typeid(Return (*)(Args...)))) { }
 
         Return operator()(Args... args) const {
+            // Bound C++ functions with a matching signature bypass Python
+            if (direct) {
+                void (*fn)(void);
+                void *cap = nb_func_direct(f, &fn);
+                if (cap)
+                    return ((Return (*)(void *, Args...)) fn)(
+                        cap, (forward_t<Args>) args...);
+            }
+
             gil_scoped_acquire acq;
             return cast<Return>(handle(f)((forward_t<Args>) args...));
         }
+
+        bool direct;
     };
 
     bool from_python(handle src, uint8_t flags, cleanup_list *) noexcept {
@@ -91,5 +103,173 @@ struct type_caster<std::function<Return(Args...)>> {
     }
 };
 
+/// Shared state of a deferred_callback<>: a Python callable and a queue of calls
+template <typename... Args> struct deferred_state {
+    struct node {
+        node *next;
+        std::tuple<std::decay_t<Args>...> args;
+    };
+
+    PyObject *f;
+    std::atomic<node *> head{ nullptr };
+    std::atomic<bool> scheduled{ false };
+    std::atomic<size_t> ref_count{ 1 };
+
+    explicit deferred_state(PyObject *f) : f(f) { Py_INCREF(f); }
+
+    void inc_ref() noexcept { ref_count.fetch_add(1, std::memory_order_relaxed); }
+
+    void dec_ref() noexcept {
+        if (ref_count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        gil_scoped_acquire acq;
+        drain();
+        Py_DECREF(f);
+        delete this;
+    }
+
+    /// Enqueue a call (lock-free, does not require the GIL)
+    void push(node *n) noexcept {
+        node *h = head.load(std::memory_order_relaxed);
+        do {
+            n->next = h;
+        } while (!head.compare_exchange_weak(h, n, std::memory_order_release,
+                                             std::memory_order_relaxed));
+
+        // Ask the interpreter to drain the queue unless it already will
+        if (!scheduled.exchange(true)) {
+            inc_ref();
+            if (Py_AddPendingCall(pending_call, this) != 0) {
+                scheduled.store(false);
+                ref_count.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static int pending_call(void *p) noexcept {
+        deferred_state *s = (deferred_state *) p;
+        s->drain();
+        s->dec_ref();
+        return 0;
+    }
+
+    /// Perform all queued calls in the order they were made (requires the GIL)
+    void drain() noexcept {
+        scheduled.store(false);
+        node *n = head.exchange(nullptr, std::memory_order_acquire), *prev = nullptr;
+
+        while (n) {
+            node *next = n->next;
+            n->next = prev;
+            prev = n;
+            n = next;
+        }
+
+        while (prev) {
+            node *next = prev->next;
+            try {
+                std::apply([fn = handle(f)](auto &...args) { fn(args...); },
+                           prev->args);
+            } catch (python_error &e) {
+                e.discard_as_unraisable(handle(f));
+            } catch (const std::exception &e) {
+                PyErr_SetString(PyExc_RuntimeError, e.what());
+                PyErr_WriteUnraisable(f);
+            }
+            delete prev;
+            prev = next;
+        }
+    }
+};
+
+NAMESPACE_END(detail)
+
+template <typename Signature> class deferred_callback;
+
+/**
+ * Wrapper around a Python callable that can be invoked from arbitrary C++
+ * threads without acquiring the GIL. Calls are queued and later performed in
+ * batches by the interpreter, so that one GIL acquisition covers many calls.
+ */
+template <typename... Args> class deferred_callback<void(Args...)> {
+    // Arguments are copied into the queue without holding the GIL
+    static_assert(
+        !(detail::is_python_value<detail::intrinsic_t<Args>>::value || ...),
+        "nanobind::deferred_callback: arguments referencing Python objects are "
+        "unsupported!");
+
+public:
+    using state = detail::deferred_state<Args...>;
+
+    deferred_callback() = default;
+    explicit deferred_callback(handle f) : m_state(new state(f.ptr())) { }
+
+    deferred_callback(const deferred_callback &c) : m_state(c.m_state) {
+        if (m_state)
+            m_state->inc_ref();
+    }
+
+    deferred_callback(deferred_callback &&c) noexcept : m_state(c.m_state) {
+        c.m_state = nullptr;
+    }
+
+    ~deferred_callback() {
+        if (m_state)
+            m_state->dec_ref();
+    }
+
+    deferred_callback &operator=(deferred_callback c) noexcept {
+        std::swap(m_state, c.m_state);
+        return *this;
+    }
+
+    /// Queue a call of the Python function with the given arguments
+    void operator()(Args... args) const {
+        m_state->push(new typename state::node{
+            nullptr, { (detail::forward_t<Args>) args... } });
+    }
+
+    /// Immediately perform all queued calls (acquires the GIL)
+    void flush() const {
+        if (m_state) {
+            gil_scoped_acquire acq;
+            m_state->drain();
+        }
+    }
+
+    /// Return the wrapped Python function
+    handle function() const { return m_state ? handle(m_state->f) : handle(); }
+
+    explicit operator bool() const { return m_state != nullptr; }
+
+private:
+    state *m_state = nullptr;
+};
+
+NAMESPACE_BEGIN(detail)
+
+template <typename... Args>
+struct type_caster<deferred_callback<void(Args...)>> {
+    NB_TYPE_CASTER(deferred_callback<void(Args...)>,
+                   const_name("Callable[[") +
+                       concat(make_caster<Args>::Name...) +
+                       const_name("], None]"));
+
+    bool from_python(handle src, uint8_t, cleanup_list *) noexcept {
+        if (!PyCallable_Check(src.ptr()))
+            return false;
+
+        value = Value(src);
+        return true;
+    }
+
+    static handle from_cpp(const Value &value, rv_policy,
+                           cleanup_list *) noexcept {
+        if (!value)
+            return none().release();
+        return value.function().inc_ref();
+    }
+};
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -0,0 +1,114 @@
+/*
+    nanobind/stl/future.h: type caster converting std::future<...> into
+    asyncio futures
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <future>
+#include <optional>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * Returning a ``std::future<T>`` to Python produces an ``asyncio.Future`` of
+ * the running event loop. A worker thread of the shared thread pool waits for
+ * the C++ future without holding the GIL and then completes the asyncio
+ * future with its value or exception. Each pending future occupies one
+ * worker thread. Futures can't be passed from Python to C++.
+ */
+template <typename T> struct type_caster<std::future<T>> {
+    NB_TYPE_CASTER(std::future<T>, const_name("asyncio.Future[") +
+                                       make_caster<T>::Name + const_name("]"))
+
+    struct task {
+        Value value;
+        PyObject *loop, *future;
+
+        static void run(void *p) noexcept {
+            task *t = (task *) p;
+            std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> result;
+            std::exception_ptr error;
+
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    t->value.get();
+                    result.emplace(true);
+                } else {
+                    result.emplace(t->value.get());
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            gil_scoped_acquire guard;
+            PyObject *o = nullptr;
+
+            if (result) {
+                try {
+                    if constexpr (std::is_void_v<T>)
+                        o = none().release().ptr();
+                    else
+                        o = make_caster<T>::from_cpp(std::move(*result),
+                                                     rv_policy::move, nullptr).ptr();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+
+            if (!o) {
+                if (error) {
+                    try {
+                        std::rethrow_exception(error);
+                    } catch (...) {
+                        translate_exception();
+                    }
+                } else if (!PyErr_Occurred()) {
+                    PyErr_SetString(PyExc_TypeError,
+                                    "nanobind::detail::type_caster<std::future>: "
+                                    "could not convert the result to a Python "
+                                    "object!");
+                }
+            }
+
+            PyObject *loop = t->loop, *future = t->future;
+            result.reset();
+            delete t;
+            async_future_set(loop, future, o);
+        }
+    };
+
+    bool from_python(handle, uint8_t, cleanup_list *) noexcept {
+        return false;
+    }
+
+    static handle from_cpp(Value &&value, rv_policy, cleanup_list *) {
+        if (!value.valid())
+            raise("std::future: the future has no shared state!");
+
+        PyObject *loop = nullptr;
+        object future = steal(async_future_new(&loop));
+
+        task *t = new task{ std::move(value), loop, future.inc_ref().ptr() };
+        try {
+            async_submit(task::run, t);
+        } catch (...) {
+            future.dec_ref();
+            Py_DECREF(loop);
+            delete t;
+            throw;
+        }
+
+        return future.release();
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
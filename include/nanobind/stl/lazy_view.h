@@ -0,0 +1,179 @@
+/*
+    nanobind/stl/lazy_view.h: Read-only views of STL containers that convert
+    elements on demand
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <nanobind/make_iterator.h>
+#include <nanobind/stl/detail/traits.h>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+
+/**
+ * Non-owning reference to a C++ container. When returned from a bound
+ * function, it is exposed as a read-only ``Sequence``, ``Mapping``, or set
+ * that converts elements only when they are accessed, and which keeps the
+ * first function argument (i.e., ``self`` for methods) alive.
+ */
+template <typename T> class lazy_view {
+public:
+    using container_type = T;
+
+    lazy_view(const T &value) : m_value(&value) { }
+
+    const T &operator*() const { return *m_value; }
+    const T *operator->() const { return m_value; }
+
+private:
+    const T *m_value;
+};
+
+NAMESPACE_BEGIN(detail)
+
+template <typename T, typename SFINAE = int>
+struct has_mapped_type : std::false_type { };
+template <typename T>
+struct has_mapped_type<T, enable_if_t<sizeof(typename T::mapped_type) != 0>>
+    : std::true_type { };
+
+template <typename T, typename SFINAE = int>
+struct has_key_type : std::false_type { };
+template <typename T>
+struct has_key_type<T, enable_if_t<sizeof(typename T::key_type) != 0>>
+    : std::true_type { };
+
+template <typename T> struct lazy_view_kind {
+    static constexpr bool is_map = has_mapped_type<T>::value;
+    static constexpr bool is_set = has_key_type<T>::value && !is_map;
+};
+
+template <typename T> void lazy_view_bind() {
+    using View = lazy_view<T>;
+    using Kind = lazy_view_kind<T>;
+
+    if (type<View>().is_valid())
+        return;
+
+    const char *name = Kind::is_map   ? "LazyMappingView"
+                       : Kind::is_set ? "LazySetView"
+                                      : "LazySequenceView";
+
+    class_<View> cl(handle(), name, inline_keep_alive());
+
+    cl.def("__len__", [](const View &v) { return v->size(); })
+      .def("__bool__", [](const View &v) { return !v->empty(); });
+
+    if constexpr (Kind::is_map) {
+        using Key = typename T::key_type;
+        using Value = typename T::mapped_type;
+
+        cl.def("__getitem__",
+               [](const View &v, const Key &k) -> const Value & {
+                   auto it = v->find(k);
+                   if (it == v->end())
+                       throw key_error();
+                   return it->second;
+               },
+               rv_policy::reference_internal)
+          .def("__contains__",
+               [](const View &v, const Key &k) { return v->find(k) != v->end(); })
+          .def("__contains__", [](const View &, handle) { return false; })
+          .def("__iter__",
+               [](const View &v) {
+                   return make_key_iterator(type<View>(), "KeyIterator",
+                                            v->begin(), v->end());
+               },
+               nanobind::keep_alive<0, 1>());
+    } else {
+        using Value = typename T::value_type;
+
+        if constexpr (Kind::is_set) {
+            cl.def("__contains__",
+                   [](const View &v, const Value &k) { return v->find(k) != v->end(); });
+        } else {
+            cl.def("__getitem__",
+                   [](const View &v, Py_ssize_t i) -> typename T::const_reference {
+                       Py_ssize_t n = (Py_ssize_t) v->size();
+                       if (i < 0)
+                           i += n;
+                       if (i < 0 || i >= n)
+                           throw index_error();
+                       return (*v)[(size_t) i];
+                   },
+                   rv_policy::reference_internal);
+
+            if constexpr (is_equality_comparable_v<Value>) {
+                cl.def("__contains__", [](const View &v, const Value &x) {
+                    for (const auto &y : *v) {
+                        if (x == y)
+                            return true;
+                    }
+                    return false;
+                });
+            }
+        }
+
+        if constexpr (Kind::is_set || is_equality_comparable_v<Value>)
+            cl.def("__contains__", [](const View &, handle) { return false; });
+
+        cl.def("__iter__",
+               [](const View &v) {
+                   return make_iterator(type<View>(), "Iterator",
+                                        v->begin(), v->end());
+               },
+               nanobind::keep_alive<0, 1>());
+    }
+}
+
+template <typename T> struct type_caster<lazy_view<T>> : type_caster_base<lazy_view<T>> {
+    using View = lazy_view<T>;
+    using Kind = lazy_view_kind<T>;
+
+    static constexpr auto Name = [] {
+        if constexpr (Kind::is_map)
+            return const_name("Mapping[") +
+                   make_caster<typename T::key_type>::Name + const_name(", ") +
+                   make_caster<typename T::mapped_type>::Name + const_name("]");
+        else
+            return const_name<Kind::is_set>("AbstractSet[", "Sequence[") +
+                   make_caster<typename T::value_type>::Name + const_name("]");
+    }();
+
+    template <typename T_>
+    static handle from_cpp(T_ &&value, rv_policy, cleanup_list *cleanup) noexcept {
+        const View *ptr;
+        if constexpr (is_pointer_v<T_>)
+            ptr = (const View *) value;
+        else
+            ptr = (const View *) &value;
+
+        // The view refers to memory owned by 'self', which is kept alive below
+        if (!ptr || !cleanup || !cleanup->self())
+            return handle();
+
+        try {
+            lazy_view_bind<T>();
+            object result = steal(nb_type_put(&typeid(View), (void *) ptr,
+                                              rv_policy::copy, cleanup));
+            if (result.is_valid())
+                keep_alive(result.ptr(), cleanup->self());
+            return result.release();
+        } catch (python_error &e) {
+            e.restore();
+        } catch (...) {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "nanobind::lazy_view: could not create the view!");
+        }
+        return handle();
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
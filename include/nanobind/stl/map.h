@@ -19,5 +19,32 @@ template <typename Key, typename T, typename Compare, typename Alloc>
 struct type_caster<std::map<Key, T, Compare, Alloc>>
  : dict_caster<std::map<Key, T, Compare, Alloc>, Key, T> { };
 
+/// Explicit instantiation (declaration) of the std::map<Key, T> caster
+#define NB_MAP_CASTER_INST(prefix, Key, T)                                     \
+    prefix template NB_CORE bool                                               \
+    dict_caster<std::map<Key, T>, Key, T>::from_python(                        \
+        handle, uint8_t, cleanup_list *) noexcept;                             \
+    prefix template NB_CORE handle                                             \
+    dict_caster<std::map<Key, T>, Key, T>::from_cpp(                           \
+        std::map<Key, T> &&, rv_policy, cleanup_list *);                       \
+    prefix template NB_CORE handle                                             \
+    dict_caster<std::map<Key, T>, Key, T>::from_cpp(                           \
+        std::map<Key, T> &, rv_policy, cleanup_list *);                        \
+    prefix template NB_CORE handle                                             \
+    dict_caster<std::map<Key, T>, Key, T>::from_cpp(                           \
+        const std::map<Key, T> &, rv_policy, cleanup_list *);
+
+/// Instances of the above that are compiled into libnanobind
+#define NB_MAP_STRING_CASTER_INST(prefix)                                      \
+    NB_MAP_CASTER_INST(prefix, std::string, int)                               \
+    NB_MAP_CASTER_INST(prefix, std::string, int64_t)                           \
+    NB_MAP_CASTER_INST(prefix, std::string, double)                            \
+    NB_MAP_CASTER_INST(prefix, std::string, std::string)
+
+// See stl/vector.h. All of these have std::string keys.
+#if !defined(NB_NO_EXTERN_CASTERS) && defined(NB_STL_STRING_CASTER)
+NB_MAP_STRING_CASTER_INST(extern)
+#endif
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
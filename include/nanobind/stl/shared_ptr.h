@@ -21,8 +21,7 @@ struct py_deleter {
         // Don't run the deleter if the interpreter has been shut down
         if (!Py_IsInitialized())
             return;
-        gil_scoped_acquire guard;
-        Py_DECREF(o);
+        decref_deferred(o);
     }
 
     PyObject *o;
@@ -51,6 +50,42 @@ shared_from_python(T *ptr, handle h) noexcept {
         return std::shared_ptr<T>(nullptr);
 }
 
+inline void shared_cache_free(void *p) noexcept {
+    delete (std::weak_ptr<void> *) p;
+}
+
+/**
+ * Like shared_from_python(), but reuse the shared_ptr of an earlier call for
+ * the same instance while any copy of it is still alive. The instance stores
+ * a std::weak_ptr to it, which does not keep the instance itself alive.
+ * Conversions that return the same object repeatedly therefore share one
+ * control block instead of allocating a new one each time.
+ */
+inline NB_NOINLINE std::shared_ptr<void>
+shared_from_python_cached(void *ptr, handle h) noexcept {
+#if !defined(NB_FREE_THREADED)
+    if (ptr && nb_type_check((PyObject *) Py_TYPE(h.ptr())) &&
+        nb_inst_ptr(h.ptr()) == ptr) {
+        std::weak_ptr<void> *cache = (std::weak_ptr<void> *)
+            keep_alive_payload(h.ptr(), shared_cache_free);
+
+        if (cache) {
+            if (std::shared_ptr<void> sp = cache->lock())
+                return sp;
+        }
+
+        std::shared_ptr<void> sp = shared_from_python(ptr, h);
+        if (cache)
+            *cache = sp;
+        else
+            keep_alive(h.ptr(), new std::weak_ptr<void>(sp), shared_cache_free);
+        return sp;
+    }
+#endif
+
+    return shared_from_python(ptr, h);
+}
+
 inline NB_NOINLINE void shared_from_cpp(std::shared_ptr<void> &&ptr,
                                         PyObject *o) noexcept {
     keep_alive(o, new std::shared_ptr<void>(std::move(ptr)),
@@ -93,7 +128,7 @@ template <typename T> struct type_caster<std::shared_ptr<T>> {
             value = shared_from_python(ptr, src);
         } else {
             value = std::static_pointer_cast<T>(
-                shared_from_python(static_cast<void *>(ptr), src));
+                shared_from_python_cached(static_cast<void *>(ptr), src));
         }
         return true;
     }
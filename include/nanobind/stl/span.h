@@ -0,0 +1,145 @@
+/*
+    nanobind/stl/span.h: type caster for std::span<T> (C++20) that references
+    the contents of contiguous arrays without a copy
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+#include <span>
+
+#if !defined(__cpp_lib_span)
+#  error "nanobind/stl/span.h requires C++20"
+#endif
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * Spans of arithmetic values reference the contents of one-dimensional
+ * C-contiguous CPU arrays of the same dtype (buffer protocol or DLPack). Spans
+ * of const values also accept other arrays when implicit conversions are
+ * permitted, along with Python sequences, whose elements are converted into
+ * scratch memory of the cleanup list. Either storage remains valid until the
+ * bound function returns. Writes through spans of non-const values are
+ * visible to the caller, hence they only accept writable arrays as is.
+ */
+template <typename T, size_t Extent>
+struct is_view_value<std::span<T, Extent>> : std::true_type { };
+
+template <typename T, size_t Extent> struct type_caster<std::span<T, Extent>> {
+    using Value = std::span<T, Extent>;
+    using Scalar = std::remove_const_t<T>;
+
+    static_assert(std::is_arithmetic_v<Scalar>,
+                  "nanobind::detail::type_caster<std::span<T>>: only spans of "
+                  "arithmetic types are supported!");
+
+    static constexpr bool IsConst = std::is_const_v<T>;
+    static constexpr bool IsDynamic = Extent == std::dynamic_extent;
+    static constexpr bool IsClass = false;
+
+    static constexpr auto Name =
+        const_name("ndarray[") + ndarray_arg<Scalar>::name +
+        const_name(", shape=(") +
+        const_name<IsDynamic>(const_name("*"), const_name<Extent>()) +
+        const_name("), order='C', device='cpu']") +
+        const_name<IsConst>(const_name(" | Sequence[") +
+                                make_caster<Scalar>::Name + const_name("]"),
+                            const_name(""));
+
+    /// The span is constructed on the fly (fixed-extent spans lack a default state)
+    template <typename T_> using Cast = Value;
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        bool convert = flags & (uint8_t) cast_flags::convert;
+
+        size_t shape[1] = { IsDynamic ? any : Extent };
+        ndarray_req req;
+        ndarray_arg<Scalar>::apply(req);
+        req.ndim = 1;
+        req.shape = shape;
+        req.req_shape = true;
+        req.req_order = 'C';
+        req.req_device = (uint8_t) device::cpu::value;
+        req.readonly = IsConst;
+
+        // Converted copies would not reflect writes, hence only for const spans
+        ndarray_handle *h = ndarray_import(src.ptr(), &req, convert && IsConst);
+        if (h) {
+            array = ndarray<>(h);
+            data = (T *) array.data();
+            size = array.shape(0);
+            return true;
+        }
+
+        if constexpr (IsConst) {
+            PyObject *temp;
+            size_t n;
+            PyObject **o = cleanup ? seq_get(src.ptr(), &n, &temp) : nullptr;
+            if (!o)
+                return false;
+
+            Scalar *buf = nullptr;
+            if (IsDynamic || n == Extent)
+                buf = (Scalar *) cleanup->alloc((n ? n : 1) * sizeof(Scalar));
+
+            make_caster<Scalar> caster;
+            bool success = buf != nullptr;
+
+            for (size_t i = 0; success && i < n; ++i) {
+                success = caster.from_python(o[i], flags, cleanup);
+                if (success)
+                    buf[i] = caster.operator cast_t<Scalar>();
+            }
+
+            Py_XDECREF(temp);
+
+            if (success) {
+                data = buf;
+                size = n;
+            }
+
+            return success;
+        } else {
+            (void) cleanup;
+            return false;
+        }
+    }
+
+    explicit operator Value() { return Value(data, size); }
+
+    template <typename T_>
+    static handle from_cpp(T_ &&src, rv_policy policy, cleanup_list *cleanup) {
+        object ret = steal(PyList_New((Py_ssize_t) src.size()));
+
+        if (ret.is_valid()) {
+            Py_ssize_t index = 0;
+
+            for (const Scalar &value : src) {
+                handle h = make_caster<Scalar>::from_cpp(value, policy, cleanup);
+
+                if (!h.is_valid()) {
+                    ret.reset();
+                    break;
+                }
+
+                NB_LIST_SET_ITEM(ret.ptr(), index++, h.ptr());
+            }
+        }
+
+        return ret.release();
+    }
+
+    ndarray<> array;
+    T *data = nullptr;
+    size_t size = 0;
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -31,9 +31,22 @@ template <> struct type_caster<std::string> {
 
     static handle from_cpp(const std::string &value, rv_policy,
                            cleanup_list *) noexcept {
-        return PyUnicode_FromStringAndSize(value.c_str(), value.size());
+        return str_from_cpp(value.c_str(), value.size());
     }
 };
 
+// Declare the prebuilt std::string casters of stl/vector.h and stl/map.h if
+// they were included first (otherwise, they do so themselves)
+#define NB_STL_STRING_CASTER
+
+#if !defined(NB_NO_EXTERN_CASTERS)
+#  if defined(NB_VECTOR_CASTER_INST)
+NB_VECTOR_CASTER_INST(extern, std::string)
+#  endif
+#  if defined(NB_MAP_STRING_CASTER_INST)
+NB_MAP_STRING_CASTER_INST(extern)
+#  endif
+#endif
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
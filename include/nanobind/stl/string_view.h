@@ -15,15 +15,22 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
+template <> struct is_view_value<std::string_view> : std::true_type { };
+
 template <> struct type_caster<std::string_view> {
     NB_TYPE_CASTER(std::string_view, const_name("str"));
 
-    bool from_python(handle src, uint8_t, cleanup_list *) noexcept {
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
         Py_ssize_t size;
         const char *str = PyUnicode_AsUTF8AndSize(src.ptr(), &size);
         if (!str) {
             PyErr_Clear();
-            return false;
+            if (!(flags & (uint8_t) cast_flags::convert))
+                return false;
+            // Reference the contents of bytes-like objects without a copy
+            str = bytes_view(src.ptr(), &size, cleanup);
+            if (!str)
+                return false;
         }
         value = std::string_view(str, (size_t) size);
         return true;
@@ -31,7 +38,7 @@ template <> struct type_caster<std::string_view> {
 
     static handle from_cpp(std::string_view value, rv_policy,
                            cleanup_list *) noexcept {
-        return PyUnicode_FromStringAndSize(value.data(), value.size());
+        return str_from_cpp(value.data(), value.size());
     }
 };
 
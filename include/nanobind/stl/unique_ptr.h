@@ -31,8 +31,7 @@ template <typename T> struct deleter {
     /// Perform the requested deletion operation
     void operator()(void *p) noexcept {
         if (o) {
-            gil_scoped_acquire guard;
-            Py_DECREF(o);
+            detail::decref_deferred(o);
         } else {
             delete (T *) p;
         }
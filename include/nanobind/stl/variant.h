@@ -10,6 +10,8 @@
 #pragma once
 
 #include <nanobind/nanobind.h>
+#include <string>
+#include <string_view>
 #include <variant>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
@@ -65,6 +67,71 @@ class type_caster<std::variant<Ts...>> {
         return true;
     }
 
+    static constexpr size_t N = sizeof...(Ts);
+
+    /// Builtin Python type that exactly corresponds to 'T' (0: none, 1: int, 2: float, 3: str, 4: bool)
+    template <typename T> static constexpr int builtin_kind() {
+        if constexpr (std::is_same_v<T, bool>)
+            return 4;
+        else if constexpr (std::is_floating_point_v<T>)
+            return 2;
+        else if constexpr (std::is_integral_v<T> && !is_std_char_v<T>)
+            return 1;
+        else if constexpr (std::is_same_v<T, std::string> ||
+                           std::is_same_v<T, std::string_view> ||
+                           std::is_same_v<T, str>)
+            return 3;
+        else
+            return 0;
+    }
+
+    static constexpr size_t first_of(int kind) {
+        constexpr int kinds[] = { builtin_kind<intrinsic_t<Ts>>()... };
+        for (size_t i = 0; i < N; ++i) {
+            if (kinds[i] == kind)
+                return i;
+        }
+        return N;
+    }
+
+    template <typename T> static const std::type_info *class_type() noexcept {
+        if constexpr (Caster<T>::IsClass)
+            return &typeid(intrinsic_t<T>);
+        else
+            return nullptr;
+    }
+
+    /// Alternative whose caster should be tried first for an object of type 'tp'
+    static size_t dispatch_index(PyTypeObject *tp) noexcept {
+        size_t index = N;
+        if (tp == &PyLong_Type)
+            index = first_of(1);
+        else if (tp == &PyFloat_Type)
+            index = first_of(2);
+        else if (tp == &PyUnicode_Type)
+            index = first_of(3);
+        else if (tp == &PyBool_Type)
+            index = first_of(4);
+
+        if (index != N)
+            return index;
+
+        if constexpr ((Caster<Ts>::IsClass || ...)) {
+            // Compare C++ types, since each interpreter has its own bound types
+            if (nb_type_check((PyObject *) tp)) {
+                static const std::type_info *types[N] = { class_type<Ts>()... };
+                const std::type_info *type = nb_type_info((PyObject *) tp);
+
+                for (size_t i = 0; i < N; ++i) {
+                    if (types[i] && *types[i] == *type)
+                        return i;
+                }
+            }
+        }
+
+        return N;
+    }
+
 public:
     using Value = std::variant<Ts...>;
 
@@ -76,6 +143,18 @@ public:
     Value value;
 
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        using caster_fn = bool (type_caster::*)(const handle &, uint8_t, cleanup_list *);
+        static constexpr caster_fn casters[] = { &type_caster::variadic_caster<Ts>... };
+
+        // A failing alternative must not drain a single-pass input
+        if constexpr (N > 1)
+            flags &= (uint8_t) ~(uint8_t) cast_flags::consume;
+
+        // Exact builtin or bound types select their alternative directly
+        size_t index = dispatch_index(Py_TYPE(src.ptr()));
+        if (index != N && (this->*casters[index])(src, flags, cleanup))
+            return true;
+
         return (variadic_caster<Ts>(src, flags, cleanup) || ...);
     }
 
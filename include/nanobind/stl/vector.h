@@ -18,5 +18,33 @@ NAMESPACE_BEGIN(detail)
 template <typename Type, typename Alloc> struct type_caster<std::vector<Type, Alloc>>
  : list_caster<std::vector<Type, Alloc>, Type> { };
 
+/// Explicit instantiation (declaration) of the std::vector<T> caster
+#define NB_VECTOR_CASTER_INST(prefix, T)                                       \
+    prefix template NB_CORE bool list_caster<std::vector<T>, T>::from_python(  \
+        handle, uint8_t, cleanup_list *) noexcept;                             \
+    prefix template NB_CORE bool list_caster<std::vector<T>, T>::from_iter(    \
+        PyObject *, size_t, uint8_t, cleanup_list *) noexcept;                 \
+    prefix template NB_CORE handle list_caster<std::vector<T>, T>::from_cpp(   \
+        std::vector<T> &&, rv_policy, cleanup_list *);                         \
+    prefix template NB_CORE handle list_caster<std::vector<T>, T>::from_cpp(   \
+        std::vector<T> &, rv_policy, cleanup_list *);                          \
+    prefix template NB_CORE handle list_caster<std::vector<T>, T>::from_cpp(   \
+        const std::vector<T> &, rv_policy, cleanup_list *);
+
+/* Casters of common element types are compiled once into libnanobind
+   (src/nb_casters.cpp). Define NB_NO_EXTERN_CASTERS when building against a
+   nanobind library that doesn't provide them. Declaring the std::string
+   variant requires the caster of stl/string.h, which this header doesn't
+   include. Whichever of the two headers is included last declares it. */
+#if !defined(NB_NO_EXTERN_CASTERS)
+NB_VECTOR_CASTER_INST(extern, int)
+NB_VECTOR_CASTER_INST(extern, int64_t)
+NB_VECTOR_CASTER_INST(extern, float)
+NB_VECTOR_CASTER_INST(extern, double)
+#  if defined(NB_STL_STRING_CASTER)
+NB_VECTOR_CASTER_INST(extern, std::string)
+#  endif
+#endif
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
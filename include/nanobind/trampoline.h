@@ -15,26 +15,58 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
-NB_CORE void trampoline_new(void **data, size_t size, void *ptr) noexcept;
-NB_CORE void trampoline_release(void **data, size_t size) noexcept;
+NB_CORE PyObject *trampoline_new(void *ptr) noexcept;
 
-NB_CORE PyObject *trampoline_lookup(void **data, size_t size, const char *name,
+NB_CORE PyObject *trampoline_lookup(PyObject *self, const char *name,
                                     bool pure);
 
-template <size_t Size> struct trampoline {
-    mutable void *data[2 * Size + 1];
-
-    NB_INLINE trampoline(void *ptr) {
-        trampoline_new(data, Size, ptr);
+/**
+ * Call the override 'key' of the method 'name' returned by trampoline_lookup().
+ * The converted arguments are stored starting at 'args[2]', and the function
+ * places 'self' in 'args[1]'.
+ */
+NB_CORE PyObject *trampoline_vectorcall(PyObject *self, const char *name,
+                                        PyObject *key, PyObject **args,
+                                        size_t nargs);
+
+/// Pending call of an override, see NB_OVERRIDE_NAME()
+struct trampoline_call {
+    PyObject *self;
+    const char *name;
+    PyObject *key;
+
+    template <typename... Args> object operator()(Args &&...args_) const {
+        PyObject *args[sizeof...(Args) + 2];
+        size_t nargs = 0;
+
+        ((args[2 + nargs++] =
+              make_caster<Args>::from_cpp((forward_t<Args>) args_,
+                                          rv_policy::automatic_reference,
+                                          nullptr).ptr()),
+         ...);
+
+        return steal(trampoline_vectorcall(self, name, key, args, nargs));
     }
+};
 
-    NB_INLINE ~trampoline() { trampoline_release(data, Size); }
+/**
+ * Overrides are cached per Python type (see src/trampoline.cpp), hence the
+ * 'Size' parameter is no longer needed. It is kept for compatibility.
+ */
+template <size_t Size> struct trampoline {
+    PyObject *self;
+
+    NB_INLINE trampoline(void *ptr) : self(trampoline_new(ptr)) { }
 
     NB_INLINE handle lookup(const char *name, bool pure) const {
-        return trampoline_lookup(data, Size, name, pure);
+        return trampoline_lookup(self, name, pure);
     }
 
-    NB_INLINE handle base() const { return (PyObject *) data[0]; }
+    NB_INLINE handle base() const { return self; }
+
+    NB_INLINE trampoline_call call(const char *name, handle key) const {
+        return { self, name, key.ptr() };
+    }
 };
 
 #define NB_TRAMPOLINE(base, size)                                              \
@@ -43,21 +75,23 @@ template <size_t Size> struct trampoline {
     nanobind::detail::trampoline<size> nb_trampoline{ this }
 
 #define NB_OVERRIDE_NAME(name, func, ...)                                      \
-    nanobind::handle nb_key = nb_trampoline.lookup(name, false);               \
+    const char *nb_name = name;                                                \
+    nanobind::handle nb_key = nb_trampoline.lookup(nb_name, false);            \
     using nb_ret_type = decltype(NBBase::func(__VA_ARGS__));                   \
     if (nb_key.is_valid()) {                                                   \
         nanobind::gil_scoped_acquire nb_guard;                                 \
         return nanobind::cast<nb_ret_type>(                                    \
-            nb_trampoline.base().attr(nb_key)(__VA_ARGS__));                   \
+            nb_trampoline.call(nb_name, nb_key)(__VA_ARGS__));                 \
     } else                                                                     \
         return NBBase::func(__VA_ARGS__)
 
 #define NB_OVERRIDE_PURE_NAME(name, func, ...)                                 \
-    nanobind::handle nb_key = nb_trampoline.lookup(name, true);                \
+    const char *nb_name = name;                                                \
+    nanobind::handle nb_key = nb_trampoline.lookup(nb_name, true);             \
     using nb_ret_type = decltype(NBBase::func(__VA_ARGS__));                   \
     nanobind::gil_scoped_acquire nb_guard;                                     \
     return nanobind::cast<nb_ret_type>(                                        \
-        nb_trampoline.base().attr(nb_key)(__VA_ARGS__))
+        nb_trampoline.call(nb_name, nb_key)(__VA_ARGS__))
 
 #define NB_OVERRIDE(func, ...)                                                 \
     NB_OVERRIDE_NAME(#func, func, __VA_ARGS__)
@@ -0,0 +1,282 @@
+/*
+    nanobind/vectorize.h: elementwise application of scalar C++ functions
+    to n-dimensional arrays with NumPy-style broadcasting
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+#include <exception>
+#include <thread>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Argument of a vectorized function: either a scalar or a CPU ndarray
+template <typename T> struct vectorize_arg {
+    ndarray<T, device::cpu> array;
+    T value{};
+};
+
+template <typename T> struct type_caster<vectorize_arg<T>> {
+    NB_TYPE_CASTER(vectorize_arg<T>, make_caster<T>::Name + const_name(" | ndarray[") +
+                                        ndarray_arg<T>::name + const_name("]"))
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        PyObject *o = src.ptr();
+        make_caster<T> caster;
+
+        // Fast path for builtin Python scalars
+        if (PyFloat_CheckExact(o) || PyLong_CheckExact(o) || PyBool_Check(o)) {
+            if (!caster.from_python(src, flags, cleanup))
+                return false;
+            value.value = caster.operator cast_t<T>();
+            return true;
+        }
+
+        ndarray_req req;
+        ndarray_arg<T>::apply(req);
+        req.req_device = (uint8_t) device::cpu::value;
+
+        ndarray_handle *h =
+            ndarray_import(o, &req, flags & (uint8_t) cast_flags::convert);
+        if (h) {
+            value.array = ndarray<T, device::cpu>(h);
+            return true;
+        }
+
+        // Other scalar types (e.g. with an __index__ or __float__ method)
+        if (!caster.from_python(src, flags, cleanup))
+            return false;
+        value.value = caster.operator cast_t<T>();
+        return true;
+    }
+
+    static handle from_cpp(const vectorize_arg<T> &, rv_policy,
+                           cleanup_list *) noexcept {
+        return handle();
+    }
+};
+
+/// Number of output elements per thread below which no threads are spawned
+constexpr size_t vectorize_block_size = 1 << 16;
+
+template <typename Func, typename Return, typename... Args> struct vectorize_helper {
+    static_assert(sizeof...(Args) > 0 && std::is_arithmetic_v<Return> &&
+                      (std::is_arithmetic_v<Args> && ...),
+                  "nb::vectorize(): the function must map arithmetic arguments "
+                  "to an arithmetic return value!");
+
+    static constexpr size_t N = sizeof...(Args);
+
+    Func func;
+    size_t threads;
+
+    object operator()(vectorize_arg<Args>... args) const {
+        return call(std::make_index_sequence<N>(), args...);
+    }
+
+private:
+    template <size_t... Is>
+    object call(std::index_sequence<Is...>, vectorize_arg<Args> &...args) const {
+        const bool is_array[N] = { args.array.is_valid()... };
+        const size_t ndims[N] = { args.array.ndim()... };
+
+        bool any_array = false;
+        size_t ndim = 0;
+        for (size_t k = 0; k < N; ++k) {
+            any_array |= is_array[k];
+            ndim = std::max(ndim, ndims[k]);
+        }
+
+        if (!any_array)
+            return cast(func(args.value...));
+
+        // Compute the broadcast output shape
+        std::vector<size_t> shape(ndim, 1);
+        (broadcast_shape(args, shape), ...);
+
+        size_t size = 1;
+        for (size_t s : shape)
+            size *= s;
+
+        // Per-argument strides (in elements) with respect to the output shape
+        std::vector<int64_t> strides(N * ndim, 0);
+        (broadcast_strides(args, shape, strides.data() + Is * ndim), ...);
+
+        const void *data[N] = {
+            (args.array.is_valid() ? (const void *) args.array.data()
+                                   : (const void *) &args.value)...
+        };
+
+        Return *out = new Return[size > 0 ? size : 1];
+        capsule owner(out, [](void *p) noexcept { delete[] (Return *) p; });
+
+        {
+            gil_scoped_release guard;
+
+            size_t nthreads = std::max(threads, (size_t) 1);
+            nthreads = std::min(nthreads, size / vectorize_block_size + 1);
+
+            if (nthreads == 1) {
+                run<Is...>(out, data, shape, strides, 0, size);
+            } else {
+                std::vector<std::thread> workers;
+                std::vector<std::exception_ptr> errors(nthreads);
+                size_t block = (size + nthreads - 1) / nthreads;
+
+                auto task = [&](size_t i) {
+                    try {
+                        run<Is...>(out, data, shape, strides, i * block,
+                                   std::min(size, (i + 1) * block));
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                };
+
+                workers.reserve(nthreads - 1);
+                for (size_t i = 1; i < nthreads; ++i)
+                    workers.emplace_back(task, i);
+                task(0);
+                for (std::thread &w : workers)
+                    w.join();
+
+                for (std::exception_ptr &e : errors) {
+                    if (e)
+                        std::rethrow_exception(e);
+                }
+            }
+        }
+
+        if (ndim == 0)
+            return cast(out[0]);
+
+        return cast(ndarray<numpy, Return>(out, ndim, shape.data(), owner),
+                    rv_policy::reference);
+    }
+
+    template <typename T>
+    static void broadcast_shape(const vectorize_arg<T> &arg,
+                                std::vector<size_t> &shape) {
+        if (!arg.array.is_valid())
+            return;
+
+        size_t ndim = shape.size(), offset = ndim - arg.array.ndim();
+        for (size_t i = 0; i < arg.array.ndim(); ++i) {
+            size_t s = arg.array.shape(i), &o = shape[offset + i];
+            if (o == 1)
+                o = s;
+            else if (s != 1 && s != o)
+                throw value_error("nb::vectorize(): operands could not be "
+                                  "broadcast together!");
+        }
+    }
+
+    template <typename T>
+    static void broadcast_strides(const vectorize_arg<T> &arg,
+                                  const std::vector<size_t> &shape,
+                                  int64_t *strides) {
+        if (!arg.array.is_valid())
+            return;
+
+        size_t offset = shape.size() - arg.array.ndim();
+        for (size_t i = 0; i < arg.array.ndim(); ++i) {
+            if (arg.array.shape(i) != 1)
+                strides[offset + i] = arg.array.stride(i);
+        }
+    }
+
+    /// Evaluate the output elements [start, end) in C order
+    template <size_t... Is>
+    void run(Return *out, const void **data, const std::vector<size_t> &shape,
+             const std::vector<int64_t> &strides, size_t start,
+             size_t end) const {
+        if (start >= end)
+            return;
+
+        size_t ndim = shape.size(),
+               inner = ndim ? shape[ndim - 1] : 1;
+
+        int64_t inner_stride[N];
+        bool contiguous = true;
+        for (size_t k = 0; k < N; ++k) {
+            inner_stride[k] = ndim ? strides[k * ndim + ndim - 1] : 0;
+            contiguous &= inner_stride[k] == 1;
+        }
+
+        // Multi-index of the current row (all but the last dimension)
+        std::vector<size_t> index(ndim ? ndim - 1 : 0, 0);
+        size_t row = start / inner, col = start % inner;
+        for (size_t i = index.size(); i-- > 0; ) {
+            index[i] = row % shape[i];
+            row /= shape[i];
+        }
+
+        size_t pos = start;
+        while (pos < end) {
+            int64_t offset[N] = { };
+            for (size_t k = 0; k < N; ++k) {
+                for (size_t i = 0; i < index.size(); ++i)
+                    offset[k] += (int64_t) index[i] * strides[k * ndim + i];
+            }
+
+            size_t count = std::min(inner - col, end - pos);
+            Return *o = out + pos;
+
+            if (contiguous) {
+                for (size_t j = col; j < col + count; ++j)
+                    *o++ = func(((const Args *) data[Is])[offset[Is] + (int64_t) j]...);
+            } else {
+                for (size_t j = col; j < col + count; ++j)
+                    *o++ = func(((const Args *) data[Is])[offset[Is] +
+                                                          (int64_t) j * inner_stride[Is]]...);
+            }
+
+            pos += count;
+            col = 0;
+
+            for (size_t i = index.size(); i-- > 0; ) {
+                if (++index[i] < shape[i])
+                    break;
+                index[i] = 0;
+            }
+        }
+    }
+};
+
+template <typename Func, typename Return, typename... Args>
+auto vectorize_make(Func &&f, size_t threads, Return (*)(Args...)) {
+    return vectorize_helper<std::decay_t<Func>, std::decay_t<Return>,
+                            std::decay_t<Args>...>{ (forward_t<Func>) f,
+                                                    threads };
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * Wrap a scalar C++ function (e.g. ``double f(double, double)``) so that it
+ * accepts scalars or ndarrays for each argument. Array arguments are broadcast
+ * against each other following the NumPy conventions, and the function is
+ * evaluated elementwise with the GIL released, optionally using several
+ * threads. Returns a NumPy array, or a scalar if all arguments were scalars.
+ */
+template <typename Return, typename... Args>
+auto vectorize(Return (*f)(Args...), size_t threads = 1) {
+    return detail::vectorize_make(f, threads, (Return (*)(Args...)) nullptr);
+}
+
+template <typename Func,
+          detail::enable_if_t<detail::is_lambda_v<std::remove_reference_t<Func>>> = 0>
+auto vectorize(Func &&f, size_t threads = 1) {
+    using am = detail::analyze_method<decltype(&std::remove_reference_t<Func>::operator())>;
+    return detail::vectorize_make((detail::forward_t<Func>) f, threads,
+                                  (typename am::func *) nullptr);
+}
+
+NAMESPACE_END(NB_NAMESPACE)
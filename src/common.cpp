@@ -8,6 +8,8 @@
 */
 
 #include <nanobind/nanobind.h>
+#include <string_view>
+#include <vector>
 #include "nb_internals.h"
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
@@ -91,23 +93,118 @@ void raise_cast_error() {
 
 // ========================================================================
 
+/* Per-thread bump allocator backing cleanup_list. Cleanup lists are nested
+   like the calls that create them, hence each one can rewind the arena to its
+   position before the first allocation. Chunks are retained for later calls,
+   so that function dispatch doesn't use the heap in the steady state. */
+struct alignas(16) scratch_chunk {
+    scratch_chunk *next;
+    size_t size, used;
+};
+
+struct scratch_arena {
+    scratch_chunk *head = nullptr, *cur = nullptr;
+
+    ~scratch_arena() {
+        while (head) {
+            scratch_chunk *next = head->next;
+            free(head);
+            head = next;
+        }
+    }
+};
+
+static constexpr size_t scratch_chunk_size = 4096;
+static thread_local scratch_arena scratch;
+
+void *scratch_alloc(size_t size) noexcept {
+    scratch_arena &a = scratch;
+    size = (size + 15) & ~(size_t) 15;
+
+    scratch_chunk *c = a.cur, *last = nullptr;
+    if (!c && (c = a.head))
+        c->used = 0;
+
+    // Chunks following the current one are unused
+    while (c && c->used + size > c->size) {
+        last = c;
+        if ((c = c->next))
+            c->used = 0;
+    }
+
+    if (!c) {
+        size_t chunk_size = last ? 2 * last->size : scratch_chunk_size;
+        if (chunk_size < size)
+            chunk_size = size;
+        c = (scratch_chunk *) malloc(sizeof(scratch_chunk) + chunk_size);
+        if (!c)
+            return nullptr;
+        c->next = nullptr;
+        c->size = chunk_size;
+        c->used = 0;
+        if (last)
+            last->next = c;
+        else
+            a.head = c;
+    }
+
+    a.cur = c;
+    void *p = (uint8_t *) (c + 1) + c->used;
+    c->used += size;
+    return p;
+}
+
+void scratch_mark(void **chunk, size_t *used) noexcept {
+    scratch_chunk *c = scratch.cur;
+    *chunk = c;
+    *used = c ? c->used : 0;
+}
+
+void scratch_rewind(void *chunk, size_t used) noexcept {
+    scratch_chunk *c = (scratch_chunk *) chunk;
+    scratch.cur = c;
+    if (c)
+        c->used = used;
+}
+
+void *cleanup_list::alloc(size_t size) noexcept {
+    if (m_arena_used == (size_t) -1)
+        scratch_mark(&m_arena_chunk, &m_arena_used);
+    return scratch_alloc(size);
+}
+
+void cleanup_list::rewind() noexcept {
+    if (m_arena_used != (size_t) -1) {
+        scratch_rewind(m_arena_chunk, m_arena_used);
+        m_arena_used = (size_t) -1;
+    }
+}
+
 void cleanup_list::release() noexcept {
     /* Don't decrease the reference count of the first
        element, it stores the 'self' element. */
     for (size_t i = 1; i < m_size; ++i)
         Py_DECREF(m_data[i]);
-    if (m_capacity != Small)
-        free(m_data);
+    rewind();
     m_data = nullptr;
 }
 
+void cleanup_list::reset() noexcept {
+    for (size_t i = 1; i < m_size; ++i)
+        Py_DECREF(m_data[i]);
+    m_size = 1;
+
+    // The first element is also stored in 'm_local[0]'
+    m_data = m_local;
+    m_capacity = Small;
+    rewind();
+}
+
 void cleanup_list::expand() noexcept {
     uint32_t new_capacity = m_capacity * 2;
-    PyObject **new_data = (PyObject **) malloc(new_capacity * sizeof(PyObject *));
+    PyObject **new_data = (PyObject **) alloc(new_capacity * sizeof(PyObject *));
     check(new_data, "nanobind::detail::cleanup_list::expand(): out of memory!");
     memcpy(new_data, m_data, m_size * sizeof(PyObject *));
-    if (m_capacity != Small)
-        free(m_data);
     m_data = new_data;
     m_capacity = new_capacity;
 }
@@ -120,9 +217,53 @@ PyObject *module_new(const char *name, PyModuleDef *def) noexcept {
     def->m_size = -1;
     PyObject *m = PyModule_Create(def);
     check(m, "nanobind::detail::module_new(): allocation failed!");
+#if defined(NB_FREE_THREADED)
+    // Declare that the extension is safe to use without the GIL
+    PyUnstable_Module_SetGIL(m, Py_MOD_GIL_NOT_USED);
+#endif
     return m;
 }
 
+PyObject *module_def_init(const char *name, PyModuleDef *def,
+                          PyModuleDef_Slot *slots,
+                          int (*exec)(PyObject *)) noexcept {
+    size_t i = 0;
+    slots[i++] = { Py_mod_exec, (void *) exec };
+#if PY_VERSION_HEX >= 0x030C0000 && !defined(PYPY_VERSION)
+    slots[i++] = { Py_mod_multiple_interpreters,
+                   Py_MOD_PER_INTERPRETER_GIL_SUPPORTED };
+#endif
+#if defined(NB_FREE_THREADED)
+    slots[i++] = { Py_mod_gil, Py_MOD_GIL_NOT_USED };
+#endif
+    slots[i] = { 0, nullptr };
+
+    PyModuleDef_Base base = PyModuleDef_HEAD_INIT;
+    memset(def, 0, sizeof(PyModuleDef));
+    def->m_base = base;
+    def->m_name = name;
+    def->m_size = 0;
+    def->m_slots = slots;
+
+    return PyModuleDef_Init(def);
+}
+
+bool module_exec_begin(PyObject *, PyModuleDef *def) noexcept {
+    // Bind (or create) the internals of the interpreter importing the module
+    nb_internals &internals = *internals_fetch();
+
+    lock_internals guard(internals);
+    auto [it, success] = internals.module_defs.try_emplace(def, nullptr);
+    if (!success) {
+        PyErr_Format(PyExc_ImportError,
+                     "nanobind: extension module \"%s\" can only be "
+                     "initialized once per interpreter!", def->m_name);
+        return false;
+    }
+
+    return true;
+}
+
 PyObject *module_import(const char *name) {
     PyObject *res = PyImport_ImportModule(name);
     if (!res)
@@ -156,6 +297,11 @@ PyObject *module_new_submodule(PyObject *base, const char *name,
     res = PyImport_AddModule(PyUnicode_AsUTF8(name_py));
 #endif
 
+#if defined(NB_FREE_THREADED)
+    if (!res || PyUnstable_Module_SetGIL(res, Py_MOD_GIL_NOT_USED))
+        goto fail;
+#endif
+
     if (doc) {
         PyObject *doc_py = PyUnicode_FromString(doc);
         if (!doc_py || PyObject_SetAttrString(res, "__doc__", doc_py))
@@ -246,8 +392,28 @@ PyObject *obj_op_2(PyObject *a, PyObject *b,
     return res;
 }
 
-PyObject *obj_vectorcall(PyObject *base, PyObject *const *args, size_t nargsf,
-                         PyObject *kwnames, bool method_call) {
+PyObject *kwnames_new(const char *const *names, size_t size) {
+    if (size == 0)
+        return nullptr;
+
+    object result = steal(PyTuple_New((Py_ssize_t) size));
+    if (!result.is_valid())
+        raise_python_error();
+
+    for (size_t i = 0; i < size; ++i) {
+        PyObject *name = PyUnicode_InternFromString(names[i]);
+        if (!name)
+            raise_python_error();
+        NB_TUPLE_SET_ITEM(result.ptr(), i, name);
+    }
+
+    return result.release().ptr();
+}
+
+/// Shared implementation of obj_vectorcall() and obj_try_vectorcall()
+static PyObject *obj_vectorcall_impl(PyObject *base, PyObject *const *args,
+                                     size_t nargsf, PyObject *kwnames,
+                                     bool method_call, bool raise_error) {
     PyObject *res = nullptr;
     bool gil_error = false, cast_error = false;
 
@@ -290,6 +456,14 @@ end:
     Py_DECREF(base);
 
     if (!res) {
+        if (!raise_error && !gil_error) {
+            if (cast_error && !PyErr_Occurred())
+                PyErr_SetString(PyExc_TypeError,
+                                "nanobind::detail::obj_try_vectorcall(): could "
+                                "not convert the arguments to Python objects!");
+            return nullptr;
+        }
+
         if (cast_error)
             raise_cast_error();
         else if (gil_error)
@@ -301,6 +475,17 @@ end:
     return res;
 }
 
+PyObject *obj_vectorcall(PyObject *base, PyObject *const *args, size_t nargsf,
+                         PyObject *kwnames, bool method_call) {
+    return obj_vectorcall_impl(base, args, nargsf, kwnames, method_call, true);
+}
+
+PyObject *obj_try_vectorcall(PyObject *base, PyObject *const *args,
+                             size_t nargsf, PyObject *kwnames,
+                             bool method_call) {
+    return obj_vectorcall_impl(base, args, nargsf, kwnames, method_call, false);
+}
+
 
 PyObject *obj_iter(PyObject *o) {
     PyObject *result = PyObject_GetIter(o);
@@ -487,6 +672,90 @@ PyObject *str_from_cstr_and_size(const char *str, size_t size) {
     return result;
 }
 
+static NB_THREAD_LOCAL bool str_intern_enabled = false;
+
+/// Longer strings are unlikely to repeat and expensive to compare
+static constexpr size_t str_cache_max_len = 128;
+
+bool str_intern_set(bool value) noexcept {
+    bool prev = str_intern_enabled;
+    str_intern_enabled = value;
+    return prev;
+}
+
+/// Create a Python string, bypassing the UTF-8 decoder for pure ASCII input
+static PyObject *str_new(const char *str, size_t size) noexcept {
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+    // Empty and single-character strings are shared singletons in CPython
+    if (size > 1) {
+        const uint8_t *p = (const uint8_t *) str;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            memcpy(&word, p + i, 8);
+            if (word & 0x8080808080808080ull)
+                break;
+        }
+        for (; i < size; ++i) {
+            if (p[i] & 0x80)
+                break;
+        }
+
+        if (i == size) {
+            PyObject *result = PyUnicode_New((Py_ssize_t) size, 127);
+            if (result)
+                memcpy(PyUnicode_DATA(result), str, size);
+            return result;
+        }
+    }
+#endif
+
+    return PyUnicode_FromStringAndSize(str, (Py_ssize_t) size);
+}
+
+PyObject *str_from_cpp(const char *str, size_t size) noexcept {
+    if (!str_intern_enabled || size > str_cache_max_len)
+        return str_new(str, size);
+
+    nb_internals &internals = internals_get();
+    size_t hash = std::hash<std::string_view>()(std::string_view(str, size));
+
+    lock_internals guard(internals);
+    nb_internals::str_cache_entry &entry =
+        internals.str_cache[hash & (nb_internals::str_cache_size - 1)];
+
+    if (entry.value && entry.hash == hash) {
+        Py_ssize_t size_2;
+        const char *str_2 = PyUnicode_AsUTF8AndSize(entry.value, &size_2);
+
+        if (str_2 && (size_t) size_2 == size && memcmp(str, str_2, size) == 0) {
+            Py_INCREF(entry.value);
+            return entry.value;
+        }
+
+        PyErr_Clear();
+    }
+
+    PyObject *result = str_new(str, size);
+    if (result) {
+        Py_INCREF(result);
+        Py_XDECREF(entry.value);
+        entry.hash = hash;
+        entry.value = result;
+    }
+
+    return result;
+}
+
+void str_cache_clear() noexcept {
+    nb_internals &internals = internals_get();
+    lock_internals guard(internals);
+    for (nb_internals::str_cache_entry &entry : internals.str_cache) {
+        Py_CLEAR(entry.value);
+        entry.hash = 0;
+    }
+}
+
 // ========================================================================
 
 PyObject *bytes_from_obj(PyObject *o) {
@@ -510,6 +779,46 @@ PyObject *bytes_from_cstr_and_size(const char *str, size_t size) {
     return result;
 }
 
+const char *bytes_view(PyObject *o, Py_ssize_t *size,
+                       cleanup_list *cleanup) noexcept {
+    if (PyBytes_Check(o)) {
+        char *data;
+        if (PyBytes_AsStringAndSize(o, &data, size)) {
+            PyErr_Clear();
+            return nullptr;
+        }
+        return data;
+    }
+
+    PyObject *exporter = o;
+    if (PyByteArray_Check(o)) {
+        // Prevent the bytearray from being resized while it is referenced
+        if (!cleanup)
+            return nullptr;
+        exporter = PyMemoryView_FromObject(o);
+        if (!exporter) {
+            PyErr_Clear();
+            return nullptr;
+        }
+        cleanup->append(exporter);
+    } else if (!PyMemoryView_Check(o)) {
+        return nullptr;
+    }
+
+    // The memoryview holds a buffer export, hence the data remains valid
+    Py_buffer view;
+    if (PyObject_GetBuffer(exporter, &view, PyBUF_SIMPLE)) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    const char *result = (const char *) view.buf;
+    *size = view.len;
+    PyBuffer_Release(&view);
+
+    return result;
+}
+
 // ========================================================================
 
 PyObject *int_from_obj(PyObject *o) {
@@ -553,6 +862,20 @@ PyObject **seq_get(PyObject *seq, size_t *size_out, PyObject **temp_out) noexcep
         else
             PyErr_Clear();
     }
+#elif defined(PYPY_VERSION)
+    /* PySequence_Fast() switches a PyPy list to a storage strategy holding
+       an array of PyObject pointers (tuples are first copied into such a
+       list). Its elements can then be accessed without cpyext calls. */
+    if (PySequence_Check(seq)) {
+        temp = PySequence_Fast(seq, "");
+
+        if (temp) {
+            size = (size_t) PySequence_Fast_GET_SIZE(temp);
+            result = size ? PySequence_Fast_ITEMS(temp) : (PyObject **) 1;
+        } else {
+            PyErr_Clear();
+        }
+    }
 #else
     /* There isn't a nice way to get a PyObject** in Py_LIMITED_API. This
        is going to be slow, but hopefully also very future-proof.. */
@@ -648,6 +971,19 @@ PyObject **seq_get_with_size(PyObject *seq, size_t size,
         else
             PyErr_Clear();
     }
+#elif defined(PYPY_VERSION)
+    // See seq_get()
+    if (PySequence_Check(seq)) {
+        temp = PySequence_Fast(seq, "");
+
+        if (!temp) {
+            PyErr_Clear();
+        } else if (size == (size_t) PySequence_Fast_GET_SIZE(temp)) {
+            result = size ? PySequence_Fast_ITEMS(temp) : (PyObject **) 1;
+        } else {
+            Py_CLEAR(temp);
+        }
+    }
 #else
     /* There isn't a nice way to get a PyObject** in Py_LIMITED_API. This
        is going to be slow, but hopefully also very future-proof.. */
@@ -704,6 +1040,31 @@ PyObject **seq_get_with_size(PyObject *seq, size_t size,
     return result;
 }
 
+PyObject *seq_iter(PyObject *seq, bool consume, size_t *size_hint) noexcept {
+    *size_hint = 0;
+
+#if !defined(Py_LIMITED_API)
+    // seq_get() directly accesses the contents of lists and tuples
+    if (PyList_CheckExact(seq) || PyTuple_CheckExact(seq))
+        return nullptr;
+#endif
+
+    /* Iterators can only be traversed once. Only accept them when the caller
+       permits it (cast_flags::consume), i.e., when no other overload would
+       receive a partially consumed iterator after a failed conversion. */
+    if (!PySequence_Check(seq) && !(consume && PyIter_Check(seq)))
+        return nullptr;
+
+    PyObject *iter = PyObject_GetIter(seq);
+    if (!iter) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    *size_hint = obj_len_hint(seq);
+    return iter;
+}
+
 // ========================================================================
 
 static void property_install_impl(PyTypeObject *tp, PyObject *scope,
@@ -924,6 +1285,79 @@ void decref_checked(PyObject *o) noexcept {
     Py_DECREF(o);
 }
 
+void decref_pending_release(nb_internals &internals) noexcept {
+    internals.decref_scheduled.store(false);
+    nb_deferred_decref *d = internals.decref_pending.exchange(nullptr);
+
+    while (d) {
+        nb_deferred_decref *next = d->next;
+        if (d->release) {
+            d->release(d->o);
+        } else {
+            Py_DECREF((PyObject *) d->o);
+            free(d);
+        }
+        d = next;
+    }
+}
+
+static int decref_pending_call(void *internals) {
+    decref_pending_release(*(nb_internals *) internals);
+    return 0;
+}
+
+void decref_deferred(PyObject *o) noexcept {
+    if (!o)
+        return;
+
+    // Stable ABI builds can't tell whether the GIL is held
+#if !defined(Py_LIMITED_API)
+    if (NB_LIKELY(PyGILState_Check())) {
+        Py_DECREF(o);
+        return;
+    }
+#endif
+
+    nb_internals *internals = decref_pending_internals();
+    nb_deferred_decref *d = nullptr;
+    if (internals && internals->decref_defer.load(std::memory_order_relaxed))
+        d = (nb_deferred_decref *) malloc(sizeof(nb_deferred_decref));
+
+    if (!d) {
+        gil_scoped_acquire guard;
+        Py_DECREF(o);
+        return;
+    }
+
+    d->o = o;
+    d->release = nullptr;
+    decref_pending_push(*internals, d);
+}
+
+void decref_pending_push(nb_internals &internals,
+                         nb_deferred_decref *d) noexcept {
+    d->next = internals.decref_pending.load(std::memory_order_relaxed);
+    while (!internals.decref_pending.compare_exchange_weak(d->next, d))
+        ;
+
+    /* Ask the main thread to release the entry. If its queue of pending
+       calls is full, the next dispatcher call or enqueued entry retries */
+    if (!internals.decref_scheduled.exchange(true) &&
+        Py_AddPendingCall(decref_pending_call, &internals) != 0)
+        internals.decref_scheduled.store(false);
+}
+
+void set_deferred_decref(bool value) noexcept {
+    internals_get().decref_defer.store(value);
+}
+
+/// Release queued references and stop deferring them during shutdown
+void decref_pending_clear() noexcept {
+    nb_internals &internals = internals_get();
+    internals.decref_defer.store(false);
+    decref_pending_release(internals);
+}
+
 // ========================================================================
 
 void set_leak_warnings(bool value) noexcept {
@@ -934,6 +1368,180 @@ void set_implicit_cast_warnings(bool value) noexcept {
     internals_get().print_implicit_cast_warnings = value;
 }
 
+void set_tracemalloc(bool value) noexcept {
+    internals_get().tracemalloc = value;
+}
+
+void set_lazy_functions(bool value) noexcept {
+    nb_internals &internals = internals_get();
+    if (value)
+        internals.lazy_depth++;
+    else
+        internals.lazy_depth--;
+}
+
+void set_release_gil_default(bool value) noexcept {
+    nb_internals &internals = internals_get();
+    if (value)
+        internals.release_gil_depth++;
+    else
+        internals.release_gil_depth--;
+}
+
+void reserve_bindings(size_t types, size_t funcs) noexcept {
+    nb_internals &internals = internals_get();
+    lock_internals guard(internals);
+    internals.type_c2p.reserve(internals.type_c2p.size() + types);
+    internals.type_c2p_fast.reserve(internals.type_c2p_fast.size() + types);
+    internals.funcs.reserve(internals.funcs.size() + funcs);
+}
+
+void **datetime_cache() noexcept {
+    return internals_get().datetime_cache;
+}
+
+// ========================================================================
+
+/// Python string of an nb::interned key in a specific interpreter
+struct nb_interned_entry {
+    PyObject *value;
+    uint64_t internals_id;
+    /// Copy of the key (followed by the string data)
+    char key[1];
+};
+
+PyObject *interned_get(const char *value, void **cache_) noexcept {
+    std::atomic<nb_interned_entry *> &cache =
+        *(std::atomic<nb_interned_entry *> *) cache_;
+    nb_internals &internals = internals_get();
+
+    nb_interned_entry *e = cache.load(std::memory_order_acquire);
+    if (NB_LIKELY(e && e->internals_id == internals.id))
+        return e->value;
+
+    /* The key was last used by another interpreter (or never). Entries are
+       never freed, since other threads may still be reading them via 'cache'.
+       Slots are indexed by the address of 'cache', which a destroyed
+       non-static key may have shared with this one. Compare the stored
+       string to detect this and replace the stale entry. */
+    {
+        lock_internals guard(internals);
+        void *&slot = internals.interned[(void *) cache_];
+        if (!slot || strcmp(((nb_interned_entry *) slot)->key, value) != 0) {
+            PyObject *str = PyUnicode_InternFromString(value);
+            check(str, "nanobind::detail::interned_get(\"%s\"): could not "
+                       "create string!", value);
+            size_t len = strlen(value);
+            nb_interned_entry *ne = (nb_interned_entry *) malloc(
+                sizeof(nb_interned_entry) + len);
+            check(ne, "nanobind::detail::interned_get(): out of memory!");
+            ne->value = str;
+            ne->internals_id = internals.id;
+            memcpy(ne->key, value, len + 1);
+            slot = ne;
+        }
+        e = (nb_interned_entry *) slot;
+    }
+
+    cache.store(e, std::memory_order_release);
+    return e->value;
+}
+
+// ========================================================================
+
+/// Accumulated statistics of one or more hash tables
+struct map_stats {
+    size_t size = 0, capacity = 0, max_probe = 0;
+
+    /**
+     * Add the entries of 'map'. The probe length of an entry is its distance
+     * from its home bucket in an open addressing table with linear probing,
+     * which is reconstructed from the number of entries per home bucket.
+     */
+    template <typename Map> void add(const Map &map) {
+        size_t buckets = map.bucket_count();
+        size += map.size();
+        capacity += buckets;
+        if (map.empty() || buckets == 0)
+            return;
+
+        std::vector<uint32_t> count(buckets, 0);
+        for (const auto &kv : map)
+            count[map.hash_function()(kv.first) % buckets]++;
+
+        // Sweep twice so that runs wrapping around the end are accounted for
+        size_t carry = 0;
+        for (size_t i = 0; i < 2 * buckets; ++i) {
+            size_t c = count[i % buckets];
+            if (c) {
+                carry += c - 1;
+                if (carry > max_probe)
+                    max_probe = carry;
+            } else if (carry) {
+                carry--;
+            }
+        }
+    }
+
+    PyObject *to_dict() const {
+        return Py_BuildValue(
+            "{snsnsdsn}", "size", (Py_ssize_t) size, "capacity",
+            (Py_ssize_t) capacity, "load_factor",
+            capacity ? (double) size / (double) capacity : 0.0, "max_probe",
+            (Py_ssize_t) max_probe);
+    }
+};
+
+PyObject *internals_stats() {
+    nb_internals &internals = internals_get();
+    map_stats inst_c2p, keep_alive, type_c2p, funcs, descrs;
+    size_t seq_chains = 0, seq_instances = 0, seq_max_length = 0;
+
+    for (size_t i = 0; i <= internals.shard_mask; ++i) {
+        nb_shard &shard = internals.shards[i];
+        lock_shard guard(shard);
+        inst_c2p.add(shard.inst_c2p);
+        keep_alive.add(shard.keep_alive);
+
+        for (const auto &kv : shard.inst_c2p) {
+            if (!nb_is_seq(kv.second))
+                continue;
+            size_t length = 0;
+            for (nb_inst_seq *seq = nb_get_seq(kv.second); seq; seq = seq->next)
+                length++;
+            seq_chains++;
+            seq_instances += length;
+            if (length > seq_max_length)
+                seq_max_length = length;
+        }
+    }
+
+    {
+        lock_internals guard(internals);
+        type_c2p.add(internals.type_c2p);
+        funcs.add(internals.funcs);
+        descrs.add(internals.descrs);
+    }
+
+    PyObject *result = Py_BuildValue(
+        "{sNsNsNsNsNs{snsnsn}sn}",
+        "inst_c2p", inst_c2p.to_dict(),
+        "keep_alive", keep_alive.to_dict(),
+        "type_c2p", type_c2p.to_dict(),
+        "funcs", funcs.to_dict(),
+        "descrs", descrs.to_dict(),
+        "inst_seq",
+            "chains", (Py_ssize_t) seq_chains,
+            "instances", (Py_ssize_t) seq_instances,
+            "max_length", (Py_ssize_t) seq_max_length,
+        "ndarray_handles",
+            (Py_ssize_t) internals.ndarray_handles.load(std::memory_order_relaxed));
+
+    if (!result)
+        raise_python_error();
+    return result;
+}
+
 // ========================================================================
 
 void slice_compute(PyObject *slice, Py_ssize_t size, Py_ssize_t &start,
@@ -14,7 +14,8 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
-Buffer buf(128);
+// Per thread, since interpreters with their own GIL may run concurrently
+thread_local Buffer buf(128);
 
 NAMESPACE_END(detail)
 
@@ -160,12 +161,16 @@ NAMESPACE_BEGIN(detail)
 
 void register_exception_translator(exception_translator t, void *payload) {
     nb_internals &internals = internals_get();
+    lock_internals guard(internals);
 
     nb_translator_seq *cur  = &internals.translators,
                       *next = new nb_translator_seq(*cur);
     cur->next = next;
     cur->payload = payload;
     cur->translator = t;
+
+    // The new translator takes precedence, invalidate cached lookups
+    internals.translator_cache.clear();
 }
 
 NB_CORE PyObject *exception_new(PyObject *scope, const char *name,
@@ -15,14 +15,13 @@ NAMESPACE_BEGIN(detail)
 
 void implicitly_convertible(const std::type_info *src,
                             const std::type_info *dst) noexcept {
-    nb_type_map &type_c2p = internals_get().type_c2p;
-
-    nb_type_map::iterator it = type_c2p.find(std::type_index(*dst));
-    check(it != type_c2p.end(),
+    nb_internals &internals = internals_get();
+    type_data *t = nb_type_c2p(internals, dst);
+    check(t,
           "nanobind::detail::implicitly_convertible(src=%s, dst=%s): "
           "destination type unknown!", type_name(src), type_name(dst));
 
-    type_data *t = it->second;
+    lock_internals guard(internals);
     size_t size = 0;
 
     if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
@@ -31,6 +30,7 @@ void implicitly_convertible(const std::type_info *src,
     } else {
         t->implicit = nullptr;
         t->implicit_py = nullptr;
+        t->implicit_native = nullptr;
         t->flags |= (uint32_t) type_flags::has_implicit_conversions;
     }
 
@@ -46,14 +46,13 @@ void implicitly_convertible(const std::type_info *src,
 void implicitly_convertible(bool (*predicate)(PyTypeObject *, PyObject *,
                                               cleanup_list *),
                             const std::type_info *dst) noexcept {
-    nb_type_map &type_c2p = internals_get().type_c2p;
-
-    nb_type_map::iterator it = type_c2p.find(std::type_index(*dst));
-    check(it != type_c2p.end(),
+    nb_internals &internals = internals_get();
+    type_data *t = nb_type_c2p(internals, dst);
+    check(t,
           "nanobind::detail::implicitly_convertible(src=<predicate>, dst=%s): "
           "destination type unknown!", type_name(dst));
 
-    type_data *t = it->second;
+    lock_internals guard(internals);
     size_t size = 0;
 
     if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
@@ -62,6 +61,7 @@ void implicitly_convertible(bool (*predicate)(PyTypeObject *, PyObject *,
     } else {
         t->implicit = nullptr;
         t->implicit_py = nullptr;
+        t->implicit_native = nullptr;
         t->flags |= (uint32_t) type_flags::has_implicit_conversions;
     }
 
@@ -73,5 +73,34 @@ void implicitly_convertible(bool (*predicate)(PyTypeObject *, PyObject *,
     t->implicit_py = (decltype(t->implicit_py)) data;
 }
 
+void implicitly_convertible(bool (*convert)(PyObject *, void *) noexcept,
+                            const std::type_info *dst) noexcept {
+    nb_internals &internals = internals_get();
+    type_data *t = nb_type_c2p(internals, dst);
+    check(t,
+          "nanobind::detail::implicitly_convertible(src=<native>, dst=%s): "
+          "destination type unknown!", type_name(dst));
+
+    lock_internals guard(internals);
+    size_t size = 0;
+
+    if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
+        while (t->implicit_native && t->implicit_native[size])
+            size++;
+    } else {
+        t->implicit = nullptr;
+        t->implicit_py = nullptr;
+        t->implicit_native = nullptr;
+        t->flags |= (uint32_t) type_flags::has_implicit_conversions;
+    }
+
+    void **data = (void **) malloc(sizeof(void *) * (size + 2));
+    memcpy(data, t->implicit_native, size * sizeof(void *));
+    data[size] = (void *) convert;
+    data[size + 1] = nullptr;
+    free(t->implicit_native);
+    t->implicit_native = (decltype(t->implicit_native)) data;
+}
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
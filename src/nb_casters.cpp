@@ -0,0 +1,29 @@
+/*
+    src/nb_casters.cpp: explicit instantiations of common STL type casters,
+    which extensions then don't need to compile themselves
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <nanobind/stl/map.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+#if !defined(NB_NO_EXTERN_CASTERS)
+NB_VECTOR_CASTER_INST(, int)
+NB_VECTOR_CASTER_INST(, int64_t)
+NB_VECTOR_CASTER_INST(, float)
+NB_VECTOR_CASTER_INST(, double)
+NB_VECTOR_CASTER_INST(, std::string)
+
+NB_MAP_STRING_CASTER_INST()
+#endif
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
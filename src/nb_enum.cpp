@@ -20,12 +20,79 @@ NB_INLINE enum_supplement &nb_enum_supplement(PyTypeObject *type) {
 static PyObject *nb_enum_int_signed(PyObject *o);
 static PyObject *nb_enum_int_unsigned(PyObject *o);
 
+/* Enumerations whose values lie in a small range store their entries in a
+   list indexed by value ('enum_supplement::dense'), which avoids a dictionary
+   lookup. The values are mapped to 64 bit keys so that signed and unsigned
+   enumerations can share the range checks below. */
+static constexpr uint64_t nb_enum_sign_bit = (uint64_t) 1 << 63;
+
+static uint64_t nb_enum_key(const void *p, uint32_t size, bool is_signed) {
+    if (is_signed) {
+        int64_t value;
+        switch (size) {
+            case 1: value = *(const int8_t *)  p; break;
+            case 2: value = *(const int16_t *) p; break;
+            case 4: value = *(const int32_t *) p; break;
+            default: value = *(const int64_t *) p; break;
+        }
+        return (uint64_t) value ^ nb_enum_sign_bit;
+    } else {
+        switch (size) {
+            case 1: return *(const uint8_t *)  p;
+            case 2: return *(const uint16_t *) p;
+            case 4: return *(const uint32_t *) p;
+            default: return *(const uint64_t *) p;
+        }
+    }
+}
+
+NB_INLINE uint64_t nb_enum_key(PyObject *o, bool is_signed) {
+    return nb_enum_key(inst_ptr((nb_inst *) o),
+                       nb_type_data(Py_TYPE(o))->size, is_signed);
+}
+
+/// Bit pattern of an enumeration value (used by flag enumerations)
+NB_INLINE uint64_t nb_enum_bits(PyObject *o) {
+    return nb_enum_key(inst_ptr((nb_inst *) o),
+                       nb_type_data(Py_TYPE(o))->size, false);
+}
+
+static void nb_enum_store(void *p, uint32_t size, uint64_t bits) {
+    switch (size) {
+        case 1: *(uint8_t *)  p = (uint8_t)  bits; break;
+        case 2: *(uint16_t *) p = (uint16_t) bits; break;
+        case 4: *(uint32_t *) p = (uint32_t) bits; break;
+        default: *(uint64_t *) p = bits; break;
+    }
+}
+
+/// Maximum number of cached combinations of a flag enumeration
+static constexpr Py_ssize_t nb_enum_max_composites = 1024;
+
+/// Look up an entry in the dense list, returns a borrowed reference or nullptr
+NB_INLINE PyObject *nb_enum_dense_get(const enum_supplement &supp,
+                                      uint64_t key) {
+    if (!supp.dense) // enumeration without entries
+        return nullptr;
+
+    uint64_t index = key - supp.key_min;
+    if (key < supp.key_min || index >= (uint64_t) NB_LIST_GET_SIZE(supp.dense))
+        return nullptr;
+
+    PyObject *rec = NB_LIST_GET_ITEM(supp.dense, (Py_ssize_t) index);
+    return rec != Py_None ? rec : nullptr;
+}
+
 /// Map to unique representative enum instance, returns a borrowed reference
 static PyObject *nb_enum_lookup(PyObject *self) {
     enum_supplement &supp = nb_enum_supplement(Py_TYPE(self));
+
+    PyObject *rec = nb_enum_dense_get(supp, nb_enum_key(self, supp.is_signed));
+    if (NB_LIKELY(rec))
+        return rec;
+
     PyObject *int_val = supp.is_signed ? nb_enum_int_signed(self)
                                        : nb_enum_int_unsigned(self);
-    PyObject *rec = nullptr;
     if (int_val && supp.entries)
         rec = (PyObject *) PyDict_GetItem(supp.entries, int_val);
 
@@ -40,33 +107,92 @@ static PyObject *nb_enum_lookup(PyObject *self) {
     }
 }
 
-static PyObject *nb_enum_repr(PyObject *self) {
-    PyObject *entry = nb_enum_lookup(self);
-    if (!entry)
+/// Name of a combination of flags, e.g. "A|B" (returns a new reference)
+static PyObject *nb_enum_flag_name(PyObject *self) {
+    enum_supplement &supp = nb_enum_supplement(Py_TYPE(self));
+    uint64_t bits = nb_enum_bits(self), rest = bits;
+
+    PyObject *names = PyList_New(0), *sep, *result = nullptr;
+    if (!names)
         return nullptr;
 
-    PyObject *name = nb_inst_name(self);
-    PyObject *result =
-        PyUnicode_FromFormat("%U.%U", name, NB_TUPLE_GET_ITEM(entry, 0));
-    Py_DECREF(name);
+    if (supp.entries) {
+        PyObject *key, *rec;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(supp.entries, &pos, &key, &rec)) {
+            uint64_t b = nb_enum_bits(NB_TUPLE_GET_ITEM(rec, 2));
+            if (b == 0 || (b & ~bits) || !(b & rest))
+                continue;
+            if (PyList_Append(names, NB_TUPLE_GET_ITEM(rec, 0)))
+                goto done;
+            rest &= ~b;
+        }
+    }
+
+    // Bits without a name are appended as a hexadecimal number
+    if (rest || PyList_Size(names) == 0) {
+        PyObject *int_val = PyLong_FromUnsignedLongLong(rest),
+                 *hex = int_val ? PyNumber_ToBase(int_val, 16) : nullptr;
+        int rv = hex ? PyList_Append(names, hex) : -1;
+        Py_XDECREF(hex);
+        Py_XDECREF(int_val);
+        if (rv)
+            goto done;
+    }
 
+    sep = PyUnicode_FromString("|");
+    if (sep) {
+        result = PyUnicode_Join(sep, names);
+        Py_DECREF(sep);
+    }
+
+done:
+    Py_DECREF(names);
     return result;
 }
 
-static PyObject *nb_enum_get_name(PyObject *self, void *) {
+/// Name of an entry or of a combination of flags (returns a new reference)
+static PyObject *nb_enum_name(PyObject *self) {
     PyObject *entry = nb_enum_lookup(self);
-    if (!entry)
+    if (NB_LIKELY(entry)) {
+        PyObject *result = NB_TUPLE_GET_ITEM(entry, 0);
+        Py_INCREF(result);
+        return result;
+    }
+
+    if (!nb_enum_supplement(Py_TYPE(self)).is_flag)
         return nullptr;
 
-    PyObject *result = NB_TUPLE_GET_ITEM(entry, 0);
-    Py_INCREF(result);
+    PyErr_Clear();
+    return nb_enum_flag_name(self);
+}
+
+static PyObject *nb_enum_repr(PyObject *self) {
+    PyObject *entry_name = nb_enum_name(self);
+    if (!entry_name)
+        return nullptr;
+
+    PyObject *name = nb_inst_name(self);
+    PyObject *result = PyUnicode_FromFormat("%U.%U", name, entry_name);
+    Py_DECREF(name);
+    Py_DECREF(entry_name);
+
     return result;
 }
 
+static PyObject *nb_enum_get_name(PyObject *self, void *) {
+    return nb_enum_name(self);
+}
+
 static PyObject *nb_enum_get_doc(PyObject *self, void *) {
     PyObject *entry = nb_enum_lookup(self);
-    if (!entry)
-        return nullptr;
+    if (!entry) {
+        if (!nb_enum_supplement(Py_TYPE(self)).is_flag)
+            return nullptr;
+        // Combinations of flags don't have a docstring
+        PyErr_Clear();
+        Py_RETURN_NONE;
+    }
 
     PyObject *result = NB_TUPLE_GET_ITEM(entry, 1);
     Py_INCREF(result);
@@ -151,6 +277,16 @@ PyObject *nb_enum_richcompare(PyObject *a, PyObject *b, int op) {
     // Python will ask type(a) to check 'a > b' if type(b) doesn't
     // know how to check 'b < a'.
 
+    if ((op == Py_EQ || op == Py_NE) && Py_TYPE(a) == Py_TYPE(b)) {
+        // Fast path: compare two enumerators of the same type by value
+        uint32_t size = nb_type_data(Py_TYPE(a))->size;
+        bool equal = memcmp(inst_ptr((nb_inst *) a),
+                            inst_ptr((nb_inst *) b), size) == 0;
+        PyObject *result = (equal == (op == Py_EQ)) ? Py_True : Py_False;
+        Py_INCREF(result);
+        return result;
+    }
+
     if (op == Py_EQ || op == Py_NE) {
         // For equality/inequality comparisons, only allow enums to be
         // equal with their same enum type or with their underlying
@@ -263,6 +399,49 @@ NB_ENUM_UNOP(neg, PyNumber_Negative)
 NB_ENUM_UNOP(inv, PyNumber_Invert)
 NB_ENUM_UNOP(abs, PyNumber_Absolute)
 
+static PyObject *nb_enum_get(PyTypeObject *tp, const void *value) noexcept;
+
+/* Bitwise operations of flag enumerations are computed on the underlying
+   values and return an enumeration instance. Their results are looked up
+   among the entries and a cache of combinations ('enum_supplement::composites')
+   so that they usually don't allocate. Operations involving other types use
+   integer arithmetic as with 'nb::is_arithmetic()'. */
+NB_NOINLINE static PyObject *nb_enum_flag_binop(PyObject *a, PyObject *b,
+                                                int op) {
+    PyTypeObject *tp = Py_TYPE(a);
+    if (tp != Py_TYPE(b))
+        return nb_enum_binop(a, b, op == 0   ? PyNumber_Or
+                                   : op == 1 ? PyNumber_And
+                                             : PyNumber_Xor);
+
+    uint64_t x = nb_enum_bits(a), y = nb_enum_bits(b), value = 0;
+    nb_enum_store(&value, nb_type_data(tp)->size,
+                  op == 0 ? (x | y) : op == 1 ? (x & y) : (x ^ y));
+
+    return nb_enum_get(tp, &value);
+}
+
+static PyObject *nb_enum_flag_or(PyObject *a, PyObject *b) {
+    return nb_enum_flag_binop(a, b, 0);
+}
+
+static PyObject *nb_enum_flag_and(PyObject *a, PyObject *b) {
+    return nb_enum_flag_binop(a, b, 1);
+}
+
+static PyObject *nb_enum_flag_xor(PyObject *a, PyObject *b) {
+    return nb_enum_flag_binop(a, b, 2);
+}
+
+/// Complement with respect to the union of all entries
+static PyObject *nb_enum_flag_invert(PyObject *a) {
+    PyTypeObject *tp = Py_TYPE(a);
+    uint64_t value = 0;
+    nb_enum_store(&value, nb_type_data(tp)->size,
+                  ~nb_enum_bits(a) & nb_enum_supplement(tp).flag_mask);
+    return nb_enum_get(tp, &value);
+}
+
 int nb_enum_clear(PyObject *) {
     return 0;
 }
@@ -320,15 +499,85 @@ void nb_enum_prepare(const type_init_data *td,
         *t++ = { Py_nb_subtract, (void *) nb_enum_sub };
         *t++ = { Py_nb_multiply, (void *) nb_enum_mul };
         *t++ = { Py_nb_floor_divide, (void *) nb_enum_div };
-        *t++ = { Py_nb_or, (void *) nb_enum_or };
-        *t++ = { Py_nb_xor, (void *) nb_enum_xor };
-        *t++ = { Py_nb_and, (void *) nb_enum_and };
         *t++ = { Py_nb_rshift, (void *) nb_enum_rshift };
         *t++ = { Py_nb_lshift, (void *) nb_enum_lshift };
         *t++ = { Py_nb_negative, (void *) nb_enum_neg };
-        *t++ = { Py_nb_invert, (void *) nb_enum_inv };
         *t++ = { Py_nb_absolute, (void *) nb_enum_abs };
     }
+
+    if (ed->is_flag) {
+        *t++ = { Py_nb_or, (void *) nb_enum_flag_or };
+        *t++ = { Py_nb_xor, (void *) nb_enum_flag_xor };
+        *t++ = { Py_nb_and, (void *) nb_enum_flag_and };
+        *t++ = { Py_nb_invert, (void *) nb_enum_flag_invert };
+    } else if (ed->is_arithmetic) {
+        *t++ = { Py_nb_or, (void *) nb_enum_or };
+        *t++ = { Py_nb_xor, (void *) nb_enum_xor };
+        *t++ = { Py_nb_and, (void *) nb_enum_and };
+        *t++ = { Py_nb_invert, (void *) nb_enum_inv };
+    }
+}
+
+/// Register an entry in the dense list, rebuilding it if necessary
+static bool nb_enum_dense_put(enum_supplement &supp, PyObject *inst,
+                              PyObject *rec) {
+    uint64_t key = nb_enum_key(inst, supp.is_signed),
+             key_min = key, key_max = key;
+    size_t count = (size_t) PyDict_Size(supp.entries);
+
+    if (count > 1) {
+        key_min = key < supp.key_min ? key : supp.key_min;
+        key_max = key > supp.key_max ? key : supp.key_max;
+    }
+
+    uint64_t size = (uint64_t) NB_LIST_GET_SIZE(supp.dense);
+
+    // Fast path: the list already covers this value
+    if (key_min == supp.key_min && key - key_min < size) {
+        supp.key_max = key_max;
+        Py_INCREF(rec);
+        return PyList_SetItem(supp.dense, (Py_ssize_t) (key - key_min), rec) == 0;
+    }
+
+    supp.key_min = key_min;
+    supp.key_max = key_max;
+
+    // Only use a list if at least a third of its elements are occupied
+    uint64_t limit = 2 * (uint64_t) count + 64;
+    if (key_max - key_min >= limit)
+        return size == 0 || PyList_SetSlice(supp.dense, 0, (Py_ssize_t) size,
+                                            nullptr) == 0;
+
+    // Leave room for further entries when the range grows
+    uint64_t new_size = key_max - key_min + 1;
+    if (2 * size > new_size)
+        new_size = 2 * size < limit ? 2 * size : limit;
+
+    PyObject *list = PyList_New((Py_ssize_t) new_size);
+    if (!list)
+        return false;
+
+    for (uint64_t i = 0; i < new_size; ++i) {
+        Py_INCREF(Py_None);
+        NB_LIST_SET_ITEM(list, (Py_ssize_t) i, Py_None);
+    }
+
+    PyObject *int_val, *value;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(supp.entries, &pos, &int_val, &value)) {
+        uint64_t index =
+            nb_enum_key(NB_TUPLE_GET_ITEM(value, 2), supp.is_signed) - key_min;
+        Py_INCREF(value);
+        if (PyList_SetItem(list, (Py_ssize_t) index, value)) {
+            Py_DECREF(list);
+            return false;
+        }
+    }
+
+    int rv = PyList_SetSlice(supp.dense, 0, (Py_ssize_t) size, list);
+    Py_DECREF(list);
+
+    return rv == 0;
 }
 
 void nb_enum_put(PyObject *type, const char *name, const void *value,
@@ -381,9 +630,31 @@ void nb_enum_put(PyObject *type, const char *name, const void *value,
 
         supp.entries = dict;
         Py_DECREF(dict);
+
+        // The same applies to the list of entries with dense values
+        PyObject *list = PyList_New(0);
+        if (!list || PyObject_SetAttrString(type, "@dense", list))
+            goto error;
+
+        supp.dense = list;
+        Py_DECREF(list);
+
+        // .. and to the cache of flag combinations
+        if (supp.is_flag) {
+            PyObject *composites = PyDict_New();
+            if (!composites ||
+                PyObject_SetAttrString(type, "@composites", composites))
+                goto error;
+
+            supp.composites = composites;
+            Py_DECREF(composites);
+        }
     }
 
-    if (PyDict_SetItem(supp.entries, int_val, rec))
+    supp.flag_mask |= nb_enum_bits((PyObject *) inst);
+
+    if (PyDict_SetItem(supp.entries, int_val, rec) ||
+        !nb_enum_dense_put(supp, (PyObject *) inst, rec))
         goto error;
 
     Py_DECREF(int_val);
@@ -396,6 +667,89 @@ error:
           "nanobind::detail::nb_enum_put(): could not create enum entry!");
 }
 
+/// Create a flag combination without an entry, caching it if possible
+static PyObject *nb_enum_composite(PyTypeObject *tp, enum_supplement &supp,
+                                   PyObject *int_val, const void *value) {
+    nb_internals &internals = internals_get();
+    PyObject *result = nullptr;
+
+    if (int_val) {
+        lock_internals guard(internals);
+        result = PyDict_GetItem(supp.composites, int_val);
+        Py_XINCREF(result);
+    }
+
+    if (result)
+        return result;
+
+    nb_inst *inst = (nb_inst *) inst_new_impl(tp, nullptr);
+    if (!inst)
+        return nullptr;
+
+    memcpy(inst_ptr(inst), value, nb_type_data(tp)->size);
+    inst->destruct = false;
+    inst->cpp_delete = false;
+    inst->ready = true;
+    result = (PyObject *) inst;
+
+    if (int_val && PyDict_Size(supp.composites) < nb_enum_max_composites) {
+        lock_internals guard(internals);
+        PyObject *prev = PyDict_GetItem(supp.composites, int_val);
+        if (prev) {
+            // Another thread was faster
+            Py_INCREF(prev);
+            Py_DECREF(result);
+            result = prev;
+        } else if (PyDict_SetItem(supp.composites, int_val, result)) {
+            PyErr_Clear();
+        }
+    }
+
+    return result;
+}
+
+/// Map a C++ value to its unique enum instance (returns a new reference)
+static PyObject *nb_enum_get(PyTypeObject *tp, const void *value) noexcept {
+    enum_supplement &supp = nb_enum_supplement(tp);
+    type_data *t = nb_type_data(tp);
+    uint64_t key = nb_enum_key(value, t->size, supp.is_signed);
+
+    PyObject *rec = nb_enum_dense_get(supp, key), *int_val = nullptr;
+
+    if (!rec && supp.entries) {
+        // Sparse enumeration, fall back to the dictionary
+        int_val = supp.is_signed
+                      ? PyLong_FromLongLong((long long) (key ^ nb_enum_sign_bit))
+                      : PyLong_FromUnsignedLongLong((unsigned long long) key);
+        if (!int_val)
+            return nullptr;
+        rec = PyDict_GetItem(supp.entries, int_val);
+    }
+
+    PyObject *result;
+    if (rec) {
+        result = NB_TUPLE_GET_ITEM(rec, 2);
+        Py_INCREF(result);
+    } else if (supp.is_flag) {
+        result = nb_enum_composite(tp, supp, int_val, value);
+    } else {
+        // A value without an entry
+        result = nb_type_put(t->type, (void *) value, rv_policy::copy, nullptr);
+    }
+
+    Py_XDECREF(int_val);
+    return result;
+}
+
+PyObject *nb_enum_from_cpp(const std::type_info *type,
+                           const void *value) noexcept {
+    PyTypeObject *tp = (PyTypeObject *) nb_type_lookup(type);
+    if (!tp)
+        return nullptr;
+
+    return nb_enum_get(tp, value);
+}
+
 void nb_enum_export(PyObject *tp) {
     enum_supplement &supp = nb_enum_supplement((PyTypeObject *) tp);
     check(supp.entries && supp.scope != nullptr,
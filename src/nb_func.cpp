@@ -9,14 +9,30 @@
 
 #include "nb_internals.h"
 #include "buffer.h"
+#include <csignal>
 
 /// Maximum number of arguments supported by 'nb_vectorcall_simple'
 #define NB_MAXARGS_SIMPLE 8
 
+/// Number of argument type signatures remembered per overloaded function
+#define NB_DISPATCH_CACHE_SIZE 4
+
 #if defined(__GNUG__)
 #  include <cxxabi.h>
 #endif
 
+#if defined(NB_PROFILE)
+#  include <chrono>
+#endif
+
+#if defined(NB_PERF_MAP)
+#  include <cinttypes>
+#  include <mutex>
+#  include <vector>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
 #if defined(_MSC_VER)
 #  pragma warning(disable: 4706) // assignment within conditional expression
 #  pragma warning(disable: 6255) // _alloca indicates failure by raising a stack overflow exception
@@ -26,16 +42,61 @@ NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
 // Forward/external declarations
-extern Buffer buf;
+extern thread_local Buffer buf;
 
 static PyObject *nb_func_vectorcall_simple(PyObject *, PyObject *const *,
                                            size_t, PyObject *) noexcept;
 static PyObject *nb_func_vectorcall_complex(PyObject *, PyObject *const *,
                                             size_t, PyObject *) noexcept;
 static void nb_func_render_signature(const func_data *f) noexcept;
+static void nb_dispatch_clear(nb_func *func) noexcept;
+static bool nb_func_defer(nb_internals &internals, func_data_prelim<0> *f,
+                          arg_data *args_in, size_t nargs_in) noexcept;
+static void nb_descr_release(nb_internals &internals,
+                             const std::type_info **types) noexcept;
+#if defined(NB_PERF_MAP)
+static void nb_func_perf_stub(func_data *f, size_t index) noexcept;
+#endif
+
+/**
+ * Adaptive overload cache
+ *
+ * Functions with several overloads remember the argument types of recent calls
+ * along with the overload and pass that eventually accepted them. Subsequent
+ * calls with the same types first try that overload and only fall back to the
+ * linear walk over the overload chain if it does not accept the arguments.
+ *
+ * Skipping over other overloads is only valid if their failure follows from
+ * the argument types alone. Entries are therefore restricted to arguments
+ * whose type is a nanobind type, 'float', or 'bool'. Integers and strings are
+ * excluded since range and length checks make overload resolution
+ * value-dependent (e.g., 'int8_t' vs 'int64_t' or 'char' vs 'std::string'
+ * overloads), and so are containers, 'None', and arbitrary Python objects.
+ */
+struct nb_dispatch_entry {
+    PyTypeObject *types[NB_MAXARGS_SIMPLE];
+    uint32_t nargs;
+    uint32_t index;
+    uint32_t pass;
+};
+
+struct nb_dispatch_cache {
+    nb_dispatch_entry entries[NB_DISPATCH_CACHE_SIZE];
+    uint32_t next;
+};
 
 int nb_func_traverse(PyObject *self, visitproc visit, void *arg) {
     size_t size = (size_t) Py_SIZE(self);
+    nb_dispatch_cache *cache = ((nb_func *) self)->dispatch_cache;
+
+    if (cache) {
+        for (const nb_dispatch_entry &e : cache->entries) {
+            if (e.pass > 1)
+                continue;
+            for (uint32_t i = 0; i < e.nargs; ++i)
+                Py_VISIT((PyObject *) e.types[i]);
+        }
+    }
 
     if (size) {
         func_data *f = nb_func_data(self);
@@ -55,6 +116,7 @@ int nb_func_traverse(PyObject *self, visitproc visit, void *arg) {
 
 int nb_func_clear(PyObject *self) {
     size_t size = (size_t) Py_SIZE(self);
+    nb_dispatch_clear((nb_func *) self);
 
     if (size) {
         func_data *f = nb_func_data(self);
@@ -75,19 +137,24 @@ int nb_func_clear(PyObject *self) {
 /// Free a function overload chain
 void nb_func_dealloc(PyObject *self) {
     PyObject_GC_UnTrack(self);
+    nb_dispatch_clear((nb_func *) self);
 
     size_t size = (size_t) Py_SIZE(self);
     if (size) {
         func_data *f = nb_func_data(self);
 
         // Delete from registered function list
-        auto &funcs = internals_get().funcs;
-        auto it = funcs.find(self);
-        check(it != funcs.end(),
-              "nanobind::detail::nb_func_dealloc(\"%s\"): function not found!",
-              ((f->flags & (uint32_t) func_flags::has_name) ? f->name
-                                                            : "<anonymous>"));
-        funcs.erase(it);
+        nb_internals &internals = internals_get();
+        {
+            lock_internals guard(internals);
+            auto &funcs = internals.funcs;
+            auto it = funcs.find(self);
+            check(it != funcs.end(),
+                  "nanobind::detail::nb_func_dealloc(\"%s\"): function not found!",
+                  ((f->flags & (uint32_t) func_flags::has_name) ? f->name
+                                                                : "<anonymous>"));
+            funcs.erase(it);
+        }
 
         for (size_t i = 0; i < size; ++i) {
             if (f->flags & (uint32_t) func_flags::has_free)
@@ -101,8 +168,8 @@ void nb_func_dealloc(PyObject *self) {
             }
 
             free(f->args);
-            free((char *) f->descr);
-            free(f->descr_types);
+            free(f->kwargs_table);
+            nb_descr_release(internals, f->descr_types);
             ++f;
         }
     }
@@ -129,9 +196,38 @@ void nb_bound_method_dealloc(PyObject *self) {
     PyObject_GC_UnTrack(self);
     Py_DECREF((PyObject *) mb->func);
     Py_DECREF(mb->self);
+
+#if !defined(PYPY_VERSION)
+    nb_internals &internals = internals_get();
+    if (internals.nb_bound_method_freelist_size <
+        internals.nb_bound_method_freelist_capacity) {
+        mb->func = (nb_func *) internals.nb_bound_method_freelist;
+        mb->self = nullptr;
+        internals.nb_bound_method_freelist = mb;
+        internals.nb_bound_method_freelist_size++;
+        return;
+    }
+#endif
+
     PyObject_GC_Del(self);
 }
 
+/// Release the 'nb_bound_method' freelist and stop recycling instances
+void nb_bound_method_freelist_clear() noexcept {
+    nb_internals &internals = internals_get();
+    nb_bound_method *mb = internals.nb_bound_method_freelist;
+
+    while (mb) {
+        nb_bound_method *next = (nb_bound_method *) mb->func;
+        PyObject_GC_Del(mb);
+        mb = next;
+    }
+
+    internals.nb_bound_method_freelist = nullptr;
+    internals.nb_bound_method_freelist_size = 0;
+    internals.nb_bound_method_freelist_capacity = 0;
+}
+
 static arg_data method_args[2] = {
     { "self", nullptr, nullptr, false, false },
     { nullptr, nullptr, nullptr, false, false }
@@ -166,12 +262,58 @@ void *malloc_check(size_t size) {
     return ptr;
 }
 
+/// Return the pooled copy of a signature (see nb_descr)
+static nb_descr *nb_descr_acquire(nb_internals &internals, const char *text,
+                                  const std::type_info **types) noexcept {
+    size_t ntypes = 0, hash = str_hash()(text);
+    while (types[ntypes])
+        hash = hash * 31 + ptr_hash()(types[ntypes++]);
+
+    size_t text_size = strlen(text) + 1,
+           types_size = sizeof(const std::type_info *) * (ntypes + 1);
+
+    nb_descr *d = (nb_descr *) malloc_check(offsetof(nb_descr, types) +
+                                            types_size + text_size);
+    char *text_copy = (char *) d->types + types_size;
+    memcpy(d->types, types, types_size);
+    memcpy(text_copy, text, text_size);
+    d->hash = hash;
+    d->ntypes = ntypes;
+    d->text = text_copy;
+
+    lock_internals guard(internals);
+    auto [it, success] = internals.descrs.try_emplace(d, 1);
+    if (!success) {
+        free(d);
+        d = it->first;
+        it.value()++;
+    }
+
+    return d;
+}
+
+/// Release a signature obtained from nb_descr_acquire()
+static void nb_descr_release(nb_internals &internals,
+                             const std::type_info **types) noexcept {
+    nb_descr *d = (nb_descr *) ((uint8_t *) types - offsetof(nb_descr, types));
+
+    lock_internals guard(internals);
+    nb_descr_map::iterator it = internals.descrs.find(d);
+    check(it != internals.descrs.end() && it->first == d,
+          "nanobind::detail::nb_descr_release(): signature not found!");
+
+    if (--it.value() == 0) {
+        internals.descrs.erase(it);
+        free(d);
+    }
+}
+
 /**
  * \brief Wrap a C++ function into a Python function object
  *
  * This is an implementation detail of nanobind::cpp_function.
  */
-PyObject *nb_func_new(const void *in_) noexcept {
+static PyObject *nb_func_new_impl(const void *in_, bool lazy) noexcept {
     func_data_prelim<0> *f = (func_data_prelim<0> *) in_;
     arg_data *args_in = std::launder((arg_data *) f->args);
 
@@ -189,6 +331,24 @@ PyObject *nb_func_new(const void *in_) noexcept {
     PyObject *func_prev = nullptr;
     nb_internals &internals = internals_get();
 
+#if defined(NB_FREE_THREADED)
+    // Lazy creation would require locking on every module attribute access
+    lazy = false;
+#endif
+
+    /* Within nb::release_gil_default scopes, functions that don't exchange
+       Python objects release the GIL unless specified otherwise */
+    if (internals.release_gil_depth &&
+        (f->flags & (uint32_t) func_flags::can_release_gil) &&
+        !(f->flags & (uint32_t) func_flags::has_release_gil) &&
+        !(has_name && strcmp(f->name, "__init__") == 0))
+        f->flags |= (uint32_t) func_flags::release_gil;
+
+    // Postpone the creation of named functions within nb::lazy_functions scopes
+    if (lazy && internals.lazy_depth && has_scope && has_name && !return_ref &&
+        nb_func_defer(internals, f, args_in, has_args ? f->nargs - is_method : 0))
+        return nullptr;
+
     // Check for previous overloads
     if (has_scope && has_name) {
         name = PyUnicode_FromString(f->name);
@@ -257,7 +417,9 @@ PyObject *nb_func_new(const void *in_) noexcept {
         memset(prev, 0, sizeof(func_data) * to_copy);
 
         ((PyVarObject *) func_prev)->ob_size = 0;
+        nb_dispatch_clear((nb_func *) func_prev);
 
+        lock_internals guard(internals);
         auto it = internals.funcs.find(func_prev);
         check(it != internals.funcs.end(),
               "nanobind::detail::nb_func_new(): internal update failed (1)!");
@@ -270,9 +432,12 @@ PyObject *nb_func_new(const void *in_) noexcept {
                                           : nb_func_vectorcall_simple;
 
     // Register the function
-    auto [it, success] = internals.funcs.try_emplace(func, nullptr);
-    check(success,
-          "nanobind::detail::nb_func_new(): internal update failed (2)!");
+    {
+        lock_internals guard(internals);
+        auto [it, success] = internals.funcs.try_emplace(func, nullptr);
+        check(success,
+              "nanobind::detail::nb_func_new(): internal update failed (2)!");
+    }
 
     func_data *fc = nb_func_data(func) + to_copy;
     memcpy(fc, f, sizeof(func_data_prelim<0>));
@@ -300,23 +465,9 @@ PyObject *nb_func_new(const void *in_) noexcept {
             implicitly_convertible(f->descr_types[1], f->descr_types[0]);
     }
 
-    for (size_t i = 0;; ++i) {
-        if (!f->descr[i]) {
-            fc->descr = (char *) malloc_check(sizeof(char) * (i + 1));
-            memcpy((char *) fc->descr, f->descr, (i + 1) * sizeof(char));
-            break;
-        }
-    }
-
-    for (size_t i = 0;; ++i) {
-        if (!f->descr_types[i]) {
-            fc->descr_types = (const std::type_info **)
-                malloc_check(sizeof(const std::type_info *) * (i + 1));
-            memcpy(fc->descr_types, f->descr_types,
-                        (i + 1) * sizeof(const std::type_info *));
-            break;
-        }
-    }
+    nb_descr *descr = nb_descr_acquire(internals, f->descr, f->descr_types);
+    fc->descr = descr->text;
+    fc->descr_types = descr->types;
 
     if (has_args) {
         fc->args = (arg_data *) malloc_check(sizeof(arg_data) * f->nargs);
@@ -335,8 +486,36 @@ PyObject *nb_func_new(const void *in_) noexcept {
             a.none |= a.value == Py_None;
             Py_XINCREF(a.value);
         }
+
+        // Build a table of keyword names sorted by address for dispatch
+        size_t nargs_pos = fc->nargs - has_var_args - has_var_kwargs, size = 0;
+        kwarg_entry *table =
+            (kwarg_entry *) malloc_check(sizeof(kwarg_entry) * (nargs_pos + 1));
+
+        for (size_t i = 0; i < nargs_pos; ++i) {
+            PyObject *name_py = fc->args[i].name_py;
+            if (!name_py)
+                continue;
+
+            size_t j = size++;
+            for (; j > 0 && (uintptr_t) table[j - 1].name > (uintptr_t) name_py; --j)
+                table[j] = table[j - 1];
+            table[j] = kwarg_entry{ name_py, i };
+        }
+
+        fc->kwargs_table = table;
+        fc->kwargs_table_size = size;
+    } else {
+        fc->kwargs_table = nullptr;
+        fc->kwargs_table_size = 0;
     }
 
+#if defined(NB_PERF_MAP)
+    fc->perf_stub = nullptr;
+    if (NB_UNLIKELY(internals.perf_map))
+        nb_func_perf_stub(fc, to_copy);
+#endif
+
     if (has_scope && name) {
         int rv = PyObject_SetAttr(f->scope, name, (PyObject *) func);
         check(rv == 0, "nb::detail::nb_func_new(\"%s\"): setattr. failed.",
@@ -353,6 +532,341 @@ PyObject *nb_func_new(const void *in_) noexcept {
     }
 }
 
+PyObject *nb_func_new(const void *in_) noexcept {
+#if defined(NB_PROFILE)
+    auto t0 = std::chrono::steady_clock::now();
+    PyObject *result = nb_func_new_impl(in_, true);
+
+    const func_data_prelim<0> *f = (const func_data_prelim<0> *) in_;
+    nb_profile_import(
+        "function",
+        (f->flags & (uint32_t) func_flags::has_scope) ? f->scope : nullptr,
+        (f->flags & (uint32_t) func_flags::has_name) ? f->name : "<anonymous>",
+        t0);
+
+    return result;
+#else
+    return nb_func_new_impl(in_, true);
+#endif
+}
+
+bool nb_func_has_direct(PyObject *o, const std::type_info *sig) noexcept {
+    nb_internals &internals = internals_get();
+    PyTypeObject *tp = Py_TYPE(o);
+
+    if (tp != internals.nb_func && tp != internals.nb_method)
+        return false;
+
+    if (Py_SIZE(o) != 1)
+        return false;
+
+    const func_data *f = nb_func_data(o);
+    return (f->flags & (uint32_t) func_flags::has_direct) &&
+           !(f->flags & (uint32_t) func_flags::is_constructor) &&
+           (f->direct_sig == sig || *f->direct_sig == *sig);
+}
+
+void *nb_func_direct(PyObject *o, void (**direct)(void)) noexcept {
+    // Adding an overload moves the function record to a new object
+    if (Py_SIZE(o) != 1)
+        return nullptr;
+
+    func_data *f = nb_func_data(o);
+    *direct = f->direct;
+    return f->capture;
+}
+
+/// Number of argument annotations stored in a function record
+static size_t nb_lazy_nargs(const func_data_prelim<0> *f) noexcept {
+    if (!(f->flags & (uint32_t) func_flags::has_args))
+        return 0;
+    return f->nargs - ((f->flags & (uint32_t) func_flags::is_method) ? 1 : 0);
+}
+
+/// Release a deferred function binding that was never created
+static void nb_lazy_func_free(nb_lazy_func *rec) noexcept {
+    func_data_prelim<0> *f = &rec->f;
+    if (f->flags & (uint32_t) func_flags::has_free)
+        f->free(f->capture);
+    arg_data *args = std::launder((arg_data *) f->args);
+    for (size_t i = 0, n = nb_lazy_nargs(f); i < n; ++i)
+        Py_XDECREF(args[i].value);
+    free(rec);
+}
+
+/// Create the function object(s) of a list of deferred overloads
+static void nb_lazy_func_create(nb_lazy_func *rec) noexcept {
+    // Restore the original registration order
+    nb_lazy_func *prev = nullptr;
+    while (rec) {
+        nb_lazy_func *next = rec->next;
+        rec->next = prev;
+        prev = rec;
+        rec = next;
+    }
+
+    for (rec = prev; rec; ) {
+        nb_lazy_func *next = rec->next;
+        func_data_prelim<0> *f = &rec->f;
+        nb_func_new_impl(f, false);
+
+        // nb_func_new_impl() acquired its own references to default arguments
+        arg_data *args = std::launder((arg_data *) f->args);
+        for (size_t i = 0, n = nb_lazy_nargs(f); i < n; ++i)
+            Py_XDECREF(args[i].value);
+
+        free(rec);
+        rec = next;
+    }
+}
+
+static void nb_lazy_table_free(nb_lazy_table *table) noexcept {
+    for (auto [key, rec] : table->funcs) {
+        (void) key;
+        while (rec) {
+            nb_lazy_func *next = rec->next;
+            nb_lazy_func_free(rec);
+            rec = next;
+        }
+    }
+    delete table;
+}
+
+static void nb_lazy_capsule_free(PyObject *capsule) noexcept {
+    nb_lazy_table *table =
+        (nb_lazy_table *) PyCapsule_GetPointer(capsule, nullptr);
+    internals_get().lazy_funcs.erase(table->scope);
+    nb_lazy_table_free(table);
+}
+
+/// Module-level ``__getattr__`` that creates deferred functions on demand
+static PyObject *nb_lazy_module_getattr(PyObject *capsule, PyObject *name) {
+    nb_lazy_table *table =
+        (nb_lazy_table *) PyCapsule_GetPointer(capsule, nullptr);
+
+    const char *name_cstr = PyUnicode_AsUTF8AndSize(name, nullptr);
+    if (!name_cstr)
+        return nullptr;
+
+    auto it = table->funcs.find(name_cstr);
+    if (it == table->funcs.end()) {
+        PyObject *scope_name = PyModule_GetNameObject(table->scope);
+        if (scope_name) {
+            PyErr_Format(PyExc_AttributeError,
+                         "module '%U' has no attribute '%U'", scope_name, name);
+            Py_DECREF(scope_name);
+        }
+        return nullptr;
+    }
+
+    nb_lazy_func *rec = it->second;
+    table->funcs.erase(it);
+    nb_lazy_func_create(rec);
+
+    return PyObject_GetAttr(table->scope, name);
+}
+
+/// Module-level ``__dir__`` that also reports deferred functions
+static PyObject *nb_lazy_module_dir(PyObject *capsule, PyObject *) {
+    nb_lazy_table *table =
+        (nb_lazy_table *) PyCapsule_GetPointer(capsule, nullptr);
+
+    PyObject *result = PyDict_Keys(PyModule_GetDict(table->scope));
+    if (!result)
+        return nullptr;
+
+    for (auto [key, rec] : table->funcs) {
+        (void) rec;
+        PyObject *name = PyUnicode_FromString(key);
+        if (!name || PyList_Append(result, name)) {
+            Py_XDECREF(name);
+            Py_DECREF(result);
+            return nullptr;
+        }
+        Py_DECREF(name);
+    }
+
+    return result;
+}
+
+static PyMethodDef nb_lazy_module_getattr_def = {
+    "__getattr__", (PyCFunction) nb_lazy_module_getattr, METH_O, nullptr
+};
+
+static PyMethodDef nb_lazy_module_dir_def = {
+    "__dir__", (PyCFunction) nb_lazy_module_dir, METH_NOARGS, nullptr
+};
+
+/// Create an empty table of deferred functions for the given scope
+static nb_lazy_table *nb_lazy_table_new(nb_internals &internals,
+                                        PyObject *scope) noexcept {
+    nb_lazy_table *table = new nb_lazy_table();
+    table->scope = scope;
+
+    if (PyType_Check(scope) && nb_type_check(scope)) {
+        nb_type_data((PyTypeObject *) scope)->flags |=
+            (uint32_t) type_flags::has_lazy_funcs;
+        internals.lazy_types++;
+    } else if (PyModule_Check(scope)) {
+        PyObject *dict = PyModule_GetDict(scope);
+
+        // Don't interfere with a user-provided module-level __getattr__
+        if (PyDict_GetItemString(dict, "__getattr__")) {
+            delete table;
+            return nullptr;
+        }
+
+        PyObject *capsule = PyCapsule_New(table, nullptr, nb_lazy_capsule_free);
+        check(capsule, "nb::detail::nb_lazy_table_new(): capsule creation failed!");
+
+        PyObject *getattr =
+                     PyCFunction_NewEx(&nb_lazy_module_getattr_def, capsule, nullptr),
+                 *dir = PyCFunction_NewEx(&nb_lazy_module_dir_def, capsule, nullptr);
+        Py_DECREF(capsule);
+
+        check(getattr && dir &&
+              PyDict_SetItemString(dict, "__getattr__", getattr) == 0 &&
+              PyDict_SetItemString(dict, "__dir__", dir) == 0,
+              "nb::detail::nb_lazy_table_new(): could not install hooks!");
+
+        Py_DECREF(getattr);
+        Py_DECREF(dir);
+    } else {
+        delete table;
+        return nullptr;
+    }
+
+    internals.lazy_funcs[scope] = table;
+    return table;
+}
+
+/**
+ * Store a copy of a function record so that the associated function object
+ * can be created later on. Functions of a module are created upon first access
+ * via a module-level ``__getattr__``. Functions of a type are all created
+ * together once the type or one of its instances is first used. Special
+ * methods (which must be visible to the type slot machinery) are never
+ * deferred. Returns ``false`` if the function must be created immediately.
+ */
+static bool nb_func_defer(nb_internals &internals, func_data_prelim<0> *f,
+                          arg_data *args_in, size_t nargs_in) noexcept {
+    if (f->name[0] == '_' && f->name[1] == '_')
+        return false;
+
+    nb_lazy_table *table;
+    nb_lazy_map::iterator it = internals.lazy_funcs.find(f->scope);
+    if (it != internals.lazy_funcs.end())
+        table = it->second;
+    else
+        table = nb_lazy_table_new(internals, f->scope);
+
+    if (!table)
+        return false;
+
+    size_t ntypes = 0;
+    while (f->descr_types[ntypes])
+        ntypes++;
+
+    nb_lazy_func *rec = (nb_lazy_func *) malloc_check(
+        sizeof(nb_lazy_func) + sizeof(arg_data) * nargs_in +
+        sizeof(const std::type_info *) * (ntypes + 1));
+
+    memcpy(&rec->f, f, sizeof(func_data_prelim<0>));
+
+    arg_data *args = std::launder((arg_data *) rec->f.args);
+    for (size_t i = 0; i < nargs_in; ++i) {
+        args[i] = args_in[i];
+        Py_XINCREF(args[i].value);
+    }
+
+    // The type list of the signature may reside on the caller's stack
+    rec->f.descr_types = (const std::type_info **) (args + nargs_in);
+    memcpy(rec->f.descr_types, f->descr_types,
+           sizeof(const std::type_info *) * (ntypes + 1));
+
+    nb_lazy_func *&head = table->funcs[f->name];
+    rec->next = head;
+    head = rec;
+
+    return true;
+}
+
+/// Create the deferred functions of a type and its base classes
+void nb_lazy_materialize(PyTypeObject *tp) noexcept {
+    nb_internals &internals = internals_get();
+
+    while (tp && nb_type_check((PyObject *) tp)) {
+        type_data *t = nb_type_data(tp);
+
+        if (t->flags & (uint32_t) type_flags::has_lazy_funcs) {
+            t->flags &= ~(uint32_t) type_flags::has_lazy_funcs;
+
+            nb_lazy_map::iterator it = internals.lazy_funcs.find((PyObject *) tp);
+            if (it != internals.lazy_funcs.end()) {
+                nb_lazy_table *table = it->second;
+                internals.lazy_funcs.erase(it);
+                internals.lazy_types--;
+
+                for (auto [key, rec] : table->funcs) {
+                    (void) key;
+                    nb_lazy_func_create(rec);
+                }
+                delete table;
+            }
+        }
+
+#if defined(Py_LIMITED_API)
+        tp = (PyTypeObject *) PyType_GetSlot(tp, Py_tp_base);
+#else
+        tp = tp->tp_base;
+#endif
+    }
+}
+
+/// Does the type or one of its base classes have a deferred function 'name'?
+bool nb_lazy_pending(PyTypeObject *tp, PyObject *name) noexcept {
+    nb_internals &internals = internals_get();
+    const char *name_cstr = nullptr;
+
+    while (tp && nb_type_check((PyObject *) tp)) {
+        if (nb_type_data(tp)->flags & (uint32_t) type_flags::has_lazy_funcs) {
+            nb_lazy_map::iterator it = internals.lazy_funcs.find((PyObject *) tp);
+            if (it != internals.lazy_funcs.end()) {
+                if (!name_cstr) {
+                    name_cstr = PyUnicode_AsUTF8AndSize(name, nullptr);
+                    if (!name_cstr) {
+                        PyErr_Clear();
+                        return false;
+                    }
+                }
+                if (it->second->funcs.find(name_cstr) != it->second->funcs.end())
+                    return true;
+            }
+        }
+
+#if defined(Py_LIMITED_API)
+        tp = (PyTypeObject *) PyType_GetSlot(tp, Py_tp_base);
+#else
+        tp = tp->tp_base;
+#endif
+    }
+
+    return false;
+}
+
+/// Release the deferred functions of a type that is being deallocated
+void nb_lazy_type_free(PyTypeObject *tp) noexcept {
+    nb_internals &internals = internals_get();
+    nb_lazy_map::iterator it = internals.lazy_funcs.find((PyObject *) tp);
+    if (it == internals.lazy_funcs.end())
+        return;
+
+    nb_lazy_table *table = it->second;
+    internals.lazy_funcs.erase(it);
+    internals.lazy_types--;
+    nb_lazy_table_free(table);
+}
+
 /// Used by nb_func_vectorcall: generate an error when overload resolution fails
 static NB_NOINLINE PyObject *
 nb_func_error_overload(PyObject *self, PyObject *const *args_in,
@@ -365,88 +879,777 @@ nb_func_error_overload(PyObject *self, PyObject *const *args_in,
         return Py_NotImplemented;
     }
 
-    buf.clear();
-    buf.put_dstr(f->name);
-    buf.put("(): incompatible function arguments. The following argument types "
-            "are supported:\n");
+    buf.clear();
+    buf.put_dstr(f->name);
+    buf.put("(): incompatible function arguments. The following argument types "
+            "are supported:\n");
+
+    for (uint32_t i = 0; i < count; ++i) {
+        buf.put("    ");
+        buf.put_uint32(i + 1);
+        buf.put(". ");
+        nb_func_render_signature(f + i);
+        buf.put('\n');
+    }
+
+    buf.put("\nInvoked with types: ");
+    for (size_t i = 0; i < nargs_in; ++i) {
+        str name = steal<str>(nb_inst_name(args_in[i]));
+        buf.put_dstr(name.c_str());
+        if (i + 1 < nargs_in)
+            buf.put(", ");
+    }
+
+    if (kwargs_in) {
+        if (nargs_in)
+            buf.put(", ");
+        buf.put("kwargs = { ");
+
+        size_t nkwargs_in = (size_t) NB_TUPLE_GET_SIZE(kwargs_in);
+        for (size_t j = 0; j < nkwargs_in; ++j) {
+            PyObject *key   = NB_TUPLE_GET_ITEM(kwargs_in, j),
+                     *value = args_in[nargs_in + j];
+
+            const char *key_cstr = PyUnicode_AsUTF8AndSize(key, nullptr);
+            buf.put_dstr(key_cstr);
+            buf.put(": ");
+            str name = steal<str>(nb_inst_name(value));
+            buf.put_dstr(name.c_str());
+            buf.put(", ");
+        }
+        buf.rewind(2);
+        buf.put(" }");
+    }
+
+    PyErr_SetString(PyExc_TypeError, buf.get());
+    return nullptr;
+}
+
+/// Used by nb_func_vectorcall: generate an error when result conversion fails
+static NB_NOINLINE PyObject *nb_func_error_noconvert(PyObject *self,
+                                                     PyObject *const *, size_t,
+                                                     PyObject *) noexcept {
+    if (PyErr_Occurred())
+        return nullptr;
+    func_data *f = nb_func_data(self);
+    buf.clear();
+    buf.put("Unable to convert function return value to a Python "
+            "type! The signature was\n    ");
+    nb_func_render_signature(f);
+    PyErr_SetString(PyExc_TypeError, buf.get());
+    return nullptr;
+}
+
+/**
+ * \brief Used by nb_func_vectorcall: convert a C++ exception into a Python error
+ *
+ * Translators are tried in order of registration (most recent first), and
+ * each of them re-throws exceptions that it does not handle. Where the type of
+ * the in-flight exception can be determined, the translator that handled it
+ * the last time is tried first. The cache is only updated when the exception
+ * reached the translator unchanged, and it is invalidated whenever a new
+ * translator is registered. Translators never run while the internals lock is
+ * held, since they may call back into Python.
+ */
+static NB_NOINLINE void nb_func_convert_cpp_exception() noexcept {
+    std::exception_ptr e = std::current_exception();
+    nb_internals &internals = internals_get();
+
+#if defined(__GNUG__)
+    const std::type_info *type = abi::__cxa_current_exception_type();
+
+    if (type) {
+        nb_translator_seq cached { };
+        {
+            lock_internals guard(internals);
+            auto it = internals.translator_cache.find(type);
+            if (it != internals.translator_cache.end())
+                cached = it->second;
+        }
+
+        if (cached.translator) {
+            try {
+                cached.translator(e, cached.payload);
+                return;
+            } catch (...) { }
+        }
+    }
+#endif
+
+    // Only the head of the list is modified by new registrations
+    nb_translator_seq head;
+    {
+        lock_internals guard(internals);
+        head = internals.translators;
+    }
+
+    nb_translator_seq *cur = &head;
+
+    while (cur) {
+        try {
+            // Try exception translator & forward payload
+            cur->translator(e, cur->payload);
+
+#if defined(__GNUG__)
+            if (type && e == std::current_exception()) {
+                lock_internals guard(internals);
+                internals.translator_cache[type] =
+                    nb_translator_seq{ cur->translator, cur->payload };
+            }
+#endif
+            return;
+        } catch (...) {
+            e = std::current_exception();
+        }
+
+        cur = cur->next;
+    }
+
+    PyErr_SetString(PyExc_SystemError,
+                    "nanobind::detail::nb_func_error_except(): exception "
+                    "could not be translated!");
+}
+
+void translate_exception() noexcept {
+    try {
+        throw;
+    } catch (builtin_exception &e) {
+        if (!set_builtin_exception_status(e))
+            PyErr_SetString(PyExc_SystemError,
+                            "nanobind::detail::translate_exception(): "
+                            "next_overload raised outside of a function "
+                            "binding!");
+    } catch (python_error &e) {
+        e.restore();
+    } catch (...) {
+        nb_func_convert_cpp_exception();
+    }
+}
+
+// ========================================================================
+
+/// Incremented by SIGINT, polled by nb::interrupt_token
+static std::atomic<uint32_t> interrupt_count { 0 };
+static_assert(sizeof(interrupt_count) == sizeof(uint32_t),
+              "interrupt_count must be layout-compatible with uint32_t!");
+
+/* Number of interrupt tokens created so far. Function dispatch only checks
+   for observed interruptions when this changed during the call, which keeps
+   the thread-local flag below off the common path. */
+static std::atomic<uint32_t> interrupt_arms { 0 };
+
+/* Set when an interrupt token created on the current thread that reported an
+   interruption is destroyed. Tokens may be destroyed on other threads, hence
+   the atomic. Cleared by the function dispatcher that returns next. */
+static NB_THREAD_LOCAL std::atomic<uint32_t> interrupt_observed { 0 };
+static_assert(sizeof(interrupt_observed) == sizeof(uint32_t),
+              "interrupt_observed must be layout-compatible with uint32_t!");
+
+/// Handler of SIGINT (normally Python's) that was replaced by interrupt_signal()
+using interrupt_handler = void (*)(int);
+static std::atomic<interrupt_handler> interrupt_prev { nullptr };
+
+static void interrupt_signal(int sig) {
+    interrupt_count.fetch_add(1, std::memory_order_relaxed);
+    interrupt_handler prev = interrupt_prev.load(std::memory_order_relaxed);
+    if (prev)
+        prev(sig);
+#if defined(_WIN32)
+    // The CRT resets the handler, and Python's handler reinstalls itself
+    signal(SIGINT, interrupt_signal);
+#endif
+}
+
+/* Install interrupt_signal() in front of the current SIGINT handler. Nothing
+   is done if SIGINT isn't handled (e.g., in embedded interpreters), and later
+   changes via signal.signal() replace the hook. */
+static bool interrupt_install() noexcept {
+#if defined(_WIN32)
+    interrupt_handler prev = signal(SIGINT, SIG_IGN);
+    if (prev == SIG_ERR)
+        return false;
+    if (prev == SIG_DFL || prev == SIG_IGN) {
+        signal(SIGINT, prev);
+        return false;
+    }
+    interrupt_prev = prev;
+    signal(SIGINT, interrupt_signal);
+#else
+    struct sigaction sa;
+    if (sigaction(SIGINT, nullptr, &sa) != 0 || (sa.sa_flags & SA_SIGINFO) ||
+        sa.sa_handler == SIG_DFL || sa.sa_handler == SIG_IGN)
+        return false;
+    interrupt_prev = sa.sa_handler;
+    sa.sa_handler = interrupt_signal;
+    sigaction(SIGINT, &sa, nullptr);
+#endif
+    return true;
+}
+
+const uint32_t *interrupt_arm(uint32_t *armed, uint32_t **observed) noexcept {
+    static bool installed = interrupt_install();
+    (void) installed;
+
+    interrupt_arms.fetch_add(1, std::memory_order_relaxed);
+    *armed = interrupt_count.load(std::memory_order_relaxed);
+    *observed = (uint32_t *) &interrupt_observed;
+    return (const uint32_t *) &interrupt_count;
+}
+
+/**
+ * Raise the exception of an interruption that was observed during a function
+ * call. On the main thread, this invokes the Python-level signal handler
+ * (which normally raises KeyboardInterrupt). Other threads, cancelled tokens,
+ * or handlers that don't raise produce a KeyboardInterrupt.
+ */
+static NB_NOINLINE PyObject *interrupt_raise(PyObject *result) noexcept {
+    if (!interrupt_observed.exchange(0, std::memory_order_relaxed) ||
+        !result || result == NB_NEXT_OVERLOAD)
+        return result;
+
+    if (PyErr_CheckSignals() == 0)
+        PyErr_SetNone(PyExc_KeyboardInterrupt);
+    Py_DECREF(result);
+    return nullptr;
+}
+
+/**
+ * \brief Used by nb_func_vectorcall: invoke a single overload
+ *
+ * Returns the result of the call, ``NB_NEXT_OVERLOAD`` if the overload could
+ * not handle the provided arguments, or ``nullptr`` when an error occurred. In
+ * the latter case, a Python error is set unless the return value conversion
+ * failed (see ``nb_func_error_noconvert``).
+ */
+static NB_INLINE PyObject *nb_func_invoke_impl(const func_data *f,
+                                               PyObject **args,
+                                               uint8_t *args_flags,
+                                               cleanup_list *cleanup,
+                                               int pass) noexcept {
+    PyObject *result = nullptr;
+    bool translated = true;
+    (void) pass; (void) translated;
+
+    // Interruptions are reported to the call that created the token
+    uint32_t arms = interrupt_arms.load(std::memory_order_relaxed);
+
+#if defined(NB_PROFILE)
+    nb_profile_data *profile = &((func_data *) f)->profile,
+                    *profile_prev = profile_current;
+    profile_current = profile;
+    auto t0 = std::chrono::steady_clock::now();
+#endif
+
+    try {
+        result = f->impl((void *) f->capture, args, args_flags,
+                         (rv_policy) (f->flags & 0b111), cleanup);
+        translated = false;
+    } catch (builtin_exception &e) {
+        if (!set_builtin_exception_status(e)) {
+            result = NB_NEXT_OVERLOAD;
+            translated = false;
+        }
+    } catch (python_error &e) {
+        e.restore();
+    } catch (...) {
+        nb_func_convert_cpp_exception();
+    }
+
+    if (NB_UNLIKELY(interrupt_arms.load(std::memory_order_relaxed) != arms))
+        result = interrupt_raise(result);
+
+#if defined(NB_PROFILE)
+    auto t1 = std::chrono::steady_clock::now();
+    profile->time_ns += (uint64_t)
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    profile_current = profile_prev;
+
+    if (result == NB_NEXT_OVERLOAD)
+        profile->misses[pass]++;
+    else
+        profile->calls++;
+
+    if (translated)
+        profile->exceptions++;
+#endif
+
+    return result;
+}
+
+#if defined(NB_PERF_MAP)
+using nb_func_invoke_fn = PyObject *(*) (const func_data *, PyObject **,
+                                         uint8_t *, cleanup_list *,
+                                         int) noexcept;
+
+/// Target of the stubs created by nb::set_perf_map()
+static NB_NOINLINE PyObject *nb_func_invoke_perf(const func_data *f,
+                                                 PyObject **args,
+                                                 uint8_t *args_flags,
+                                                 cleanup_list *cleanup,
+                                                 int pass) noexcept {
+    return nb_func_invoke_impl(f, args, args_flags, cleanup, pass);
+}
+#endif
+
+static NB_INLINE PyObject *nb_func_invoke(const func_data *f, PyObject **args,
+                                          uint8_t *args_flags,
+                                          cleanup_list *cleanup,
+                                          int pass) noexcept {
+#if defined(NB_PERF_MAP)
+    void *stub = __atomic_load_n(&f->perf_stub, __ATOMIC_ACQUIRE);
+    if (NB_UNLIKELY(stub))
+        return ((nb_func_invoke_fn) stub)(f, args, args_flags, cleanup, pass);
+#endif
+    return nb_func_invoke_impl(f, args, args_flags, cleanup, pass);
+}
+
+#if defined(NB_PERF_MAP)
+/* A stub sets up a stack frame and calls nb_func_invoke_perf(), whose address
+   follows the code. Profilers that walk frame pointers thus see a return
+   address within the stub, which they resolve via /tmp/perf-<pid>.map. The
+   callee catches all C++ exceptions, hence the stub needs no unwind info for
+   exception handling. DWARF-based unwinders (perf --call-graph=dwarf, gdb)
+   can't step through it, however. */
+#if defined(__x86_64__)
+static const uint8_t perf_stub_code[] = {
+    0x55,                               // push %rbp
+    0x48, 0x89, 0xe5,                   // mov  %rsp, %rbp
+    0xff, 0x15, 0x06, 0x00, 0x00, 0x00, // call *6(%rip)
+    0x5d,                               // pop  %rbp
+    0xc3,                               // ret
+    0xcc, 0xcc, 0xcc, 0xcc              // int3 (padding)
+};
+#else
+static const uint32_t perf_stub_code[] = {
+    0xa9bf7bfd, // stp x29, x30, [sp, #-16]!
+    0x910003fd, // mov x29, sp
+    0x58000090, // ldr x16, #16
+    0xd63f0200, // blr x16
+    0xa8c17bfd, // ldp x29, x30, [sp], #16
+    0xd65f03c0  // ret
+};
+#endif
+
+static constexpr size_t perf_stub_size = 32, perf_arena_size = 64 * 1024;
+static_assert(sizeof(perf_stub_code) + sizeof(void *) <= perf_stub_size);
+
+/// Remaining stubs of the current arena, and fallback perf map (Python < 3.12)
+static std::mutex perf_mutex;
+static uint8_t *perf_stub_next = nullptr, *perf_stub_end = nullptr;
+static FILE *perf_map_file = nullptr;
+
+/// Allocate a stub. Arenas are filled and then made executable (never writable)
+static void *perf_stub_alloc() noexcept {
+    if (perf_stub_next == perf_stub_end) {
+        void *p = mmap(nullptr, perf_arena_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            return nullptr;
+
+        uint8_t *arena = (uint8_t *) p;
+        nb_func_invoke_fn target = nb_func_invoke_perf;
+        for (size_t i = 0; i < perf_arena_size; i += perf_stub_size) {
+            memcpy(arena + i, perf_stub_code, sizeof(perf_stub_code));
+            memcpy(arena + i + sizeof(perf_stub_code), &target, sizeof(void *));
+        }
+
+        __builtin___clear_cache((char *) arena, (char *) arena + perf_arena_size);
+        if (mprotect(p, perf_arena_size, PROT_READ | PROT_EXEC)) {
+            munmap(p, perf_arena_size);
+            return nullptr;
+        }
+
+        perf_stub_next = arena;
+        perf_stub_end = arena + perf_arena_size;
+    }
+
+    void *stub = perf_stub_next;
+    perf_stub_next += perf_stub_size;
+    return stub;
+}
+
+static void perf_map_write(const void *addr, const char *name) noexcept {
+#if PY_VERSION_HEX >= 0x030C0000 && !defined(Py_LIMITED_API) && \
+    !defined(PYPY_VERSION)
+    // Shares the perf map with CPython's own trampolines ('python -X perf')
+    PyUnstable_WritePerfMapEntry(addr, (unsigned int) perf_stub_size, name);
+#else
+    if (!perf_map_file) {
+        char path[64];
+        snprintf(path, sizeof(path), "/tmp/perf-%ld.map", (long) getpid());
+        perf_map_file = fopen(path, "a");
+        if (!perf_map_file)
+            return;
+    }
+
+    fprintf(perf_map_file, "%" PRIxPTR " %zx %s\n", (uintptr_t) addr,
+            perf_stub_size, name);
+    fflush(perf_map_file);
+#endif
+}
+
+/// Route calls of overload 'index' of a function through a named stub
+static void nb_func_perf_stub(func_data *f, size_t index) noexcept {
+    PyObject *scope = (f->flags & (uint32_t) func_flags::has_scope) ? f->scope
+                                                                     : nullptr,
+             *module = nullptr, *qualname = nullptr, *name;
+
+    if (scope && (f->flags & (uint32_t) func_flags::has_name)) {
+        bool is_module = PyModule_Check(scope);
+        module = PyObject_GetAttrString(scope, is_module ? "__name__"
+                                                         : "__module__");
+        if (!is_module)
+            qualname = PyObject_GetAttrString(scope, "__qualname__");
+        PyErr_Clear();
+    }
+
+    const char *fname = (f->flags & (uint32_t) func_flags::has_name)
+                            ? f->name : "<anonymous>";
+    if (module && qualname)
+        name = PyUnicode_FromFormat("nb::%S.%S.%s", module, qualname, fname);
+    else if (module)
+        name = PyUnicode_FromFormat("nb::%S.%s", module, fname);
+    else
+        name = PyUnicode_FromFormat("nb::%s", fname);
+
+    if (name && index > 0) {
+        PyObject *tmp = PyUnicode_FromFormat("%U (overload %zu)", name,
+                                             index + 1);
+        Py_DECREF(name);
+        name = tmp;
+    }
+
+    const char *name_str = name ? PyUnicode_AsUTF8AndSize(name, nullptr)
+                                : nullptr;
+    if (name_str) {
+        std::lock_guard<std::mutex> guard(perf_mutex);
+        void *stub = __atomic_load_n(&f->perf_stub, __ATOMIC_RELAXED)
+                         ? nullptr : perf_stub_alloc();
+        if (stub) {
+            perf_map_write(stub, name_str);
+            __atomic_store_n(&f->perf_stub, stub, __ATOMIC_RELEASE);
+        }
+    }
+
+    PyErr_Clear();
+    Py_XDECREF(name);
+    Py_XDECREF(qualname);
+    Py_XDECREF(module);
+}
+#endif
+
+void set_perf_map(bool value) noexcept {
+    nb_internals &internals = internals_get();
+    internals.perf_map = value;
+
+#if defined(NB_PERF_MAP)
+    if (!value)
+        return;
+
+    // Also name the functions that already exist
+    std::vector<PyObject *> funcs;
+    {
+        lock_internals guard(internals);
+        funcs.reserve(internals.funcs.size());
+        for (auto [func, p] : internals.funcs) {
+            (void) p;
+            Py_INCREF((PyObject *) func);
+            funcs.push_back((PyObject *) func);
+        }
+    }
+
+    for (PyObject *func : funcs) {
+        func_data *f = nb_func_data(func);
+        for (size_t i = 0; i < (size_t) Py_SIZE(func); ++i) {
+            if (!__atomic_load_n(&f[i].perf_stub, __ATOMIC_RELAXED))
+                nb_func_perf_stub(f + i, i);
+        }
+        Py_DECREF(func);
+    }
+#endif
+}
+
+/// Used by nb_func_vectorcall: mark a successfully constructed instance as ready
+static NB_INLINE void nb_func_constructed(PyObject *self_arg,
+                                          uint32_t self_flags) noexcept {
+    nb_inst *self_arg_nb = (nb_inst *) self_arg;
+    self_arg_nb->destruct = true;
+    self_arg_nb->ready = true;
+
+    if (NB_UNLIKELY(self_flags & (uint32_t) type_flags::intrusive_ptr))
+        nb_type_data(Py_TYPE(self_arg))
+            ->set_self_py(inst_ptr(self_arg_nb), self_arg);
+}
+
+/// Can overloads be skipped based on the type 'tp' alone?
+static NB_INLINE bool nb_dispatch_cacheable(PyTypeObject *tp) noexcept {
+    return tp == &PyFloat_Type || tp == &PyBool_Type ||
+           nb_type_check((PyObject *) tp);
+}
+
+/// Find the cache entry matching the types of the given positional arguments
+static NB_INLINE const nb_dispatch_entry *
+nb_dispatch_lookup(nb_func *func, PyObject *const *args,
+                   size_t nargs) noexcept {
+    nb_dispatch_cache *cache = func->dispatch_cache;
+    if (!cache || nargs > NB_MAXARGS_SIMPLE)
+        return nullptr;
+
+    for (uint32_t i = 0; i < NB_DISPATCH_CACHE_SIZE; ++i) {
+        const nb_dispatch_entry &e = cache->entries[i];
+        if (e.nargs != nargs || e.pass > 1)
+            continue;
+
+        size_t j = 0;
+        while (j < nargs && e.types[j] == Py_TYPE(args[j]))
+            ++j;
+
+        if (j == nargs)
+            return &e;
+    }
+
+    return nullptr;
+}
+
+/// Record that overload 'index' accepted the given arguments during 'pass'
+static NB_NOINLINE void nb_dispatch_store(nb_func *func, PyObject *const *args,
+                                          size_t nargs, size_t index,
+                                          int pass) noexcept {
+#if defined(NB_FREE_THREADED)
+    /* Concurrent calls would race on the unsynchronized cache entries, and a
+       lock would cost more than the cache saves. The cache is never created,
+       hence nb_dispatch_lookup() always misses. */
+    (void) func; (void) args; (void) nargs; (void) index; (void) pass;
+#else
+    if (nargs > NB_MAXARGS_SIMPLE)
+        return;
+
+    for (size_t i = 0; i < nargs; ++i) {
+        if (!nb_dispatch_cacheable(Py_TYPE(args[i])))
+            return;
+    }
+
+    nb_dispatch_cache *cache = func->dispatch_cache;
+    if (!cache) {
+        cache = (nb_dispatch_cache *) PyMem_Malloc(sizeof(nb_dispatch_cache));
+        if (!cache)
+            return;
+        for (uint32_t i = 0; i < NB_DISPATCH_CACHE_SIZE; ++i)
+            cache->entries[i] = nb_dispatch_entry{ {}, 0, 0, 2 }; // unused
+        cache->next = 0;
+        func->dispatch_cache = cache;
+    }
+
+    // Replace a stale entry with the same key, or evict in round-robin order
+    nb_dispatch_entry *e = (nb_dispatch_entry *)
+        nb_dispatch_lookup(func, args, nargs);
+    if (!e) {
+        e = &cache->entries[cache->next];
+        cache->next = (cache->next + 1) % NB_DISPATCH_CACHE_SIZE;
+    }
+
+    for (uint32_t i = 0; i < e->nargs && e->pass <= 1; ++i)
+        Py_DECREF((PyObject *) e->types[i]);
+
+    for (size_t i = 0; i < nargs; ++i) {
+        PyTypeObject *tp = Py_TYPE(args[i]);
+        Py_INCREF((PyObject *) tp);
+        e->types[i] = tp;
+    }
+
+    e->nargs = (uint32_t) nargs;
+    e->index = (uint32_t) index;
+    e->pass = (uint32_t) pass;
+#endif
+}
+
+/// Release the overload cache of a function (e.g., when it is redefined)
+static void nb_dispatch_clear(nb_func *func) noexcept {
+    nb_dispatch_cache *cache = func->dispatch_cache;
+    if (!cache)
+        return;
+
+    func->dispatch_cache = nullptr;
+
+    for (uint32_t i = 0; i < NB_DISPATCH_CACHE_SIZE; ++i) {
+        const nb_dispatch_entry &e = cache->entries[i];
+        if (e.pass > 1)
+            continue;
+        for (uint32_t j = 0; j < e.nargs; ++j)
+            Py_DECREF((PyObject *) e.types[j]);
+    }
+
+    PyMem_Free(cache);
+}
+
+/**
+ * \brief Used by nb_func_vectorcall_complex: find the positional argument of
+ * overload 'f' named 'key'
+ *
+ * Keyword names are usually interned, in which case a binary search by address
+ * suffices. Other strings are compared by value. Returns ``(size_t) -1`` when
+ * the overload has no argument of this name.
+ */
+static NB_INLINE size_t nb_func_kwarg_index(const func_data *f,
+                                            PyObject *key) noexcept {
+    const kwarg_entry *table = f->kwargs_table;
+    size_t lo = 0, hi = f->kwargs_table_size;
+
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        uintptr_t name = (uintptr_t) table[mid].name;
+
+        if (name == (uintptr_t) key)
+            return table[mid].index;
+        else if (name < (uintptr_t) key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+#if !defined(PYPY_VERSION) && !defined(Py_LIMITED_API)
+    if (PyUnicode_CHECK_INTERNED(key))
+        return (size_t) -1;
+#endif
+
+    for (size_t i = 0; i < f->kwargs_table_size; ++i) {
+        if (PyUnicode_Compare(key, table[i].name) == 0)
+            return table[i].index;
+    }
+
+    return (size_t) -1;
+}
+
+/**
+ * \brief Used by nb_func_vectorcall_complex: map the provided positional and
+ * keyword arguments onto the parameters of the overload 'f'
+ *
+ * Returns ``false`` when the arguments are incompatible with this overload.
+ */
+static NB_INLINE bool
+nb_func_prepare_args(const func_data *f, int pass, bool single,
+                     bool is_constructor,
+                     PyObject *const *args_in, size_t nargs_in,
+                     PyObject *kwargs_in, size_t nkwargs_in, PyObject **args,
+                     uint8_t *args_flags, bool *kwarg_used,
+                     cleanup_list &cleanup) noexcept {
+    const bool has_args       = f->flags & (uint32_t) func_flags::has_args,
+               has_var_args   = f->flags & (uint32_t) func_flags::has_var_args,
+               has_var_kwargs = f->flags & (uint32_t) func_flags::has_var_kwargs;
+
+    /// Number of positional arguments
+    size_t nargs_pos = f->nargs - has_var_args - has_var_kwargs;
+
+    // Iterators may only be consumed when no other overload will be tried
+    const uint8_t convert_flags =
+        single ? (uint8_t) (cast_flags::convert | cast_flags::consume)
+               : (uint8_t) cast_flags::convert;
+
+    if (nargs_in > nargs_pos && !has_var_args)
+        return false; // Too many positional arguments given for this overload
+
+    if (nargs_in < nargs_pos && !has_args)
+        return false; // Not enough positional arguments, insufficient
+                      // keyword/default arguments to fill in the blanks
+
+    memset(kwarg_used, 0, nkwargs_in * sizeof(bool));
+
+    // 0. Assign keyword arguments to the named positional arguments
+    if (kwargs_in && has_args) {
+        memset(args, 0, nargs_pos * sizeof(PyObject *));
+
+        for (size_t j = 0; j < nkwargs_in; ++j) {
+            size_t index =
+                nb_func_kwarg_index(f, NB_TUPLE_GET_ITEM(kwargs_in, j));
+
+            if (index < nargs_pos) {
+                args[index] = args_in[nargs_in + j];
+                kwarg_used[j] = true;
+            }
+        }
+    }
+
+    // 1. Copy positional arguments, potentially substitute kwargs/defaults
+    size_t i = 0;
+    for (; i < nargs_pos; ++i) {
+        PyObject *arg = nullptr;
+        bool arg_convert  = pass == 1,
+             arg_none     = false;
 
-    for (uint32_t i = 0; i < count; ++i) {
-        buf.put("    ");
-        buf.put_uint32(i + 1);
-        buf.put(". ");
-        nb_func_render_signature(f + i);
-        buf.put('\n');
-    }
+        if (i < nargs_in)
+            arg = args_in[i];
 
-    buf.put("\nInvoked with types: ");
-    for (size_t i = 0; i < nargs_in; ++i) {
-        str name = steal<str>(nb_inst_name(args_in[i]));
-        buf.put_dstr(name.c_str());
-        if (i + 1 < nargs_in)
-            buf.put(", ");
-    }
+        if (has_args) {
+            const arg_data &ad = f->args[i];
 
-    if (kwargs_in) {
-        if (nargs_in)
-            buf.put(", ");
-        buf.put("kwargs = { ");
+            if (kwargs_in) {
+                PyObject *hit = args[i]; // assigned in step 0
 
-        size_t nkwargs_in = (size_t) NB_TUPLE_GET_SIZE(kwargs_in);
-        for (size_t j = 0; j < nkwargs_in; ++j) {
-            PyObject *key   = NB_TUPLE_GET_ITEM(kwargs_in, j),
-                     *value = args_in[nargs_in + j];
+                if (hit) {
+                    if (arg)
+                        break; // conflict between keyword and positional arg.
+                    arg = hit;
+                }
+            }
 
-            const char *key_cstr = PyUnicode_AsUTF8AndSize(key, nullptr);
-            buf.put_dstr(key_cstr);
-            buf.put(": ");
-            str name = steal<str>(nb_inst_name(value));
-            buf.put_dstr(name.c_str());
-            buf.put(", ");
+            if (!arg)
+                arg = ad.value;
+
+            arg_convert &= ad.convert;
+            arg_none = ad.none;
         }
-        buf.rewind(2);
-        buf.put(" }");
+
+        if (!arg || (arg == Py_None && !arg_none))
+            break;
+
+        args[i] = arg;
+        args_flags[i] = arg_convert ? convert_flags : (uint8_t) 0;
     }
 
-    PyErr_SetString(PyExc_TypeError, buf.get());
-    return nullptr;
-}
+    // Skip this overload if positional arguments were unavailable
+    if (i != nargs_pos)
+        return false;
 
-/// Used by nb_func_vectorcall: generate an error when result conversion fails
-static NB_NOINLINE PyObject *nb_func_error_noconvert(PyObject *self,
-                                                     PyObject *const *, size_t,
-                                                     PyObject *) noexcept {
-    if (PyErr_Occurred())
-        return nullptr;
-    func_data *f = nb_func_data(self);
-    buf.clear();
-    buf.put("Unable to convert function return value to a Python "
-            "type! The signature was\n    ");
-    nb_func_render_signature(f);
-    PyErr_SetString(PyExc_TypeError, buf.get());
-    return nullptr;
-}
+    // Deal with remaining positional arguments
+    if (has_var_args) {
+        PyObject *tuple = PyTuple_New(
+            nargs_in > nargs_pos ? (Py_ssize_t) (nargs_in - nargs_pos) : 0);
 
-/// Used by nb_func_vectorcall: convert a C++ exception into a Python error
-static NB_NOINLINE void nb_func_convert_cpp_exception() noexcept {
-    std::exception_ptr e = std::current_exception();
+        for (size_t j = nargs_pos; j < nargs_in; ++j) {
+            PyObject *o = args_in[j];
+            Py_INCREF(o);
+            NB_TUPLE_SET_ITEM(tuple, j - nargs_pos, o);
+        }
 
-    nb_translator_seq *cur  = &internals_get().translators;
+        args[nargs_pos] = tuple;
+        args_flags[nargs_pos] = 0;
+        cleanup.append(tuple);
+    }
 
-    while (cur) {
-        try {
-            // Try exception translator & forward payload
-            cur->translator(e, cur->payload);
-            return;
-        } catch (...) {
-            e = std::current_exception();
+    // Deal with remaining keyword arguments
+    if (has_var_kwargs) {
+        PyObject *dict = PyDict_New();
+        for (size_t j = 0; j < nkwargs_in; ++j) {
+            PyObject *key = NB_TUPLE_GET_ITEM(kwargs_in, j);
+            if (!kwarg_used[j])
+                PyDict_SetItem(dict, key, args_in[nargs_in + j]);
         }
 
-        cur = cur->next;
+        args[nargs_pos + has_var_args] = dict;
+        args_flags[nargs_pos + has_var_args] = 0;
+        cleanup.append(dict);
+    } else if (kwargs_in) {
+        bool success = true;
+        for (size_t j = 0; j < nkwargs_in; ++j)
+            success &= kwarg_used[j];
+        if (!success)
+            return false;
     }
 
-    PyErr_SetString(PyExc_SystemError,
-                    "nanobind::detail::nb_func_error_except(): exception "
-                    "could not be translated!");
+    if (is_constructor)
+        args_flags[0] = (uint8_t) cast_flags::construct;
+
+    return true;
 }
 
 /// Dispatch loop that is used to invoke functions created by nb_func_new
@@ -459,6 +1662,7 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
                  nkwargs_in = kwargs_in ? (size_t) NB_TUPLE_GET_SIZE(kwargs_in) : 0;
 
     func_data *fr = nb_func_data(self);
+    decref_pending_check(internals_get());
 
     const bool is_method = fr->flags & (uint32_t) func_flags::is_method;
     bool is_constructor = false;
@@ -542,164 +1746,55 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
 
         If one of these fail, move on to the next overload and keep trying
         until we get a result other than NB_NEXT_OVERLOAD.
+
+        Functions with several overloads first consult the adaptive overload
+        cache (see 'nb_dispatch_entry') when called without keyword arguments.
     */
 
+    if (count > 1 && !kwargs_in) {
+        const nb_dispatch_entry *e =
+            nb_dispatch_lookup((nb_func *) self, args_in, nargs_in);
+
+        if (e && nb_func_prepare_args(fr + e->index, (int) e->pass, false,
+                                      is_constructor, args_in, nargs_in,
+                                      nullptr, 0, args, args_flags,
+                                      kwarg_used, cleanup)) {
+            result = nb_func_invoke(fr + e->index, args, args_flags, &cleanup,
+                                    (int) e->pass);
+            if (result != NB_NEXT_OVERLOAD)
+                goto finalize;
+        }
+    }
+
     for (int pass = (count > 1) ? 0 : 1; pass < 2; ++pass) {
         for (size_t k = 0; k < count; ++k) {
             const func_data *f = fr + k;
 
-            const bool has_args       = f->flags & (uint32_t) func_flags::has_args,
-                       has_var_args   = f->flags & (uint32_t) func_flags::has_var_args,
-                       has_var_kwargs = f->flags & (uint32_t) func_flags::has_var_kwargs;
-
-            /// Number of positional arguments
-            size_t nargs_pos = f->nargs - has_var_args - has_var_kwargs;
-
-            if (nargs_in > nargs_pos && !has_var_args)
-                continue; // Too many positional arguments given for this overload
-
-            if (nargs_in < nargs_pos && !has_args)
-                continue; // Not enough positional arguments, insufficient
-                          // keyword/default arguments to fill in the blanks
-
-            memset(kwarg_used, 0, nkwargs_in * sizeof(bool));
-
-            // 1. Copy positional arguments, potentially substitute kwargs/defaults
-            size_t i = 0;
-            for (; i < nargs_pos; ++i) {
-                PyObject *arg = nullptr;
-                bool arg_convert  = pass == 1,
-                     arg_none     = false;
-
-                if (i < nargs_in)
-                    arg = args_in[i];
-
-                if (has_args) {
-                    const arg_data &ad = f->args[i];
-
-                    if (kwargs_in && ad.name_py) {
-                        PyObject *hit = nullptr;
-                        for (size_t j = 0; j < nkwargs_in; ++j) {
-                            PyObject *key = NB_TUPLE_GET_ITEM(kwargs_in, j);
-                            #if defined(PYPY_VERSION)
-                                bool match = PyUnicode_Compare(key, ad.name_py) == 0;
-                            #else
-                                bool match = (key == ad.name_py);
-                            #endif
-                            if (match) {
-                                hit = args_in[nargs_in + j];
-                                kwarg_used[j] = true;
-                                break;
-                            }
-                        }
-
-                        if (hit) {
-                            if (arg)
-                                break; // conflict between keyword and positional arg.
-                            arg = hit;
-                        }
-                    }
-
-                    if (!arg)
-                        arg = ad.value;
-
-                    arg_convert &= ad.convert;
-                    arg_none = ad.none;
-                }
-
-                if (!arg || (arg == Py_None && !arg_none))
-                    break;
-
-                args[i] = arg;
-                args_flags[i] = arg_convert ? (uint8_t) cast_flags::convert : (uint8_t) 0;
-            }
-
-            // Skip this overload if positional arguments were unavailable
-            if (i != nargs_pos)
+            if (!nb_func_prepare_args(f, pass, count == 1, is_constructor,
+                                      args_in, nargs_in, kwargs_in, nkwargs_in,
+                                      args, args_flags, kwarg_used, cleanup))
                 continue;
 
-            // Deal with remaining positional arguments
-            if (has_var_args) {
-                PyObject *tuple = PyTuple_New(
-                    nargs_in > nargs_pos ? (Py_ssize_t) (nargs_in - nargs_pos) : 0);
-
-                for (size_t j = nargs_pos; j < nargs_in; ++j) {
-                    PyObject *o = args_in[j];
-                    Py_INCREF(o);
-                    NB_TUPLE_SET_ITEM(tuple, j - nargs_pos, o);
-                }
-
-                args[nargs_pos] = tuple;
-                args_flags[nargs_pos] = 0;
-                cleanup.append(tuple);
-            }
-
-            // Deal with remaining keyword arguments
-            if (has_var_kwargs) {
-                PyObject *dict = PyDict_New();
-                for (size_t j = 0; j < nkwargs_in; ++j) {
-                    PyObject *key = NB_TUPLE_GET_ITEM(kwargs_in, j);
-                    if (!kwarg_used[j])
-                        PyDict_SetItem(dict, key, args_in[nargs_in + j]);
-                }
-
-                args[nargs_pos + has_var_args] = dict;
-                args_flags[nargs_pos + has_var_args] = 0;
-                cleanup.append(dict);
-            } else if (kwargs_in) {
-                bool success = true;
-                for (size_t j = 0; j < nkwargs_in; ++j)
-                    success &= kwarg_used[j];
-                if (!success)
-                    continue;
-            }
-
-            if (is_constructor)
-                args_flags[0] = (uint8_t) cast_flags::construct;
-
-            try {
-                // Found a suitable overload, let's try calling it
-                result = f->impl((void *) f->capture, args, args_flags,
-                                 (rv_policy) (f->flags & 0b111), &cleanup);
-
-                if (NB_UNLIKELY(!result)) {
-                    error_handler = nb_func_error_noconvert;
-                    goto done;
-                }
-            } catch (builtin_exception &e) {
-                if (set_builtin_exception_status(e)) {
-                    result = nullptr;
-                    goto done;
-                } else {
-                    result = NB_NEXT_OVERLOAD;
-                }
-            } catch (python_error &e) {
-                e.restore();
-                result = nullptr;
-                goto done;
-            } catch (...) {
-                nb_func_convert_cpp_exception();
-                result = nullptr;
-                goto done;
-            }
+            // Found a suitable overload, let's try calling it
+            result = nb_func_invoke(f, args, args_flags, &cleanup, pass);
 
             if (result != NB_NEXT_OVERLOAD) {
-                if (is_constructor) {
-                    nb_inst *self_arg_nb = (nb_inst *) self_arg;
-                    self_arg_nb->destruct = true;
-                    self_arg_nb->ready = true;
-
-                    if (NB_UNLIKELY(self_flags & (uint32_t) type_flags::intrusive_ptr))
-                        nb_type_data(Py_TYPE(self_arg))
-                            ->set_self_py(inst_ptr(self_arg_nb), self_arg);
-                }
-
-                goto done;
+                if (count > 1 && !kwargs_in && result)
+                    nb_dispatch_store((nb_func *) self, args_in, nargs_in, k,
+                                      pass);
+                goto finalize;
             }
         }
     }
 
     error_handler = nb_func_error_overload;
+    goto done;
+
+finalize:
+    if (NB_UNLIKELY(!result))
+        error_handler = nb_func_error_noconvert;
+    else if (is_constructor)
+        nb_func_constructed(self_arg, self_flags);
 
 done:
     cleanup.release();
@@ -720,6 +1815,7 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
                                            PyObject *kwargs_in) noexcept {
     uint8_t args_flags[NB_MAXARGS_SIMPLE];
     func_data *fr = nb_func_data(self);
+    decref_pending_check(internals_get());
 
     const size_t count         = (size_t) Py_SIZE(self),
                  nargs_in      = (size_t) NB_VECTORCALL_NARGS(nargsf);
@@ -772,9 +1868,33 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
         goto done;
     }
 
+    // Try the overload that accepted arguments of the same types last time
+    if (count > 1) {
+        const nb_dispatch_entry *e =
+            nb_dispatch_lookup((nb_func *) self, args_in, nargs_in);
+
+        if (e) {
+            for (int i = 0; i < NB_MAXARGS_SIMPLE; ++i)
+                args_flags[i] = (uint8_t) e->pass;
+
+            if (is_constructor)
+                args_flags[0] = (uint8_t) cast_flags::construct;
+
+            result = nb_func_invoke(fr + e->index, (PyObject **) args_in,
+                                    args_flags, &cleanup, (int) e->pass);
+            if (result != NB_NEXT_OVERLOAD)
+                goto finalize;
+        }
+    }
+
     for (int pass = (count > 1) ? 0 : 1; pass < 2; ++pass) {
+        // Iterators may only be consumed when no other overload will be tried
+        uint8_t pass_flags = (uint8_t) pass;
+        if (count == 1)
+            pass_flags |= (uint8_t) cast_flags::consume;
+
         for (int i = 0; i < NB_MAXARGS_SIMPLE; ++i)
-            args_flags[i] = (uint8_t) pass;
+            args_flags[i] = pass_flags;
 
         if (is_constructor)
             args_flags[0] = (uint8_t) cast_flags::construct;
@@ -785,50 +1905,27 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
             if (nargs_in != f->nargs)
                 continue;
 
-            try {
-                // Found a suitable overload, let's try calling it
-                result = f->impl((void *) f->capture, (PyObject **) args_in,
-                                 args_flags, (rv_policy) (f->flags & 0b111),
-                                 &cleanup);
-
-                if (NB_UNLIKELY(!result)) {
-                    error_handler = nb_func_error_noconvert;
-                    goto done;
-                }
-            } catch (builtin_exception &e) {
-                if (set_builtin_exception_status(e)) {
-                    result = nullptr;
-                    goto done;
-                } else {
-                    result = NB_NEXT_OVERLOAD;
-                }
-            } catch (python_error &e) {
-                e.restore();
-                result = nullptr;
-                goto done;
-            } catch (...) {
-                nb_func_convert_cpp_exception();
-                result = nullptr;
-                goto done;
-            }
+            // Found a suitable overload, let's try calling it
+            result = nb_func_invoke(f, (PyObject **) args_in, args_flags,
+                                    &cleanup, pass);
 
             if (result != NB_NEXT_OVERLOAD) {
-                if (is_constructor) {
-                    nb_inst *self_arg_nb = (nb_inst *) self_arg;
-                    self_arg_nb->destruct = true;
-                    self_arg_nb->ready = true;
-
-                    if (NB_UNLIKELY(self_flags & (uint32_t) type_flags::intrusive_ptr))
-                        nb_type_data(Py_TYPE(self_arg))
-                            ->set_self_py(inst_ptr(self_arg_nb), self_arg);
-                }
-
-                goto done;
+                if (count > 1 && result)
+                    nb_dispatch_store((nb_func *) self, args_in, nargs_in, k,
+                                      pass);
+                goto finalize;
             }
         }
     }
 
     error_handler = nb_func_error_overload;
+    goto done;
+
+finalize:
+    if (NB_UNLIKELY(!result))
+        error_handler = nb_func_error_noconvert;
+    else if (is_constructor)
+        nb_func_constructed(self_arg, self_flags);
 
 done:
     cleanup.release();
@@ -858,14 +1955,25 @@ static PyObject *nb_bound_method_vectorcall(PyObject *self,
         args_tmp[0] = tmp;
     } else {
         size_t nkwargs_in = kwargs_in ? (size_t) NB_TUPLE_GET_SIZE(kwargs_in) : 0;
-        PyObject **args_tmp = (PyObject **) PyObject_Malloc((nargs + nkwargs_in + 1) * sizeof(PyObject *));
-        if (!args_tmp)
-            return PyErr_NoMemory();
+
+        // Use the scratch arena for unusually long argument lists
+        PyObject *args_small[NB_MAXARGS_SIMPLE + 1], **args_tmp = args_small;
+        void *mark_chunk = nullptr;
+        size_t mark_used = 0;
+        if (nargs + nkwargs_in + 1 > NB_MAXARGS_SIMPLE + 1) {
+            scratch_mark(&mark_chunk, &mark_used);
+            args_tmp = (PyObject **) scratch_alloc((nargs + nkwargs_in + 1) * sizeof(PyObject *));
+            if (!args_tmp)
+                return PyErr_NoMemory();
+        }
+
         args_tmp[0] = mb->self;
         for (size_t i = 0; i < nargs + nkwargs_in; ++i)
             args_tmp[i + 1] = args_in[i];
         result = mb->func->vectorcall((PyObject *) mb->func, args_tmp, nargs + 1, kwargs_in);
-        PyObject_Free(args_tmp);
+
+        if (args_tmp != args_small)
+            scratch_rewind(mark_chunk, mark_used);
     }
 
     return result;
@@ -877,8 +1985,19 @@ PyObject *nb_method_descr_get(PyObject *self, PyObject *inst, PyObject *) {
            'CALL_METHOD' opcode and vector calls. Pytest rewrites the bytecode
            in a way that breaks this optimization :-/ */
 
-        nb_bound_method *mb =
-            PyObject_GC_New(nb_bound_method, internals_get().nb_bound_method);
+        nb_internals &internals = internals_get();
+        nb_bound_method *mb = internals.nb_bound_method_freelist;
+
+        if (mb) {
+            internals.nb_bound_method_freelist = (nb_bound_method *) mb->func;
+            internals.nb_bound_method_freelist_size--;
+            PyObject_Init((PyObject *) mb, internals.nb_bound_method);
+        } else {
+            mb = PyObject_GC_New(nb_bound_method, internals.nb_bound_method);
+            if (!mb)
+                return nullptr;
+        }
+
         mb->func = (nb_func *) self;
         mb->self = inst;
         mb->vectorcall = nb_bound_method_vectorcall;
@@ -999,10 +2118,10 @@ static void nb_func_render_signature(const func_data *f) noexcept {
                       "nb::detail::nb_func_finalize(): missing type!");
 
                 if (!(is_method && arg_index == 0)) {
-                    auto it = internals.type_c2p.find(std::type_index(**descr_type));
+                    type_data *td = nb_type_c2p(internals, *descr_type);
 
-                    if (it != internals.type_c2p.end()) {
-                        handle th((PyObject *) it->second->type_py);
+                    if (td) {
+                        handle th((PyObject *) td->type_py);
                         buf.put_dstr((borrow<str>(th.attr("__module__"))).c_str());
                         buf.put('.');
                         buf.put_dstr((borrow<str>(th.attr("__qualname__"))).c_str());
@@ -1065,6 +2184,21 @@ static PyObject *nb_func_get_module(PyObject *self) {
     }
 }
 
+/// Capsule with the C entry point of a function annotated with nb::cfunc
+static PyObject *nb_func_get_cfunc(PyObject *self) {
+    func_data *f = nb_func_data(self);
+
+    // Overloads would need to be dispatched, hence only single ones qualify
+    if (Py_SIZE(self) != 1 || !(f->flags & (uint32_t) func_flags::has_cfunc)) {
+        PyErr_SetString(PyExc_AttributeError,
+                        "'nb_func' object has no attribute '__nb_cfunc__'");
+        return nullptr;
+    }
+
+    void **capture = (void **) f->capture;
+    return capsule_new(capture[0], (const char *) capture[1], nullptr);
+}
+
 PyObject *nb_func_get_doc(PyObject *self, void *) {
     func_data *f = nb_func_data(self);
     uint32_t count = (uint32_t) Py_SIZE(self);
@@ -1124,15 +2258,290 @@ PyObject *nb_func_getattro(PyObject *self, PyObject *name_) {
         return nb_func_get_qualname(self);
     else if (strcmp(name, "__doc__") == 0)
         return nb_func_get_doc(self, nullptr);
+    else if (strcmp(name, "__nb_cfunc__") == 0)
+        return nb_func_get_cfunc(self);
     else
         return PyObject_GenericGetAttr(self, name_);
 }
 
+/// Shared implementation of the map() and starmap() methods of functions
+static PyObject *nb_func_map_impl(PyObject *self, PyObject *iterable,
+                                  bool star) noexcept {
+    nb_internals &internals = internals_get();
+    PyObject *func = self, *bound = nullptr;
+
+    if (Py_TYPE(self) == internals.nb_bound_method) {
+        func = (PyObject *) ((nb_bound_method *) self)->func;
+        bound = ((nb_bound_method *) self)->self;
+    }
+
+    func_data *f = nb_func_data(func);
+    const bool is_method = f->flags & (uint32_t) func_flags::is_method;
+
+    /* Invoke the C++ implementation directly when overload resolution is
+       trivial. Otherwise, fall back to a vectorcall per element. */
+    bool direct = Py_SIZE(func) == 1 && !((nb_func *) func)->complex_call &&
+                  !(f->flags & (uint32_t) func_flags::is_constructor) &&
+                  (!is_method || bound);
+
+    if (direct && bound) {
+        PyTypeObject *tp = Py_TYPE(bound);
+        direct = nb_type_check((PyObject *) tp) &&
+                 !(nb_type_data(tp)->flags & (uint32_t) type_flags::is_trampoline);
+    }
+
+    PyObject *it = PyObject_GetIter(iterable);
+    if (!it)
+        return nullptr;
+
+    PyObject *result = PyList_New(0);
+    if (!result) {
+        Py_DECREF(it);
+        return nullptr;
+    }
+
+    // Argument flags and temporaries are shared by all calls
+    uint8_t args_flags[NB_MAXARGS_SIMPLE];
+    memset(args_flags, (uint8_t) (cast_flags::convert | cast_flags::consume),
+           sizeof(args_flags));
+    cleanup_list cleanup(bound);
+
+    PyObject *args[NB_MAXARGS_SIMPLE + 1];
+    const size_t offset = bound ? 1 : 0;
+    args[0] = bound;
+
+    PyObject *item;
+    while ((item = PyIter_Next(it))) {
+        PyObject *tuple = nullptr, *value;
+        size_t nargs;
+
+        if (star) {
+            if (PyTuple_CheckExact(item)) {
+                tuple = item;
+                Py_INCREF(tuple);
+            } else {
+                tuple = PySequence_Tuple(item);
+                if (!tuple) {
+                    Py_DECREF(item);
+                    break;
+                }
+            }
+            nargs = (size_t) NB_TUPLE_GET_SIZE(tuple) + offset;
+        } else {
+            nargs = 1 + offset;
+        }
+
+        if (nargs > NB_MAXARGS_SIMPLE) {
+            value = PyObject_Call(self, tuple, nullptr);
+        } else {
+            bool fail = false;
+            for (size_t i = offset; i < nargs; ++i) {
+                PyObject *arg = tuple ? NB_TUPLE_GET_ITEM(tuple, i - offset) : item;
+                args[i] = arg;
+                fail |= arg == Py_None;
+            }
+
+            if (direct && !fail && nargs == f->nargs) {
+                value = nb_func_invoke(f, args, args_flags, &cleanup, 1);
+                cleanup.reset();
+
+                if (NB_UNLIKELY(value == NB_NEXT_OVERLOAD))
+                    value = nb_func_error_overload(func, args, nargs, nullptr);
+                else if (NB_UNLIKELY(!value))
+                    value = nb_func_error_noconvert(func, args, nargs, nullptr);
+            } else {
+#if PY_VERSION_HEX < 0x03090000
+                value = _PyObject_Vectorcall(self, args + offset,
+                                             nargs - offset, nullptr);
+#else
+                value = PyObject_Vectorcall(self, args + offset,
+                                            nargs - offset, nullptr);
+#endif
+            }
+        }
+
+        Py_XDECREF(tuple);
+        Py_DECREF(item);
+
+        if (!value || PyList_Append(result, value)) {
+            Py_XDECREF(value);
+            break;
+        }
+        Py_DECREF(value);
+    }
+
+    cleanup.release();
+    Py_DECREF(it);
+
+    if (PyErr_Occurred()) {
+        Py_DECREF(result);
+        return nullptr;
+    }
+
+    return result;
+}
+
+static PyObject *nb_func_map(PyObject *self, PyObject *iterable) {
+    return nb_func_map_impl(self, iterable, false);
+}
+
+static PyObject *nb_func_starmap(PyObject *self, PyObject *iterable) {
+    return nb_func_map_impl(self, iterable, true);
+}
+
+PyMethodDef nb_func_methods[] = {
+    { "map", nb_func_map, METH_O,
+      "Call the function with each element of an iterable and return a list "
+      "of the results" },
+    { "starmap", nb_func_starmap, METH_O,
+      "Call the function with the unpacked arguments stored in each element "
+      "of an iterable and return a list of the results" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
 PyObject *nb_bound_method_getattro(PyObject *self, PyObject *name) {
+    // Bind map() and starmap() to the instance
+    for (PyMethodDef *m = nb_func_methods; m->ml_name; ++m) {
+        if (PyUnicode_CompareWithASCIIString(name, m->ml_name) == 0)
+            return PyCFunction_NewEx(m, self, nullptr);
+    }
+
     nb_func *func = ((nb_bound_method *) self)->func;
     return nb_func_getattro((PyObject *) func, name);
 }
 
+#if defined(NB_PROFILE)
+/// Return a list with the counters of all function overloads that were invoked
+PyObject *nb_profile_dump(PyObject *, PyObject *) {
+    PyObject *result = PyList_New(0);
+    if (!result)
+        return nullptr;
+
+    for (auto [func, unused] : internals_get().funcs) {
+        func_data *f = nb_func_data(func);
+        uint32_t count = (uint32_t) Py_SIZE((PyObject *) func);
+        (void) unused;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const nb_profile_data &pd = f[i].profile;
+            if (!pd.calls && !pd.misses[0] && !pd.misses[1])
+                continue;
+
+            buf.clear();
+            nb_func_render_signature(f + i);
+
+            PyObject *entry = Py_BuildValue(
+                "{sNsssIsKs(KK)sKsKsd}",
+                "name", nb_func_get_qualname((PyObject *) func),
+                "signature", buf.get(),
+                "overload", (unsigned int) i,
+                "calls", (unsigned long long) pd.calls,
+                "misses", (unsigned long long) pd.misses[0],
+                          (unsigned long long) pd.misses[1],
+                "implicit_conversions", (unsigned long long) pd.implicit_conversions,
+                "exceptions", (unsigned long long) pd.exceptions,
+                "time", (double) pd.time_ns * 1e-9);
+
+            if (!entry || PyList_Append(result, entry)) {
+                Py_XDECREF(entry);
+                Py_DECREF(result);
+                return nullptr;
+            }
+
+            Py_DECREF(entry);
+        }
+    }
+
+    return result;
+}
+
+/// Reset the counters of all function overloads
+PyObject *nb_profile_reset(PyObject *, PyObject *) {
+    for (auto [func, unused] : internals_get().funcs) {
+        func_data *f = nb_func_data(func);
+        uint32_t count = (uint32_t) Py_SIZE((PyObject *) func);
+        (void) unused;
+
+        for (uint32_t i = 0; i < count; ++i)
+            memset(&f[i].profile, 0, sizeof(nb_profile_data));
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+void nb_profile_import(const char *kind, PyObject *scope, const char *name,
+                       std::chrono::steady_clock::time_point t0) noexcept {
+    auto t1 = std::chrono::steady_clock::now();
+    nb_import_record record{ kind, std::string(), (uint64_t)
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() };
+
+    // Prefix the name with that of the enclosing module and type (if any)
+    if (scope) {
+        error_scope scope_guard; // preserve any pending error status
+        bool is_module = PyModule_Check(scope);
+        PyObject *prefix[2] = {
+            PyObject_GetAttrString(scope, is_module ? "__name__" : "__module__"),
+            is_module ? nullptr : PyObject_GetAttrString(scope, "__qualname__")
+        };
+        PyErr_Clear();
+
+        for (PyObject *o : prefix) {
+            const char *s = o ? PyUnicode_AsUTF8AndSize(o, nullptr) : nullptr;
+            if (s) {
+                record.name += s;
+                record.name += '.';
+            }
+            PyErr_Clear();
+            Py_XDECREF(o);
+        }
+    }
+    record.name += name;
+
+    nb_internals &internals = internals_get();
+    lock_internals guard(internals);
+    internals.import_profile.push_back(std::move(record));
+}
+
+/// Return a list with the durations of all class and function registrations
+PyObject *nb_import_dump(PyObject *, PyObject *) {
+    nb_internals &internals = internals_get();
+    lock_internals guard(internals);
+
+    PyObject *result = PyList_New(0);
+    if (!result)
+        return nullptr;
+
+    for (const nb_import_record &r : internals.import_profile) {
+        PyObject *entry = Py_BuildValue("{sssssd}", "kind", r.kind, "name",
+                                        r.name.c_str(), "time",
+                                        (double) r.time_ns * 1e-9);
+
+        if (!entry || PyList_Append(result, entry)) {
+            Py_XDECREF(entry);
+            Py_DECREF(result);
+            return nullptr;
+        }
+
+        Py_DECREF(entry);
+    }
+
+    return result;
+}
+
+/// Discard the recorded class and function registrations
+PyObject *nb_import_reset(PyObject *, PyObject *) {
+    nb_internals &internals = internals_get();
+    {
+        lock_internals guard(internals);
+        internals.import_profile.clear();
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+#endif
+
 /// Excise a substring from 's'
 static void strexc(char *s, const char *sub) {
     size_t len = strlen(sub);
@@ -11,13 +11,17 @@
 #include <structmember.h>
 #include "nb_internals.h"
 
+#if defined(NB_FREE_THREADED)
+#  include <thread>
+#endif
+
 #if defined(__GNUC__) && !defined(__clang__)
 #  pragma GCC diagnostic ignored "-Wmissing-field-initializers"
 #endif
 
 /// Tracks the ABI of nanobind
 #ifndef NB_INTERNALS_VERSION
-#  define NB_INTERNALS_VERSION 8
+#  define NB_INTERNALS_VERSION 9
 #endif
 
 /// On MSVC, debug and release builds are not ABI-compatible!
@@ -68,8 +72,22 @@
 #  define NB_LIMITED_API ""
 #endif
 
+/// Profiling builds store extra per-function data (see NB_PROFILE)
+#if defined(NB_PROFILE)
+#  define NB_PROFILE_TYPE "_profile"
+#else
+#  define NB_PROFILE_TYPE ""
+#endif
+
+/// Free-threaded builds use a different internals layout
+#if defined(NB_FREE_THREADED)
+#  define NB_FREE_THREADED_ABI "_ft"
+#else
+#  define NB_FREE_THREADED_ABI ""
+#endif
+
 #define NB_INTERNALS_ID "__nb_internals_v" \
-    NB_TOSTRING(NB_INTERNALS_VERSION) NB_COMPILER_TYPE NB_STDLIB NB_BUILD_ABI NB_BUILD_TYPE NB_LIMITED_API "__"
+    NB_TOSTRING(NB_INTERNALS_VERSION) NB_COMPILER_TYPE NB_STDLIB NB_BUILD_ABI NB_BUILD_TYPE NB_LIMITED_API NB_PROFILE_TYPE NB_FREE_THREADED_ABI "__"
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -77,6 +95,7 @@ NAMESPACE_BEGIN(detail)
 extern PyObject *nb_func_getattro(PyObject *, PyObject *);
 extern PyObject *nb_func_get_doc(PyObject *, void *);
 extern PyObject *nb_bound_method_getattro(PyObject *, PyObject *);
+extern PyMethodDef nb_func_methods[];
 extern int nb_func_traverse(PyObject *, visitproc, void *);
 extern int nb_func_clear(PyObject *);
 extern void nb_func_dealloc(PyObject *);
@@ -84,6 +103,32 @@ extern int nb_bound_method_traverse(PyObject *, visitproc, void *);
 extern int nb_bound_method_clear(PyObject *);
 extern void nb_bound_method_dealloc(PyObject *);
 extern PyObject *nb_method_descr_get(PyObject *, PyObject *, PyObject *);
+extern void nb_bound_method_freelist_clear() noexcept;
+extern void ndarray_handle_freelist_clear() noexcept;
+extern void ndarray_wrap_funcs_clear() noexcept;
+extern void ndarray_pool_clear() noexcept;
+extern void parallel_pool_clear() noexcept;
+extern void decref_pending_clear() noexcept;
+extern void str_cache_clear() noexcept;
+
+#if defined(NB_PROFILE)
+extern PyObject *nb_profile_dump(PyObject *, PyObject *);
+extern PyObject *nb_profile_reset(PyObject *, PyObject *);
+extern PyObject *nb_import_dump(PyObject *, PyObject *);
+extern PyObject *nb_import_reset(PyObject *, PyObject *);
+
+static PyMethodDef nb_profile_methods[] = {
+    { "profile_dump", nb_profile_dump, METH_NOARGS,
+      "Return the call counters of all nanobind function overloads" },
+    { "profile_reset", nb_profile_reset, METH_NOARGS,
+      "Reset the call counters of all nanobind function overloads" },
+    { "import_dump", nb_import_dump, METH_NOARGS,
+      "Return the time spent registering each nanobind class and function" },
+    { "import_reset", nb_import_reset, METH_NOARGS,
+      "Discard the recorded class and function registration times" },
+    { nullptr, nullptr, 0, nullptr }
+};
+#endif
 
 #if PY_VERSION_HEX >= 0x03090000
 #  define NB_HAVE_VECTORCALL_PY39_OR_NEWER NB_HAVE_VECTORCALL
@@ -117,6 +162,7 @@ static PyGetSetDef nb_func_getset[] = {
 
 static PyType_Slot nb_func_slots[] = {
     { Py_tp_members, (void *) nb_func_members },
+    { Py_tp_methods, (void *) nb_func_methods },
     { Py_tp_getset, (void *) nb_func_getset },
     { Py_tp_getattro, (void *) nb_func_getattro },
     { Py_tp_traverse, (void *) nb_func_traverse },
@@ -139,6 +185,7 @@ static PyType_Spec nb_func_spec = {
 
 static PyType_Slot nb_method_slots[] = {
     { Py_tp_members, (void *) nb_func_members },
+    { Py_tp_methods, (void *) nb_func_methods },
     { Py_tp_getset, (void *) nb_func_getset },
     { Py_tp_getattro, (void *) nb_func_getattro },
     { Py_tp_traverse, (void *) nb_func_traverse },
@@ -189,7 +236,20 @@ static PyType_Spec nb_bound_method_spec = {
 NB_THREAD_LOCAL current_method current_method_data =
     current_method{ nullptr, nullptr };
 
+#if defined(NB_PROFILE)
+NB_THREAD_LOCAL nb_profile_data *profile_current = nullptr;
+#endif
+
 nb_internals *internals_p = nullptr;
+std::atomic<bool> internals_multi { false };
+
+/// Per-thread cache of the internals of the current interpreter
+struct internals_cache_entry {
+    int64_t interp;
+    nb_internals *p;
+};
+
+static NB_THREAD_LOCAL internals_cache_entry internals_cache { -1, nullptr };
 
 void default_exception_translator(const std::exception_ptr &p, void *) {
     try {
@@ -216,19 +276,23 @@ void default_exception_translator(const std::exception_ptr &p, void *) {
 #if !defined(PYPY_VERSION)
 static void internals_cleanup() {
     bool leak = false;
+    size_t inst_leaks = 0, keep_alive_leaks = 0;
 
-    if (!internals_p->inst_c2p.empty()) {
-        if (internals_p->print_leak_warnings) {
-            fprintf(stderr, "nanobind: leaked %zu instances!\n",
-                    internals_p->inst_c2p.size());
-        }
+    for (size_t i = 0; i <= internals_p->shard_mask; ++i) {
+        inst_leaks += internals_p->shards[i].inst_c2p.size();
+        keep_alive_leaks += internals_p->shards[i].keep_alive.size();
+    }
+
+    if (inst_leaks) {
+        if (internals_p->print_leak_warnings)
+            fprintf(stderr, "nanobind: leaked %zu instances!\n", inst_leaks);
         leak = true;
     }
 
-    if (!internals_p->keep_alive.empty()) {
+    if (keep_alive_leaks) {
         if (internals_p->print_leak_warnings) {
             fprintf(stderr, "nanobind: leaked %zu keep_alive records!\n",
-                    internals_p->keep_alive.size());
+                    keep_alive_leaks);
         }
         leak = true;
     }
@@ -267,6 +331,9 @@ static void internals_cleanup() {
     }
 
     if (!leak) {
+#if defined(NB_FREE_THREADED)
+        delete[] internals_p->shards;
+#endif
         delete internals_p;
         internals_p = nullptr;
     } else {
@@ -282,6 +349,25 @@ static void internals_cleanup() {
 }
 #endif
 
+#if !defined(PYPY_VERSION)
+/// Called by Python's 'atexit' module while the interpreter is still intact
+static PyObject *internals_atexit(PyObject *, PyObject *) {
+    nb_bound_method_freelist_clear();
+    ndarray_handle_freelist_clear();
+    ndarray_wrap_funcs_clear();
+    ndarray_pool_clear();
+    parallel_pool_clear();
+    decref_pending_clear();
+    str_cache_clear();
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyMethodDef internals_atexit_def = {
+    "_nb_atexit", internals_atexit, METH_NOARGS, nullptr
+};
+#endif
+
 static PyObject *internals_dict() {
 #if defined(PYPY_VERSION)
     PyObject *dict = PyEval_GetBuiltins();
@@ -295,10 +381,33 @@ static PyObject *internals_dict() {
     return dict;
 }
 
+/// Unique ID of the current interpreter (unlike its address, never reused)
+static int64_t internals_interp_id() {
+#if defined(PYPY_VERSION)
+    return 0;
+#elif PY_VERSION_HEX < 0x03090000
+    return PyInterpreterState_GetID(_PyInterpreterState_Get());
+#else
+    return PyInterpreterState_GetID(PyInterpreterState_Get());
+#endif
+}
+
 static NB_NOINLINE nb_internals *internals_make() {
     str nb_name("nanobind");
 
     nb_internals *p = new nb_internals();
+    static std::atomic<uint64_t> internals_counter { 0 };
+    p->id = ++internals_counter;
+
+#if defined(NB_FREE_THREADED)
+    // Use a power-of-two number of shards well above the core count
+    size_t shard_count = 1,
+           target = 2 * (size_t) std::thread::hardware_concurrency();
+    while (shard_count < target)
+        shard_count *= 2;
+    p->shards = new nb_shard[shard_count];
+    p->shard_mask = shard_count - 1;
+#endif
 
     PyObject *dict = internals_dict();
 
@@ -339,6 +448,8 @@ static NB_NOINLINE nb_internals *internals_make() {
         (destructor) PyType_GetSlot(&PyType_Type, Py_tp_dealloc);
     p->PyType_Type_tp_setattro =
         (setattrofunc) PyType_GetSlot(&PyType_Type, Py_tp_setattro);
+    p->PyType_Type_tp_getattro =
+        (getattrofunc) PyType_GetSlot(&PyType_Type, Py_tp_getattro);
     p->PyProperty_Type_tp_descr_get =
         (descrgetfunc) PyType_GetSlot(&PyProperty_Type, Py_tp_descr_get);
     p->PyProperty_Type_tp_descr_set =
@@ -347,6 +458,18 @@ static NB_NOINLINE nb_internals *internals_make() {
 
     p->translators = { default_exception_translator, nullptr, nullptr };
 
+    const char *perf_map = getenv("NANOBIND_PERF_MAP");
+    p->perf_map = perf_map && *perf_map && strcmp(perf_map, "0") != 0;
+
+#if defined(NB_PROFILE)
+    /* Expose the profiling interface through the internal module, which is
+       made importable as 'nanobind_profile' */
+    if (PyModule_AddFunctions(p->nb_module, nb_profile_methods) ||
+        PyDict_SetItemString(PyImport_GetModuleDict(), "nanobind_profile",
+                             p->nb_module))
+        PyErr_Clear();
+#endif
+
 #if PY_VERSION_HEX < 0x030C0000 && !defined(PYPY_VERSION)
     /* The implementation of typing.py on CPython <3.12 tends to introduce
        spurious reference leaks that upset nanobind's leak checker. The
@@ -382,9 +505,24 @@ static NB_NOINLINE nb_internals *internals_make() {
 #endif
 
 #if !defined(PYPY_VERSION)
+    /* Objects retained in freelists must be released before the interpreter
+       shuts down. Fails silently, in which case they are simply leaked. */
+    PyObject *atexit_mod = PyImport_ImportModule("atexit"),
+             *atexit_func = PyCFunction_New(&internals_atexit_def, nullptr),
+             *atexit_rv = nullptr;
+    if (atexit_mod && atexit_func)
+        atexit_rv = PyObject_CallMethod(atexit_mod, "register", "O", atexit_func);
+    if (!atexit_rv)
+        PyErr_Clear();
+    Py_XDECREF(atexit_rv);
+    Py_XDECREF(atexit_func);
+    Py_XDECREF(atexit_mod);
+
     /* Install the memory leak checker. This feature is unsupported on
-       PyPy, see https://foss.heptapod.net/pypy/pypy/-/issues/3855 */
-    if (Py_AtExit(internals_cleanup))
+       PyPy, see https://foss.heptapod.net/pypy/pypy/-/issues/3855. It only
+       covers the internals of the first interpreter, those of other
+       interpreters are released when the process exits. */
+    if (!internals_p && Py_AtExit(internals_cleanup))
         fprintf(stderr,
                 "Warning: could not install the nanobind cleanup handler! This "
                 "is needed to check for reference leaks and release remaining "
@@ -410,11 +548,30 @@ nb_internals *internals_fetch() {
         ptr = internals_make();
     }
 
-    internals_p = ptr;
+#if defined(Py_LIMITED_API)
+    // Computed once so that nb_type_data() reduces to an addition
+    if (!nb_type_data_offset)
+        nb_type_data_offset =
+            cast<size_t>(handle(&PyType_Type).attr("__basicsize__"));
+#endif
+
+    if (!internals_p)
+        internals_p = ptr;
+    else if (internals_p != ptr)
+        internals_multi.store(true, std::memory_order_relaxed);
+
+    internals_cache = internals_cache_entry{ internals_interp_id(), ptr };
 
     return ptr;
 }
 
+nb_internals *internals_get_multi() noexcept {
+    internals_cache_entry entry = internals_cache;
+    if (NB_LIKELY(entry.p && entry.interp == internals_interp_id()))
+        return entry.p;
+    return internals_fetch();
+}
+
 #if defined(NB_COMPACT_ASSERTIONS)
 NB_NOINLINE void fail_unspecified() noexcept {
     fail("nanobind: encountered an unrecoverable error condition. Recompile "
@@ -13,6 +13,13 @@
 #include <tsl/robin_map.h>
 #include <typeindex>
 #include <cstring>
+#include <atomic>
+
+#if defined(NB_PROFILE)
+#  include <chrono>
+#  include <string>
+#  include <vector>
+#endif
 
 #if defined(_MSC_VER)
 #  define NB_THREAD_LOCAL __declspec(thread)
@@ -20,6 +27,12 @@
 #  define NB_THREAD_LOCAL __thread
 #endif
 
+#if defined(NB_FREE_THREADED)
+#  if !defined(Py_GIL_DISABLED)
+#    error "NB_FREE_THREADED requires a free-threaded build of Python (3.13+)"
+#  endif
+#endif
+
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
@@ -30,9 +43,78 @@ NAMESPACE_BEGIN(detail)
 #  define check(cond, ...) if (NB_UNLIKELY(!(cond))) nanobind::detail::fail(__VA_ARGS__)
 #endif
 
+#if defined(NB_PROFILE)
+/// Per-overload counters collected in profiling builds (see NB_PROFILE)
+struct nb_profile_data {
+    /// Number of successful invocations
+    uint64_t calls;
+    /// Number of rejected calls in the strict (0) and converting (1) pass
+    uint64_t misses[2];
+    /// Number of implicit conversions performed while casting arguments
+    uint64_t implicit_conversions;
+    /// Number of exceptions that were translated into Python errors
+    uint64_t exceptions;
+    /// Cumulative time spent in 'func_data::impl' (nanoseconds)
+    uint64_t time_ns;
+};
+
+/// Duration of a class or function registration (see NB_PROFILE)
+struct nb_import_record {
+    /// "class" or "function"
+    const char *kind;
+    /// Fully qualified name
+    std::string name;
+    /// Time spent in nb_type_new() or nb_func_new() (nanoseconds)
+    uint64_t time_ns;
+};
+#endif
+
+/// Entry of the keyword argument lookup table of a function overload
+struct kwarg_entry {
+    PyObject *name;
+    size_t index;
+};
+
+/* With nb::set_perf_map(), calls are routed through small stubs in
+   executable memory that are named in the perf map of the process */
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#  define NB_PERF_MAP
+#endif
+
 /// Nanobind function metadata (overloads, etc.)
 struct func_data : func_data_prelim<0> {
     arg_data *args;
+
+    /// Interned names of positional arguments, sorted by address
+    kwarg_entry *kwargs_table;
+    size_t kwargs_table_size;
+
+#if defined(NB_PERF_MAP)
+    /// Stub that invokes this overload under its name in the perf map (or
+    /// nullptr). Set atomically, since other threads may be calling it
+    void *perf_stub;
+#endif
+
+#if defined(NB_PROFILE)
+    nb_profile_data profile;
+#endif
+};
+
+/// Number of size classes (multiples of NB_POOL_GRANULARITY) of the instance pool
+#define NB_POOL_CLASSES 16
+#define NB_POOL_GRANULARITY 16
+
+/// Number of size classes (powers of two from 64 B to 4 MiB) of ndarray_alloc()
+#define NB_NDARRAY_POOL_CLASSES 17
+
+/// Number of entries of the direct-mapped cache used by nb_type_get()
+#define NB_CAST_CACHE_SIZE 64
+
+/// Result of a native implicit conversion, stored in cleanup_list::alloc() memory
+struct nb_scratch {
+    PyObject_HEAD
+    const type_data *type; // set once 'value' holds a constructed instance
+    void *value;
 };
 
 /// Python object representing an instance of a bound C++ type
@@ -64,16 +146,41 @@ struct nb_inst { // usually: 24 bytes
 
     /// Does this instance hold reference to others? (via internals.keep_alive)
     bool clear_keep_alive : 1;
+
+    /// Number of buffers referencing the instance data (see bind_vector.h)
+    uint16_t exports;
+
+    // Types with the 'has_inline_keep_alive' flag store a 'PyObject *'
+    // keep_alive patient directly after this header, followed by a list of
+    // cached member wrappers for types with 'has_member_cache'
+    // (see inst_header_size())
 };
 
 static_assert(sizeof(nb_inst) == sizeof(PyObject) + sizeof(void *));
 
+struct nb_dispatch_cache;
+struct nb_thread_pool;
+
+/// Reference queued by decref_deferred() until the GIL is available
+struct nb_deferred_decref {
+    /// Object to release, or the argument of 'release'
+    void *o;
+    nb_deferred_decref *next;
+
+    /// Custom release function of entries embedded in another object. When
+    /// not set, 'o' is a 'PyObject *' and the entry was allocated by malloc()
+    void (*release)(void *) noexcept;
+};
+
 /// Python object representing a bound C++ function
 struct nb_func {
     PyObject_VAR_HEAD
     PyObject* (*vectorcall)(PyObject *, PyObject * const*, size_t, PyObject *);
     uint32_t max_nargs_pos;
     bool complex_call;
+
+    /// Recently successful overload resolutions (created on demand)
+    nb_dispatch_cache *dispatch_cache;
 };
 
 /// Python object representing a `nb_ndarray` (which wraps a DLPack ndarray)
@@ -126,6 +233,23 @@ public:
     void deallocate(T *p, size_type /*n*/) noexcept { PyMem_Free(p); }
 };
 
+/// Hash function and comparison for NUL-terminated strings
+struct str_hash {
+    size_t operator()(const char *s) const {
+        // 64-bit FNV-1a hash
+        uint64_t v = 0xcbf29ce484222325ull;
+        for (; *s; ++s)
+            v = (v ^ (uint8_t) *s) * 0x100000001b3ull;
+        return (size_t) v;
+    }
+};
+
+struct str_eq {
+    bool operator()(const char *a, const char *b) const {
+        return strcmp(a, b) == 0;
+    }
+};
+
 template <typename key, typename value, typename hash = std::hash<key>,
           typename eq = std::equal_to<key>>
 using py_map = tsl::robin_map<key, value, hash, eq>;
@@ -136,6 +260,20 @@ struct nb_inst_seq {
     nb_inst_seq *next;
 };
 
+// Entry of the cache of (Python type, C++ type) -> base class lookups
+struct nb_cast_cache_entry {
+    PyTypeObject *src;
+    const std::type_info *dst;
+    type_data *dst_type; // may be null if 'dst' is not a bound type
+    bool valid;
+};
+
+// Per-thread cache of type lookups (free-threaded builds)
+struct nb_type_cache_entry {
+    const std::type_info *type;
+    type_data *td;
+};
+
 // Weak reference list. Usually, there is just one entry
 struct nb_weakref_seq {
     void (*callback)(void *) noexcept;
@@ -166,6 +304,79 @@ struct nb_translator_seq {
     nb_translator_seq *next = nullptr;
 };
 
+/// Function binding whose creation was deferred (see nb::lazy_functions)
+struct nb_lazy_func {
+    /// Next overload of the same name (in reverse order of registration)
+    nb_lazy_func *next;
+
+    /// Copy of the function record, followed by its argument annotations
+    func_data_prelim<0> f;
+};
+
+/// Deferred function bindings of a module or type, indexed by name
+struct nb_lazy_table {
+    PyObject *scope;
+    py_map<const char *, nb_lazy_func *, str_hash, str_eq> funcs;
+};
+
+using nb_lazy_map = py_map<PyObject *, nb_lazy_table *, ptr_hash>;
+
+/**
+ * Signature of bound functions: the text with '%' placeholders, and the
+ * C++ types that they refer to. Functions with the same signature (e.g.,
+ * overloads, or the same accessor bound in many classes) share one
+ * reference-counted copy, see nb_descr_acquire().
+ */
+struct nb_descr {
+    size_t hash;
+    size_t ntypes;
+    const char *text;
+    /// Null-terminated list of 'ntypes' types, followed by the 'text' storage
+    const std::type_info *types[1];
+};
+
+struct nb_descr_hash {
+    size_t operator()(const nb_descr *d) const { return d->hash; }
+};
+
+struct nb_descr_eq {
+    bool operator()(const nb_descr *a, const nb_descr *b) const {
+        return a->hash == b->hash && a->ntypes == b->ntypes &&
+               memcmp(a->types, b->types,
+                      sizeof(const std::type_info *) * a->ntypes) == 0 &&
+               strcmp(a->text, b->text) == 0;
+    }
+};
+
+/// Pooled signatures and their reference counts
+using nb_descr_map = py_map<nb_descr *, size_t, nb_descr_hash, nb_descr_eq>;
+
+using nb_translator_map =
+    py_map<const std::type_info *, nb_translator_seq, ptr_hash>;
+
+/// Mutable state associated with instances
+struct nb_shard {
+    /**
+     * C++ -> Python instance map
+     *
+     * This associative data structure maps a C++ instance pointer onto its
+     * associated PyObject* (if bit 0 of the map value is zero) or a linked
+     * list of type `nb_inst_seq*` (if bit 0 is set---it must be cleared before
+     * interpreting the pointer in this case).
+     *
+     * The latter case occurs when several distinct Python objects reference
+     * the same memory address (e.g. a struct and its first member).
+     */
+    nb_ptr_map inst_c2p;
+
+    /// Dictionary storing keep_alive references
+    nb_ptr_map keep_alive;
+
+#if defined(NB_FREE_THREADED)
+    PyMutex mutex { };
+#endif
+};
+
 struct nb_internals {
     /// Internal nanobind module
     PyObject *nb_module;
@@ -184,46 +395,192 @@ struct nb_internals {
     bool nb_static_property_enabled = true;
     descrsetfunc nb_static_property_descr_set = nullptr;
 
+    /// Descriptor for direct access to scalar fields (created on demand)
+    PyTypeObject *nb_member = nullptr;
+
     /// N-dimensional array wrapper (created on demand)
     PyTypeObject *nb_ndarray = nullptr;
 
+    /// Storage for native implicit conversions (created on demand)
+    PyTypeObject *nb_scratch = nullptr;
+
+    /// Recycled 'nb_bound_method' instances (linked via their 'func' field)
+    struct nb_bound_method *nb_bound_method_freelist = nullptr;
+    uint32_t nb_bound_method_freelist_size = 0;
+
+    /// Max. size of the above freelist (set to zero during shutdown)
+#if !defined(NB_FREE_THREADED)
+    uint32_t nb_bound_method_freelist_capacity = 16;
+#else
+    uint32_t nb_bound_method_freelist_capacity = 0; // not thread-safe
+#endif
+
+    /// Recycled 'ndarray_handle' instances (linked via their 'owner' field)
+    struct ndarray_handle *ndarray_handle_freelist = nullptr;
+    uint32_t ndarray_handle_freelist_size = 0;
+
+    /// Max. size of the above freelist (set to zero during shutdown)
+#if !defined(NB_FREE_THREADED)
+    uint32_t ndarray_handle_freelist_capacity = 64;
+#else
+    uint32_t ndarray_handle_freelist_capacity = 0; // not thread-safe
+#endif
+
+    /// Number of allocated 'ndarray_handle' instances (excluding the freelist)
+    std::atomic<size_t> ndarray_handles { 0 };
+
+    /// Functions that convert returned ndarrays (see ndarray_wrap_func)
+    PyObject *ndarray_wrap_funcs[5] = { };
+
+    /// Reconstructor of pickled ndarray_shm() arrays (see ndarray_shm_pickle())
+    PyObject *ndarray_shm_open = nullptr;
+
+    /// Recycled ndarray_alloc() buffers, segregated by size class
+    void *ndarray_pool[NB_NDARRAY_POOL_CLASSES] = { };
+    uint32_t ndarray_pool_size[NB_NDARRAY_POOL_CLASSES] = { };
+
+    /// Max. number of buffers per size class (set to zero during shutdown)
+#if !defined(NB_FREE_THREADED)
+    uint32_t ndarray_pool_capacity = 4;
+#else
+    uint32_t ndarray_pool_capacity = 0; // not thread-safe
+#endif
+
+    /// Free lists of nb::pooled() instances, segregated by size class
+    void *inst_pool[NB_POOL_CLASSES] = { };
+
+#if !defined(NB_FREE_THREADED)
+    /// Cached outcome of nb_type_get() checks involving a base class
+    nb_cast_cache_entry cast_cache[NB_CAST_CACHE_SIZE] = { };
+
+    /// Instance-level state (see nb_shard)
+    nb_shard shards[1];
+    static constexpr size_t shard_mask = 0;
+
+    nb_shard &shard(void *) { return shards[0]; }
+#else
+    /// Lock protecting the remaining mutable fields of this data structure
+    PyMutex mutex { };
+
+    /// Incremented whenever cached type lookups of threads become stale
+    std::atomic<uint64_t> type_epoch { 1 };
+
+    /// Instance-level state, split into shards to reduce lock contention
+    nb_shard *shards = nullptr;
+    size_t shard_mask = 0;
+
     /**
-     * C++ -> Python instance map
-     *
-     * This associative data structure maps a C++ instance pointer onto its
-     * associated PyObject* (if bit 0 of the map value is zero) or a linked
-     * list of type `nb_inst_seq*` (if bit 0 is set---it must be cleared before
-     * interpreting the pointer in this case).
-     *
-     * The latter case occurs when several distinct Python objects reference
-     * the same memory address (e.g. a struct and its first member).
+     * Select a shard based on the high bits of an address, which tend to
+     * group the allocations made by an individual thread (this heuristic
+     * follows pybind11 PR #5148).
      */
-    nb_ptr_map inst_c2p;
+    nb_shard &shard(void *p) {
+        void *region = (void *) (((uintptr_t) p) >> 20);
+        return shards[ptr_hash()(region) & shard_mask];
+    }
+#endif
 
     /// C++ -> Python type map
     nb_type_map type_c2p;
 
-    /// Dictionary storing keep_alive references
-    nb_ptr_map keep_alive;
+    /**
+     * Memoized lookups into 'type_c2p' keyed by the address of the
+     * std::type_info instance (avoids hashing the type name). Several
+     * addresses may refer to the same type when it is used from multiple
+     * shared libraries. Maps to 'type_data *'.
+     */
+    nb_ptr_map type_c2p_fast;
 
     /// nb_func/meth instance map for leak reporting (used as set, the value is unused)
     nb_ptr_map funcs;
 
+    /// Signatures shared by the functions in 'funcs'
+    nb_descr_map descrs;
+
+    /// Module definitions executed in this interpreter (used as set, see NB_MODULE)
+    nb_ptr_map module_defs;
+
     /// Registered C++ -> Python exception translators
     nb_translator_seq translators;
 
+    /// Translator that most recently handled a given C++ exception type
+    nb_translator_map translator_cache;
+
+    /// Route by which ndarray_import() last converted instances of a Python type
+    /// (tagged with the type's version, see ndarray_route_tag())
+    nb_ptr_map ndarray_routes;
+
+    /// Slot implementations of operators.h bindings, keyed by the bound function
+    nb_ptr_map op_slots;
+
+    /// Worker threads of nb::parallel_for(), created on first use
+    nb_thread_pool *thread_pool = nullptr;
+
+    /// References released by threads without the GIL (see decref_deferred())
+    std::atomic<nb_deferred_decref *> decref_pending { nullptr };
+    std::atomic<bool> decref_scheduled { false };
+
+    /// Are such references queued instead of acquiring the GIL?
+    std::atomic<bool> decref_defer { false };
+
+    /// Was any type bound with an nb::intrusive_ptr 'get_self_py' callback?
+    std::atomic<bool> has_get_self_py { false };
+
+    /// Deferred function bindings of modules and types
+    nb_lazy_map lazy_funcs;
+
+#if defined(NB_PROFILE)
+    /// Registrations of classes and functions in the order they happened
+    std::vector<nb_import_record> import_profile;
+#endif
+
+    /// Unique ID of this 'nb_internals' instance (see interned_get())
+    uint64_t id = 0;
+
+    /// Strings of nb::interned keys used in this interpreter, indexed by their cache
+    nb_ptr_map interned;
+
+    /// Direct-mapped cache of strings returned by nb::intern_strings() functions
+    static constexpr size_t str_cache_size = 1024;
+    struct str_cache_entry {
+        size_t hash;
+        PyObject *value;
+    } str_cache[str_cache_size] { };
+
+    /// State of the 'datetime' module used by the std::chrono casters
+    void *datetime_cache[5] { };
+
+    /// Incremented whenever the Python overrides of a type hierarchy change
+    std::atomic<uint64_t> override_epoch { 0 };
+
+    /// Number of types with deferred function bindings
+    size_t lazy_types = 0;
+
+    /// Nesting depth of nb::lazy_functions scopes
+    uint32_t lazy_depth = 0;
+
+    /// Nesting depth of nb::release_gil_default scopes
+    uint32_t release_gil_depth = 0;
+
     /// Should nanobind print leak warnings on exit?
     bool print_leak_warnings = true;
 
     /// Should nanobind print warnings after implicit cast failures?
     bool print_implicit_cast_warnings = true;
 
+    /// Report memory managed by nanobind to tracemalloc? (nb::set_tracemalloc())
+    bool tracemalloc = false;
+
+    /// Name new functions in the perf map? (nb::set_perf_map())
+    bool perf_map = false;
+
 #if defined(Py_LIMITED_API)
     // Cache important functions from PyType_Type and PyProperty_Type
     freefunc PyType_Type_tp_free;
     initproc PyType_Type_tp_init;
     destructor PyType_Type_tp_dealloc;
     setattrofunc PyType_Type_tp_setattro;
+    getattrofunc PyType_Type_tp_getattro;
     descrgetfunc PyProperty_Type_tp_descr_get;
     descrsetfunc PyProperty_Type_tp_descr_set;
 #endif
@@ -236,27 +593,169 @@ struct nb_internals {
 #  define NB_SLOT(internals, type, name) type.name
 #endif
 
+/// RAII lock of the mutable fields of 'nb_internals' (free-threaded builds)
+struct lock_internals {
+#if defined(NB_FREE_THREADED)
+    lock_internals(nb_internals &internals) : m(internals.mutex) { PyMutex_Lock(&m); }
+    ~lock_internals() { PyMutex_Unlock(&m); }
+    PyMutex &m;
+#else
+    lock_internals(nb_internals &) { }
+#endif
+};
+
+/// RAII lock of a shard of instance-level state (free-threaded builds)
+struct lock_shard {
+#if defined(NB_FREE_THREADED)
+    lock_shard(nb_shard &shard) : m(shard.mutex) { PyMutex_Lock(&m); }
+    ~lock_shard() { PyMutex_Unlock(&m); }
+    PyMutex &m;
+#else
+    lock_shard(nb_shard &) { }
+#endif
+};
+
+/**
+ * Increase the reference count of an instance found in the instance map.
+ * In free-threaded builds, another thread may concurrently be in the process
+ * of deleting it, in which case the function fails and returns 'false'.
+ */
+NB_INLINE bool nb_try_inc_ref(PyObject *o) noexcept {
+#if !defined(NB_FREE_THREADED)
+    Py_INCREF(o);
+    return true;
+#elif PY_VERSION_HEX >= 0x030E0000
+    return PyUnstable_TryIncRef(o);
+#else
+    // Based on _Py_TryIncrefFast() and _Py_TryIncRefShared() of CPython 3.13
+    uint32_t local = _Py_atomic_load_uint32_relaxed(&o->ob_ref_local);
+    local += 1;
+    if (local == 0) // immortal
+        return true;
+
+    if (_Py_IsOwnedByCurrentThread(o)) {
+        _Py_atomic_store_uint32_relaxed(&o->ob_ref_local, local);
+        return true;
+    }
+
+    Py_ssize_t shared = _Py_atomic_load_ssize_relaxed(&o->ob_ref_shared);
+    while (true) {
+        if (shared == 0 || shared == _Py_REF_MERGED)
+            return false;
+        if (_Py_atomic_compare_exchange_ssize(
+                &o->ob_ref_shared, &shared,
+                shared + (1 << _Py_REF_SHARED_SHIFT)))
+            return true;
+    }
+#endif
+}
+
 struct current_method {
     const char *name;
     PyObject *self;
 };
 
 extern NB_THREAD_LOCAL current_method current_method_data;
+
+#if defined(NB_PROFILE)
+/// Counters of the overload that is currently being invoked (if any)
+extern NB_THREAD_LOCAL nb_profile_data *profile_current;
+
+/// Record the registration of 'name' in 'scope' that began at time 't0'
+extern void nb_profile_import(const char *kind, PyObject *scope,
+                              const char *name,
+                              std::chrono::steady_clock::time_point t0) noexcept;
+#endif
+/**
+ * Internals of the first interpreter that used nanobind. Once a second
+ * interpreter creates its own internals (see NB_MODULE with
+ * NB_MULTIPLE_INTERPRETERS), 'internals_multi' is set and lookups go through
+ * a per-thread cache keyed on the current interpreter instead.
+ */
 extern nb_internals *internals_p;
+extern std::atomic<bool> internals_multi;
 extern nb_internals *internals_fetch();
+extern nb_internals *internals_get_multi() noexcept;
 
 inline nb_internals &internals_get() noexcept {
     nb_internals *ptr = internals_p;
     if (NB_UNLIKELY(!ptr))
         ptr = internals_fetch();
+    else if (NB_UNLIKELY(internals_multi.load(std::memory_order_relaxed)))
+        ptr = internals_get_multi();
     return *ptr;
 }
 
+/**
+ * Internals that receive the references released by threads without a thread
+ * state. These are only known when a single interpreter uses nanobind.
+ */
+inline nb_internals *decref_pending_internals() noexcept {
+    if (internals_multi.load(std::memory_order_relaxed))
+        return nullptr;
+    return internals_p;
+}
+
 extern char *type_name(const std::type_info *t);
 
 // Forward declarations
 extern PyObject *inst_new_impl(PyTypeObject *tp, void *value);
+extern type_data *nb_type_c2p(nb_internals &internals,
+                              const std::type_info *type);
 extern PyTypeObject *nb_static_property_tp() noexcept;
+extern void nb_lazy_materialize(PyTypeObject *tp) noexcept;
+
+/// Per-thread scratch arena (see cleanup_list), rewound to a previous mark
+extern void *scratch_alloc(size_t size) noexcept;
+extern void scratch_mark(void **chunk, size_t *used) noexcept;
+extern void scratch_rewind(void *chunk, size_t used) noexcept;
+
+/* When enabled via nb::set_tracemalloc(), memory that nanobind allocates on
+   behalf of Python objects outside of the Python allocators is reported to
+   tracemalloc, which attributes it to the current Python frame. */
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+#  define NB_TRACEMALLOC
+
+/* Python < 3.12 declares these functions without C linkage in C++. The
+   declarations below are part of the (hidden) nanobind namespace, and
+   PyAPI_FUNC() of Python 3.8 doesn't override that visibility. */
+#  if defined(_WIN32)
+extern "C" PyAPI_FUNC(int) PyTraceMalloc_Track(unsigned int, uintptr_t, size_t);
+extern "C" PyAPI_FUNC(int) PyTraceMalloc_Untrack(unsigned int, uintptr_t);
+#  else
+extern "C" NB_IMPORT int PyTraceMalloc_Track(unsigned int, uintptr_t, size_t);
+extern "C" NB_IMPORT int PyTraceMalloc_Untrack(unsigned int, uintptr_t);
+#  endif
+#endif
+
+NB_INLINE void trace_alloc(const void *p, size_t size) noexcept {
+#if defined(NB_TRACEMALLOC)
+    if (NB_UNLIKELY(internals_get().tracemalloc))
+        PyTraceMalloc_Track(0, (uintptr_t) p, size);
+#else
+    (void) p; (void) size;
+#endif
+}
+
+NB_INLINE void trace_free(const void *p) noexcept {
+#if defined(NB_TRACEMALLOC)
+    if (NB_UNLIKELY(internals_get().tracemalloc))
+        PyTraceMalloc_Untrack(0, (uintptr_t) p);
+#else
+    (void) p;
+#endif
+}
+
+/// Release references queued by decref_deferred()
+extern void decref_pending_release(nb_internals &internals) noexcept;
+
+/// Queue an entry for release once the interpreter holds the GIL again
+extern void decref_pending_push(nb_internals &internals,
+                                nb_deferred_decref *d) noexcept;
+extern bool nb_lazy_pending(PyTypeObject *tp, PyObject *name) noexcept;
+extern void nb_lazy_type_free(PyTypeObject *tp) noexcept;
+extern void nb_override_free(type_data *t) noexcept;
+extern void nb_override_invalidate(PyTypeObject *tp, const char *name) noexcept;
 
 /// Fetch the nanobind function record from a 'nb_func' instance
 NB_INLINE func_data *nb_func_data(void *o) {
@@ -264,7 +763,8 @@ NB_INLINE func_data *nb_func_data(void *o) {
 }
 
 #if defined(Py_LIMITED_API)
-extern type_data *nb_type_data_static(PyTypeObject *o) noexcept;
+/// Offset of 'type_data' in type objects (PyType_Type.__basicsize__)
+extern size_t nb_type_data_offset;
 #endif
 
 /// Fetch the nanobind type record from a 'nb_type' instance
@@ -272,7 +772,7 @@ NB_INLINE type_data *nb_type_data(PyTypeObject *o) noexcept{
     #if !defined(Py_LIMITED_API)
         return (type_data *) (((char *) o) + sizeof(PyHeapTypeObject));
     #else
-        return nb_type_data_static(o);
+        return (type_data *) (((char *) o) + nb_type_data_offset);
     #endif
 }
 
@@ -286,6 +786,12 @@ inline void *inst_ptr(nb_inst *self) {
     return self->direct ? ptr : *(void **) ptr;
 }
 
+/// Release queued references, if any (the caller must hold the GIL)
+NB_INLINE void decref_pending_check(nb_internals &internals) noexcept {
+    if (NB_UNLIKELY(internals.decref_pending.load(std::memory_order_relaxed)))
+        decref_pending_release(internals);
+}
+
 template <typename T> struct scoped_pymalloc {
     scoped_pymalloc(size_t size = 1) {
         ptr = (T *) PyMem_Malloc(size * sizeof(T));
@@ -0,0 +1,422 @@
+/*
+    src/nb_member.cpp: descriptor type for direct access to scalar fields
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include "nb_internals.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * Descriptor created by def_rw() / def_ro() for arithmetic and boolean
+ * fields. It reads and writes the field at a fixed offset from the instance
+ * pointer, which bypasses the function dispatch of a regular property.
+ */
+struct nb_member {
+    PyObject_HEAD
+    PyTypeObject *type;
+    PyObject *name;
+    const char *doc;
+    size_t offset;
+    member_kind kind;
+    bool readonly;
+};
+
+static const char *nb_member_kind_name(member_kind kind) {
+    switch (kind) {
+        case member_kind::bool_: return "bool";
+        case member_kind::f32:
+        case member_kind::f64: return "float";
+        default: return "int";
+    }
+}
+
+/// Return a pointer to the field, or raise an exception and return nullptr
+static char *nb_member_ptr(nb_member *m, PyObject *o) {
+    PyTypeObject *tp = Py_TYPE(o);
+
+    if (NB_UNLIKELY(tp != m->type && !PyType_IsSubtype(tp, m->type))) {
+        PyObject *tp_name = nb_type_name(tp);
+        PyErr_Format(PyExc_TypeError,
+                     "descriptor '%U' for '%s' objects doesn't apply to a "
+                     "'%U' object", m->name, nb_type_data(m->type)->name,
+                     tp_name);
+        Py_XDECREF(tp_name);
+        return nullptr;
+    }
+
+    // Warn just like nb_type_get() and then fail
+    nb_inst *inst = (nb_inst *) o;
+    if (NB_UNLIKELY(!inst->ready)) {
+        if (PyErr_WarnFormat(PyExc_RuntimeWarning, 1,
+                             "nanobind: attempted to access an uninitialized "
+                             "instance of type '%s'!\n",
+                             nb_type_data(tp)->name) == 0)
+            PyErr_Format(PyExc_TypeError,
+                         "attribute '%U' of '%s' objects cannot be accessed "
+                         "on an uninitialized instance", m->name,
+                         nb_type_data(m->type)->name);
+        return nullptr;
+    }
+
+    return (char *) inst_ptr(inst) + m->offset;
+}
+
+static PyObject *nb_member_descr_get(PyObject *self, PyObject *o, PyObject *) {
+    nb_member *m = (nb_member *) self;
+
+    if (!o || o == Py_None) {
+        Py_INCREF(self);
+        return self;
+    }
+
+    char *p = nb_member_ptr(m, o);
+    if (!p)
+        return nullptr;
+
+    switch (m->kind) {
+        case member_kind::bool_: {
+            PyObject *result = *(bool *) p ? Py_True : Py_False;
+            Py_INCREF(result);
+            return result;
+        }
+        case member_kind::i8:  return PyLong_FromLong(*(int8_t *) p);
+        case member_kind::u8:  return PyLong_FromUnsignedLong(*(uint8_t *) p);
+        case member_kind::i16: return PyLong_FromLong(*(int16_t *) p);
+        case member_kind::u16: return PyLong_FromUnsignedLong(*(uint16_t *) p);
+        case member_kind::i32: return PyLong_FromLong(*(int32_t *) p);
+        case member_kind::u32: return PyLong_FromUnsignedLong(*(uint32_t *) p);
+        case member_kind::i64: return PyLong_FromLongLong(*(int64_t *) p);
+        case member_kind::u64: return PyLong_FromUnsignedLongLong(*(uint64_t *) p);
+        case member_kind::f32: return PyFloat_FromDouble(*(float *) p);
+        case member_kind::f64: return PyFloat_FromDouble(*(double *) p);
+    }
+
+    return nullptr;
+}
+
+static int nb_member_descr_set(PyObject *self, PyObject *o, PyObject *value) {
+    nb_member *m = (nb_member *) self;
+
+    if (m->readonly || !value) {
+        PyErr_Format(PyExc_AttributeError,
+                     m->readonly ? "attribute '%U' of '%s' objects is not "
+                                   "writable"
+                                 : "attribute '%U' of '%s' objects cannot be "
+                                   "deleted",
+                     m->name, nb_type_data(m->type)->name);
+        return -1;
+    }
+
+    char *p = nb_member_ptr(m, o);
+    if (!p)
+        return -1;
+
+    // Accept the same values as the type casters used by regular properties
+    uint8_t flags = (uint8_t) cast_flags::convert;
+    bool success;
+
+    switch (m->kind) {
+        case member_kind::bool_:
+            success = value == Py_True || value == Py_False;
+            if (success)
+                *(bool *) p = value == Py_True;
+            break;
+        case member_kind::i8:  success = load_i8 (value, flags, (int8_t *) p);   break;
+        case member_kind::u8:  success = load_u8 (value, flags, (uint8_t *) p);  break;
+        case member_kind::i16: success = load_i16(value, flags, (int16_t *) p);  break;
+        case member_kind::u16: success = load_u16(value, flags, (uint16_t *) p); break;
+        case member_kind::i32: success = load_i32(value, flags, (int32_t *) p);  break;
+        case member_kind::u32: success = load_u32(value, flags, (uint32_t *) p); break;
+        case member_kind::i64: success = load_i64(value, flags, (int64_t *) p);  break;
+        case member_kind::u64: success = load_u64(value, flags, (uint64_t *) p); break;
+        case member_kind::f32: success = load_f32(value, flags, (float *) p);    break;
+        case member_kind::f64: success = load_f64(value, flags, (double *) p);   break;
+        default: success = false;
+    }
+
+    if (NB_UNLIKELY(!success)) {
+        PyErr_Clear();
+        PyObject *tp_name = nb_inst_name(value);
+        PyErr_Format(PyExc_TypeError,
+                     "attribute '%U' of '%s' objects expects a value of type "
+                     "'%s' (got '%U')", m->name, nb_type_data(m->type)->name,
+                     nb_member_kind_name(m->kind), tp_name);
+        Py_XDECREF(tp_name);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int nb_member_traverse(PyObject *self, visitproc visit, void *arg) {
+    Py_VISIT(((nb_member *) self)->type);
+    return 0;
+}
+
+static int nb_member_clear(PyObject *self) {
+    Py_CLEAR(((nb_member *) self)->type);
+    return 0;
+}
+
+static void nb_member_dealloc(PyObject *self) {
+    nb_member *m = (nb_member *) self;
+    PyTypeObject *tp = Py_TYPE(self);
+
+    PyObject_GC_UnTrack(self);
+    Py_CLEAR(m->type);
+    Py_CLEAR(m->name);
+    PyObject_GC_Del(self);
+
+    Py_DECREF(tp);
+}
+
+static PyObject *nb_member_get_name(PyObject *self, void *) {
+    PyObject *name = ((nb_member *) self)->name;
+    Py_INCREF(name);
+    return name;
+}
+
+static PyObject *nb_member_get_doc(PyObject *self, void *) {
+    const char *doc = ((nb_member *) self)->doc;
+    if (doc)
+        return PyUnicode_FromString(doc);
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyGetSetDef nb_member_getset[] = {
+    { "__name__", nb_member_get_name, nullptr, nullptr, nullptr },
+    { "__doc__", nb_member_get_doc, nullptr, nullptr, nullptr },
+    { nullptr, nullptr, nullptr, nullptr, nullptr }
+};
+
+static PyTypeObject *nb_member_tp() noexcept {
+    nb_internals &internals = internals_get();
+    PyTypeObject *tp = internals.nb_member;
+
+    if (NB_UNLIKELY(!tp)) {
+        PyType_Slot slots[] = {
+            { Py_tp_descr_get, (void *) nb_member_descr_get },
+            { Py_tp_descr_set, (void *) nb_member_descr_set },
+            { Py_tp_traverse, (void *) nb_member_traverse },
+            { Py_tp_clear, (void *) nb_member_clear },
+            { Py_tp_dealloc, (void *) nb_member_dealloc },
+            { Py_tp_getset, (void *) nb_member_getset },
+            { 0, nullptr }
+        };
+
+        PyType_Spec spec = {
+            /* .name = */ "nanobind.nb_member",
+            /* .basicsize = */ (int) sizeof(nb_member),
+            /* .itemsize = */ 0,
+            /* .flags = */ Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+            /* .slots = */ slots
+        };
+
+        tp = (PyTypeObject *) PyType_FromSpec(&spec);
+        check(tp, "nb_member type creation failed!");
+
+        internals.nb_member = tp;
+    }
+
+    return tp;
+}
+
+void member_install(PyObject *scope, const char *name, size_t offset,
+                    member_kind kind, bool readonly,
+                    const char *doc) noexcept {
+    check(nb_type_check(scope),
+          "nanobind::detail::member_install(\"%s\"): scope must be a "
+          "nanobind type!", name);
+
+    PyTypeObject *tp = nb_member_tp();
+    nb_member *m = (nb_member *) PyType_GenericAlloc(tp, 0);
+    check(m, "nanobind::detail::member_install(\"%s\"): allocation failed!",
+          name);
+
+    Py_INCREF(scope);
+    m->type = (PyTypeObject *) scope;
+    m->name = PyUnicode_InternFromString(name);
+    m->doc = doc;
+    m->offset = offset;
+    m->kind = kind;
+    m->readonly = readonly;
+
+    check(m->name && PyObject_SetAttr(scope, m->name, (PyObject *) m) == 0,
+          "nanobind::detail::member_install(\"%s\"): could not install the "
+          "descriptor!", name);
+
+    Py_DECREF(m);
+}
+
+static char nb_member_format(member_kind kind) {
+    switch (kind) {
+        case member_kind::bool_: return '?';
+        case member_kind::i8:  return 'b';
+        case member_kind::u8:  return 'B';
+        case member_kind::i16: return 'h';
+        case member_kind::u16: return 'H';
+        case member_kind::i32: return 'i';
+        case member_kind::u32: return 'I';
+        case member_kind::i64: return 'q';
+        case member_kind::u64: return 'Q';
+        case member_kind::f32: return 'f';
+        default: return 'd';
+    }
+}
+
+static size_t nb_member_size(member_kind kind) {
+    switch (kind) {
+        case member_kind::bool_:
+        case member_kind::i8:
+        case member_kind::u8: return 1;
+        case member_kind::i16:
+        case member_kind::u16: return 2;
+        case member_kind::i32:
+        case member_kind::u32:
+        case member_kind::f32: return 4;
+        default: return 8;
+    }
+}
+
+int record_getbuffer(PyObject *exporter, Py_buffer *view, int flags,
+                     const std::type_info *type, void *data,
+                     size_t count) noexcept {
+    view->obj = nullptr;
+
+    PyTypeObject *tp = (PyTypeObject *) nb_type_lookup(type);
+    if (!tp) {
+        PyErr_SetString(PyExc_BufferError,
+                        "Cannot export the contents of a vector whose "
+                        "element type is not bound!");
+        return -1;
+    }
+
+    nb_internals &internals = internals_get();
+    size_t itemsize = nb_type_data(tp)->size;
+
+    /* Collect the fields installed by def_rw() / def_ro() on the element type
+       and its bound base classes. Fields of derived classes shadow those of
+       base classes with the same name. */
+    struct field { size_t offset; member_kind kind; std::string name; };
+    std::vector<field> fields;
+    bool readonly = false;
+
+    try {
+        object mro = handle((PyObject *) tp).attr("__mro__");
+
+        for (handle base : mro) {
+            if (!nb_type_check(base.ptr()))
+                continue;
+
+            object dict = base.attr("__dict__"),
+                   items = steal(PyMapping_Items(dict.ptr()));
+            if (!items.is_valid())
+                raise_python_error();
+
+            for (handle item : items) {
+                PyObject *value = PyTuple_GetItem(item.ptr(), 1);
+                if (!value || Py_TYPE(value) != internals.nb_member)
+                    continue;
+
+                nb_member *m = (nb_member *) value;
+                Py_ssize_t size;
+                const char *name = PyUnicode_AsUTF8AndSize(m->name, &size);
+                if (!name)
+                    raise_python_error();
+
+                std::string name_s(name, size);
+                bool shadowed = false;
+                for (const field &f : fields)
+                    shadowed |= f.name == name_s;
+                if (shadowed)
+                    continue;
+
+                fields.push_back({ m->offset, m->kind, std::move(name_s) });
+                readonly |= m->readonly;
+            }
+        }
+    } catch (...) {
+        translate_exception();
+        return -1;
+    }
+
+    if (fields.empty()) {
+        PyErr_Format(PyExc_BufferError,
+                     "Cannot export the contents of a vector of '%s' "
+                     "instances: the type has no fields bound via def_rw() "
+                     "or def_ro()!", nb_type_data(tp)->name);
+        return -1;
+    }
+
+    // Fields bound via def_ro() remain read-only in the exported buffer
+    if (readonly && (flags & PyBUF_WRITABLE)) {
+        PyErr_Format(PyExc_BufferError,
+                     "Cannot export the contents of a vector of '%s' "
+                     "instances as a writable buffer: the type has fields "
+                     "bound via def_ro()!", nb_type_data(tp)->name);
+        return -1;
+    }
+
+    std::sort(fields.begin(), fields.end(),
+              [](const field &a, const field &b) { return a.offset < b.offset; });
+
+    // PEP 3118 struct format, e.g. 'T{d:price:q:qty:}', unbound bytes are padding
+    std::string format = "T{";
+    size_t pos = 0;
+    for (const field &f : fields) {
+        if (f.offset < pos)
+            continue; // overlaps the previous field (e.g., an alias)
+        if (f.offset > pos)
+            format += std::to_string(f.offset - pos) + 'x';
+        format += nb_member_format(f.kind);
+        format += ':';
+        format += f.name;
+        format += ':';
+        pos = f.offset + nb_member_size(f.kind);
+    }
+    if (itemsize > pos)
+        format += std::to_string(itemsize - pos) + 'x';
+    format += '}';
+
+    // A single allocation holds the shape, stride, and format
+    Py_ssize_t *shape = (Py_ssize_t *) PyMem_Malloc(
+        2 * sizeof(Py_ssize_t) + format.size() + 1);
+    if (!shape) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    char *format_buf = (char *) (shape + 2);
+    memcpy(format_buf, format.c_str(), format.size() + 1);
+
+    shape[0] = (Py_ssize_t) count;
+    shape[1] = (Py_ssize_t) itemsize;
+
+    view->buf = data;
+    view->obj = exporter;
+    view->len = shape[0] * shape[1];
+    view->itemsize = shape[1];
+    view->readonly = readonly;
+    view->format = format_buf;
+    view->ndim = 1;
+    view->shape = shape;
+    view->strides = shape + 1;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    Py_INCREF(exporter);
+
+    return 0;
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
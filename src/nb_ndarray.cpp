@@ -1,7 +1,24 @@
 #include <nanobind/ndarray.h>
 #include <atomic>
+#include <limits>
 #include "nb_internals.h"
 
+#if defined(_WIN32)
+#  if !defined(NOMINMAX)
+#    define NOMINMAX
+#  endif
+#  if !defined(WIN32_LEAN_AND_MEAN)
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
@@ -13,15 +30,110 @@ struct managed_dltensor {
     void (*deleter)(managed_dltensor *);
 };
 
+/// DLPack 1.0 tensor, exchanged via "dltensor_versioned" capsules
+struct managed_dltensor_versioned {
+    struct { uint32_t major, minor; } version;
+    void *manager_ctx;
+    void (*deleter)(managed_dltensor_versioned *);
+    uint64_t flags;
+    dlpack::dltensor dltensor;
+};
+
+static constexpr uint64_t dlpack_flag_read_only = 1;
+
+/**
+ * Reference-counted wrapper around a DLPack tensor. Handles are allocated
+ * along with storage for the shape and strides of 'capacity' dimensions
+ * (at least 'ndarray_handle_dims'), which directly follows the structure.
+ */
 struct ndarray_handle {
     managed_dltensor *ndarray;
     std::atomic<size_t> refcount;
     PyObject *owner, *self;
-    bool free_shape;
-    bool free_strides;
+    uint32_t capacity;
+    bool inline_strides; // imported tensor refers to the strides storage
+    bool free_data;
     bool call_deleter;
+    bool readonly; // reject writable buffer protocol requests
+    bool pool_data; // return the data to the pool of ndarray_alloc()
+    uint8_t pool_class;
+
+    /// File mapping created by ndarray_mmap(), unmapped upon release
+    void *mapping;
+    size_t mapping_size;
+
+    /// Shared memory segment created by ndarray_shm(), unlinked upon release
+    /// by its owner (ownership passes on when the array is pickled)
+    char *shm_name;
+    bool shm_owner;
+
+    /// Entry of the deferred release queue (see ndarray_release_deferred())
+    nb_deferred_decref pending;
+
+    /// Tensor storage used by ndarray_create()
+    managed_dltensor tensor;
 };
 
+/// Dimension count covered by the storage of recycled handles
+static constexpr uint32_t ndarray_handle_dims = 4;
+
+/// Shape storage, followed by the strides (at offset 'capacity')
+NB_INLINE int64_t *ndarray_handle_storage(ndarray_handle *th) {
+    return (int64_t *) (th + 1);
+}
+
+static ndarray_handle *ndarray_handle_alloc(size_t ndim) {
+    nb_internals &internals = internals_get();
+    ndarray_handle *th = internals.ndarray_handle_freelist;
+    internals.ndarray_handles.fetch_add(1, std::memory_order_relaxed);
+
+    if (ndim <= ndarray_handle_dims && th) {
+        internals.ndarray_handle_freelist = (ndarray_handle *) th->owner;
+        internals.ndarray_handle_freelist_size--;
+        return th;
+    }
+
+    size_t capacity = ndim > ndarray_handle_dims ? ndim : ndarray_handle_dims;
+    th = (ndarray_handle *) PyMem_Malloc(sizeof(ndarray_handle) +
+                                         2 * capacity * sizeof(int64_t));
+    if (!th)
+        fail("nanobind::detail::ndarray_handle_alloc(): out of memory!");
+    th->capacity = (uint32_t) capacity;
+    return th;
+}
+
+static void ndarray_handle_free(ndarray_handle *th) noexcept {
+    nb_internals &internals = internals_get();
+    internals.ndarray_handles.fetch_sub(1, std::memory_order_relaxed);
+
+    if (th->capacity == ndarray_handle_dims &&
+        internals.ndarray_handle_freelist_size <
+            internals.ndarray_handle_freelist_capacity) {
+        th->owner = (PyObject *) internals.ndarray_handle_freelist;
+        internals.ndarray_handle_freelist = th;
+        internals.ndarray_handle_freelist_size++;
+        return;
+    }
+
+    PyMem_Free(th);
+}
+
+/// Release the 'ndarray_handle' freelist and stop recycling handles
+void ndarray_handle_freelist_clear() noexcept {
+    nb_internals &internals = internals_get();
+    ndarray_handle *th = internals.ndarray_handle_freelist;
+
+    while (th) {
+        ndarray_handle *next = (ndarray_handle *) th->owner;
+        PyMem_Free(th);
+        th = next;
+    }
+
+    internals.ndarray_handle_freelist = nullptr;
+    internals.ndarray_handle_freelist_size = 0;
+    internals.ndarray_handle_freelist_capacity = 0;
+}
+
 static void nb_ndarray_dealloc(PyObject *self) {
     ndarray_dec_ref(((nb_ndarray *) self)->th);
 
@@ -35,11 +147,16 @@ static void nb_ndarray_dealloc(PyObject *self) {
     tp_free(self);
 }
 
-static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
+static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int flags) {
     nb_ndarray *self = (nb_ndarray *) exporter;
 
     dlpack::dltensor &t = self->th->ndarray->dltensor;
 
+    if (self->th->readonly && (flags & PyBUF_WRITABLE)) {
+        PyErr_SetString(PyExc_BufferError, "ndarray is read-only!");
+        return -1;
+    }
+
     if (t.device.device_type != device::cpu::value) {
         PyErr_SetString(PyExc_BufferError, "Only CPU-allocated ndarrays can be "
                                            "accessed via the buffer protocol!");
@@ -96,8 +213,8 @@ static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
     Py_INCREF(exporter);
 
     Py_ssize_t len = view->itemsize;
-    scoped_pymalloc<Py_ssize_t> strides((size_t) t.ndim),
-                                  shape((size_t) t.ndim);
+    scoped_pymalloc<Py_ssize_t> shape(2 * (size_t) t.ndim);
+    Py_ssize_t *strides = shape.get() + t.ndim;
 
     for (size_t i = 0; i < (size_t) t.ndim; ++i) {
         len *= (Py_ssize_t) t.shape[i];
@@ -107,20 +224,69 @@ static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
 
     view->ndim = t.ndim;
     view->len = len;
-    view->readonly = false;
+    view->readonly = self->th->readonly;
     view->suboffsets = nullptr;
     view->internal = nullptr;
-    view->strides = strides.release();
+    view->strides = strides;
     view->shape = shape.release();
 
     return 0;
 }
 
 static void nb_ndarray_releasebuffer(PyObject *, Py_buffer *view) {
-    PyMem_Free(view->shape);
-    PyMem_Free(view->strides);
+    PyMem_Free(view->shape); // also contains the strides
+}
+
+/**
+ * Arrays created by ndarray_shm() pickle as the name of their shared memory
+ * segment, which the reconstructor registered by ndarray_shm_pickle() maps in
+ * the unpickling process. The array that created the segment remains its
+ * owner and unlinks it upon release, hence pickles can be loaded any number
+ * of times while it is alive.
+ */
+static PyObject *nb_ndarray_reduce(PyObject *self, PyObject *) {
+    ndarray_handle *th = ((nb_ndarray *) self)->th;
+    if (!th->shm_name) {
+        PyErr_SetString(PyExc_TypeError,
+                        "nanobind.nb_ndarray: only arrays created by "
+                        "nb::ndarray_shm() can be pickled!");
+        return nullptr;
+    }
+
+    PyObject *open = internals_get().ndarray_shm_open;
+    if (!open) {
+        PyErr_SetString(PyExc_TypeError,
+                        "nanobind.nb_ndarray: pickling shared memory arrays "
+                        "requires a prior call to nb::ndarray_shm_pickle()!");
+        return nullptr;
+    }
+    Py_INCREF(open);
+
+    const dlpack::dltensor &t = th->ndarray->dltensor;
+    PyObject *shape = PyTuple_New(t.ndim);
+    for (int32_t i = 0; shape && i < t.ndim; ++i) {
+        PyObject *value = PyLong_FromLongLong((long long) t.shape[i]);
+        if (!value)
+            Py_CLEAR(shape);
+        else
+            NB_TUPLE_SET_ITEM(shape, i, value);
+    }
+
+    PyObject *result = nullptr;
+    if (shape)
+        result = Py_BuildValue("(O(sOiii))", open, th->shm_name, shape,
+                               (int) t.dtype.code, (int) t.dtype.bits,
+                               (int) t.dtype.lanes);
+    Py_DECREF(open);
+    Py_XDECREF(shape);
+    return result;
 }
 
+static PyMethodDef nb_ndarray_methods[] = {
+    { "__reduce__", nb_ndarray_reduce, METH_NOARGS, nullptr },
+    { nullptr, nullptr, 0, nullptr }
+};
+
 static PyTypeObject *nd_ndarray_tp() noexcept {
     nb_internals &internals = internals_get();
     PyTypeObject *tp = internals.nb_ndarray;
@@ -128,6 +294,7 @@ static PyTypeObject *nd_ndarray_tp() noexcept {
     if (NB_UNLIKELY(!tp)) {
         PyType_Slot slots[] = {
             { Py_tp_dealloc, (void *) nb_ndarray_dealloc },
+            { Py_tp_methods, (void *) nb_ndarray_methods },
 #if PY_VERSION_HEX >= 0x03090000
             { Py_bf_getbuffer, (void *) nd_ndarray_tpbuffer },
             { Py_bf_releasebuffer, (void *) nb_ndarray_releasebuffer },
@@ -151,21 +318,26 @@ static PyTypeObject *nd_ndarray_tp() noexcept {
         tp->tp_as_buffer->bf_releasebuffer = nb_ndarray_releasebuffer;
 #endif
 
-        internals.nb_ndarray = tp;
+        PyTypeObject *tp_prev;
+        {
+            lock_internals guard(internals);
+            tp_prev = internals.nb_ndarray;
+            if (!tp_prev)
+                internals.nb_ndarray = tp;
+        }
+
+        // Another thread created the type concurrently
+        if (tp_prev) {
+            Py_DECREF(tp);
+            tp = tp_prev;
+        }
     }
 
     return tp;
 }
 
-static PyObject *dlpack_from_buffer_protocol(PyObject *o) {
-    scoped_pymalloc<Py_buffer> view;
-    scoped_pymalloc<managed_dltensor> mt;
-
-    if (PyObject_GetBuffer(o, view.get(), PyBUF_RECORDS)) {
-        PyErr_Clear();
-        return nullptr;
-    }
-
+/// Determine the dtype of a buffer, returns false if it is unsupported
+static bool buffer_dtype(const Py_buffer *view, dlpack::dtype &dt) {
     char format = 'B';
     const char *format_str = view->format;
     if (format_str)
@@ -185,52 +357,84 @@ static PyObject *dlpack_from_buffer_protocol(PyObject *o) {
     if (skip_first && format_str)
         format = *++format_str;
 
-    dlpack::dtype dt { };
-    bool fail = format_str && format_str[1] != '\0';
+    dt = { };
+    if (format_str && format_str[1] != '\0')
+        return false;
 
-    if (!fail) {
-        switch (format) {
-            case 'c':
-            case 'b':
-            case 'h':
-            case 'i':
-            case 'l':
-            case 'q':
-            case 'n': dt.code = (uint8_t) dlpack::dtype_code::Int; break;
+    switch (format) {
+        case 'c':
+        case 'b':
+        case 'h':
+        case 'i':
+        case 'l':
+        case 'q':
+        case 'n': dt.code = (uint8_t) dlpack::dtype_code::Int; break;
 
-            case 'B':
-            case 'H':
-            case 'I':
-            case 'L':
-            case 'Q':
-            case 'N': dt.code = (uint8_t) dlpack::dtype_code::UInt; break;
+        case 'B':
+        case 'H':
+        case 'I':
+        case 'L':
+        case 'Q':
+        case 'N': dt.code = (uint8_t) dlpack::dtype_code::UInt; break;
 
-            case 'e':
-            case 'f':
-            case 'd': dt.code = (uint8_t) dlpack::dtype_code::Float; break;
+        case 'e':
+        case 'f':
+        case 'd': dt.code = (uint8_t) dlpack::dtype_code::Float; break;
 
-            case '?': dt.code = (uint8_t) dlpack::dtype_code::Bool; break;
+        case '?': dt.code = (uint8_t) dlpack::dtype_code::Bool; break;
 
-            default:
-                fail = true;
-        }
+        default:
+            return false;
+    }
+
+    dt.lanes = 1;
+    dt.bits = (uint8_t) (view->itemsize * 8);
+    return true;
+}
+
+/// Tensor exported via the buffer protocol, allocated as a single block
+struct buffer_dltensor {
+    managed_dltensor mt;
+    Py_buffer view;
+    int64_t storage[2 * ndarray_handle_dims];
+};
+
+/// Destructor of unconsumed capsules created by the functions below
+static void dltensor_capsule_destructor(PyObject *o) {
+    error_scope scope; // temporarily save any existing errors
+    managed_dltensor *mt =
+        (managed_dltensor *) PyCapsule_GetPointer(o, "dltensor");
+    if (mt) {
+        if (mt->deleter)
+            mt->deleter(mt);
+    } else {
+        PyErr_Clear();
+    }
+}
+
+static PyObject *dlpack_from_buffer_protocol(PyObject *o, bool readonly) {
+    scoped_pymalloc<buffer_dltensor> bt;
+    Py_buffer *view = &bt->view;
+    managed_dltensor *mt = &bt->mt;
 
-        dt.lanes = 1;
-        dt.bits = (uint8_t) (view->itemsize * 8);
+    if (PyObject_GetBuffer(o, view, readonly ? PyBUF_RECORDS_RO : PyBUF_RECORDS)) {
+        PyErr_Clear();
+        return nullptr;
     }
 
-    if (fail) {
-        PyBuffer_Release(view.get());
+    dlpack::dtype dt;
+    if (!buffer_dtype(view, dt)) {
+        PyBuffer_Release(view);
         return nullptr;
     }
 
     mt->deleter = [](managed_dltensor *mt2) {
         gil_scoped_acquire guard;
-        Py_buffer *buf = (Py_buffer *) mt2->manager_ctx;
-        PyBuffer_Release(buf);
-        PyMem_Free(mt2->dltensor.shape);
-        PyMem_Free(mt2->dltensor.strides);
-        PyMem_Free(mt2);
+        buffer_dltensor *bt2 = (buffer_dltensor *) mt2;
+        PyBuffer_Release(&bt2->view);
+        if (mt2->dltensor.shape != bt2->storage)
+            PyMem_Free(mt2->dltensor.shape);
+        PyMem_Free(bt2);
     };
 
     /* DLPack mandates 256-byte alignment of the 'DLTensor::data' field, but
@@ -249,28 +453,584 @@ static PyObject *dlpack_from_buffer_protocol(PyObject *o) {
     mt->dltensor.dtype = dt;
     mt->dltensor.byte_offset = value_int - value_rounded;
 
-    scoped_pymalloc<int64_t> strides((size_t) view->ndim);
-    scoped_pymalloc<int64_t> shape((size_t) view->ndim);
-    for (size_t i = 0; i < (size_t) view->ndim; ++i) {
+    size_t ndim = (size_t) view->ndim;
+    int64_t *shape = bt->storage;
+    if (ndim > ndarray_handle_dims) {
+        shape = (int64_t *) PyMem_Malloc(2 * ndim * sizeof(int64_t));
+        if (!shape) {
+            PyBuffer_Release(view);
+            return nullptr;
+        }
+    }
+
+    int64_t *strides = shape + ndim;
+    for (size_t i = 0; i < ndim; ++i) {
         strides[i] = (int64_t) (view->strides[i] / view->itemsize);
         shape[i] = (int64_t) view->shape[i];
     }
 
-    mt->manager_ctx = view.release();
-    mt->dltensor.shape = shape.release();
-    mt->dltensor.strides = strides.release();
+    mt->manager_ctx = nullptr;
+    mt->dltensor.shape = shape;
+    mt->dltensor.strides = strides;
 
-    return PyCapsule_New(mt.release(), "dltensor", [](PyObject *o) {
-        error_scope scope; // temporarily save any existing errors
-        managed_dltensor *mt =
-            (managed_dltensor *) PyCapsule_GetPointer(o, "dltensor");
-        if (mt) {
-            if (mt->deleter)
-                mt->deleter(mt);
-        } else {
+    return PyCapsule_New(bt.release(), "dltensor", dltensor_capsule_destructor);
+}
+
+/// Tensor exported via __(cuda_)array_interface__, allocated as a single block
+/// that ends with the shape and strides of its 'ndim' dimensions
+struct interface_dltensor {
+    managed_dltensor mt;
+    PyObject *owner;
+};
+
+/// Parse an array interface 'typestr' such as '<f4', returns false if unsupported
+static bool interface_dtype(const char *typestr, dlpack::dtype &dt) {
+    int32_t num = 1;
+    bool little_endian = *(uint8_t *) &num == 1;
+
+    switch (typestr[0]) {
+        case '|': case '=': break;
+        case '<': if (!little_endian) return false; break;
+        case '>': if (little_endian) return false; break;
+        default: return false;
+    }
+
+    dt = { };
+    switch (typestr[1]) {
+        case 'b': dt.code = (uint8_t) dlpack::dtype_code::Bool; break;
+        case 'i': dt.code = (uint8_t) dlpack::dtype_code::Int; break;
+        case 'u': dt.code = (uint8_t) dlpack::dtype_code::UInt; break;
+        case 'f': dt.code = (uint8_t) dlpack::dtype_code::Float; break;
+        case 'c': dt.code = (uint8_t) dlpack::dtype_code::Complex; break;
+        default: return false;
+    }
+
+    char *end = nullptr;
+    long size = strtol(typestr + 2, &end, 10);
+    if (size <= 0 || size > 16 || *end != '\0')
+        return false;
+
+    dt.bits = (uint8_t) (size * 8);
+    dt.lanes = 1;
+    return true;
+}
+
+/**
+ * Create a DLPack tensor referencing the memory described by the
+ * ``__cuda_array_interface__`` (CUDA device memory) or ``__array_interface__``
+ * (host memory) of 'o', which is kept alive by the tensor. Only interfaces
+ * that specify a data pointer are handled here.
+ */
+static PyObject *dlpack_from_interface(PyObject *o, bool cuda,
+                                       bool readonly) noexcept {
+    try {
+        object iface = getattr(o, cuda ? "__cuda_array_interface__"
+                                       : "__array_interface__", handle());
+        if (!iface.is_valid() || !PyDict_Check(iface.ptr()))
+            return nullptr;
+        auto item = [&](const char *key) {
+            return handle(PyDict_GetItemString(iface.ptr(), key));
+        };
+
+        dlpack::dtype dt;
+        handle typestr = item("typestr"), data = item("data"),
+               shape_o = item("shape"), mask = item("mask"),
+               offset = item("offset"), strides_o = item("strides");
+
+        if (!typestr.is_valid() || !PyUnicode_Check(typestr.ptr()) ||
+            !interface_dtype(borrow<str>(typestr).c_str(), dt) ||
+            !data.is_valid() || !PyTuple_Check(data.ptr()) || len(data) != 2 ||
+            !shape_o.is_valid() || !PyTuple_Check(shape_o.ptr()) ||
+            (mask.is_valid() && !mask.is_none()))
+            return nullptr;
+
+        // 'data' is a (pointer, read-only flag) tuple
+        int data_readonly = PyObject_IsTrue(PyTuple_GetItem(data.ptr(), 1));
+        if (data_readonly < 0) {
+            PyErr_Clear();
+            return nullptr;
+        }
+
+        if (!readonly && data_readonly)
+            return nullptr;
+
+        uintptr_t ptr = cast<uintptr_t>(data[0]);
+        if (offset.is_valid())
+            ptr += cast<uintptr_t>(offset);
+
+        if (!strides_o.is_valid())
+            strides_o = none();
+
+        size_t ndim = len(shape_o), itemsize = dt.bits / 8;
+        if (!strides_o.is_none() &&
+            (!PyTuple_Check(strides_o.ptr()) || len(strides_o) != ndim))
+            return nullptr;
+
+        scoped_pymalloc<uint8_t> block(sizeof(interface_dltensor) +
+                                       2 * ndim * sizeof(int64_t));
+        interface_dltensor *it = (interface_dltensor *) block.get();
+        int64_t *shape = (int64_t *) (it + 1);
+
+        int64_t *strides = strides_o.is_none() ? nullptr : shape + ndim;
+        bool fail = false;
+        for (size_t i = 0; i < ndim; ++i) {
+            shape[i] = cast<int64_t>(shape_o[i]);
+            if (strides) {
+                int64_t stride = cast<int64_t>(strides_o[i]);
+                fail |= stride % (int64_t) itemsize != 0;
+                strides[i] = stride / (int64_t) itemsize;
+            }
+        }
+
+        if (fail)
+            return nullptr;
+
+        managed_dltensor *mt = &it->mt;
+        mt->dltensor.data = (void *) ptr;
+        mt->dltensor.device = { cuda ? device::cuda::value : device::cpu::value, 0 };
+        mt->dltensor.ndim = (int32_t) ndim;
+        mt->dltensor.dtype = dt;
+        mt->dltensor.byte_offset = 0;
+        mt->dltensor.shape = shape;
+        mt->dltensor.strides = strides;
+        mt->manager_ctx = nullptr;
+        mt->deleter = [](managed_dltensor *mt2) {
+            gil_scoped_acquire guard;
+            interface_dltensor *it2 = (interface_dltensor *) mt2;
+            Py_DECREF(it2->owner);
+            PyMem_Free(it2);
+        };
+
+        PyObject *capsule =
+            PyCapsule_New(it, "dltensor", dltensor_capsule_destructor);
+        if (capsule) {
+            it->owner = o;
+            Py_INCREF(o);
+            block.release();
+        }
+
+        return capsule;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/// Ways of obtaining a DLPack capsule from a Python object
+enum class ndarray_route : uintptr_t {
+    unknown = 0,
+    dlpack,        // o.__dlpack__(max_version=(1, 0))
+    dlpack_legacy, // o.__dlpack__()
+    framework,     // <framework>.to_dlpack(o)
+    buffer,        // buffer protocol
+    cuda_array_interface, // o.__cuda_array_interface__
+    array_interface,      // o.__array_interface__
+    none           // nothing works (only cached for immutable builtin types)
+};
+
+/* The address of a deallocated type may be reused by another one, hence cache
+   entries also store the version tag of the type, which is never reused and
+   changes when the type is modified. Zero means that the route of 'tp' can't
+   be cached. Without access to the tag, this is the case for heap types. */
+static uintptr_t ndarray_route_tag(PyTypeObject *tp) noexcept {
+#if defined(Py_LIMITED_API) || defined(PYPY_VERSION)
+    return (PyType_GetFlags(tp) & Py_TPFLAGS_HEAPTYPE) ? 0 : 1;
+#else
+#  if PY_VERSION_HEX < 0x030B0000
+    if (!PyType_HasFeature(tp, Py_TPFLAGS_VALID_VERSION_TAG))
+        return 0;
+#  endif
+    return tp->tp_version_tag;
+#endif
+}
+
+static ndarray_route ndarray_route_get(nb_internals &internals,
+                                       PyTypeObject *tp) noexcept {
+    uintptr_t tag = ndarray_route_tag(tp);
+    if (!tag)
+        return ndarray_route::unknown;
+
+    lock_internals guard(internals);
+    auto it = internals.ndarray_routes.find((void *) tp);
+    if (it == internals.ndarray_routes.end())
+        return ndarray_route::unknown;
+
+    uintptr_t value = (uintptr_t) it->second;
+    return (value >> 4) == (tag & (UINTPTR_MAX >> 4))
+               ? (ndarray_route) (value & 0xF)
+               : ndarray_route::unknown;
+}
+
+static void ndarray_route_set(nb_internals &internals, PyTypeObject *tp,
+                              ndarray_route route) noexcept {
+    uintptr_t tag = ndarray_route_tag(tp);
+    if (!tag)
+        return;
+
+    lock_internals guard(internals);
+    internals.ndarray_routes[(void *) tp] =
+        (void *) ((tag << 4) | (uintptr_t) route);
+}
+
+/// Stream on which the current thread consumes arrays (see nb::ndarray_stream)
+static thread_local intptr_t ndarray_stream_value = ndarray_no_stream;
+
+intptr_t ndarray_stream_swap(intptr_t stream) noexcept {
+    intptr_t prev = ndarray_stream_value;
+    ndarray_stream_value = stream;
+    return prev;
+}
+
+/// Should the consumer stream be passed to o.__dlpack__()? (not for host memory)
+static bool dlpack_use_stream(PyObject *o) noexcept {
+    if (NB_LIKELY(ndarray_stream_value == ndarray_no_stream))
+        return false;
+
+    long device_type = -1;
+    PyObject *device = PyObject_CallMethod(o, "__dlpack_device__", nullptr);
+    if (device && PyTuple_Check(device) && PyTuple_Size(device) == 2)
+        device_type = PyLong_AsLong(PyTuple_GetItem(device, 0));
+    Py_XDECREF(device);
+    PyErr_Clear();
+
+    return device_type != -1 && device_type != device::cpu::value &&
+           device_type != device::cuda_host::value &&
+           device_type != device::rocm_host::value;
+}
+
+static PyObject *dlpack_from_method(PyObject *o, bool versioned) noexcept {
+    bool use_stream = dlpack_use_stream(o);
+
+    if (!versioned && !use_stream) {
+        PyObject *result = PyObject_CallMethod(o, "__dlpack__", nullptr);
+        if (!result)
             PyErr_Clear();
+        return result;
+    }
+
+    try {
+        object method = handle(o).attr("__dlpack__"), result;
+        if (versioned && use_stream)
+            result = method(arg("max_version") = make_tuple(1, 0),
+                            arg("stream") = ndarray_stream_value);
+        else if (versioned)
+            result = method(arg("max_version") = make_tuple(1, 0));
+        else
+            result = method(arg("stream") = ndarray_stream_value);
+        return result.release().ptr();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/// Return the DLPack module of the framework that defines 'tp' (if any)
+static const char *dlpack_framework(PyTypeObject *tp) noexcept {
+    try {
+        const char *module_name =
+            borrow<str>(handle(tp).attr("__module__")).c_str();
+
+        if (strncmp(module_name, "tensorflow.", 11) == 0)
+            return "tensorflow.experimental.dlpack";
+        else if (strcmp(module_name, "torch") == 0)
+            return "torch.utils.dlpack";
+        else if (strncmp(module_name, "jaxlib", 6) == 0)
+            return "jax.dlpack";
+    } catch (...) { }
+
+    return nullptr;
+}
+
+static PyObject *dlpack_from_framework(PyObject *o) noexcept {
+    const char *package_name = dlpack_framework(Py_TYPE(o));
+    if (!package_name)
+        return nullptr;
+
+    try {
+        return module_::import_(package_name)
+            .attr("to_dlpack")(handle(o))
+            .release()
+            .ptr();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/**
+ * Can 'route' be used for all instances of the type of 'o' without changing
+ * the outcome? This is the case when the routes that are tried first are
+ * unavailable for the type. Failures are only cached for immutable types.
+ */
+static bool dlpack_route_cacheable(PyObject *o, ndarray_route route) noexcept {
+    PyTypeObject *tp = Py_TYPE(o);
+
+    if (route == ndarray_route::dlpack ||
+        route == ndarray_route::dlpack_legacy)
+        return true;
+
+    if (PyObject_HasAttrString((PyObject *) tp, "__dlpack__"))
+        return false;
+
+    if (route == ndarray_route::framework)
+        return true;
+
+    if (dlpack_framework(tp))
+        return false;
+
+    if (route == ndarray_route::buffer)
+        return true;
+
+    if (PyObject_CheckBuffer(o))
+        return false;
+
+    if (route == ndarray_route::cuda_array_interface)
+        return true;
+
+    if (PyObject_HasAttrString((PyObject *) tp, "__cuda_array_interface__"))
+        return false;
+
+    if (route == ndarray_route::array_interface)
+        return true;
+
+    return !(PyType_GetFlags(tp) & Py_TPFLAGS_HEAPTYPE) &&
+           !PyObject_HasAttrString((PyObject *) tp, "__array_interface__");
+}
+
+static PyObject *dlpack_from_route(PyObject *o, ndarray_route route,
+                                   bool readonly) noexcept {
+    switch (route) {
+        case ndarray_route::dlpack: return dlpack_from_method(o, true);
+        case ndarray_route::dlpack_legacy: return dlpack_from_method(o, false);
+        case ndarray_route::framework: return dlpack_from_framework(o);
+        case ndarray_route::buffer: return dlpack_from_buffer_protocol(o, readonly);
+        case ndarray_route::cuda_array_interface: return dlpack_from_interface(o, true, readonly);
+        case ndarray_route::array_interface: return dlpack_from_interface(o, false, readonly);
+        default: return nullptr;
+    }
+}
+
+// ========================================================================
+
+/// Convert a single value. Floats are saturated when converted to integers
+template <typename Dst, typename Src> NB_INLINE Dst convert_value(Src v) {
+    if constexpr (is_half_v<Src>) {
+        return convert_value<Dst>((float) v);
+    } else if constexpr (is_half_v<Dst>) {
+        return Dst((float) v);
+    } else if constexpr (std::is_same_v<Dst, bool>) {
+        return v != 0;
+    } else if constexpr (std::is_floating_point_v<Src> &&
+                         !std::is_floating_point_v<Dst>) {
+        using UDst = std::make_unsigned_t<Dst>;
+        constexpr UDst top = UDst(1) << (sizeof(Dst) * 8 - 1);
+        const Src lo = (Src) std::numeric_limits<Dst>::min(),
+                  hi = std::is_signed_v<Dst> ? (Src) top : (Src) top * 2;
+        if (!(v >= lo)) // also catches NaN
+            return std::numeric_limits<Dst>::min();
+        if (v >= hi)
+            return std::numeric_limits<Dst>::max();
+        return (Dst) v;
+    } else {
+        return (Dst) v;
+    }
+}
+
+/// Convert 'size' values with a given source stride into a contiguous array
+using convert_fn = void (*)(void *dst, const void *src, size_t size,
+                            int64_t stride);
+
+template <typename Dst, typename Src>
+static void convert_run(void *dst_, const void *src_, size_t size,
+                        int64_t stride) {
+    Dst *dst = (Dst *) dst_;
+    const Src *src = (const Src *) src_;
+
+    if constexpr (std::is_same_v<Dst, Src>) {
+        if (stride == 1) {
+            memcpy(dst, src, size * sizeof(Dst));
+            return;
+        }
+    }
+
+    // Keep the unit-stride loop separate so that it can be vectorized
+    if (stride == 1) {
+        for (size_t i = 0; i < size; ++i)
+            dst[i] = convert_value<Dst>(src[i]);
+    } else {
+        for (size_t i = 0; i < size; ++i)
+            dst[i] = convert_value<Dst>(src[(int64_t) i * stride]);
+    }
+}
+
+/// Map a DLPack dtype onto an index into the type list used by convert_lookup
+static int convert_type_index(dlpack::dtype dt) noexcept {
+    if (dt.lanes != 1)
+        return -1;
+
+    int bits_index;
+    switch (dt.bits) {
+        case 8: bits_index = 0; break;
+        case 16: bits_index = 1; break;
+        case 32: bits_index = 2; break;
+        case 64: bits_index = 3; break;
+        default: return -1;
+    }
+
+    switch ((dlpack::dtype_code) dt.code) {
+        case dlpack::dtype_code::Bool: return dt.bits == 8 ? 0 : -1;
+        case dlpack::dtype_code::Int: return 1 + bits_index;
+        case dlpack::dtype_code::UInt: return 5 + bits_index;
+        case dlpack::dtype_code::Float: return bits_index >= 1 ? 8 + bits_index : -1;
+        case dlpack::dtype_code::Bfloat: return dt.bits == 16 ? 12 : -1;
+        default: return -1;
+    }
+}
+
+template <typename Dst, typename... Src>
+static constexpr convert_fn convert_row[] = { convert_run<Dst, Src>... };
+
+template <typename... Ts>
+static constexpr const convert_fn *convert_table[] = { convert_row<Ts, Ts...>... };
+
+static convert_fn convert_lookup(dlpack::dtype dst, dlpack::dtype src) noexcept {
+    int di = convert_type_index(dst), si = convert_type_index(src);
+    if (di < 0 || si < 0)
+        return nullptr;
+
+    return convert_table<bool, int8_t, int16_t, int32_t, int64_t, uint8_t,
+                         uint16_t, uint32_t, uint64_t, float16, float,
+                         double, bfloat16>[di][si];
+}
+
+/**
+ * Copy the contents of the host memory tensor 't' into a freshly allocated
+ * buffer with the requested dtype and memory order. Returns nullptr if the
+ * conversion isn't supported. The caller must hold the GIL.
+ */
+static ndarray_handle *ndarray_convert(const dlpack::dltensor &t,
+                                       const ndarray_req *req) noexcept {
+    dlpack::dtype dtype = req->req_dtype ? req->dtype : t.dtype;
+    convert_fn fn = convert_lookup(dtype, t.dtype);
+
+    if (t.device.device_type != device::cpu::value || !fn ||
+        (req->req_order && req->req_order != 'C' && req->req_order != 'F'))
+        return nullptr;
+
+    size_t ndim = (size_t) t.ndim, size = 1,
+           dsize = dtype.bits / 8, ssize = t.dtype.bits / 8;
+
+    scoped_pymalloc<int64_t> src_strides(ndim), dst_strides(ndim),
+        index(ndim);
+    scoped_pymalloc<size_t> shape(ndim);
+
+    for (size_t i = ndim; i-- > 0; ) {
+        shape[i] = (size_t) t.shape[i];
+        src_strides[i] = t.strides ? t.strides[i] : (int64_t) size;
+        index[i] = 0;
+        size *= shape[i];
+    }
+
+    // Keep Fortran-ordered inputs in that order when no order was requested
+    bool f_order = req->req_order == 'F';
+    if (!req->req_order && ndim > 1 && t.strides) {
+        int64_t accum = 1;
+        f_order = true;
+        for (size_t i = 0; i < ndim && f_order; ++i) {
+            f_order = shape[i] == 1 || t.strides[i] == accum;
+            accum *= (int64_t) shape[i];
         }
-    });
+    }
+
+    int64_t accum = 1;
+    for (size_t j = 0; j < ndim; ++j) {
+        size_t i = f_order ? j : ndim - 1 - j;
+        dst_strides[i] = accum;
+        accum *= (int64_t) shape[i];
+    }
+
+    uint8_t *dst = (uint8_t *) PyMem_Malloc(size ? size * dsize : 1);
+    if (!dst)
+        return nullptr;
+
+    const uint8_t *src =
+        (const uint8_t *) t.data + t.byte_offset;
+
+    if (size != 0 && ndim == 0) {
+        fn(dst, src, 1, 1);
+    } else if (size != 0) {
+        // Innermost non-trivial dimension of the output and of the input
+        size_t inner = f_order ? 0 : ndim - 1;
+        for (size_t j = 0; j < ndim; ++j) {
+            size_t i = f_order ? j : ndim - 1 - j;
+            if (shape[i] > 1) {
+                inner = i;
+                break;
+            }
+        }
+
+        size_t src_inner = inner;
+        for (size_t i = 0; i < ndim; ++i) {
+            if (shape[i] > 1 && (shape[src_inner] == 1 ||
+                                 std::abs(src_strides[i]) <
+                                     std::abs(src_strides[src_inner])))
+                src_inner = i;
+        }
+
+        /* When the innermost dimensions differ (e.g. C <-> F order), process
+           strips of 'block' elements so that the cache lines touched in the
+           input are reused for consecutive rows of the output */
+        constexpr size_t block = 32;
+        bool tiled = src_inner != inner;
+        size_t n_inner = shape[inner], n_tile = tiled ? block : n_inner,
+               n_outer = tiled ? shape[src_inner] : 1;
+        int64_t src_stride = src_strides[inner];
+
+        while (true) {
+            int64_t src_offset = 0, dst_offset = 0;
+            for (size_t i = 0; i < ndim; ++i) {
+                src_offset += index[i] * src_strides[i];
+                dst_offset += index[i] * dst_strides[i];
+            }
+
+            for (size_t i0 = 0; i0 < n_inner; i0 += n_tile) {
+                size_t n = std::min(n_tile, n_inner - i0);
+                for (size_t j = 0; j < n_outer; ++j) {
+                    int64_t s = src_offset + (int64_t) i0 * src_stride,
+                            d = dst_offset + (int64_t) i0;
+                    if (tiled) {
+                        s += (int64_t) j * src_strides[src_inner];
+                        d += (int64_t) j * dst_strides[src_inner];
+                    }
+                    fn(dst + d * (int64_t) dsize, src + s * (int64_t) ssize,
+                       n, src_stride);
+                }
+            }
+
+            // Advance the index of the remaining dimensions
+            size_t i = 0;
+            for (; i < ndim; ++i) {
+                size_t k = ndim - 1 - i;
+                if (k == inner || (tiled && k == src_inner))
+                    continue;
+                if ((size_t) ++index[k] < shape[k])
+                    break;
+                index[k] = 0;
+            }
+            if (i == ndim)
+                break;
+        }
+    }
+
+    ndarray_handle *result;
+    try {
+        result = ndarray_create(dst, ndim, shape.get(), nullptr,
+                                dst_strides.get(), &dtype,
+                                device::cpu::value, 0);
+    } catch (...) {
+        PyMem_Free(dst);
+        return nullptr;
+    }
+
+    result->free_data = true;
+    return result;
 }
 
 ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
@@ -278,36 +1038,41 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     object capsule;
     bool is_pycapsule = PyCapsule_CheckExact(o);
 
-    // If this is not a capsule, try calling o.__dlpack__()
     if (!is_pycapsule) {
-        capsule = steal(PyObject_CallMethod(o, "__dlpack__", nullptr));
+        /* Probing the various protocols involves failed attribute lookups and
+           exceptions. Remember the route that worked for each type and try
+           it first. The other routes are still tried if it fails. */
+        nb_internals &internals = internals_get();
+        PyTypeObject *tp = Py_TYPE(o);
+        ndarray_route cached = ndarray_route_get(internals, tp);
+
+        if (cached == ndarray_route::none)
+            return nullptr;
+
+        capsule = steal(dlpack_from_route(o, cached, req->readonly));
 
         if (!capsule.is_valid()) {
-            PyErr_Clear();
-            PyTypeObject *tp = Py_TYPE(o);
-
-            try {
-                const char *module_name =
-                    borrow<str>(handle(tp).attr("__module__")).c_str();
-
-                object package;
-                if (strncmp(module_name, "tensorflow.", 11) == 0)
-                    package = module_::import_("tensorflow.experimental.dlpack");
-                else if (strcmp(module_name, "torch") == 0)
-                    package = module_::import_("torch.utils.dlpack");
-                else if (strncmp(module_name, "jaxlib", 6) == 0)
-                    package = module_::import_("jax.dlpack");
-
-                if (package.is_valid())
-                    capsule = package.attr("to_dlpack")(handle(o));
-            } catch (...) {
-                capsule.reset();
+            ndarray_route routes[] = { ndarray_route::dlpack,
+                                       ndarray_route::dlpack_legacy,
+                                       ndarray_route::framework,
+                                       ndarray_route::buffer,
+                                       ndarray_route::cuda_array_interface,
+                                       ndarray_route::array_interface },
+                          route = ndarray_route::none;
+
+            for (ndarray_route r : routes) {
+                if (r == cached)
+                    continue;
+                capsule = steal(dlpack_from_route(o, r, req->readonly));
+                if (capsule.is_valid()) {
+                    route = r;
+                    break;
+                }
             }
-        }
 
-        // Try creating a ndarray via the buffer protocol
-        if (!capsule.is_valid())
-            capsule = steal(dlpack_from_buffer_protocol(o));
+            if (route != cached && dlpack_route_cacheable(o, route))
+                ndarray_route_set(internals, tp, route);
+        }
 
         if (!capsule.is_valid())
             return nullptr;
@@ -316,14 +1081,30 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     }
 
     // Extract the pointer underlying the capsule
-    void *ptr = PyCapsule_GetPointer(capsule.ptr(), "dltensor");
+    bool versioned = PyCapsule_IsValid(capsule.ptr(), "dltensor_versioned");
+    void *ptr = PyCapsule_GetPointer(capsule.ptr(), versioned
+                                     ? "dltensor_versioned" : "dltensor");
     if (!ptr) {
         PyErr_Clear();
         return nullptr;
     }
 
     // Check if the ndarray satisfies the requirements
-    dlpack::dltensor &t = ((managed_dltensor *) ptr)->dltensor;
+    managed_dltensor_versioned *mtv = nullptr;
+    dlpack::dltensor *tp_;
+    bool pass_ro = true;
+
+    if (versioned) {
+        mtv = (managed_dltensor_versioned *) ptr;
+        if (mtv->version.major != 1)
+            return nullptr;
+        tp_ = &mtv->dltensor;
+        pass_ro = req->readonly || !(mtv->flags & dlpack_flag_read_only);
+    } else {
+        tp_ = &((managed_dltensor *) ptr)->dltensor;
+    }
+
+    dlpack::dltensor &t = *tp_;
 
     bool pass_dtype = true, pass_device = true,
          pass_shape = true, pass_order = true;
@@ -352,7 +1133,12 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     for (uint32_t i = 0; i < req->ndim; ++i)
         size *= t.shape[i];
 
-    scoped_pymalloc<int64_t> strides((size_t) t.ndim);
+    // The handle also provides the storage for missing strides
+    struct handle_guard {
+        ndarray_handle *th;
+        ~handle_guard() { if (th) ndarray_handle_free(th); }
+    } guard { ndarray_handle_alloc((size_t) t.ndim) };
+    int64_t *strides = ndarray_handle_storage(guard.th) + guard.th->capacity;
     if ((req->req_order || !t.strides) && t.ndim > 0) {
         size_t accum = 1;
 
@@ -390,8 +1176,13 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     }
 
     // Support implicit conversion of 'dtype' and order
-    if (pass_device && pass_shape && (!pass_dtype || !pass_order) && convert &&
-        capsule.ptr() != o) {
+    if (pass_device && pass_shape && pass_ro && (!pass_dtype || !pass_order) &&
+        convert && capsule.ptr() != o) {
+        // Convert host memory arrays directly without a roundtrip via Python
+        ndarray_handle *result = ndarray_convert(t, req);
+        if (result)
+            return result;
+
         PyTypeObject *tp = Py_TYPE(o);
         str module_name_o = borrow<str>(handle(tp).attr("__module__"));
         const char *module_name = module_name_o.c_str();
@@ -404,7 +1195,7 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
             return nullptr;
 
         const char *prefix = nullptr;
-        char dtype[9];
+        char dtype[17]; // longest prefix ('bfloat') and 10 digits
         if (req->dtype.code == (uint8_t) dlpack::dtype_code::Bool) {
             std::strcpy(dtype, "bool");
         } else {
@@ -412,6 +1203,7 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
                 case (uint8_t) dlpack::dtype_code::Int: prefix = "int"; break;
                 case (uint8_t) dlpack::dtype_code::UInt: prefix = "uint"; break;
                 case (uint8_t) dlpack::dtype_code::Float: prefix = "float"; break;
+                case (uint8_t) dlpack::dtype_code::Bfloat: prefix = "bfloat"; break;
                 default:
                     return nullptr;
             }
@@ -442,16 +1234,36 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
             return ndarray_import(converted.ptr(), req, false);
     }
 
-    if (!pass_dtype || !pass_device || !pass_shape || !pass_order)
+    if (!pass_dtype || !pass_device || !pass_shape || !pass_order || !pass_ro)
         return nullptr;
 
     // Create a reference-counted wrapper
-    scoped_pymalloc<ndarray_handle> result;
-    result->ndarray = (managed_dltensor *) ptr;
+    ndarray_handle *result = guard.th;
+    guard.th = nullptr;
+
+    if (versioned) {
+        // Expose the tensor through the legacy interface used elsewhere
+        result->tensor.dltensor = t;
+        result->tensor.manager_ctx = mtv;
+        result->tensor.deleter = [](managed_dltensor *mt) {
+            managed_dltensor_versioned *mtv2 =
+                (managed_dltensor_versioned *) mt->manager_ctx;
+            if (mtv2->deleter)
+                mtv2->deleter(mtv2);
+        };
+        result->ndarray = &result->tensor;
+    } else {
+        result->ndarray = (managed_dltensor *) ptr;
+    }
+
     result->refcount = 0;
     result->owner = nullptr;
-    result->free_shape = false;
+    result->free_data = false;
     result->call_deleter = true;
+    result->readonly = mtv && (mtv->flags & dlpack_flag_read_only);
+    result->pool_data = false;
+    result->mapping = nullptr;
+    result->shm_name = nullptr;
     if (is_pycapsule) {
         result->self = nullptr;
     } else {
@@ -460,20 +1272,22 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     }
 
     // Ensure that the strides member is always initialized
-    if (t.strides) {
-        result->free_strides = false;
+    dlpack::dltensor &rt = result->ndarray->dltensor;
+    if (rt.strides) {
+        result->inline_strides = false;
     } else {
-        result->free_strides = true;
-        t.strides = strides.release();
+        result->inline_strides = true;
+        rt.strides = strides;
     }
 
     // Mark the dltensor capsule as "consumed"
-    if (PyCapsule_SetName(capsule.ptr(), "used_dltensor") ||
+    if (PyCapsule_SetName(capsule.ptr(), versioned ? "used_dltensor_versioned"
+                                                   : "used_dltensor") ||
         PyCapsule_SetDestructor(capsule.ptr(), nullptr))
         check(false, "nanobind::detail::ndarray_import(): could not mark "
                      "dltensor capsule as consumed!");
 
-    return result.release();
+    return result;
 }
 
 dlpack::dltensor *ndarray_inc_ref(ndarray_handle *th) noexcept {
@@ -483,6 +1297,123 @@ dlpack::dltensor *ndarray_inc_ref(ndarray_handle *th) noexcept {
     return &th->ndarray->dltensor;
 }
 
+/// Alignment of the buffers returned by ndarray_alloc()
+static constexpr size_t ndarray_pool_align = 64;
+
+/// Size class 'i' holds buffers of 2^(i + 6) bytes, larger ones aren't pooled
+static constexpr uint32_t ndarray_pool_shift = 6;
+
+static void *ndarray_pool_malloc(size_t size) noexcept {
+    void *ptr = PyMem_Malloc(size + ndarray_pool_align);
+    if (!ptr)
+        return nullptr;
+
+    // Store the original pointer right before the aligned block
+    uintptr_t aligned = ((uintptr_t) ptr + ndarray_pool_align) &
+                        ~(uintptr_t) (ndarray_pool_align - 1);
+    ((void **) aligned)[-1] = ptr;
+    return (void *) aligned;
+}
+
+static void ndarray_pool_release(void *ptr) noexcept {
+    PyMem_Free(((void **) ptr)[-1]);
+}
+
+static void ndarray_pool_free(void *ptr, uint32_t cls) noexcept {
+    nb_internals &internals = internals_get();
+
+    if (cls < NB_NDARRAY_POOL_CLASSES &&
+        internals.ndarray_pool_size[cls] < internals.ndarray_pool_capacity) {
+        // Recycled buffers are attributed to the frame that reuses them
+        trace_free(((void **) ptr)[-1]);
+        *(void **) ptr = internals.ndarray_pool[cls];
+        internals.ndarray_pool[cls] = ptr;
+        internals.ndarray_pool_size[cls]++;
+        return;
+    }
+
+    ndarray_pool_release(ptr);
+}
+
+/// Release the buffers of the ndarray_alloc() pool and stop recycling them
+void ndarray_pool_clear() noexcept {
+    nb_internals &internals = internals_get();
+
+    for (uint32_t i = 0; i < NB_NDARRAY_POOL_CLASSES; ++i) {
+        void *ptr = internals.ndarray_pool[i];
+        while (ptr) {
+            void *next = *(void **) ptr;
+            ndarray_pool_release(ptr);
+            ptr = next;
+        }
+        internals.ndarray_pool[i] = nullptr;
+        internals.ndarray_pool_size[i] = 0;
+    }
+
+    internals.ndarray_pool_capacity = 0;
+}
+
+/// Release a mapping created by ndarray_mmap()
+static void ndarray_unmap(void *base, size_t size) noexcept {
+#if defined(_WIN32)
+    (void) size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
+
+/// Release the resources of a handle whose reference count reached zero
+static void ndarray_release(ndarray_handle *th) noexcept {
+    Py_XDECREF(th->owner);
+    Py_XDECREF(th->self);
+    managed_dltensor *mt = th->ndarray;
+    if (th->inline_strides)
+        mt->dltensor.strides = nullptr;
+    if (th->free_data) {
+        PyMem_Free(mt->dltensor.data);
+        mt->dltensor.data = nullptr;
+    }
+    if (th->pool_data) {
+        ndarray_pool_free(mt->dltensor.data, th->pool_class);
+        mt->dltensor.data = nullptr;
+    }
+    if (th->call_deleter && mt->deleter)
+        mt->deleter(mt);
+    if (th->mapping) {
+        trace_free(th->mapping);
+        ndarray_unmap(th->mapping, th->mapping_size);
+    }
+    if (th->shm_name) {
+#if !defined(_WIN32)
+        if (th->shm_owner)
+            shm_unlink(th->shm_name);
+#endif
+        PyMem_Free(th->shm_name);
+    }
+    ndarray_handle_free(th);
+}
+
+#if !defined(Py_LIMITED_API)
+static void ndarray_release_pending(void *th) noexcept {
+    ndarray_release((ndarray_handle *) th);
+}
+
+/// Queue a handle for release once the interpreter holds the GIL again
+static void ndarray_release_deferred(ndarray_handle *th) noexcept {
+    nb_internals *internals = decref_pending_internals();
+    if (!internals) {
+        gil_scoped_acquire guard;
+        ndarray_release(th);
+        return;
+    }
+
+    th->pending.o = th;
+    th->pending.release = ndarray_release_pending;
+    decref_pending_push(*internals, &th->pending);
+}
+#endif
+
 void ndarray_dec_ref(ndarray_handle *th) noexcept {
     if (!th)
         return;
@@ -491,24 +1422,16 @@ void ndarray_dec_ref(ndarray_handle *th) noexcept {
     if (rc_value == 0) {
         check(false, "ndarray_dec_ref(): reference count became negative!");
     } else if (rc_value == 1) {
-        Py_XDECREF(th->owner);
-        Py_XDECREF(th->self);
-        managed_dltensor *mt = th->ndarray;
-        if (th->free_shape) {
-            PyMem_Free(mt->dltensor.shape);
-            mt->dltensor.shape = nullptr;
-        }
-        if (th->free_strides) {
-            PyMem_Free(mt->dltensor.strides);
-            mt->dltensor.strides = nullptr;
-        }
-        if (th->call_deleter) {
-            if (mt->deleter)
-                mt->deleter(mt);
-        } else {
-            PyMem_Free(mt);
-        }
-        PyMem_Free(th);
+#if !defined(Py_LIMITED_API)
+        if (NB_LIKELY(PyGILState_Check()))
+            ndarray_release(th);
+        else
+            ndarray_release_deferred(th);
+#else
+        // Stable ABI builds can't tell whether the GIL is held
+        gil_scoped_acquire guard;
+        ndarray_release(th);
+#endif
     }
 }
 
@@ -526,9 +1449,10 @@ ndarray_handle *ndarray_create(void *value, size_t ndim, const size_t *shape_in,
               value_rounded = value_int;
 #endif
 
-    scoped_pymalloc<managed_dltensor> ndarray;
-    scoped_pymalloc<ndarray_handle> result;
-    scoped_pymalloc<int64_t> shape(ndim), strides(ndim);
+    ndarray_handle *result = ndarray_handle_alloc(ndim);
+    managed_dltensor *ndarray = &result->tensor;
+    int64_t *shape = ndarray_handle_storage(result),
+            *strides = shape + result->capacity;
 
     auto deleter = [](managed_dltensor *mt) {
         gil_scoped_acquire guard;
@@ -559,19 +1483,381 @@ ndarray_handle *ndarray_create(void *value, size_t ndim, const size_t *shape_in,
     ndarray->dltensor.ndim = (int32_t) ndim;
     ndarray->dltensor.dtype = *dtype;
     ndarray->dltensor.byte_offset = value_int - value_rounded;
-    ndarray->dltensor.shape = shape.release();
-    ndarray->dltensor.strides = strides.release();
-    ndarray->manager_ctx = result.get();
+    ndarray->dltensor.shape = shape;
+    ndarray->dltensor.strides = strides;
+    ndarray->manager_ctx = result;
     ndarray->deleter = deleter;
-    result->ndarray = (managed_dltensor *) ndarray.release();
+    result->ndarray = ndarray;
     result->refcount = 0;
     result->owner = owner;
     result->self = nullptr;
-    result->free_shape = true;
-    result->free_strides = true;
+    result->inline_strides = false;
+    result->free_data = false;
     result->call_deleter = false;
+    result->readonly = false;
+    result->pool_data = false;
+    result->mapping = nullptr;
+    result->shm_name = nullptr;
     Py_XINCREF(owner);
-    return result.release();
+    return result;
+}
+
+ndarray_handle *ndarray_alloc(size_t ndim, const size_t *shape,
+                              dlpack::dtype *dtype) {
+    size_t size = ((size_t) dtype->bits * dtype->lanes + 7) / 8;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (shape[i] && size > PY_SSIZE_T_MAX / shape[i])
+            raise("nanobind::ndarray_alloc(): array size overflow!");
+        size *= shape[i];
+    }
+
+    uint32_t cls = 0;
+    while (cls < NB_NDARRAY_POOL_CLASSES &&
+           ((size_t) 1 << (cls + ndarray_pool_shift)) < size)
+        cls++;
+
+    nb_internals &internals = internals_get();
+    void *data = nullptr;
+
+    if (cls < NB_NDARRAY_POOL_CLASSES) {
+        data = internals.ndarray_pool[cls];
+        if (data) {
+            internals.ndarray_pool[cls] = *(void **) data;
+            internals.ndarray_pool_size[cls]--;
+            trace_alloc(((void **) data)[-1],
+                        ((size_t) 1 << (cls + ndarray_pool_shift)) +
+                            ndarray_pool_align);
+        } else {
+            data = ndarray_pool_malloc((size_t) 1 << (cls + ndarray_pool_shift));
+        }
+    } else {
+        data = ndarray_pool_malloc(size);
+    }
+
+    if (!data) {
+        PyErr_NoMemory();
+        raise_python_error();
+    }
+
+    ndarray_handle *result = ndarray_create(data, ndim, shape, nullptr, nullptr,
+                                            dtype, device::cpu::value, 0);
+    result->pool_data = true;
+    result->pool_class = (uint8_t) cls;
+    return result;
+}
+
+ndarray_handle *ndarray_mmap(const char *path, uint64_t offset, size_t ndim,
+                             const size_t *shape, dlpack::dtype *dtype,
+                             int mode, int advice) {
+    bool cow = (mmap_mode) mode == mmap_mode::copy_on_write;
+
+    uint64_t size = ((uint64_t) dtype->bits * dtype->lanes + 7) / 8;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (shape[i] && size > (uint64_t) PY_SSIZE_T_MAX / shape[i])
+            raise("nanobind::ndarray_mmap(): array size overflow!");
+        size *= (uint64_t) shape[i];
+    }
+
+    // Mappings must start at a multiple of the page size / granularity
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    uint64_t granularity = info.dwAllocationGranularity;
+#else
+    uint64_t granularity = (uint64_t) sysconf(_SC_PAGESIZE);
+#endif
+    uint64_t start = offset - offset % granularity, file_size;
+
+    if (size > (uint64_t) PY_SSIZE_T_MAX - (offset - start))
+        raise("nanobind::ndarray_mmap(): the mapping of \"%s\" exceeds the "
+              "address space!", path);
+
+    uint64_t map_size = offset - start + size;
+
+    void *base = nullptr;
+
+#if defined(_WIN32)
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+    scoped_pymalloc<wchar_t> wpath((size_t) (wlen > 0 ? wlen : 1));
+    if (wlen <= 0 ||
+        !MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath.get(), wlen))
+        raise("nanobind::ndarray_mmap(): invalid path \"%s\"!", path);
+
+    HANDLE file = CreateFileW(wpath.get(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER file_size_li;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &file_size_li)) {
+        PyErr_SetFromWindowsErrWithFilename(0, path);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        raise_python_error();
+    }
+    file_size = (uint64_t) file_size_li.QuadPart;
+
+    if (offset > file_size || size > file_size - offset) {
+        CloseHandle(file);
+        raise("nanobind::ndarray_mmap(): \"%s\" contains %llu bytes, which "
+              "is too small for an array of %llu bytes at offset %llu!", path,
+              (unsigned long long) file_size, (unsigned long long) size,
+              (unsigned long long) offset);
+    }
+
+    if (map_size) {
+        HANDLE mapping =
+            CreateFileMappingW(file, nullptr, cow ? PAGE_WRITECOPY : PAGE_READONLY,
+                               0, 0, nullptr);
+        if (mapping) {
+            base = MapViewOfFile(mapping, cow ? FILE_MAP_COPY : FILE_MAP_READ,
+                                 (DWORD) (start >> 32), (DWORD) start,
+                                 (SIZE_T) map_size);
+            CloseHandle(mapping);
+        }
+        if (!base) {
+            PyErr_SetFromWindowsErrWithFilename(0, path);
+            CloseHandle(file);
+            raise_python_error();
+        }
+    }
+    CloseHandle(file);
+    (void) advice; // Access pattern hints are not supported on Windows
+#else
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+        if (fd >= 0)
+            close(fd);
+        raise_python_error();
+    }
+    file_size = (uint64_t) st.st_size;
+
+    if (offset > file_size || size > file_size - offset) {
+        close(fd);
+        raise("nanobind::ndarray_mmap(): \"%s\" contains %llu bytes, which "
+              "is too small for an array of %llu bytes at offset %llu!", path,
+              (unsigned long long) file_size, (unsigned long long) size,
+              (unsigned long long) offset);
+    }
+
+    if (map_size) {
+        base = mmap(nullptr, (size_t) map_size,
+                    cow ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                    cow ? MAP_PRIVATE : MAP_SHARED, fd, (off_t) start);
+        if (base == MAP_FAILED) {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+            close(fd);
+            raise_python_error();
+        }
+
+        int hint = POSIX_MADV_NORMAL;
+        switch ((mmap_advice) advice) {
+            case mmap_advice::normal: break;
+            case mmap_advice::sequential: hint = POSIX_MADV_SEQUENTIAL; break;
+            case mmap_advice::random: hint = POSIX_MADV_RANDOM; break;
+            case mmap_advice::will_need: hint = POSIX_MADV_WILLNEED; break;
+        }
+        if (hint != POSIX_MADV_NORMAL)
+            (void) posix_madvise(base, (size_t) map_size, hint);
+    }
+    close(fd);
+#endif
+
+    ndarray_handle *result =
+        ndarray_create((uint8_t *) base + (offset - start), ndim, shape,
+                       nullptr, nullptr, dtype, device::cpu::value, 0);
+    result->readonly = !cow;
+    result->mapping = base;
+    result->mapping_size = (size_t) map_size;
+    return result;
+}
+
+/// Create ('create' == true) or open the shared memory segment 'name' and map it
+static ndarray_handle *ndarray_shm_map(const char *func, const char *name,
+                                       bool create, size_t ndim,
+                                       const size_t *shape,
+                                       dlpack::dtype *dtype) {
+#if defined(_WIN32)
+    (void) name; (void) create; (void) ndim; (void) shape; (void) dtype;
+    raise("nanobind::%s(): shared memory arrays are not supported on "
+          "Windows!", func);
+#else
+    uint64_t size = ((uint64_t) dtype->bits * dtype->lanes + 7) / 8;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (shape[i] && size > (uint64_t) PY_SSIZE_T_MAX / shape[i])
+            raise("nanobind::%s(): array size overflow!", func);
+        size *= (uint64_t) shape[i];
+    }
+
+    // Empty arrays still reference a (minimal) segment
+    size_t map_size = size ? (size_t) size : 1;
+
+    char buf[48];
+    int fd;
+
+    if (create) {
+        static std::atomic<uint32_t> counter { 0 };
+        do {
+            snprintf(buf, sizeof(buf), "/nb-%lx-%x", (unsigned long) getpid(),
+                     (unsigned) ++counter);
+            fd = shm_open(buf, O_RDWR | O_CREAT | O_EXCL, 0600);
+        } while (fd < 0 && errno == EEXIST);
+        name = buf;
+
+        if (fd >= 0 && ftruncate(fd, (off_t) map_size) != 0) {
+            int error = errno;
+            close(fd);
+            shm_unlink(name);
+            errno = error;
+            fd = -1;
+        }
+    } else {
+        fd = shm_open(name, O_RDWR, 0);
+        struct stat st;
+        if (fd >= 0 && fstat(fd, &st) == 0 &&
+            (uint64_t) st.st_size < (uint64_t) map_size) {
+            close(fd);
+            raise("nanobind::%s(): the shared memory segment \"%s\" "
+                  "contains %llu bytes, which is too small for an array of "
+                  "%llu bytes!", func, name, (unsigned long long) st.st_size,
+                  (unsigned long long) size);
+        }
+    }
+
+    if (fd < 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, name);
+        raise_python_error();
+    }
+
+    void *base = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    int error = errno;
+    close(fd);
+
+    scoped_pymalloc<char> name_copy(strlen(name) + 1);
+    if (base != MAP_FAILED)
+        memcpy(name_copy.get(), name, strlen(name) + 1);
+
+    ndarray_handle *result = nullptr;
+    try {
+        if (base == MAP_FAILED) {
+            errno = error;
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, name);
+            raise_python_error();
+        }
+        result = ndarray_create(base, ndim, shape, nullptr, nullptr, dtype,
+                                device::cpu::value, 0);
+    } catch (...) {
+        if (base != MAP_FAILED)
+            munmap(base, map_size);
+        if (create)
+            shm_unlink(name);
+        throw;
+    }
+
+    result->mapping = base;
+    result->mapping_size = map_size;
+    result->shm_name = name_copy.release();
+    result->shm_owner = create;
+    if (create)
+        trace_alloc(base, map_size);
+    return result;
+#endif
+}
+
+ndarray_handle *ndarray_shm(size_t ndim, const size_t *shape,
+                            dlpack::dtype *dtype) {
+    return ndarray_shm_map("ndarray_shm", nullptr, true, ndim, shape, dtype);
+}
+
+ndarray_handle *ndarray_shm_open(const char *name, size_t ndim,
+                                 const size_t *shape, dlpack::dtype *dtype) {
+    return ndarray_shm_map("ndarray_shm_open", name, false, ndim, shape, dtype);
+}
+
+/// Return a Python object referencing 'th' that exposes the buffer protocol
+static PyObject *nb_ndarray_new(ndarray_handle *th) noexcept {
+    PyObject *o = PyType_GenericAlloc(nd_ndarray_tp(), 0);
+    if (o) {
+        ((nb_ndarray *) o)->th = th;
+        ndarray_inc_ref(th);
+    }
+    return o;
+}
+
+PyObject *memoryview_from_buffer(const void *data, size_t size,
+                                 PyObject *owner, bool readonly) {
+    dlpack::dtype dtype { (uint8_t) dlpack::dtype_code::UInt, 8, 1 };
+    ndarray_handle *th = ndarray_create((void *) data, 1, &size, owner,
+                                        nullptr, &dtype, device::cpu::value, 0);
+    th->readonly = readonly;
+
+    ndarray_inc_ref(th);
+    PyObject *exporter = nb_ndarray_new(th), *result = nullptr;
+    ndarray_dec_ref(th);
+
+    if (exporter) {
+        result = PyMemoryView_FromObject(exporter);
+        Py_DECREF(exporter);
+    }
+
+    if (!result)
+        raise_python_error();
+    return result;
+}
+
+/// Unpickle an array created by ndarray_shm() (args: name, shape, dtype)
+static PyObject *ndarray_shm_unpickle(PyObject *, PyObject *args) {
+    const char *name;
+    PyObject *shape_o;
+    int code, bits, lanes;
+    if (!PyArg_ParseTuple(args, "sO!iii", &name, &PyTuple_Type, &shape_o,
+                          &code, &bits, &lanes))
+        return nullptr;
+
+    try {
+        size_t ndim = (size_t) NB_TUPLE_GET_SIZE(shape_o);
+        scoped_pymalloc<size_t> shape(ndim ? ndim : 1);
+        for (size_t i = 0; i < ndim; ++i) {
+            shape[i] = PyLong_AsSize_t(NB_TUPLE_GET_ITEM(shape_o, i));
+            if (shape[i] == (size_t) -1 && PyErr_Occurred())
+                return nullptr;
+        }
+
+        dlpack::dtype dtype { (uint8_t) code, (uint8_t) bits,
+                              (uint16_t) lanes };
+        ndarray_handle *th =
+            ndarray_shm_open(name, ndim, shape.get(), &dtype);
+        ndarray_inc_ref(th);
+        PyObject *result = nb_ndarray_new(th);
+        ndarray_dec_ref(th); // released here if the allocation failed
+        return result;
+    } catch (...) {
+        translate_exception();
+        return nullptr;
+    }
+}
+
+static PyMethodDef ndarray_shm_unpickle_def = {
+    "_nb_shm_open", ndarray_shm_unpickle, METH_VARARGS, nullptr
+};
+
+/* Add the reconstructor of pickled ndarray_shm() arrays to an extension
+   module. Pickle stores it by reference, i.e., as the module name and the
+   attribute name. Pickles reference the first module that registered it. */
+void ndarray_shm_pickle(PyObject *module) {
+    nb_internals &internals = internals_get();
+    object name = handle(module).attr("__name__");
+    object func = steal(
+        PyCFunction_NewEx(&ndarray_shm_unpickle_def, nullptr, name.ptr()));
+    if (!func.is_valid())
+        raise_python_error();
+
+    setattr(module, ndarray_shm_unpickle_def.ml_name, func);
+
+    lock_internals guard(internals);
+    if (!internals.ndarray_shm_open)
+        internals.ndarray_shm_open = func.release().ptr();
 }
 
 static void ndarray_capsule_destructor(PyObject *o) {
@@ -585,6 +1871,53 @@ static void ndarray_capsule_destructor(PyObject *o) {
         PyErr_Clear();
 }
 
+/// Deleter of the DLPack 1.0 tensors that ndarray_wrap() creates
+static void ndarray_versioned_deleter(managed_dltensor_versioned *mtv) {
+    ndarray_dec_ref((ndarray_handle *) mtv->manager_ctx);
+    free(mtv);
+}
+
+static void ndarray_capsule_versioned_destructor(PyObject *o) {
+    error_scope scope; // temporarily save any existing errors
+    managed_dltensor_versioned *mtv = (managed_dltensor_versioned *)
+        PyCapsule_GetPointer(o, "dltensor_versioned");
+
+    if (mtv)
+        mtv->deleter(mtv);
+    else
+        PyErr_Clear();
+}
+
+/// Python functions used by ndarray_wrap(), cached in 'nb_internals'
+enum class ndarray_wrap_func : int {
+    numpy_asarray = 0, numpy_array, pytorch, tensorflow, jax
+};
+
+/// Return a borrowed reference to a cached conversion function
+static PyObject *ndarray_wrap_func_get(ndarray_wrap_func id) {
+    nb_internals &internals = internals_get();
+    PyObject **slot = internals.ndarray_wrap_funcs + (int) id;
+
+    if (NB_LIKELY(*slot))
+        return *slot;
+
+    const char *module = nullptr, *name = "from_dlpack";
+    switch (id) {
+        case ndarray_wrap_func::numpy_asarray: module = "numpy"; name = "asarray"; break;
+        case ndarray_wrap_func::numpy_array: module = "numpy"; name = "array"; break;
+        case ndarray_wrap_func::pytorch: module = "torch.utils.dlpack"; break;
+        case ndarray_wrap_func::tensorflow: module = "tensorflow.experimental.dlpack"; break;
+        case ndarray_wrap_func::jax: module = "jax.dlpack"; break;
+    }
+
+    object func = module_::import_(module).attr(name);
+
+    lock_internals guard(internals);
+    if (!*slot)
+        *slot = func.release().ptr();
+    return *slot;
+}
+
 PyObject *ndarray_wrap(ndarray_handle *th, int framework,
                        rv_policy policy) noexcept {
     if (!th)
@@ -599,16 +1932,15 @@ PyObject *ndarray_wrap(ndarray_handle *th, int framework,
 
     if ((ndarray_framework) framework == ndarray_framework::numpy) {
         try {
-            object o = steal(PyType_GenericAlloc(nd_ndarray_tp(), 0));
+            object o = steal(nb_ndarray_new(th));
             if (!o.is_valid())
                 return nullptr;
-            ((nb_ndarray *) o.ptr())->th = th;
-            ndarray_inc_ref(th);
 
-            return module_::import_("numpy")
-                .attr("array")(o, arg("copy") = copy)
-                .release()
-                .ptr();
+            handle func = ndarray_wrap_func_get(
+                copy ? ndarray_wrap_func::numpy_array
+                     : ndarray_wrap_func::numpy_asarray);
+
+            return func(o).release().ptr();
         } catch (const std::exception &e) {
             PyErr_Format(PyExc_RuntimeError,
                          "nanobind::detail::ndarray_wrap(): could not "
@@ -617,26 +1949,34 @@ PyObject *ndarray_wrap(ndarray_handle *th, int framework,
         }
     }
 
-    object package;
+    if ((ndarray_framework) framework == ndarray_framework::buffer) {
+        if (copy) {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "nanobind::detail::ndarray_wrap(): arrays "
+                            "returned via nb::buffer cannot be copied!");
+            return nullptr;
+        }
+        return nb_ndarray_new(th);
+    }
+
+    handle func;
     try {
         switch ((ndarray_framework) framework) {
             case ndarray_framework::none:
                 break;
 
             case ndarray_framework::pytorch:
-                package = module_::import_("torch.utils.dlpack");
+                func = ndarray_wrap_func_get(ndarray_wrap_func::pytorch);
                 break;
 
-
             case ndarray_framework::tensorflow:
-                package = module_::import_("tensorflow.experimental.dlpack");
+                func = ndarray_wrap_func_get(ndarray_wrap_func::tensorflow);
                 break;
 
             case ndarray_framework::jax:
-                package = module_::import_("jax.dlpack");
+                func = ndarray_wrap_func_get(ndarray_wrap_func::jax);
                 break;
 
-
             default:
                 check(false, "nanobind::detail::ndarray_wrap(): unknown "
                              "framework specified!");
@@ -648,14 +1988,38 @@ PyObject *ndarray_wrap(ndarray_handle *th, int framework,
         return nullptr;
     }
 
-    object o = steal(PyCapsule_New(th->ndarray, "dltensor",
-                                   ndarray_capsule_destructor));
+    object o;
+    if (th->readonly) {
+        // Legacy DLPack capsules can't express that the data is read-only
+        managed_dltensor_versioned *mtv = (managed_dltensor_versioned *)
+            malloc(sizeof(managed_dltensor_versioned));
+        if (!mtv) {
+            PyErr_NoMemory();
+            return nullptr;
+        }
 
-       ndarray_inc_ref(th);
+        mtv->version = { 1, 0 };
+        mtv->manager_ctx = th;
+        mtv->deleter = ndarray_versioned_deleter;
+        mtv->flags = dlpack_flag_read_only;
+        mtv->dltensor = th->ndarray->dltensor;
 
-    if (package.is_valid()) {
+        o = steal(PyCapsule_New(mtv, "dltensor_versioned",
+                                ndarray_capsule_versioned_destructor));
+        if (!o.is_valid()) {
+            free(mtv);
+            return nullptr;
+        }
+    } else {
+        o = steal(PyCapsule_New(th->ndarray, "dltensor",
+                                ndarray_capsule_destructor));
+    }
+
+    ndarray_inc_ref(th);
+
+    if (func.is_valid()) {
         try {
-            o = package.attr("from_dlpack")(o);
+            o = func(o);
         } catch (const std::exception &e) {
             PyErr_Format(PyExc_RuntimeError,
                          "nanobind::detail::ndarray_wrap(): could not "
@@ -678,5 +2042,201 @@ PyObject *ndarray_wrap(ndarray_handle *th, int framework,
     return o.release().ptr();
 }
 
+/// Release the cached conversion functions used by ndarray_wrap() and the
+/// reconstructor of shared memory arrays
+void ndarray_wrap_funcs_clear() noexcept {
+    nb_internals &internals = internals_get();
+    for (PyObject *&func : internals.ndarray_wrap_funcs)
+        Py_CLEAR(func);
+    Py_CLEAR(internals.ndarray_shm_open);
+}
+
+// ========================================================================
+
+/// Check whether an integer can be represented by the type 'Dst'
+template <typename Dst, typename Src> NB_INLINE bool arith_fits(Src v) {
+    if constexpr (std::is_floating_point_v<Dst> ||
+                  std::is_floating_point_v<Src>) {
+        return true;
+    } else if constexpr (std::is_signed_v<Src> == std::is_signed_v<Dst>) {
+        if constexpr (sizeof(Dst) >= sizeof(Src))
+            return true;
+        else
+            return v >= (Src) std::numeric_limits<Dst>::min() &&
+                   v <= (Src) std::numeric_limits<Dst>::max();
+    } else if constexpr (std::is_signed_v<Src>) {
+        if (v < 0)
+            return false;
+        if constexpr (sizeof(Dst) >= sizeof(Src))
+            return true;
+        else
+            return (std::make_unsigned_t<Src>) v <=
+                   std::numeric_limits<Dst>::max();
+    } else {
+        if constexpr (sizeof(Dst) > sizeof(Src))
+            return true;
+        else
+            return v <= (std::make_unsigned_t<Dst>)
+                            std::numeric_limits<Dst>::max();
+    }
+}
+
+template <typename Dst, typename Src>
+static bool arith_copy(Dst *dst, const void *src_, size_t size,
+                       int64_t stride) {
+    const Src *src = (const Src *) src_;
+
+    if constexpr (std::is_same_v<Dst, Src>) {
+        if (stride == 1) {
+            memcpy(dst, src, size * sizeof(Dst));
+            return true;
+        }
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        Src v = src[(int64_t) i * stride];
+        if (!arith_fits<Dst>(v))
+            return false;
+        dst[i] = (Dst) v;
+    }
+
+    return true;
+}
+
+template <typename Dst>
+static bool arith_copy_from(dlpack::dtype dt, const void *src, size_t size,
+                            int64_t stride, void *payload,
+                            void *(*alloc)(void *, size_t), bool convert) {
+    constexpr uint8_t code =
+        (uint8_t) (std::is_floating_point_v<Dst> ? dlpack::dtype_code::Float
+                   : std::is_signed_v<Dst>       ? dlpack::dtype_code::Int
+                                                 : dlpack::dtype_code::UInt);
+
+    if (dt.lanes != 1 ||
+        (!convert && (dt.code != code || dt.bits != sizeof(Dst) * 8)))
+        return false;
+
+    // Floating point values are never implicitly converted into integers
+    bool is_float = dt.code == (uint8_t) dlpack::dtype_code::Float;
+    if (is_float && !std::is_floating_point_v<Dst>)
+        return false;
+
+    using copy_fn = bool (*)(Dst *, const void *, size_t, int64_t);
+    copy_fn fn = nullptr;
+
+    switch (dt.code) {
+        case (uint8_t) dlpack::dtype_code::Int:
+            switch (dt.bits) {
+                case 8:  fn = arith_copy<Dst, int8_t>;  break;
+                case 16: fn = arith_copy<Dst, int16_t>; break;
+                case 32: fn = arith_copy<Dst, int32_t>; break;
+                case 64: fn = arith_copy<Dst, int64_t>; break;
+            }
+            break;
+
+        case (uint8_t) dlpack::dtype_code::UInt:
+            switch (dt.bits) {
+                case 8:  fn = arith_copy<Dst, uint8_t>;  break;
+                case 16: fn = arith_copy<Dst, uint16_t>; break;
+                case 32: fn = arith_copy<Dst, uint32_t>; break;
+                case 64: fn = arith_copy<Dst, uint64_t>; break;
+            }
+            break;
+
+        case (uint8_t) dlpack::dtype_code::Float:
+            if constexpr (std::is_floating_point_v<Dst>) {
+                switch (dt.bits) {
+                    case 32: fn = arith_copy<Dst, float>;  break;
+                    case 64: fn = arith_copy<Dst, double>; break;
+                }
+            }
+            break;
+    }
+
+    if (!fn)
+        return false;
+
+    Dst *dst = (Dst *) alloc(payload, size);
+    return dst && fn(dst, src, size, stride);
+}
+
+bool seq_load_array(PyObject *seq, member_kind kind, bool convert,
+                    void *(*alloc)(void *, size_t), void *payload) noexcept {
+    // Don't bother with the common case of a list or tuple
+    if (PyList_CheckExact(seq) || PyTuple_CheckExact(seq) ||
+        PyUnicode_Check(seq))
+        return false;
+
+    dlpack::dtype dt;
+    const void *data;
+    size_t size;
+    int64_t stride;
+
+    ndarray_handle *th = nullptr;
+    Py_buffer view;
+
+    if (PyObject_CheckBuffer(seq)) {
+        if (PyObject_GetBuffer(seq, &view, PyBUF_RECORDS_RO)) {
+            PyErr_Clear();
+            return false;
+        }
+
+        bool fail = view.ndim != 1 || view.itemsize <= 0 ||
+                    !buffer_dtype(&view, dt) ||
+                    view.strides[0] % view.itemsize != 0 ||
+                    (uintptr_t) view.buf % (uintptr_t) view.itemsize != 0;
+
+        if (fail) {
+            PyBuffer_Release(&view);
+            return false;
+        }
+
+        data = view.buf;
+        size = (size_t) view.shape[0];
+        stride = (int64_t) (view.strides[0] / view.itemsize);
+    } else {
+        size_t shape = nanobind::any;
+        ndarray_req req;
+        req.ndim = 1;
+        req.shape = &shape;
+        req.req_shape = true;
+        req.req_device = (uint8_t) device::cpu::value;
+
+        th = ndarray_import(seq, &req, false);
+        if (!th) {
+            PyErr_Clear();
+            return false;
+        }
+
+        dlpack::dltensor &t = *ndarray_inc_ref(th);
+        dt = t.dtype;
+        data = (const uint8_t *) t.data + t.byte_offset;
+        size = (size_t) t.shape[0];
+        stride = t.strides[0];
+    }
+
+    bool success;
+    switch (kind) {
+        case member_kind::i8:  success = arith_copy_from<int8_t>  (dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::u8:  success = arith_copy_from<uint8_t> (dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::i16: success = arith_copy_from<int16_t> (dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::u16: success = arith_copy_from<uint16_t>(dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::i32: success = arith_copy_from<int32_t> (dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::u32: success = arith_copy_from<uint32_t>(dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::i64: success = arith_copy_from<int64_t> (dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::u64: success = arith_copy_from<uint64_t>(dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::f32: success = arith_copy_from<float>   (dt, data, size, stride, payload, alloc, convert); break;
+        case member_kind::f64: success = arith_copy_from<double>  (dt, data, size, stride, payload, alloc, convert); break;
+        default: success = false;
+    }
+
+    if (th)
+        ndarray_dec_ref(th);
+    else
+        PyBuffer_Release(&view);
+
+    return success;
+}
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
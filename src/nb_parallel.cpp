@@ -0,0 +1,407 @@
+/*
+    src/nb_parallel.cpp: thread pool backing nb::parallel_for() and
+    asynchronous calls (nb::async_(), std::future)
+
+    Copyright (c) 2022 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include "nb_internals.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// A loop that is being processed by the thread pool
+struct parallel_job {
+    parallel_fn fn;
+    void *payload;
+    size_t size, chunk;
+
+    /// Start of the next unclaimed chunk
+    std::atomic<size_t> next { 0 };
+
+    /// Set when an exception or KeyboardInterrupt occurred
+    std::atomic<bool> cancel { false };
+
+    /// First exception raised by 'fn'
+    std::mutex error_mutex;
+    std::exception_ptr error;
+};
+
+/// Lazily started worker threads, owned by 'nb_internals'
+struct nb_thread_pool {
+    std::mutex mutex;
+    std::condition_variable cv_work, cv_done;
+    std::vector<std::thread> workers;
+
+    /// Job published to the workers, its generation, and pending workers
+    parallel_job *job = nullptr;
+    uint64_t generation = 0;
+    size_t pending = 0;
+    bool stop = false;
+
+    /// Held while a job runs (concurrent callers process their loops serially)
+    std::mutex run_mutex;
+
+    /// Requested number of threads including the caller (0: one per core)
+    size_t threads = 0;
+
+    /// Tasks submitted via async_submit() and the threads processing them
+    std::mutex task_mutex;
+    std::condition_variable cv_task;
+    std::deque<std::pair<void (*)(void *), void *>> tasks;
+    std::vector<std::thread> task_workers;
+    bool task_stop = false;
+};
+
+/**
+ * Is the current thread a worker of the pool, or a caller of parallel_for()
+ * that released the GIL? Nested loops then run serially without touching
+ * the GIL.
+ */
+static thread_local bool parallel_is_worker = false;
+
+/// Marks the calling thread as a worker while it participates in a loop
+struct parallel_worker_scope {
+    parallel_worker_scope() : prev(parallel_is_worker) { parallel_is_worker = true; }
+    ~parallel_worker_scope() { parallel_is_worker = prev; }
+    bool prev;
+};
+
+/// Poll for KeyboardInterrupt (at most every 50 ms); returns true if raised
+static bool parallel_poll_signals(
+    std::chrono::steady_clock::time_point &last_poll) noexcept {
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_poll < std::chrono::milliseconds(50))
+        return false;
+    last_poll = now;
+
+    gil_scoped_acquire guard;
+    return PyErr_CheckSignals() != 0;
+}
+
+/**
+ * Claim and process chunks until the job is exhausted or cancelled. The
+ * thread that called parallel_for() also polls for KeyboardInterrupt and
+ * returns true if one was raised.
+ */
+static bool parallel_run(parallel_job *job, bool poll_signals) noexcept {
+    auto last_poll = std::chrono::steady_clock::now();
+
+    while (!job->cancel.load(std::memory_order_relaxed)) {
+        if (poll_signals && parallel_poll_signals(last_poll)) {
+            job->cancel = true;
+            return true;
+        }
+
+        size_t start = job->next.fetch_add(job->chunk);
+        if (start >= job->size)
+            break;
+        size_t end = start + job->chunk < job->size ? start + job->chunk
+                                                    : job->size;
+        try {
+            job->fn(job->payload, start, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(job->error_mutex);
+            if (!job->error)
+                job->error = std::current_exception();
+            job->cancel = true;
+        }
+    }
+
+    return false;
+}
+
+static void parallel_worker(nb_thread_pool *pool, uint64_t generation) {
+    parallel_is_worker = true;
+
+    std::unique_lock<std::mutex> lock(pool->mutex);
+    while (true) {
+        pool->cv_work.wait(lock, [&] {
+            return pool->stop || pool->generation != generation;
+        });
+        if (pool->stop)
+            return;
+
+        generation = pool->generation;
+        parallel_job *job = pool->job;
+        lock.unlock();
+        parallel_run(job, false);
+        lock.lock();
+
+        if (--pool->pending == 0)
+            pool->cv_done.notify_all();
+    }
+}
+
+static size_t parallel_threads_default(nb_thread_pool *pool) {
+    if (pool && pool->threads)
+        return pool->threads;
+    size_t count = (size_t) std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+/// Stop and join the worker threads (the caller must hold 'run_mutex')
+static void parallel_stop_workers(nb_thread_pool *pool) {
+    {
+        std::lock_guard<std::mutex> guard(pool->mutex);
+        pool->stop = true;
+    }
+    pool->cv_work.notify_all();
+    for (std::thread &t : pool->workers)
+        t.join();
+    pool->workers.clear();
+    pool->stop = false;
+}
+
+static nb_thread_pool *parallel_pool() {
+    nb_internals &internals = internals_get();
+    nb_thread_pool *pool = internals.thread_pool;
+    if (NB_LIKELY(pool))
+        return pool;
+
+    pool = new nb_thread_pool();
+    lock_internals guard(internals);
+    if (internals.thread_pool) {
+        delete pool;
+        return internals.thread_pool;
+    }
+    internals.thread_pool = pool;
+    return pool;
+}
+
+void parallel_set_threads(size_t threads) {
+    nb_thread_pool *pool = parallel_pool();
+    gil_scoped_release guard;
+    std::lock_guard<std::mutex> run_guard(pool->run_mutex);
+    parallel_stop_workers(pool);
+    pool->threads = threads;
+}
+
+size_t parallel_threads() noexcept {
+    return parallel_threads_default(internals_get().thread_pool);
+}
+
+static void task_worker(nb_thread_pool *pool) {
+    // Tasks don't hold the GIL, hence loops within them run serially
+    parallel_is_worker = true;
+
+    std::unique_lock<std::mutex> lock(pool->task_mutex);
+    while (true) {
+        pool->cv_task.wait(lock, [&] {
+            return pool->task_stop || !pool->tasks.empty();
+        });
+        if (pool->tasks.empty())
+            return;
+
+        std::pair<void (*)(void *), void *> task = pool->tasks.front();
+        pool->tasks.pop_front();
+        lock.unlock();
+        task.first(task.second);
+        lock.lock();
+    }
+}
+
+void async_submit(void (*fn)(void *), void *payload) {
+    nb_thread_pool *pool = parallel_pool();
+
+    std::lock_guard<std::mutex> guard(pool->task_mutex);
+    if (pool->task_workers.empty()) {
+        size_t threads = parallel_threads_default(pool);
+        for (size_t i = 0; i < threads; ++i)
+            pool->task_workers.emplace_back(task_worker, pool);
+    }
+
+    pool->tasks.emplace_back(fn, payload);
+    pool->cv_task.notify_one();
+}
+
+/// Completes an asyncio future unless it was cancelled (args: future, value, is_exc)
+static PyObject *async_set_result(PyObject *, PyObject *args) {
+    PyObject *future, *value;
+    int is_exc;
+    if (!PyArg_ParseTuple(args, "OOp", &future, &value, &is_exc))
+        return nullptr;
+
+    PyObject *done = PyObject_CallMethod(future, "done", nullptr);
+    if (!done)
+        return nullptr;
+    int skip = PyObject_IsTrue(done);
+    Py_DECREF(done);
+    if (skip < 0)
+        return nullptr;
+
+    if (!skip) {
+        PyObject *result = PyObject_CallMethod(
+            future, is_exc ? "set_exception" : "set_result", "O", value);
+        if (!result)
+            return nullptr;
+        Py_DECREF(result);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyMethodDef async_set_result_def = {
+    "_nb_async_set_result", async_set_result, METH_VARARGS, nullptr
+};
+
+PyObject *async_future_new(PyObject **loop_out) {
+    object loop = module_::import_("asyncio").attr("get_running_loop")();
+    object future = loop.attr("create_future")();
+    *loop_out = loop.release().ptr();
+    return future.release().ptr();
+}
+
+void async_future_set(PyObject *loop_, PyObject *future_,
+                      PyObject *value_) noexcept {
+    object loop = steal(loop_), future = steal(future_), value = steal(value_);
+    bool is_exc = !value.is_valid();
+
+    try {
+        if (is_exc) {
+            PyObject *type, *exc, *trace;
+            PyErr_Fetch(&type, &exc, &trace);
+            PyErr_NormalizeException(&type, &exc, &trace);
+            if (trace)
+                PyException_SetTraceback(exc, trace);
+            Py_XDECREF(type);
+            Py_XDECREF(trace);
+            value = steal(exc);
+        }
+
+        object callback = steal(PyCFunction_New(&async_set_result_def, nullptr));
+        if (!callback.is_valid())
+            raise_python_error();
+
+        loop.attr("call_soon_threadsafe")(callback, future, value,
+                                          is_exc);
+    } catch (python_error &e) {
+        // The event loop was closed in the meantime
+        e.discard_as_unraisable(future);
+    }
+}
+
+/// Shut down the thread pool during interpreter shutdown
+void parallel_pool_clear() noexcept {
+    nb_internals &internals = internals_get();
+    nb_thread_pool *pool = internals.thread_pool;
+    if (!pool)
+        return;
+
+    // Pending tasks still run (they may need the GIL to post their results)
+    Py_BEGIN_ALLOW_THREADS
+    {
+        std::lock_guard<std::mutex> run_guard(pool->run_mutex);
+        parallel_stop_workers(pool);
+    }
+    {
+        std::lock_guard<std::mutex> guard(pool->task_mutex);
+        pool->task_stop = true;
+    }
+    pool->cv_task.notify_all();
+    for (std::thread &t : pool->task_workers)
+        t.join();
+    Py_END_ALLOW_THREADS
+
+    internals.thread_pool = nullptr;
+    delete pool;
+}
+
+void parallel_for(size_t size, size_t grain, parallel_fn fn, void *payload) {
+    if (size == 0)
+        return;
+
+    nb_thread_pool *pool = parallel_pool();
+    size_t threads = parallel_threads_default(pool);
+    if (grain == 0)
+        grain = 1;
+
+    // Split the loop into many chunks per thread to balance the load
+    size_t chunk = (size + 16 * threads - 1) / (16 * threads);
+    if (chunk < grain)
+        chunk = grain;
+
+    if (parallel_is_worker) {
+        fn(payload, 0, size);
+        return;
+    }
+
+    if (threads == 1 || chunk >= size) {
+        gil_scoped_release gil_guard;
+        parallel_worker_scope worker_guard;
+        fn(payload, 0, size);
+        return;
+    }
+
+    parallel_job job;
+    job.fn = fn;
+    job.payload = payload;
+    job.size = size;
+    job.chunk = chunk;
+    bool interrupted = false;
+
+    {
+        gil_scoped_release gil_guard;
+        parallel_worker_scope worker_guard;
+
+        std::unique_lock<std::mutex> run_guard(pool->run_mutex, std::try_to_lock);
+        if (!run_guard.owns_lock()) {
+            // The pool is busy with another loop, process this one directly
+            interrupted = parallel_run(&job, true);
+        } else {
+            if (pool->workers.size() + 1 != threads) {
+                parallel_stop_workers(pool);
+                for (size_t i = 1; i < threads; ++i)
+                    pool->workers.emplace_back(parallel_worker, pool,
+                                               pool->generation);
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(pool->mutex);
+                pool->job = &job;
+                pool->pending = pool->workers.size();
+                pool->generation++;
+            }
+            pool->cv_work.notify_all();
+
+            interrupted = parallel_run(&job, true);
+
+            // Wait for the workers, and check for KeyboardInterrupt meanwhile
+            auto last_poll = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            while (pool->pending != 0) {
+                if (pool->cv_done.wait_for(lock, std::chrono::milliseconds(50)) ==
+                        std::cv_status::timeout && !interrupted) {
+                    lock.unlock();
+                    if (parallel_poll_signals(last_poll)) {
+                        interrupted = true;
+                        job.cancel = true;
+                    }
+                    lock.lock();
+                }
+            }
+            pool->job = nullptr;
+        }
+    }
+
+    if (interrupted)
+        raise_python_error();
+
+    if (job.error)
+        std::rethrow_exception(job.error);
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
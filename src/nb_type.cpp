@@ -13,6 +13,9 @@
 #  pragma warning(disable: 4706) // assignment within conditional expression
 #endif
 
+/// Size (and alignment) of the memory regions carved into pooled instances
+#define NB_POOL_SLAB_SIZE 16384
+
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
@@ -25,16 +28,43 @@ static PyObject **nb_dict_ptr(PyObject *self) {
 #endif
 }
 
+static PyObject **inst_keep_alive_slot(nb_inst *inst) noexcept;
+static PyObject **inst_member_cache_slot(nb_inst *inst, const type_data *t);
+
 static int inst_clear(PyObject *self) {
-    PyObject *&dict = *nb_dict_ptr(self);
-    Py_CLEAR(dict);
+    const type_data *t = nb_type_data(Py_TYPE(self));
+    if (t->flags & (uint32_t) type_flags::has_dynamic_attr) {
+        PyObject *&dict = *nb_dict_ptr(self);
+        Py_CLEAR(dict);
+    }
+    if (t->flags & (uint32_t) type_flags::has_member_cache)
+        Py_CLEAR(*inst_member_cache_slot((nb_inst *) self, t));
     return 0;
 }
 
 static int inst_traverse(PyObject *self, visitproc visit, void *arg) {
-    PyObject *&dict = *nb_dict_ptr(self);
-    if (dict)
-        Py_VISIT(dict);
+    const type_data *t = nb_type_data(Py_TYPE(self));
+    if (t->flags & (uint32_t) type_flags::has_dynamic_attr) {
+        PyObject *&dict = *nb_dict_ptr(self);
+        if (dict)
+            Py_VISIT(dict);
+    }
+
+    /* The inline keep_alive patient is visited so that the garbage collector
+       sees the reference from cached member wrappers to their owner. It is
+       only released by inst_dealloc(), after the C++ destructor has run. */
+    if (t->flags & (uint32_t) type_flags::has_inline_keep_alive) {
+        PyObject *patient = *inst_keep_alive_slot((nb_inst *) self);
+        if (patient)
+            Py_VISIT(patient);
+    }
+
+    if (t->flags & (uint32_t) type_flags::has_member_cache) {
+        PyObject *cache = *inst_member_cache_slot((nb_inst *) self, t);
+        if (cache)
+            Py_VISIT(cache);
+    }
+
 #if PY_VERSION_HEX >= 0x03090000
     Py_VISIT(Py_TYPE(self));
 #endif
@@ -47,16 +77,175 @@ static int inst_init(PyObject *self, PyObject *, PyObject *) {
     return -1;
 }
 
+/// Size of the instance header, including the optional inline keep_alive
+/// and member cache slots
+static NB_INLINE size_t inst_header_size(const type_data *t) noexcept {
+    size_t size = sizeof(nb_inst);
+    if (t->flags & (uint32_t) type_flags::has_inline_keep_alive)
+        size += sizeof(PyObject *);
+    if (t->flags & (uint32_t) type_flags::has_member_cache)
+        size += sizeof(PyObject *);
+    return size;
+}
+
+/// Pointer to the inline keep_alive slot of types with 'has_inline_keep_alive'
+static PyObject **inst_keep_alive_slot(nb_inst *inst) noexcept {
+    return (PyObject **) (inst + 1);
+}
+
+/// Pointer to the list of cached wrappers of types with 'has_member_cache'
+static PyObject **inst_member_cache_slot(nb_inst *inst, const type_data *t) {
+    PyObject **slot = (PyObject **) (inst + 1);
+    if (t->flags & (uint32_t) type_flags::has_inline_keep_alive)
+        slot++;
+    return slot;
+}
+
+/// Size class of instances with internal storage (pooled if < NB_POOL_CLASSES)
+static NB_INLINE size_t inst_pool_class(const type_data *t) noexcept {
+#if defined(NB_FREE_THREADED)
+    // The instance pool is not thread-safe
+    (void) t;
+    return NB_POOL_CLASSES;
+#else
+    size_t size = inst_header_size(t) + t->size, align = (size_t) t->align;
+    if (align > sizeof(void *))
+        size += align - sizeof(void *);
+    return (size - 1) / NB_POOL_GRANULARITY;
+#endif
+}
+
+/**
+ * Header at the start of each slab of the instance pool. Slabs are aligned to
+ * their size, which locates the header of any block by masking its address.
+ */
+struct inst_pool_slab {
+    /// Number of blocks handed out by inst_pool_alloc()
+    size_t live;
+
+    /// Next slab to be released (used by inst_pool_trim())
+    inst_pool_slab *next;
+};
+
+static_assert(sizeof(inst_pool_slab) <= NB_POOL_GRANULARITY);
+
+static NB_INLINE inst_pool_slab *inst_pool_slab_of(void *block) noexcept {
+    return (inst_pool_slab *) ((uintptr_t) block &
+                               ~(uintptr_t) (NB_POOL_SLAB_SIZE - 1));
+}
+
+static void *inst_pool_slab_malloc() noexcept {
+#if defined(_WIN32)
+    return _aligned_malloc(NB_POOL_SLAB_SIZE, NB_POOL_SLAB_SIZE);
+#else
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, NB_POOL_SLAB_SIZE, NB_POOL_SLAB_SIZE))
+        return nullptr;
+    return ptr;
+#endif
+}
+
+static void inst_pool_slab_free(void *ptr) noexcept {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+/// Fetch a memory block of the given size class from the instance pool
+static nb_inst *inst_pool_alloc(size_t cls) noexcept {
+    void *&head = internals_get().inst_pool[cls];
+    void *block = head;
+
+    if (NB_UNLIKELY(!block)) {
+        // Carve a new slab into a linked list of blocks following the header
+        size_t size = (cls + 1) * NB_POOL_GRANULARITY,
+               count = (NB_POOL_SLAB_SIZE - NB_POOL_GRANULARITY) / size;
+
+        uint8_t *slab = (uint8_t *) inst_pool_slab_malloc();
+        if (!slab)
+            return nullptr;
+
+        ((inst_pool_slab *) slab)->live = 0;
+        uint8_t *first = slab + NB_POOL_GRANULARITY;
+
+        for (size_t i = 0; i < count; ++i)
+            *(void **) (first + i * size) =
+                (i + 1 < count) ? (void *) (first + (i + 1) * size) : nullptr;
+
+        block = first;
+    }
+
+    head = *(void **) block;
+    inst_pool_slab_of(block)->live++;
+    trace_alloc(block, (cls + 1) * NB_POOL_GRANULARITY);
+    return (nb_inst *) block;
+}
+
+/// Return a memory block to the instance pool
+static NB_INLINE void inst_pool_free(void *block, size_t cls) noexcept {
+    void *&head = internals_get().inst_pool[cls];
+    trace_free(block);
+    inst_pool_slab_of(block)->live--;
+    *(void **) block = head;
+    head = block;
+}
+
+/// Release the slabs of a size class that no longer contain live instances
+static void inst_pool_trim(size_t cls) noexcept {
+    void **link = &internals_get().inst_pool[cls];
+    inst_pool_slab *empty = nullptr;
+
+    /* Unlink the blocks of empty slabs, which are collected in 'empty' and
+       marked by an invalid 'live' count */
+    while (void *block = *link) {
+        inst_pool_slab *slab = inst_pool_slab_of(block);
+
+        if (slab->live == 0) {
+            slab->live = (size_t) -1;
+            slab->next = empty;
+            empty = slab;
+        }
+
+        if (slab->live == (size_t) -1)
+            *link = *(void **) block;
+        else
+            link = (void **) block;
+    }
+
+    while (empty) {
+        inst_pool_slab *next = empty->next;
+        inst_pool_slab_free(empty);
+        empty = next;
+    }
+}
+
 /// Allocate memory for a nb_type instance with internal or external storage
 PyObject *inst_new_impl(PyTypeObject *tp, void *value) {
+    if (NB_UNLIKELY(internals_get().lazy_types))
+        nb_lazy_materialize(tp);
+
     bool gc = PyType_HasFeature(tp, Py_TPFLAGS_HAVE_GC);
     const type_data *t = nb_type_data(tp);
     size_t align = (size_t) t->align;
 
     nb_inst *self;
+    size_t header_size = inst_header_size(t);
 
-    if (!gc) {
-        size_t size = sizeof(nb_inst);
+    size_t pool_class = NB_POOL_CLASSES;
+    if (NB_UNLIKELY(t->flags & (uint32_t) type_flags::is_pooled) && !gc && !value)
+        pool_class = inst_pool_class(t);
+
+    if (pool_class < NB_POOL_CLASSES) {
+        self = inst_pool_alloc(pool_class);
+        if (!self)
+            return PyErr_NoMemory();
+        // Recycled blocks still contain the header of the previous instance
+        memset(self, 0, sizeof(nb_inst));
+        PyObject_Init((PyObject *) self, tp);
+    } else if (!gc) {
+        size_t size = header_size;
         if (!value) {
             // Internal storage: space for the object and padding for alignment
             size += t->size;
@@ -73,9 +262,12 @@ PyObject *inst_new_impl(PyTypeObject *tp, void *value) {
         self = (nb_inst *) PyType_GenericAlloc(tp, 0);
     }
 
+    if (header_size != sizeof(nb_inst))
+        memset(self + 1, 0, header_size - sizeof(nb_inst));
+
     if (!value) {
         // Compute suitably aligned instance payload pointer
-        uintptr_t payload = (uintptr_t) (self + 1);
+        uintptr_t payload = (uintptr_t) self + header_size;
         payload = (payload + align - 1) / align * align;
 
         // Encode offset to aligned payload
@@ -96,7 +288,7 @@ PyObject *inst_new_impl(PyTypeObject *tp, void *value) {
             if (!gc) {
                 // Offset *not* representable, allocate extra memory for a pointer
                 nb_inst *self_2 =
-                    (nb_inst *) PyObject_Realloc(self, sizeof(nb_inst) + sizeof(void *));
+                    (nb_inst *) PyObject_Realloc(self, header_size + sizeof(void *));
 
                 if (!self_2) {
                     PyObject_Free(self);
@@ -106,17 +298,27 @@ PyObject *inst_new_impl(PyTypeObject *tp, void *value) {
                 self = self_2;
             }
 
-            *(void **) (self + 1) = value;
-            self->offset = (int32_t) sizeof(nb_inst);
+            *(void **) ((uint8_t *) self + header_size) = value;
+            self->offset = (int32_t) header_size;
             self->direct = false;
         }
 
         self->internal = false;
     }
 
+#if defined(NB_FREE_THREADED) && PY_VERSION_HEX >= 0x030E0000
+    // Permit other threads to look up this instance via nb_try_inc_ref()
+    PyUnstable_EnableTryIncRef((PyObject *) self);
+#endif
+
+    if (NB_UNLIKELY(t->flags & (uint32_t) type_flags::no_identity))
+        return (PyObject *) self;
+
     // Update hash table that maps from C++ to Python instance
-    auto [it, success] =
-        internals_get().inst_c2p.try_emplace(value, self);
+    nb_shard &shard = internals_get().shard(value);
+    lock_shard guard(shard);
+
+    auto [it, success] = shard.inst_c2p.try_emplace(value, self);
 
     if (NB_UNLIKELY(!success)) {
         void *entry = it->second;
@@ -157,6 +359,105 @@ static PyObject *inst_new(PyTypeObject *type, PyObject *, PyObject *) {
     return inst_new_impl(type, nullptr);
 }
 
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX >= 0x03090000
+/// Call the type via tp_call, which performs the regular __new__/__init__ steps
+static PyObject *nb_type_call_slow(PyObject *self, PyObject *const *args,
+                                   Py_ssize_t nargs, PyObject *kwnames) {
+    object args_tuple = steal(PyTuple_New(nargs)), kwargs;
+    if (!args_tuple.is_valid())
+        return nullptr;
+
+    for (Py_ssize_t i = 0; i < nargs; ++i) {
+        Py_INCREF(args[i]);
+        NB_TUPLE_SET_ITEM(args_tuple.ptr(), i, args[i]);
+    }
+
+    if (kwnames) {
+        kwargs = steal(PyDict_New());
+        if (!kwargs.is_valid())
+            return nullptr;
+
+        for (Py_ssize_t i = 0, n = NB_TUPLE_GET_SIZE(kwnames); i < n; ++i) {
+            if (PyDict_SetItem(kwargs.ptr(), NB_TUPLE_GET_ITEM(kwnames, i),
+                               args[nargs + i]))
+                return nullptr;
+        }
+    }
+
+    return Py_TYPE(self)->tp_call(self, args_tuple.ptr(), kwargs.ptr());
+}
+
+/**
+ * Vectorcall implementation of nanobind types, which allocates the instance
+ * and directly dispatches to the bound __init__ overloads instead of going
+ * through CPython's type_call(), tp_init slot, and argument tuple/dict.
+ */
+static PyObject *nb_type_vectorcall(PyObject *self, PyObject *const *args_in,
+                                    size_t nargsf, PyObject *kwnames) noexcept {
+    static void *init_cache = nullptr;
+    PyTypeObject *tp = (PyTypeObject *) self;
+    Py_ssize_t nargs = NB_VECTORCALL_NARGS(nargsf);
+
+    // Assigning __new__ or __init__ after type creation replaces these slots
+    if (NB_UNLIKELY(tp->tp_new != inst_new || tp->tp_init != inst_init))
+        return nb_type_call_slow(self, args_in, nargs, kwnames);
+
+    PyObject *inst = inst_new_impl(tp, nullptr);
+    if (!inst)
+        return nullptr;
+
+    // Borrowed reference (also reflects __init__ methods created lazily above)
+    PyObject *init = _PyType_Lookup(tp, interned_get("__init__", &init_cache));
+    if (NB_UNLIKELY(!init || Py_TYPE(init) != internals_get().nb_method)) {
+        Py_DECREF(inst);
+        return nb_type_call_slow(self, args_in, nargs, kwnames);
+    }
+
+    const size_t buf_size = 6;
+    PyObject **args, *buf[buf_size], *temp = nullptr;
+    bool alloc = false;
+
+    if (NB_LIKELY(nargsf & NB_VECTORCALL_ARGUMENTS_OFFSET)) {
+        // The caller permits temporarily overwriting the preceding entry
+        args = (PyObject **) (args_in - 1);
+        temp = args[0];
+    } else {
+        size_t size = (size_t) nargs + 1;
+        if (kwnames)
+            size += (size_t) NB_TUPLE_GET_SIZE(kwnames);
+
+        if (size <= buf_size) {
+            args = buf;
+        } else {
+            args = (PyObject **) PyMem_Malloc(size * sizeof(PyObject *));
+            if (!args) {
+                Py_DECREF(inst);
+                return PyErr_NoMemory();
+            }
+            alloc = true;
+        }
+
+        memcpy(args + 1, args_in, sizeof(PyObject *) * (size - 1));
+    }
+
+    args[0] = inst;
+    PyObject *rv = ((nb_func *) init)->vectorcall(
+        init, args, (size_t) nargs + 1, kwnames);
+    args[0] = temp;
+
+    if (NB_UNLIKELY(alloc))
+        PyMem_Free(args);
+
+    if (!rv) {
+        Py_DECREF(inst);
+        return nullptr;
+    }
+
+    Py_DECREF(rv); // None
+    return inst;
+}
+#endif
+
 static void inst_dealloc(PyObject *self) {
     PyTypeObject *tp = Py_TYPE(self);
     const type_data *t = nb_type_data(tp);
@@ -173,6 +474,9 @@ static void inst_dealloc(PyObject *self) {
     nb_inst *inst = (nb_inst *) self;
     void *p = inst_ptr(inst);
 
+    if (t->flags & (uint32_t) type_flags::has_member_cache)
+        Py_CLEAR(*inst_member_cache_slot(inst, t));
+
     if (inst->destruct) {
         check(t->flags & (uint32_t) type_flags::is_destructible,
               "nanobind::detail::inst_dealloc(\"%s\"): attempted to call "
@@ -182,21 +486,33 @@ static void inst_dealloc(PyObject *self) {
     }
 
     if (inst->cpp_delete) {
+        trace_free(p);
         if (t->align <= (uint32_t) __STDCPP_DEFAULT_NEW_ALIGNMENT__)
             operator delete(p);
         else
             operator delete(p, std::align_val_t(t->align));
     }
 
+    if (t->flags & (uint32_t) type_flags::has_inline_keep_alive)
+        Py_CLEAR(*inst_keep_alive_slot(inst));
+
     nb_internals &internals = internals_get();
     if (inst->clear_keep_alive) {
-        auto it = internals.keep_alive.find(self);
-        check(it != internals.keep_alive.end(),
-              "nanobind::detail::inst_dealloc(\"%s\"): inconsistent "
-              "keep_alive information", t->name);
+        nb_weakref_seq *s;
+        {
+            nb_shard &shard = internals.shard(self);
+            lock_shard guard(shard);
+
+            auto it = shard.keep_alive.find(self);
+            check(it != shard.keep_alive.end(),
+                  "nanobind::detail::inst_dealloc(\"%s\"): inconsistent "
+                  "keep_alive information", t->name);
+
+            s = (nb_weakref_seq *) it->second;
+            shard.keep_alive.erase(it);
+        }
 
-        nb_weakref_seq *s = (nb_weakref_seq *) it->second;
-        internals.keep_alive.erase(it);
+        // Release the patients without holding the lock
         do {
             nb_weakref_seq *c = s;
             s = c->next;
@@ -210,41 +526,47 @@ static void inst_dealloc(PyObject *self) {
         } while (s);
     }
 
-    // Update hash table that maps from C++ to Python instance
-    nb_ptr_map &inst_c2p = internals.inst_c2p;
-    nb_ptr_map::iterator it = inst_c2p.find(p);
-    bool found = false;
+    bool found = t->flags & (uint32_t) type_flags::no_identity;
 
-    if (NB_LIKELY(it != inst_c2p.end())) {
-        void *entry = it->second;
-        if (NB_LIKELY(entry == inst)) {
-            found = true;
-            inst_c2p.erase(it);
-        } else if (nb_is_seq(entry)) {
-            // Multiple objects are associated with this address. Find the right one!
-            nb_inst_seq *seq = nb_get_seq(entry),
-                        *pred = nullptr;
-
-            do {
-                if ((nb_inst *) seq->inst == inst) {
-                    found = true;
-
-                    if (pred) {
-                        pred->next = seq->next;
-                    } else {
-                        if (seq->next)
-                            it.value() = nb_mark_seq(seq->next);
-                        else
-                            inst_c2p.erase(it);
-                    }
+    if (NB_LIKELY(!found)) {
+        // Update hash table that maps from C++ to Python instance
+        nb_shard &shard = internals.shard(p);
+        lock_shard guard(shard);
 
-                    PyMem_Free(seq);
-                    break;
-                }
+        nb_ptr_map &inst_c2p = shard.inst_c2p;
+        nb_ptr_map::iterator it = inst_c2p.find(p);
 
-                pred = seq;
-                seq = seq->next;
-            } while (seq);
+        if (NB_LIKELY(it != inst_c2p.end())) {
+            void *entry = it->second;
+            if (NB_LIKELY(entry == inst)) {
+                found = true;
+                inst_c2p.erase(it);
+            } else if (nb_is_seq(entry)) {
+                // Multiple objects are associated with this address. Find the right one!
+                nb_inst_seq *seq = nb_get_seq(entry),
+                            *pred = nullptr;
+
+                do {
+                    if ((nb_inst *) seq->inst == inst) {
+                        found = true;
+
+                        if (pred) {
+                            pred->next = seq->next;
+                        } else {
+                            if (seq->next)
+                                it.value() = nb_mark_seq(seq->next);
+                            else
+                                inst_c2p.erase(it);
+                        }
+
+                        PyMem_Free(seq);
+                        break;
+                    }
+
+                    pred = seq;
+                    seq = seq->next;
+                } while (seq);
+            }
         }
     }
 
@@ -252,29 +574,144 @@ static void inst_dealloc(PyObject *self) {
           "nanobind::detail::inst_dealloc(\"%s\"): attempted to delete an "
           "unknown instance (%p)!", t->name, p);
 
-    if (NB_UNLIKELY(gc))
+    if (NB_UNLIKELY(gc)) {
         NB_SLOT(internals, PyType_Type, tp_free)(self);
-    else
+    } else if ((t->flags & (uint32_t) type_flags::is_pooled) && inst->internal) {
+        size_t pool_class = inst_pool_class(t);
+        if (pool_class < NB_POOL_CLASSES)
+            inst_pool_free(self, pool_class);
+        else
+            PyObject_Free(self);
+    } else {
         PyObject_Free(self);
+    }
 
     Py_DECREF(tp);
 }
 
+#if defined(NB_FREE_THREADED)
+/// Per-thread caches of type lookups, validated against 'internals.type_epoch'
+struct nb_thread_cache {
+    nb_internals *owner;
+    uint64_t epoch;
+    nb_type_cache_entry types[NB_CAST_CACHE_SIZE];
+    nb_cast_cache_entry casts[NB_CAST_CACHE_SIZE];
+};
+
+static NB_THREAD_LOCAL nb_thread_cache thread_cache;
+
+static NB_INLINE nb_thread_cache &nb_thread_cache_get(nb_internals &internals) noexcept {
+    nb_thread_cache &tc = thread_cache;
+    uint64_t epoch = internals.type_epoch.load(std::memory_order_acquire);
+
+    if (NB_UNLIKELY(tc.epoch != epoch || tc.owner != &internals)) {
+        memset(&tc, 0, sizeof(nb_thread_cache));
+        tc.owner = &internals;
+        tc.epoch = epoch;
+    }
+
+    return tc;
+}
+#endif
+
+/// Direct-mapped cache of nb_type_get() results
+static NB_INLINE nb_cast_cache_entry *nb_cast_cache(nb_internals &internals) noexcept {
+#if defined(NB_FREE_THREADED)
+    return nb_thread_cache_get(internals).casts;
+#else
+    return internals.cast_cache;
+#endif
+}
+
+/// Discard cached type lookups after a type was registered or deallocated
+static void nb_type_cache_invalidate(nb_internals &internals) noexcept {
+#if defined(NB_FREE_THREADED)
+    internals.type_epoch.fetch_add(1, std::memory_order_release);
+#else
+    memset(internals.cast_cache, 0, sizeof(internals.cast_cache));
+#endif
+}
+
+static type_data *nb_type_c2p_impl(nb_internals &internals,
+                                   const std::type_info *type) {
+    nb_ptr_map &type_c2p_fast = internals.type_c2p_fast;
+    nb_ptr_map::iterator it_fast = type_c2p_fast.find((void *) type);
+    if (NB_LIKELY(it_fast != type_c2p_fast.end()))
+        return (type_data *) it_fast->second;
+
+    nb_type_map &type_c2p = internals.type_c2p;
+    nb_type_map::iterator it = type_c2p.find(std::type_index(*type));
+    if (it == type_c2p.end())
+        return nullptr;
+
+    type_c2p_fast[(void *) type] = it->second;
+    return it->second;
+}
+
+/// Look up the type_data of a bound C++ type, returns nullptr if not found
+type_data *nb_type_c2p(nb_internals &internals, const std::type_info *type) {
+#if !defined(NB_FREE_THREADED)
+    return nb_type_c2p_impl(internals, type);
+#else
+    // Avoid taking the lock if the result is available in the thread cache
+    nb_type_cache_entry &e = nb_thread_cache_get(internals)
+        .types[ptr_hash()(type) % NB_CAST_CACHE_SIZE];
+    if (NB_LIKELY(e.type == type))
+        return e.td;
+
+    type_data *td;
+    {
+        lock_internals guard(internals);
+        td = nb_type_c2p_impl(internals, type);
+    }
+
+    if (td) {
+        e.type = type;
+        e.td = td;
+    }
+
+    return td;
+#endif
+}
+
 static void nb_type_dealloc(PyObject *o) {
     type_data *t = nb_type_data((PyTypeObject *) o);
+    nb_internals &internals = internals_get();
 
     if (t->type && (t->flags & (uint32_t) type_flags::is_python_type) == 0) {
-        nb_type_map &type_c2p = internals_get().type_c2p;
+        lock_internals guard(internals);
+
+        nb_type_map &type_c2p = internals.type_c2p;
         nb_type_map::iterator it = type_c2p.find(std::type_index(*t->type));
         check(it != type_c2p.end(),
               "nanobind::detail::nb_type_dealloc(\"%s\"): could not "
               "find type!", t->name);
         type_c2p.erase(it);
+
+        // Further std::type_info addresses may refer to this type
+        internals.type_c2p_fast.clear();
     }
 
+    // The address of this type could be reused by a future type
+    nb_type_cache_invalidate(internals);
+
     if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
         free(t->implicit);
         free(t->implicit_py);
+        free(t->implicit_native);
+    }
+
+    if (t->flags & (uint32_t) type_flags::has_lazy_funcs)
+        nb_lazy_type_free((PyTypeObject *) o);
+
+    if (t->overrides)
+        nb_override_free(t);
+
+    // Existing instances keep the type alive, so its pool blocks are unused
+    if (t->flags & (uint32_t) type_flags::is_pooled) {
+        size_t pool_class = inst_pool_class(t);
+        if (pool_class < NB_POOL_CLASSES)
+            inst_pool_trim(pool_class);
     }
 
     free((char *) t->name);
@@ -318,17 +755,35 @@ static int nb_type_init(PyObject *self, PyObject *args, PyObject *kwds) {
 
     *t = *t_b;
     t->flags |=  (uint32_t) type_flags::is_python_type;
-    t->flags &= ~((uint32_t) type_flags::has_implicit_conversions);
+    t->flags &= ~((uint32_t) type_flags::has_implicit_conversions |
+                  (uint32_t) type_flags::has_lazy_funcs |
+                  (uint32_t) type_flags::is_pooled);
     PyObject *name = nb_type_name((PyTypeObject *) self);
     t->name = NB_STRDUP(PyUnicode_AsUTF8AndSize(name, nullptr));
     Py_DECREF(name);
     t->type_py = (PyTypeObject *) self;
     t->implicit = nullptr;
     t->implicit_py = nullptr;
+    t->implicit_native = nullptr;
+    t->overrides = nullptr;
 
     return 0;
 }
 
+/// Create deferred function bindings (nb::lazy_functions) upon first access
+static PyObject *nb_type_getattro(PyObject *obj, PyObject *name) {
+    nb_internals &internals = internals_get();
+
+    /* While bindings are still being registered, only create them when the
+       accessed name refers to a deferred function */
+    if (NB_UNLIKELY(internals.lazy_types) &&
+        (!internals.lazy_depth ||
+         nb_lazy_pending((PyTypeObject *) obj, name)))
+        nb_lazy_materialize((PyTypeObject *) obj);
+
+    return NB_SLOT(internals, PyType_Type, tp_getattro)(obj, name);
+}
+
 /// Special case to handle 'Class.property = value' assignments
 static int nb_type_setattro(PyObject* obj, PyObject* name, PyObject* value) {
     nb_internals &internals = internals_get();
@@ -364,7 +819,20 @@ static int nb_type_setattro(PyObject* obj, PyObject* name, PyObject* value) {
         PyErr_Clear();
     }
 
-    return NB_SLOT(internals, PyType_Type, tp_setattro)(obj, name, value);
+    int rv = NB_SLOT(internals, PyType_Type, tp_setattro)(obj, name, value);
+
+    /* This may add or remove Python overrides of this type and its
+       subclasses. Reserved names like '__bases__' can affect any method. */
+    if (rv == 0) {
+        const char *cname = PyUnicode_AsUTF8AndSize(name, nullptr);
+        if (!cname)
+            PyErr_Clear();
+        else if (cname[0] == '_' && cname[1] == '_')
+            cname = nullptr;
+        nb_override_invalidate((PyTypeObject *) obj, cname);
+    }
+
+    return rv;
 }
 
 #if PY_VERSION_HEX < 0x030C0000
@@ -611,6 +1079,7 @@ static PyTypeObject *nb_type_tp(nb_internals &internals,
         PyType_Slot slots[] = {
             { Py_tp_base, &PyType_Type },
             { Py_tp_dealloc, (void *) nb_type_dealloc },
+            { Py_tp_getattro, (void *) nb_type_getattro },
             { Py_tp_setattro, (void *) nb_type_setattro },
             { Py_tp_init, (void *) nb_type_init },
             { 0, nullptr }
@@ -618,7 +1087,7 @@ static PyTypeObject *nb_type_tp(nb_internals &internals,
 
 #if defined(Py_LIMITED_API)
         int itemsize = cast<int>(handle(&PyType_Type).attr("__itemsize__"));
-        int basicsize = cast<int>(handle(&PyType_Type).attr("__basicsize__"));
+        int basicsize = (int) nb_type_data_offset;
 #else
         int itemsize = (int) PyType_Type.tp_itemsize;
         int basicsize = (int) PyType_Type.tp_basicsize;
@@ -639,6 +1108,14 @@ static PyTypeObject *nb_type_tp(nb_internals &internals,
         tp = (PyTypeObject *) nb_type_from_metaclass(
             internals.nb_meta, internals.nb_module, &spec);
 
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX >= 0x03090000
+        // Heap metaclasses don't inherit the vectorcall protocol (< 3.12)
+        if (tp) {
+            tp->tp_flags |= Py_TPFLAGS_HAVE_VECTORCALL;
+            tp->tp_vectorcall_offset = offsetof(PyTypeObject, tp_vectorcall);
+        }
+#endif
+
         handle(tp).attr("__module__") = "nanobind";
 
         int rv = 1;
@@ -652,8 +1129,120 @@ static PyTypeObject *nb_type_tp(nb_internals &internals,
     return tp;
 }
 
-/// Called when a C++ type is bound via nb::class_<>
-PyObject *nb_type_new(const type_init_data *t) noexcept {
+/// Return the attribute dictionary of 'o', or an invalid handle if there is none
+static object inst_state(PyObject *o) {
+    object dict = steal(getattr(o, "__dict__", nullptr));
+    if (dict.is_valid() && (!PyDict_Check(dict.ptr()) || PyDict_Size(dict.ptr()) == 0))
+        dict.reset();
+    return dict;
+}
+
+static bool inst_check_ready(PyObject *self) {
+    if (!((nb_inst *) self)->ready) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "nanobind: attempted to copy or pickle an uninitialized "
+                     "instance of type '%s'!", nb_type_data(Py_TYPE(self))->name);
+        return false;
+    }
+    return true;
+}
+
+/// Shared implementation of __copy__ and __deepcopy__ (nb::trivial_pickle)
+static PyObject *inst_copy_impl(PyObject *self, PyObject *memo) {
+    if (!inst_check_ready(self))
+        return nullptr;
+
+    try {
+        object result = steal(inst_new_impl(Py_TYPE(self), nullptr));
+        if (!result.is_valid())
+            return nullptr;
+        nb_inst_copy(result.ptr(), self);
+
+        object state = inst_state(self);
+        if (state.is_valid()) {
+            if (memo) {
+                // Register the copy first in case the state references 'self'
+                object key = steal(PyLong_FromVoidPtr(self));
+                if (!key.is_valid() || PyDict_Check(memo) == 0 ||
+                    PyDict_SetItem(memo, key.ptr(), result.ptr()))
+                    raise_python_error();
+                state = module_::import_("copy").attr("deepcopy")(state,
+                                                                  handle(memo));
+            }
+            result.attr("__dict__").attr("update")(state);
+        }
+
+        return result.release().ptr();
+    } catch (python_error &e) {
+        e.restore();
+        return nullptr;
+    }
+}
+
+static PyObject *inst_copy(PyObject *self, PyObject *) {
+    return inst_copy_impl(self, nullptr);
+}
+
+static PyObject *inst_deepcopy(PyObject *self, PyObject *memo) {
+    return inst_copy_impl(self, memo);
+}
+
+/// __reduce_ex__: pickle the instance payload as a 'bytes' object
+static PyObject *inst_reduce_ex(PyObject *self, PyObject *) {
+    if (!inst_check_ready(self))
+        return nullptr;
+
+    try {
+        type_data *t = nb_type_data(Py_TYPE(self));
+        object data = steal(PyBytes_FromStringAndSize(
+            (const char *) inst_ptr((nb_inst *) self), (Py_ssize_t) t->size));
+        if (!data.is_valid())
+            raise_python_error();
+        object func = handle((PyObject *) Py_TYPE(self)).attr("_nb_unpickle");
+
+        object state = inst_state(self);
+        return make_tuple(func, make_tuple(data),
+                          state.is_valid() ? state : none()).release().ptr();
+    } catch (python_error &e) {
+        e.restore();
+        return nullptr;
+    }
+}
+
+/// Class method that reconstructs an instance from the output of __reduce_ex__
+static PyObject *inst_unpickle(PyObject *cls, PyObject *data) {
+    PyTypeObject *tp = (PyTypeObject *) cls;
+    type_data *t = nb_type_data(tp);
+    char *buf = nullptr;
+    Py_ssize_t size = 0;
+
+    if (!PyBytes_Check(data) || PyBytes_AsStringAndSize(data, &buf, &size) ||
+        (size_t) size != t->size) {
+        if (!PyErr_Occurred())
+            PyErr_Format(PyExc_TypeError,
+                         "nanobind: cannot unpickle an instance of type '%s' "
+                         "from the given data!", t->name);
+        return nullptr;
+    }
+
+    PyObject *result = inst_new_impl(tp, nullptr);
+    if (!result)
+        return nullptr;
+
+    memcpy(inst_ptr((nb_inst *) result), buf, t->size);
+    nb_inst_set_state(result, true, true);
+    return result;
+}
+
+static PyMethodDef inst_trivial_pickle_methods[] = {
+    { "__copy__", inst_copy, METH_NOARGS, nullptr },
+    { "__deepcopy__", inst_deepcopy, METH_O, nullptr },
+    { "__reduce_ex__", inst_reduce_ex, METH_O, nullptr },
+    { "_nb_unpickle", inst_unpickle, METH_O | METH_CLASS, nullptr },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+static PyObject *nb_type_new_impl(const type_init_data *t) noexcept {
     bool has_doc           = t->flags & (uint32_t) type_init_flags::has_doc,
          has_base          = t->flags & (uint32_t) type_init_flags::has_base,
          has_base_py       = t->flags & (uint32_t) type_init_flags::has_base_py,
@@ -661,7 +1250,18 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
          has_supplement    = t->flags & (uint32_t) type_init_flags::has_supplement,
          has_dynamic_attr  = t->flags & (uint32_t) type_flags::has_dynamic_attr,
          intrusive_ptr     = t->flags & (uint32_t) type_flags::intrusive_ptr,
-         has_shared_from_this = t->flags & (uint32_t) type_flags::has_shared_from_this;
+         has_shared_from_this = t->flags & (uint32_t) type_flags::has_shared_from_this,
+         is_trivial_pickle = t->flags & (uint32_t) type_flags::is_trivial_pickle,
+         has_member_cache  = t->flags & (uint32_t) type_flags::has_member_cache,
+         is_hashable       = t->flags & (uint32_t) type_init_flags::is_hashable;
+
+    check(!(t->flags & (uint32_t) type_flags::no_identity) ||
+              !(t->flags & ((uint32_t) type_flags::is_trampoline |
+                            (uint32_t) type_flags::intrusive_ptr |
+                            (uint32_t) type_flags::has_shared_from_this)),
+          "nanobind::detail::nb_type_new(\"%s\"): nb::no_identity() cannot be "
+          "combined with trampolines, intrusive reference counting, or "
+          "std::enable_shared_from_this!", t->name);
 
     nb_internals &internals = internals_get();
     str name(t->name), qualname = name;
@@ -687,7 +1287,7 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
             PyUnicode_FromFormat("%U.%U", modname.ptr(), name.ptr()));
 
     constexpr size_t ptr_size = sizeof(void *);
-    size_t basicsize = sizeof(nb_inst) + t->size;
+    size_t basicsize = inst_header_size(t) + t->size;
     if (t->align > ptr_size)
         basicsize += t->align - ptr_size;
 
@@ -701,12 +1301,11 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
               "nanobind::detail::nb_type_new(\"%s\"): base type is not a "
               "nanobind type!", t->name);
     } else if (has_base) {
-        nb_type_map::iterator it =
-            internals.type_c2p.find(std::type_index(*t->base));
-        check(it != internals.type_c2p.end(),
+        type_data *td_base = nb_type_c2p(internals, t->base);
+        check(td_base,
                   "nanobind::detail::nb_type_new(\"%s\"): base type \"%s\" not "
                   "known to nanobind!", t->name, type_name(t->base));
-        base = (PyObject *) it->second->type_py;
+        base = (PyObject *) td_base->type_py;
     }
 
     type_data *tb = nullptr;
@@ -716,9 +1315,16 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
         if (tb->flags & (uint32_t) type_flags::has_dynamic_attr)
             has_dynamic_attr = true;
 
+        // The methods of the base would copy only part of the instance
+        check(is_trivial_pickle ||
+                  !(tb->flags & (uint32_t) type_flags::is_trivial_pickle),
+              "nanobind::detail::nb_type_new(\"%s\"): subclasses of types with "
+              "the nb::trivial_pickle() annotation must also specify it!",
+              t->name);
+
         /* Handle a corner case (base class larger than derived class)
            which can arise when extending trampoline base classes */
-        size_t base_basicsize = sizeof(nb_inst) + tb->size;
+        size_t base_basicsize = inst_header_size(tb) + tb->size;
         if (tb->align > ptr_size)
             base_basicsize += tb->align - ptr_size;
         if (base_basicsize > basicsize)
@@ -726,7 +1332,7 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
     }
     char *name_copy = NB_STRDUP(name.c_str());
 
-    constexpr size_t nb_type_max_slots = 10,
+    constexpr size_t nb_type_max_slots = 12,
                      nb_extra_slots = 80,
                      nb_total_slots = nb_type_max_slots +
                                       nb_extra_slots + 1;
@@ -751,6 +1357,11 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
     if (has_doc)
         *s++ = { Py_tp_doc, (void *) t->doc };
 
+    if (is_hashable) {
+        *s++ = { Py_tp_hash, (void *) t->hash };
+        *s++ = { Py_tp_richcompare, (void *) t->richcompare };
+    }
+
     if (has_type_slots) {
         size_t num_avail = nb_extra_slots;
         if (t->type_slots_callback) {
@@ -776,8 +1387,14 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
     for (PyType_Slot *ts = slots; ts != s; ++ts) {
         if (ts->slot == Py_tp_traverse)
             has_traverse = true;
+        check(!(is_trivial_pickle && ts->slot == Py_tp_methods),
+              "nanobind::detail::nb_type_new(\"%s\"): nb::trivial_pickle() "
+              "cannot be combined with a custom Py_tp_methods slot!", t->name);
     }
 
+    if (is_trivial_pickle)
+        *s++ = { Py_tp_methods, (void *) inst_trivial_pickle_methods };
+
     if (has_dynamic_attr) {
         // realign to sizeof(void*), add one pointer
         basicsize = (basicsize + ptr_size - 1) / ptr_size * ptr_size;
@@ -798,6 +1415,13 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
         spec.basicsize = (int) basicsize;
     }
 
+    // The member cache must be visible to the garbage collector
+    if (has_member_cache && !has_traverse) {
+        *s++ = { Py_tp_traverse, (void *) inst_traverse };
+        *s++ = { Py_tp_clear, (void *) inst_clear };
+        has_traverse = true;
+    }
+
     if (has_traverse && (!base || (PyType_GetFlags((PyTypeObject *) base) &
                                    Py_TPFLAGS_HAVE_GC) == 0))
         spec.flags |= Py_TPFLAGS_HAVE_GC;
@@ -815,6 +1439,14 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
               "failed: %s!", t->name, err.what());
     }
 
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX >= 0x03090000
+    /* Construct instances via nb_type_vectorcall() unless custom type slots
+       replaced the default __new__/__init__ implementations */
+    PyTypeObject *result_tp = (PyTypeObject *) result;
+    if (result_tp->tp_new == inst_new && result_tp->tp_init == inst_init)
+        result_tp->tp_vectorcall = nb_type_vectorcall;
+#endif
+
     type_data *to = nb_type_data((PyTypeObject *) result);
     *to = *t; // note: slices off _init parts
     to->flags &= ~(uint32_t) type_init_flags::all_init_flags;
@@ -823,8 +1455,12 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
         (tb->flags & (uint32_t) type_flags::intrusive_ptr)) {
         to->flags |= (uint32_t) type_flags::intrusive_ptr;
         to->set_self_py = tb->set_self_py;
+        to->get_self_py = tb->get_self_py;
     }
 
+    if ((to->flags & (uint32_t) type_flags::intrusive_ptr) && to->get_self_py)
+        internals.has_get_self_py.store(true, std::memory_order_relaxed);
+
     if (!has_shared_from_this && tb &&
         (tb->flags & (uint32_t) type_flags::has_shared_from_this)) {
         to->flags |= (uint32_t) type_flags::has_shared_from_this;
@@ -833,6 +1469,7 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
 
     to->name = name_copy;
     to->type_py = (PyTypeObject *) result;
+    to->overrides = nullptr;
 
     if (has_dynamic_attr) {
         to->flags |= (uint32_t) type_flags::has_dynamic_attr;
@@ -850,13 +1487,98 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
         setattr(result, "__module__", modname.ptr());
 
     // Update hash table that maps from std::type_info to Python type
-    auto [it, success] =
-        internals.type_c2p.try_emplace(std::type_index(*t->type), to);
-    if (!success)
-        fail("nanobind::detail::nb_type_new(\"%s\"): type was already "
-             "registered!", t->name);
+    {
+        lock_internals guard(internals);
+        auto [it, success] =
+            internals.type_c2p.try_emplace(std::type_index(*t->type), to);
+        if (!success)
+            fail("nanobind::detail::nb_type_new(\"%s\"): type was already "
+                 "registered!", t->name);
+        internals.type_c2p_fast[(void *) t->type] = to;
+    }
+
+    // Invalidate cached lookups that may have missed this type
+    nb_type_cache_invalidate(internals);
+
+    return result;
+}
 
+/// Called when a C++ type is bound via nb::class_<>
+PyObject *nb_type_new(const type_init_data *t) noexcept {
+#if defined(NB_PROFILE)
+    auto t0 = std::chrono::steady_clock::now();
+    PyObject *result = nb_type_new_impl(t);
+    nb_profile_import("class", t->scope, t->name, t0);
     return result;
+#else
+    return nb_type_new_impl(t);
+#endif
+}
+
+static void nb_scratch_dealloc(PyObject *self) {
+    nb_scratch *s = (nb_scratch *) self;
+    const type_data *t = s->type;
+
+    if (t && (t->flags & (uint32_t) type_flags::has_destruct))
+        t->destruct(s->value);
+
+    // The memory is reclaimed when the cleanup list rewinds its arena
+    Py_DECREF(Py_TYPE(self));
+}
+
+/// Allocate uninitialized storage for an instance of the type 't'
+static nb_scratch *nb_scratch_new(nb_internals &internals, const type_data *t,
+                                  cleanup_list *cleanup) noexcept {
+    PyTypeObject *tp = internals.nb_scratch;
+
+    if (NB_UNLIKELY(!tp)) {
+        PyType_Slot slots[] = {
+            { Py_tp_dealloc, (void *) nb_scratch_dealloc },
+            { 0, nullptr }
+        };
+
+        PyType_Spec spec = {
+            /* .name = */ "nanobind.nb_scratch",
+            /* .basicsize = */ (int) sizeof(nb_scratch),
+            /* .itemsize = */ 0,
+            /* .flags = */ Py_TPFLAGS_DEFAULT,
+            /* .slots = */ slots
+        };
+
+        tp = (PyTypeObject *) PyType_FromSpec(&spec);
+        check(tp, "nb_scratch type creation failed!");
+
+        PyTypeObject *tp_prev;
+        {
+            lock_internals guard(internals);
+            tp_prev = internals.nb_scratch;
+            if (!tp_prev)
+                internals.nb_scratch = tp;
+        }
+
+        // Another thread created the type concurrently
+        if (tp_prev) {
+            Py_DECREF(tp);
+            tp = tp_prev;
+        }
+    }
+
+    size_t align = (size_t) t->align,
+           size = sizeof(nb_scratch) + t->size;
+    if (align > sizeof(void *))
+        size += align - sizeof(void *);
+
+    nb_scratch *s = (nb_scratch *) cleanup->alloc(size);
+    if (!s)
+        return nullptr;
+    PyObject_Init((PyObject *) s, tp);
+
+    uintptr_t payload = (uintptr_t) (s + 1);
+    payload = (payload + align - 1) / align * align;
+    s->type = nullptr;
+    s->value = (void *) payload;
+
+    return s;
 }
 
 /// Encapsulates the implicit conversion part of nb_type_get()
@@ -876,13 +1598,37 @@ static NB_NOINLINE bool nb_type_get_implicit(PyObject *src,
 
         it = dst_type->implicit;
         while ((v = *it++)) {
-            auto it2 = internals.type_c2p.find(std::type_index(*v));
-            if (it2 != internals.type_c2p.end() &&
-                PyType_IsSubtype(Py_TYPE(src), it2->second->type_py))
+            type_data *td = nb_type_c2p(internals, v);
+            if (td && PyType_IsSubtype(Py_TYPE(src), td->type_py))
                 goto found;
         }
     }
 
+    if (dst_type->implicit_native) {
+        // Construct the instance in-place, bypassing the Python constructor
+        nb_scratch *s = nb_scratch_new(internals, dst_type, cleanup);
+        if (!s)
+            return false;
+
+        bool (**it)(PyObject *, void *) noexcept = dst_type->implicit_native;
+        bool (*v3)(PyObject *, void *) noexcept;
+
+        while ((v3 = *it++)) {
+            if (v3(src, s->value)) {
+                s->type = dst_type;
+                cleanup->append((PyObject *) s);
+                *out = s->value;
+#if defined(NB_PROFILE)
+                if (profile_current)
+                    profile_current->implicit_conversions++;
+#endif
+                return true;
+            }
+        }
+
+        Py_DECREF((PyObject *) s);
+    }
+
     if (dst_type->implicit_py) {
         bool (**it)(PyTypeObject *, PyObject *, cleanup_list *) noexcept =
             dst_type->implicit_py;
@@ -918,6 +1664,10 @@ found:
     if (result) {
         cleanup->append(result);
         *out = inst_ptr((nb_inst *) result);
+#if defined(NB_PROFILE)
+        if (profile_current)
+            profile_current->implicit_conversions++;
+#endif
         return true;
     } else {
         PyErr_Clear();
@@ -972,10 +1722,22 @@ bool nb_type_get(const std::type_info *cpp_type, PyObject *src, uint8_t flags,
 
         // If not, look up the Python type and check the inheritance chain
         if (!valid) {
-            auto it = internals.type_c2p.find(std::type_index(*cpp_type));
-            if (it != internals.type_c2p.end()) {
-                dst_type = it->second;
-                valid = PyType_IsSubtype(src_type, dst_type->type_py);
+            nb_cast_cache_entry &e = nb_cast_cache(internals)[
+                (((uintptr_t) src_type >> 4) ^ ((uintptr_t) cpp_type >> 3)) %
+                NB_CAST_CACHE_SIZE];
+
+            if (NB_LIKELY(e.src == src_type && e.dst == cpp_type)) {
+                dst_type = e.dst_type;
+                valid = e.valid;
+            } else {
+                dst_type = nb_type_c2p(internals, cpp_type);
+                if (dst_type)
+                    valid = PyType_IsSubtype(src_type, dst_type->type_py);
+
+                e.src = src_type;
+                e.dst = cpp_type;
+                e.dst_type = dst_type;
+                e.valid = valid;
             }
         }
 
@@ -1000,11 +1762,8 @@ bool nb_type_get(const std::type_info *cpp_type, PyObject *src, uint8_t flags,
 
     // Try an implicit conversion as last resort (if possible & requested)
     if ((flags & (uint16_t) cast_flags::convert) && cleanup) {
-        if (!src_is_nb_type) {
-            auto it = internals.type_c2p.find(std::type_index(*cpp_type));
-            if (it != internals.type_c2p.end())
-                dst_type = it->second;
-        }
+        if (!src_is_nb_type)
+            dst_type = nb_type_c2p(internals, cpp_type);
 
         if (dst_type &&
             (dst_type->flags & (uint32_t) type_flags::has_implicit_conversions))
@@ -1035,8 +1794,23 @@ void keep_alive(PyObject *nurse, PyObject *patient) {
         return;
 
     if (nb_type_check((PyObject *) Py_TYPE(nurse))) {
-        nb_weakref_seq **pp =
-            (nb_weakref_seq **) &internals_get().keep_alive[nurse];
+        nb_shard &shard = internals_get().shard(nurse);
+        lock_shard guard(shard);
+
+        const type_data *t = nb_type_data(Py_TYPE(nurse));
+        if (t->flags & (uint32_t) type_flags::has_inline_keep_alive) {
+            PyObject *&slot = *inst_keep_alive_slot((nb_inst *) nurse);
+            if (slot == patient)
+                return;
+
+            if (!slot) {
+                Py_INCREF(patient);
+                slot = patient;
+                return;
+            }
+        }
+
+        nb_weakref_seq **pp = (nb_weakref_seq **) &shard.keep_alive[nurse];
 
         do {
             nb_weakref_seq *p = *pp;
@@ -1083,8 +1857,11 @@ void keep_alive(PyObject *nurse, void *payload,
     check(nurse, "nanobind::detail::keep_alive(): 'nurse' is undefined!");
 
     if (nb_type_check((PyObject *) Py_TYPE(nurse))) {
+        nb_shard &shard = internals_get().shard(nurse);
+        lock_shard guard(shard);
+
         nb_weakref_seq
-            **pp = (nb_weakref_seq **) &internals_get().keep_alive[nurse],
+            **pp = (nb_weakref_seq **) &shard.keep_alive[nurse],
             *s   = (nb_weakref_seq *) PyObject_Malloc(sizeof(nb_weakref_seq));
         check(s, "nanobind::detail::keep_alive(): out of memory!");
 
@@ -1101,6 +1878,29 @@ void keep_alive(PyObject *nurse, void *payload,
     }
 }
 
+void *keep_alive_payload(PyObject *nurse,
+                         void (*callback)(void *) noexcept) noexcept {
+#if !defined(NB_FREE_THREADED)
+    // Skip the lookup if the instance never held any references
+    if (!((nb_inst *) nurse)->clear_keep_alive)
+        return nullptr;
+#endif
+
+    nb_shard &shard = internals_get().shard(nurse);
+    lock_shard guard(shard);
+
+    nb_ptr_map::iterator it = shard.keep_alive.find(nurse);
+    if (it == shard.keep_alive.end())
+        return nullptr;
+
+    for (nb_weakref_seq *p = (nb_weakref_seq *) it->second; p; p = p->next) {
+        if (p->callback == callback)
+            return p->payload;
+    }
+
+    return nullptr;
+}
+
 static PyObject *nb_type_put_common(void *value, type_data *t, rv_policy rvp,
                                     cleanup_list *cleanup,
                                     bool *is_new) noexcept {
@@ -1176,6 +1976,9 @@ static PyObject *nb_type_put_common(void *value, type_data *t, rv_policy rvp,
     inst->cpp_delete = rvp == rv_policy::take_ownership;
     inst->ready = true;
 
+    if (inst->cpp_delete)
+        trace_alloc(new_value, t->size);
+
     if (rvp == rv_policy::reference_internal)
         keep_alive((PyObject *) inst, cleanup->self());
 
@@ -1185,6 +1988,128 @@ static PyObject *nb_type_put_common(void *value, type_data *t, rv_policy rvp,
     return (PyObject *) inst;
 }
 
+/**
+ * Instances of types with an nb::intrusive_ptr 'get_self_py' callback store
+ * a pointer to their Python object, which makes the 'inst_c2p' lookup
+ * unnecessary. Returns 'false' if the regular lookup should be performed.
+ * Otherwise, '*out' receives a new reference to the existing Python object,
+ * or 'nullptr' if a new one must be created.
+ */
+static bool nb_type_put_intrusive(type_data *td, void *value, rv_policy rvp,
+                                  PyObject **out) noexcept {
+    if (!(td->flags & (uint32_t) type_flags::intrusive_ptr) || !td->get_self_py)
+        return false;
+
+    PyObject *o = td->get_self_py(value);
+    if (!o) {
+        // rv_policy::none only returns existing instances (handled by the caller)
+        if (rvp == rv_policy::none)
+            return false;
+        *out = nullptr;
+        return true;
+    }
+
+    // The instance may be in the process of being destroyed
+    if (!nb_try_inc_ref(o))
+        return false;
+
+    *out = o;
+    return true;
+}
+
+/// Maximum number of wrappers cached by an instance with 'has_member_cache'
+static constexpr Py_ssize_t nb_member_cache_max = 32;
+
+/// Return the 'self' argument if it caches reference_internal results
+static NB_INLINE PyObject *nb_member_cache_owner(rv_policy rvp,
+                                                 cleanup_list *cleanup) {
+    if (NB_LIKELY(rvp != rv_policy::reference_internal) || !cleanup)
+        return nullptr;
+
+    PyObject *self = cleanup->self();
+    if (!self || !nb_type_check((PyObject *) Py_TYPE(self)) ||
+        !(nb_type_data(Py_TYPE(self))->flags &
+          (uint32_t) type_flags::has_member_cache))
+        return nullptr;
+
+    return self;
+}
+
+/**
+ * Return a wrapper of the member 'value' of 'owner' with reference_internal
+ * semantics. Newly created wrappers are stored in the member cache of
+ * 'owner' if they keep 'owner' alive via an inline keep_alive slot that is
+ * visited by inst_traverse(), which makes the resulting reference cycle
+ * visible to the garbage collector.
+ */
+static PyObject *nb_type_put_cached(const std::type_info *cpp_type,
+                                    const std::type_info *cpp_type_p,
+                                    void *value, PyObject *owner,
+                                    bool *is_new) noexcept {
+    const type_data *t = nb_type_data(Py_TYPE(owner));
+    PyObject *&cache = *inst_member_cache_slot((nb_inst *) owner, t);
+    nb_shard &shard = internals_get().shard(owner);
+
+    if (cache) {
+        lock_shard guard(shard);
+        Py_ssize_t size = NB_LIST_GET_SIZE(cache);
+        for (Py_ssize_t i = 0; i < size; ++i) {
+            PyObject *o = NB_LIST_GET_ITEM(cache, i);
+            if (inst_ptr((nb_inst *) o) != value)
+                continue;
+
+            const std::type_info *p = nb_type_data(Py_TYPE(o))->type;
+            if (p == cpp_type || p == cpp_type_p) {
+                Py_INCREF(o);
+                return o;
+            }
+        }
+    }
+
+    bool created = false;
+    PyObject *o =
+        cpp_type_p
+            ? nb_type_put_p(cpp_type, cpp_type_p, value, rv_policy::reference,
+                            nullptr, &created)
+            : nb_type_put(cpp_type, value, rv_policy::reference, nullptr,
+                          &created);
+    if (is_new)
+        *is_new = created;
+
+    // Existing instances are returned as with reference_internal
+    if (!o || !created)
+        return o;
+
+    keep_alive(o, owner);
+
+    PyTypeObject *tp = Py_TYPE(o);
+    if (!(nb_type_data(tp)->flags &
+          (uint32_t) type_flags::has_inline_keep_alive) ||
+        (traverseproc) PyType_GetSlot(tp, Py_tp_traverse) != inst_traverse)
+        return o;
+
+    if (!cache) {
+        PyObject *list = PyList_New(0);
+        if (!list) {
+            PyErr_Clear();
+            return o;
+        }
+
+        lock_shard guard(shard);
+        if (!cache)
+            cache = list;
+        else
+            Py_DECREF(list);
+    }
+
+    lock_shard guard(shard);
+    if (NB_LIST_GET_SIZE(cache) < nb_member_cache_max &&
+        PyList_Append(cache, o))
+        PyErr_Clear();
+
+    return o;
+}
+
 PyObject *nb_type_put(const std::type_info *cpp_type,
                       void *value, rv_policy rvp,
                       cleanup_list *cleanup,
@@ -1195,26 +2120,36 @@ PyObject *nb_type_put(const std::type_info *cpp_type,
         return Py_None;
     }
 
+    PyObject *owner = nb_member_cache_owner(rvp, cleanup);
+    if (NB_UNLIKELY(owner))
+        return nb_type_put_cached(cpp_type, nullptr, value, owner, is_new);
+
     nb_internals &internals = internals_get();
-    nb_ptr_map &inst_c2p = internals.inst_c2p;
-    nb_type_map &type_map = internals.type_c2p;
     type_data *td = nullptr;
 
-    auto lookup_type = [cpp_type, &td, &type_map]() -> bool {
+    auto lookup_type = [cpp_type, &td, &internals]() -> bool {
         if (!td) {
-            nb_type_map::iterator it =
-                type_map.find(std::type_index(*cpp_type));
-
-            if (it == type_map.end())
+            td = nb_type_c2p(internals, cpp_type);
+            if (!td)
                 return false;
-
-            td = it->second;
         }
 
         return true;
     };
 
+    if (rvp != rv_policy::copy &&
+        NB_UNLIKELY(internals.has_get_self_py.load(std::memory_order_relaxed)) &&
+        lookup_type()) {
+        PyObject *o;
+        if (nb_type_put_intrusive(td, value, rvp, &o))
+            return o ? o : nb_type_put_common(value, td, rvp, cleanup, is_new);
+    }
+
     if (rvp != rv_policy::copy) {
+        nb_shard &shard = internals.shard(value);
+        lock_shard guard(shard);
+        nb_ptr_map &inst_c2p = shard.inst_c2p;
+
         // Check if the instance is already registered with nanobind
         nb_ptr_map::iterator it = inst_c2p.find(value);
 
@@ -1232,18 +2167,16 @@ PyObject *nb_type_put(const std::type_info *cpp_type,
             while (true) {
                 PyTypeObject *tp = Py_TYPE(seq.inst);
 
-                if (nb_type_data(tp)->type == cpp_type) {
-                    Py_INCREF(seq.inst);
+                if (nb_type_data(tp)->type == cpp_type &&
+                    nb_try_inc_ref(seq.inst))
                     return seq.inst;
-                }
 
                 if (!lookup_type())
                     return nullptr;
 
-                if (PyType_IsSubtype(tp, td->type_py)) {
-                    Py_INCREF(seq.inst);
+                if (PyType_IsSubtype(tp, td->type_py) &&
+                    nb_try_inc_ref(seq.inst))
                     return seq.inst;
-                }
 
                 if (seq.next == nullptr)
                     break;
@@ -1273,37 +2206,45 @@ PyObject *nb_type_put_p(const std::type_info *cpp_type,
         return Py_None;
     }
 
+    PyObject *owner = nb_member_cache_owner(rvp, cleanup);
+    if (NB_UNLIKELY(owner))
+        return nb_type_put_cached(cpp_type, cpp_type_p ? cpp_type_p : cpp_type,
+                                  value, owner, is_new);
+
     // Check if the instance is already registered with nanobind
     nb_internals &internals = internals_get();
-    nb_ptr_map &inst_c2p = internals.inst_c2p;
-    nb_type_map &type_map = internals.type_c2p;
 
     // Look up the corresponding Python type
     type_data *td = nullptr,
               *td_p = nullptr;
 
-    auto lookup_type = [cpp_type, cpp_type_p, &td, &td_p, &type_map]() -> bool {
+    auto lookup_type = [cpp_type, cpp_type_p, &td, &td_p, &internals]() -> bool {
         if (!td) {
-            nb_type_map::iterator it =
-                type_map.find(std::type_index(*cpp_type));
-
-            if (it == type_map.end())
+            td = nb_type_c2p(internals, cpp_type);
+            if (!td)
                 return false;
 
-            td = it->second;
-
-            if (cpp_type_p && cpp_type_p != cpp_type) {
-                it = type_map.find(std::type_index(*cpp_type_p));
-
-                if (it != type_map.end())
-                    td_p = it->second;
-            }
+            if (cpp_type_p && cpp_type_p != cpp_type)
+                td_p = nb_type_c2p(internals, cpp_type_p);
         }
 
         return true;
     };
 
+    if (rvp != rv_policy::copy &&
+        NB_UNLIKELY(internals.has_get_self_py.load(std::memory_order_relaxed)) &&
+        lookup_type()) {
+        PyObject *o;
+        if (nb_type_put_intrusive(td, value, rvp, &o))
+            return o ? o : nb_type_put_common(value, td_p ? td_p : td, rvp,
+                                              cleanup, is_new);
+    }
+
     if (rvp != rv_policy::copy) {
+        nb_shard &shard = internals.shard(value);
+        lock_shard guard(shard);
+        nb_ptr_map &inst_c2p = shard.inst_c2p;
+
         // Check if the instance is already registered with nanobind
         nb_ptr_map::iterator it = inst_c2p.find(value);
 
@@ -1323,19 +2264,17 @@ PyObject *nb_type_put_p(const std::type_info *cpp_type,
 
                 const std::type_info *p = nb_type_data(tp)->type;
 
-                if (p == cpp_type || p == cpp_type_p) {
-                    Py_INCREF(seq.inst);
+                if ((p == cpp_type || p == cpp_type_p) &&
+                    nb_try_inc_ref(seq.inst))
                     return seq.inst;
-                }
 
                 if (!lookup_type())
                     return nullptr;
 
-                if (PyType_IsSubtype(tp, td->type_py) ||
-                    (td_p && PyType_IsSubtype(tp, td_p->type_py))) {
-                    Py_INCREF(seq.inst);
+                if ((PyType_IsSubtype(tp, td->type_py) ||
+                     (td_p && PyType_IsSubtype(tp, td_p->type_py))) &&
+                    nb_try_inc_ref(seq.inst))
                     return seq.inst;
-                }
 
                 if (seq.next == nullptr)
                     break;
@@ -1354,6 +2293,93 @@ PyObject *nb_type_put_p(const std::type_info *cpp_type,
     return nb_type_put_common(value, td_p ? td_p : td, rvp, cleanup, is_new);
 }
 
+/// Return a new reference to an existing instance of 'td' (or a subclass) at 'value'
+static PyObject *nb_type_find(nb_internals &internals, type_data *td,
+                              void *value) noexcept {
+    nb_shard &shard = internals.shard(value);
+    lock_shard guard(shard);
+    nb_ptr_map::iterator it = shard.inst_c2p.find(value);
+
+    if (it == shard.inst_c2p.end())
+        return nullptr;
+
+    void *entry = it->second;
+    nb_inst_seq seq;
+
+    if (NB_UNLIKELY(nb_is_seq(entry))) {
+        seq = *nb_get_seq(entry);
+    } else {
+        seq.inst = (PyObject *) entry;
+        seq.next = nullptr;
+    }
+
+    while (true) {
+        PyTypeObject *tp = Py_TYPE(seq.inst);
+
+        if ((tp == td->type_py || PyType_IsSubtype(tp, td->type_py)) &&
+            nb_try_inc_ref(seq.inst))
+            return seq.inst;
+
+        if (seq.next == nullptr)
+            break;
+
+        seq = *seq.next;
+    }
+
+    return nullptr;
+}
+
+PyObject *nb_type_put_seq(const std::type_info *cpp_type, void *value,
+                          size_t stride, size_t size, rv_policy rvp,
+                          cleanup_list *cleanup) noexcept {
+    nb_internals &internals = internals_get();
+
+    // A single type lookup for all elements
+    type_data *td = nb_type_c2p(internals, cpp_type);
+    if (!td)
+        return nullptr;
+
+    PyObject *list = PyList_New((Py_ssize_t) size);
+    if (!list)
+        return nullptr;
+
+    // Intrusive reference counting requires the general code path
+    const bool generic = (td->flags & (uint32_t) type_flags::intrusive_ptr) ||
+                         (rvp != rv_policy::copy && rvp != rv_policy::move);
+
+#if !defined(NB_FREE_THREADED)
+    // Pre-size the instance map to avoid repeated rehashing
+    if (!generic && !(td->flags & (uint32_t) type_flags::no_identity)) {
+        nb_ptr_map &inst_c2p = internals.shard(value).inst_c2p;
+        inst_c2p.reserve(inst_c2p.size() + size);
+    }
+#endif
+
+    uint8_t *p = (uint8_t *) value;
+    for (size_t i = 0; i < size; ++i, p += stride) {
+        PyObject *o = nullptr;
+
+        if (NB_UNLIKELY(generic)) {
+            o = nb_type_put(cpp_type, p, rvp, cleanup, nullptr);
+        } else {
+            // As in nb_type_put(), moved instances may already have a wrapper
+            if (rvp == rv_policy::move)
+                o = nb_type_find(internals, td, p);
+            if (!o)
+                o = nb_type_put_common(p, td, rvp, cleanup, nullptr);
+        }
+
+        if (!o) {
+            Py_DECREF(list);
+            return nullptr;
+        }
+
+        NB_LIST_SET_ITEM(list, (Py_ssize_t) i, o);
+    }
+
+    return list;
+}
+
 static void nb_type_put_unique_finalize(PyObject *o,
                                         const std::type_info *cpp_type,
                                         bool cpp_delete, bool is_new) {
@@ -1373,6 +2399,9 @@ static void nb_type_put_unique_finalize(PyObject *o,
               type_name(cpp_type), cpp_delete, inst->ready, inst->destruct,
               inst->cpp_delete);
 
+        if (!is_new)
+            trace_alloc(inst_ptr(inst), nb_type_data(Py_TYPE(o))->size);
+
         inst->ready = inst->destruct = inst->cpp_delete = true;
     } else {
         check(!inst->ready,
@@ -1439,6 +2468,7 @@ void nb_type_relinquish_ownership(PyObject *o, bool cpp_delete) {
             throw next_overload();
         }
 
+        trace_free(inst_ptr(inst));
         inst->cpp_delete = false;
         inst->destruct = false;
     }
@@ -1447,31 +2477,25 @@ void nb_type_relinquish_ownership(PyObject *o, bool cpp_delete) {
 }
 
 bool nb_type_isinstance(PyObject *o, const std::type_info *t) noexcept {
-    nb_internals &internals = internals_get();
-    auto it = internals.type_c2p.find(std::type_index(*t));
-    if (it == internals.type_c2p.end())
+    type_data *td = nb_type_c2p(internals_get(), t);
+    if (!td)
         return false;
-    return PyType_IsSubtype(Py_TYPE(o), it->second->type_py);
+    return PyType_IsSubtype(Py_TYPE(o), td->type_py);
 }
 
 PyObject *nb_type_lookup(const std::type_info *t) noexcept {
-    nb_internals &internals = internals_get();
-    auto it = internals.type_c2p.find(std::type_index(*t));
-    if (it != internals.type_c2p.end())
-        return (PyObject *) it->second->type_py;
+    type_data *td = nb_type_c2p(internals_get(), t);
+    if (td)
+        return (PyObject *) td->type_py;
     return nullptr;
 }
 
-static PyTypeObject *nb_meta_cache = nullptr;
-
 bool nb_type_check(PyObject *t) noexcept {
-    if (NB_UNLIKELY(!nb_meta_cache))
-        nb_meta_cache = internals_get().nb_meta;
-
+    // The metaclass is specific to each interpreter, don't cache it here
     PyTypeObject *meta  = Py_TYPE(t),
                  *meta2 = Py_TYPE((PyObject *) meta);
 
-    return meta2 == nb_meta_cache;
+    return meta2 == internals_get().nb_meta;
 }
 
 size_t nb_type_size(PyObject *t) noexcept {
@@ -1497,6 +2521,24 @@ PyObject *nb_inst_alloc(PyTypeObject *t) {
     return result;
 }
 
+PyObject *nb_inst_alloc_inplace(const std::type_info *t,
+                                void **storage) noexcept {
+    type_data *td = nb_type_c2p(internals_get(), t);
+
+    // Intrusively reference-counted types must be notified of their instance
+    if (!td || (td->flags & (uint32_t) type_flags::intrusive_ptr))
+        return nullptr;
+
+    PyObject *result = inst_new_impl(td->type_py, nullptr);
+    if (!result) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    *storage = inst_ptr((nb_inst *) result);
+    return result;
+}
+
 PyObject *nb_inst_wrap(PyTypeObject *t, void *ptr) {
     PyObject *result = inst_new_impl(t, ptr);
     if (!result)
@@ -1517,9 +2559,17 @@ void nb_inst_zero(PyObject *o) noexcept {
 
 void nb_inst_set_state(PyObject *o, bool ready, bool destruct) noexcept {
     nb_inst *nbi = (nb_inst *) o;
+    bool cpp_delete = destruct && !nbi->internal;
+    if (cpp_delete != (bool) nbi->cpp_delete) {
+        if (cpp_delete)
+            trace_alloc(inst_ptr(nbi), nb_type_data(Py_TYPE(o))->size);
+        else
+            trace_free(inst_ptr(nbi));
+    }
+
     nbi->ready = ready;
     nbi->destruct = destruct;
-    nbi->cpp_delete = destruct && !nbi->internal;
+    nbi->cpp_delete = cpp_delete;
 }
 
 std::pair<bool, bool> nb_inst_state(PyObject *o) noexcept {
@@ -1527,6 +2577,25 @@ std::pair<bool, bool> nb_inst_state(PyObject *o) noexcept {
     return { (bool) nbi->ready, (bool) nbi->destruct };
 }
 
+bool nb_inst_export(PyObject *o) noexcept {
+    nb_inst *nbi = (nb_inst *) o;
+    if (nbi->exports == UINT16_MAX) {
+        PyErr_SetString(PyExc_BufferError, "Too many buffers reference the "
+                                           "contents of this instance!");
+        return false;
+    }
+    nbi->exports++;
+    return true;
+}
+
+void nb_inst_unexport(PyObject *o) noexcept {
+    ((nb_inst *) o)->exports--;
+}
+
+size_t nb_inst_exports(PyObject *o) noexcept {
+    return ((nb_inst *) o)->exports;
+}
+
 void nb_inst_destruct(PyObject *o) noexcept {
     nb_inst *nbi = (nb_inst *) o;
     type_data *t = nb_type_data(Py_TYPE(o));
@@ -1587,12 +2656,7 @@ void nb_inst_move(PyObject *dst, const PyObject *src) noexcept {
 }
 
 #if defined(Py_LIMITED_API)
-static size_t type_basicsize = 0;
-type_data *nb_type_data_static(PyTypeObject *o) noexcept {
-    if (type_basicsize == 0)
-        type_basicsize = cast<size_t>(handle(&PyType_Type).attr("__basicsize__"));
-    return (type_data *) (((char *) o) + type_basicsize);
-}
+size_t nb_type_data_offset = 0;
 #endif
 
 /// Fetch the name of an instance as 'char *' (must be deallocated using 'free'!)
@@ -1616,5 +2680,147 @@ bool nb_inst_python_derived(PyObject *o) noexcept {
            (uint32_t) type_flags::is_python_type;
 }
 
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+/// Special methods whose type slots can be implemented by operators.h
+static const struct {
+    const char *name;
+    int slot, op;
+} op_slot_names[] = {
+    { "__add__", Py_nb_add, 0 },
+    { "__sub__", Py_nb_subtract, 0 },
+    { "__mul__", Py_nb_multiply, 0 },
+    { "__truediv__", Py_nb_true_divide, 0 },
+    { "__mod__", Py_nb_remainder, 0 },
+    { "__lshift__", Py_nb_lshift, 0 },
+    { "__rshift__", Py_nb_rshift, 0 },
+    { "__and__", Py_nb_and, 0 },
+    { "__xor__", Py_nb_xor, 0 },
+    { "__or__", Py_nb_or, 0 },
+    { "__iadd__", Py_nb_inplace_add, 0 },
+    { "__isub__", Py_nb_inplace_subtract, 0 },
+    { "__imul__", Py_nb_inplace_multiply, 0 },
+    { "__itruediv__", Py_nb_inplace_true_divide, 0 },
+    { "__imod__", Py_nb_inplace_remainder, 0 },
+    { "__ilshift__", Py_nb_inplace_lshift, 0 },
+    { "__irshift__", Py_nb_inplace_rshift, 0 },
+    { "__iand__", Py_nb_inplace_and, 0 },
+    { "__ixor__", Py_nb_inplace_xor, 0 },
+    { "__ior__", Py_nb_inplace_or, 0 },
+    { "__neg__", Py_nb_negative, 0 },
+    { "__pos__", Py_nb_positive, 0 },
+    { "__invert__", Py_nb_invert, 0 },
+    { "__abs__", Py_nb_absolute, 0 },
+    { "__bool__", Py_nb_bool, 0 },
+    { "__lt__", Py_tp_richcompare, Py_LT },
+    { "__le__", Py_tp_richcompare, Py_LE },
+    { "__eq__", Py_tp_richcompare, Py_EQ },
+    { "__ne__", Py_tp_richcompare, Py_NE },
+    { "__gt__", Py_tp_richcompare, Py_GT },
+    { "__ge__", Py_tp_richcompare, Py_GE }
+};
+
+static void **op_slot_field(PyTypeObject *tp, int slot) noexcept {
+    PyNumberMethods *nb = tp->tp_as_number;
+
+    switch (slot) {
+        case Py_nb_add: return (void **) &nb->nb_add;
+        case Py_nb_subtract: return (void **) &nb->nb_subtract;
+        case Py_nb_multiply: return (void **) &nb->nb_multiply;
+        case Py_nb_true_divide: return (void **) &nb->nb_true_divide;
+        case Py_nb_remainder: return (void **) &nb->nb_remainder;
+        case Py_nb_lshift: return (void **) &nb->nb_lshift;
+        case Py_nb_rshift: return (void **) &nb->nb_rshift;
+        case Py_nb_and: return (void **) &nb->nb_and;
+        case Py_nb_xor: return (void **) &nb->nb_xor;
+        case Py_nb_or: return (void **) &nb->nb_or;
+        case Py_nb_inplace_add: return (void **) &nb->nb_inplace_add;
+        case Py_nb_inplace_subtract: return (void **) &nb->nb_inplace_subtract;
+        case Py_nb_inplace_multiply: return (void **) &nb->nb_inplace_multiply;
+        case Py_nb_inplace_true_divide: return (void **) &nb->nb_inplace_true_divide;
+        case Py_nb_inplace_remainder: return (void **) &nb->nb_inplace_remainder;
+        case Py_nb_inplace_lshift: return (void **) &nb->nb_inplace_lshift;
+        case Py_nb_inplace_rshift: return (void **) &nb->nb_inplace_rshift;
+        case Py_nb_inplace_and: return (void **) &nb->nb_inplace_and;
+        case Py_nb_inplace_xor: return (void **) &nb->nb_inplace_xor;
+        case Py_nb_inplace_or: return (void **) &nb->nb_inplace_or;
+        case Py_nb_negative: return (void **) &nb->nb_negative;
+        case Py_nb_positive: return (void **) &nb->nb_positive;
+        case Py_nb_invert: return (void **) &nb->nb_invert;
+        case Py_nb_absolute: return (void **) &nb->nb_absolute;
+        case Py_nb_bool: return (void **) &nb->nb_bool;
+        case Py_tp_richcompare: return (void **) &tp->tp_richcompare;
+        default: return nullptr;
+    }
+}
+
+/// Install the slot function 'impl' and remember the previous one
+static void op_slot_set(void **field, void *impl, void **fallback) noexcept {
+    if (*field == impl || !*field)
+        return;
+    *fallback = *field;
+    *field = impl;
+}
+#endif
+
+void type_set_op_slots(PyObject *type, const op_slot_info *info) noexcept {
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+    nb_internals &internals = internals_get();
+    lock_internals guard(internals);
+    internals.op_slots[info->func] = (void *) info;
+
+    /* Setting a special method resets the associated type slot to a generic
+       implementation that looks up and calls it. Check which special methods
+       of this type start their overload chain with an operator that has a
+       direct slot implementation, and (re-)install those. */
+    PyTypeObject *tp = (PyTypeObject *) type;
+    const op_slot_info *compare[6] { };
+    bool has_compare = false;
+
+    for (const auto &s : op_slot_names) {
+        PyObject *func = PyDict_GetItemString(tp->tp_dict, s.name);
+        if (!func || Py_TYPE(func) != internals.nb_method)
+            continue;
+
+        func_data *f = nb_func_data(func);
+        if (!(f->flags & (uint32_t) func_flags::is_operator))
+            continue;
+
+        nb_ptr_map::iterator it = internals.op_slots.find(f->capture[0]);
+        if (it == internals.op_slots.end())
+            continue;
+
+        const op_slot_info *match = (const op_slot_info *) it->second;
+        if (match->slot != s.slot || match->op != s.op)
+            continue;
+
+        if (s.slot == Py_tp_richcompare) {
+            compare[s.op] = match;
+            has_compare = true;
+        } else {
+            op_slot_set(op_slot_field(tp, s.slot), match->impl,
+                        match->fallback);
+        }
+    }
+
+    if (has_compare) {
+        // All comparisons of a type share one slot and a table of operators
+        void **table = nullptr;
+        for (const op_slot_info *c : compare) {
+            if (c && !table) {
+                table = c->table;
+                op_slot_set(op_slot_field(tp, Py_tp_richcompare), c->impl,
+                            c->fallback);
+            }
+        }
+
+        for (int i = 0; i < 6; ++i)
+            table[i] = compare[i] && compare[i]->table == table
+                           ? compare[i]->entry : nullptr;
+    }
+#else
+    (void) type; (void) info;
+#endif
+}
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
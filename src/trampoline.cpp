@@ -13,74 +13,198 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
-void trampoline_new(void **data, size_t size, void *ptr) noexcept {
-    // GIL is held when the trampoline constructor runs
-    nb_ptr_map &inst_c2p = internals_get().inst_c2p;
-    nb_ptr_map::iterator it = inst_c2p.find(ptr);
-    check(it != inst_c2p.end() && (((uintptr_t) it->second) & 1) == 0,
-          "nanobind::detail::trampoline_new(): unique instance not found!");
+/**
+ * Python method overrides are cached per Python type in a small open
+ * addressing hash table that is keyed on the address of the method name.
+ * Instances of the type share this table, which means that the trampoline of
+ * an instance only needs to store a pointer to the Python object.
+ *
+ * Readers don't acquire any locks: a table is immutable except for the
+ * insertion of new entries, whose names are published last. Tables are
+ * replaced when they need to grow or when they were marked stale because an
+ * attribute of the type or one of its bases was modified (see
+ * nb_override_invalidate()). Readers may hold on to a replaced table and to
+ * the borrowed method names stored in it for an unknown amount of time,
+ * hence replaced tables are only released along with the type. Only
+ * modifications of attributes named like a cached method mark a table as
+ * stale, which keeps this from accumulating garbage during ordinary use.
+ */
+struct override_entry {
+    std::atomic<const char *> name;
+    /// Interned method name if overridden in Python, otherwise nullptr
+    PyObject *value;
+    /// Borrowed overriding function, valid while the type has version 'tag'
+    PyObject *func;
+    unsigned int tag;
+};
+
+/* Overrides implemented by plain Python functions are called directly with
+   'self' prepended to the arguments, which avoids looking up the method on
+   every call. CPython changes the version tag of a type whenever the type or
+   one of its bases is modified, which invalidates the borrowed function. */
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION) && \
+    !defined(NB_FREE_THREADED)
+#  define NB_OVERRIDE_DIRECT
 
-    data[0] = it->second;
-    memset(data + 1, 0, sizeof(void *) * 2 * size);
+/// Current version tag of 'tp', or zero if it has none
+static NB_INLINE unsigned int override_tag(PyTypeObject *tp) {
+#if PY_VERSION_HEX < 0x030B0000
+    // Before Python 3.11, PyType_Modified() only clears this flag
+    if (!PyType_HasFeature(tp, Py_TPFLAGS_VALID_VERSION_TAG))
+        return 0;
+#endif
+    return tp->tp_version_tag;
 }
+#endif
+
+struct override_table {
+    std::atomic<bool> stale;
+    size_t mask;
+    size_t size;
+    override_table *retired;
+    override_entry entries[1];
+};
 
-void trampoline_release(void **data, size_t size) noexcept {
-    // GIL is held when the trampoline destructor runs
-    for (size_t i = 0; i < size; ++i)
-        Py_XDECREF((PyObject *) data[i*2 + 2]);
+static_assert(sizeof(std::atomic<void *>) == sizeof(void *),
+              "nanobind: unsupported atomic pointer representation!");
+
+static std::atomic<override_table *> &override_ref(type_data *t) {
+    return *(std::atomic<override_table *> *) &t->overrides;
 }
 
-PyObject *trampoline_lookup(void **data, size_t size, const char *name,
-                            bool pure) {
-    const PyObject *None = Py_None;
+NB_INLINE size_t override_hash(const char *name) {
+    uintptr_t h = (uintptr_t) name;
+    h ^= h >> 4;
+    h *= (uintptr_t) 0x9E3779B97F4A7C15ull;
+    return (size_t) (h ^ (h >> 16));
+}
 
-    current_method cm = current_method_data;
-    if (cm.self == data[0] && (cm.name == name || strcmp(cm.name, name) == 0)) {
-        if (pure)
-            raise("nanobind::detail::get_trampoline('%s()'): tried to call a "
-                  "pure virtual function!", name);
-        return nullptr;
+static override_entry *override_find(override_table *table,
+                                     const char *name) {
+    size_t i = override_hash(name) & table->mask;
+    while (true) {
+        override_entry *e = table->entries + i;
+        const char *e_name = e->name.load(std::memory_order_acquire);
+        if (e_name == name)
+            return e;
+        else if (!e_name)
+            return nullptr;
+        i = (i + 1) & table->mask;
     }
+}
+
+static override_table *override_alloc(size_t capacity) {
+    override_table *table = (override_table *) calloc(
+        1, sizeof(override_table) + sizeof(override_entry) * (capacity - 1));
+    check(table, "nanobind::detail::override_alloc(): out of memory!");
+    table->mask = capacity - 1;
+    return table;
+}
+
+static void override_insert(override_table *table, const char *name,
+                            PyObject *value) {
+    size_t i = override_hash(name) & table->mask;
+    while (table->entries[i].name.load(std::memory_order_relaxed))
+        i = (i + 1) & table->mask;
 
-    // First quick sweep without lock
-    for (size_t i = 0; i < size; i++) {
-        void *d_name  = data[2*i + 1],
-             *d_value = data[2*i + 2];
-        if (name == d_name && d_value)
-            return d_value != None ? (PyObject *) d_value : nullptr;
+    Py_XINCREF(value);
+    table->entries[i].value = value;
+    table->entries[i].name.store(name, std::memory_order_release);
+    table->size++;
+}
+
+/// Release 'table' and the tables it replaced
+static void override_free_chain(override_table *table) noexcept {
+    while (table) {
+        for (size_t i = 0; i <= table->mask; ++i)
+            Py_XDECREF(table->entries[i].value);
+        override_table *next = table->retired;
+        free(table);
+        table = next;
     }
+}
 
-    PyGILState_STATE state = PyGILState_Ensure();
+void nb_override_free(type_data *t) noexcept {
+    override_free_chain(override_ref(t).load(std::memory_order_relaxed));
+    t->overrides = nullptr;
+}
 
-    // Nothing found -- retry, now with lock held
-    for (size_t i = 0; i < size; i++) {
-        void *d_name  = data[2*i + 1],
-             *d_value = data[2*i + 2];
-        if (name == d_name && d_value) {
-            PyGILState_Release(state);
-            return d_value != None ? (PyObject *) d_value : nullptr;
-        }
+/// Does 'table' store an entry for the method 'name' (or any if nullptr)?
+static bool override_caches(override_table *table, const char *name) {
+    if (!name)
+        return table->size > 0;
+
+    for (size_t i = 0; i <= table->mask; ++i) {
+        const char *e_name =
+            table->entries[i].name.load(std::memory_order_relaxed);
+        if (e_name && strcmp(e_name, name) == 0)
+            return true;
     }
 
-    // Sill no luck -- perform a lookup and populate the trampoline
-    const char *error = nullptr;
-    PyTypeObject *value_tp = nullptr;
+    return false;
+}
 
-    size_t offset = 0;
-    for (; offset < size; offset++) {
-        if (data[2 * offset + 1] == nullptr &&
-            data[2 * offset + 2] == nullptr)
-            break;
+void nb_override_invalidate(PyTypeObject *tp, const char *name) noexcept {
+    nb_internals &internals = internals_get();
+
+    // Prevents pending slow path lookups from caching outdated results
+    internals.override_epoch.fetch_add(1, std::memory_order_acq_rel);
+
+    {
+        lock_internals guard(internals);
+        type_data *t = nb_type_data(tp);
+        override_table *table = override_ref(t).load(std::memory_order_relaxed);
+        if (table && override_caches(table, name))
+            table->stale.store(true, std::memory_order_release);
     }
 
+    // The modification is also visible in subclasses
+    PyObject *subclasses =
+        PyObject_CallMethod((PyObject *) tp, "__subclasses__", nullptr);
+    if (!subclasses) {
+        PyErr_Clear();
+        return;
+    }
+
+    Py_ssize_t size = PyList_Size(subclasses);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        PyObject *sub = PyList_GetItem(subclasses, i);
+        if (sub && nb_type_check(sub))
+            nb_override_invalidate((PyTypeObject *) sub, name);
+    }
+
+    Py_DECREF(subclasses);
+}
+
+PyObject *trampoline_new(void *ptr) noexcept {
+    // GIL is held when the trampoline constructor runs
+    nb_shard &shard = internals_get().shard(ptr);
+    lock_shard guard(shard);
+
+    nb_ptr_map &inst_c2p = shard.inst_c2p;
+    nb_ptr_map::iterator it = inst_c2p.find(ptr);
+    check(it != inst_c2p.end() && (((uintptr_t) it->second) & 1) == 0,
+          "nanobind::detail::trampoline_new(): unique instance not found!");
+
+    return (PyObject *) it->second;
+}
+
+static NB_NOINLINE PyObject *trampoline_lookup_slow(PyObject *self,
+                                                    type_data *t,
+                                                    const char *name,
+                                                    bool pure) {
+    PyGILState_STATE state = PyGILState_Ensure();
+
     nb_internals &internals = internals_get();
+    uint64_t epoch;
+    const char *error = nullptr;
     PyObject *key = nullptr, *value = nullptr;
+    PyTypeObject *value_tp = nullptr;
+    bool retry;
 
-    if (offset == size) {
-        error = "the trampoline ran out of slots (you will need to increase "
-                "the value provided to the NB_TRAMPOLINE() macro)";
-        goto fail;
-    }
+again:
+    epoch = internals.override_epoch.load(std::memory_order_acquire);
+    retry = false;
 
     key = PyUnicode_InternFromString(name);
     if (!key) {
@@ -88,7 +212,8 @@ PyObject *trampoline_lookup(void **data, size_t size, const char *name,
         goto fail;
     }
 
-    value = PyObject_GetAttr((PyObject *) data[0], key);
+    // Overrides are a property of the type, so look the name up there
+    value = PyObject_GetAttr((PyObject *) Py_TYPE(self), key);
     if (!value) {
         error = "lookup failed";
         goto fail;
@@ -98,30 +223,145 @@ PyObject *trampoline_lookup(void **data, size_t size, const char *name,
     Py_CLEAR(value);
 
     if (value_tp == internals.nb_func || value_tp == internals.nb_method ||
-        value_tp == internals.nb_bound_method) {
-        if (pure) {
-            error = "tried to call a pure virtual function";
-            goto fail;
+        value_tp == internals.nb_bound_method)
+        Py_CLEAR(key);
+
+    {
+        lock_internals guard(internals);
+
+        std::atomic<override_table *> &ref = override_ref(t);
+        override_table *table = ref.load(std::memory_order_relaxed);
+        bool stale = table && table->stale.load(std::memory_order_relaxed);
+
+        // Repeat the lookup if a type was modified in the meantime
+        retry =
+            internals.override_epoch.load(std::memory_order_relaxed) != epoch;
+
+        if (!retry && (!table || stale ||
+                       (2 * (table->size + 1) > table->mask + 1 &&
+                        !override_find(table, name)))) {
+            size_t capacity = 8;
+            override_table *table_new;
+
+            if (table && !stale) {
+                // Grow the table and transfer the existing entries
+                capacity = 2 * (table->mask + 1);
+                table_new = override_alloc(capacity);
+                for (size_t i = 0; i <= table->mask; ++i) {
+                    override_entry &e = table->entries[i];
+                    const char *e_name = e.name.load(std::memory_order_relaxed);
+                    if (e_name)
+                        override_insert(table_new, e_name, e.value);
+                }
+            } else {
+                table_new = override_alloc(capacity);
+            }
+
+            table_new->retired = table;
+            ref.store(table_new, std::memory_order_release);
+            table = table_new;
         }
 
-        Py_DECREF(key);
-        key = Py_None;
-        Py_INCREF(Py_None);
+        // Another thread may have inserted the entry in the meantime
+        if (!retry && !override_find(table, name))
+            override_insert(table, name, key);
+    }
+
+    if (retry) {
+        Py_XDECREF(key);
+        goto again;
     }
 
-    data[2 * offset + 1] = (void *) name;
-    data[2 * offset + 2] = key;
+    if (!key && pure) {
+        error = "tried to call a pure virtual function";
+        goto fail;
+    }
 
+    Py_XDECREF(key);
     PyGILState_Release(state);
-    return key != None ? (PyObject *) key : nullptr;
+
+    // The table holds a reference to 'key'
+    return key;
 
 fail:
-    type_data *t = nb_type_data(Py_TYPE((PyObject *) data[0]));
+    Py_XDECREF(key);
     PyGILState_Release(state);
 
     raise("nanobind::detail::get_trampoline('%s::%s()'): %s!",
           t->name, name, error);
 }
 
+PyObject *trampoline_lookup(PyObject *self, const char *name, bool pure) {
+    current_method cm = current_method_data;
+    if (cm.self == self && (cm.name == name || strcmp(cm.name, name) == 0)) {
+        if (pure)
+            raise("nanobind::detail::get_trampoline('%s()'): tried to call a "
+                  "pure virtual function!", name);
+        return nullptr;
+    }
+
+    type_data *t = nb_type_data(Py_TYPE(self));
+    override_table *table = override_ref(t).load(std::memory_order_acquire);
+
+    // Fast path: a single probe sequence without any locks
+    if (NB_LIKELY(table && !table->stale.load(std::memory_order_acquire))) {
+        override_entry *e = override_find(table, name);
+        if (e) {
+            if (NB_UNLIKELY(!e->value && pure))
+                raise("nanobind::detail::get_trampoline('%s::%s()'): tried "
+                      "to call a pure virtual function!", t->name, name);
+            return e->value;
+        }
+    }
+
+    return trampoline_lookup_slow(self, t, name, pure);
+}
+
+PyObject *trampoline_vectorcall(PyObject *self, const char *name,
+                                PyObject *key, PyObject **args,
+                                size_t nargs) {
+    Py_INCREF(self);
+    args[1] = self;
+
+    size_t nargsf = (nargs + 1) | NB_VECTORCALL_ARGUMENTS_OFFSET;
+
+#if defined(NB_OVERRIDE_DIRECT)
+    PyTypeObject *tp = Py_TYPE(self);
+    override_table *table =
+        override_ref(nb_type_data(tp)).load(std::memory_order_relaxed);
+    override_entry *e = table ? override_find(table, name) : nullptr;
+
+    if (e && e->value == key) {
+        unsigned int tag = override_tag(tp);
+        if (e->tag != tag || !tag) {
+            // Only types with the generic attribute lookup bind functions as usual
+            PyObject *func = nullptr;
+            if (tp->tp_getattro == PyObject_GenericGetAttr) {
+                func = _PyType_Lookup(tp, key); // assigns a version tag
+                if (func && !PyFunction_Check(func))
+                    func = nullptr;
+            }
+
+            e->func = func;
+            e->tag = override_tag(tp);
+        }
+
+        // An attribute in the instance dictionary shadows the function
+        PyObject **dict = e->func ? _PyObject_GetDictPtr(self) : nullptr;
+
+        if (e->func && e->tag && (!dict || !*dict ||
+                                  !PyDict_GetItem(*dict, key))) {
+            Py_INCREF(e->func);
+            return obj_vectorcall(e->func, args + 1, nargsf, nullptr, false);
+        }
+    }
+#else
+    (void) name;
+#endif
+
+    Py_INCREF(key);
+    return obj_vectorcall(key, args + 1, nargsf, nullptr, true);
+}
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -10,6 +10,7 @@
 */
 
 #include <nanobind/stl/chrono.h>
+#include <nanobind/stl/chrono_ndarray.h>
 
 struct different_resolutions {
     using time_point_h = std::chrono::time_point<std::chrono::system_clock,
@@ -85,6 +86,25 @@ NB_MODULE(test_chrono_ext, m) {
         .def_rw("timestamp_ms", &different_resolutions::timestamp_ms)
         .def_rw("timestamp_us", &different_resolutions::timestamp_us);
 
+    using tp_ns = std::chrono::time_point<std::chrono::system_clock,
+                                          std::chrono::nanoseconds>;
+    using tp_us = std::chrono::time_point<std::chrono::system_clock,
+                                          std::chrono::microseconds>;
+
+    m.def("datetime64_ns", [](nanobind::vector_datetime64<std::chrono::nanoseconds> v) {
+        for (tp_ns &t : v.value)
+            t += std::chrono::nanoseconds(1);
+        return v;
+    });
+    m.def("datetime64_us", [](nanobind::vector_datetime64<std::chrono::microseconds> v) {
+        for (tp_us &t : v.value)
+            t += std::chrono::microseconds(1);
+        return v;
+    });
+    m.def("datetime64_count", [](const nanobind::vector_datetime64<> &v) {
+        return v.value.size();
+    });
+
 #if defined(Py_LIMITED_API) || defined(PYPY_VERSION)
     m.attr("access_via_python") = true;
 #else
@@ -336,3 +336,20 @@ def test_chrono_invalid(test_type, roundtrip):
                     roundtrip(fake_val)
                 assert cm.unraisable is not None
                 assert errtype in repr(cm.unraisable.exc_value)
+
+
+def test_chrono_datetime64():
+    # Without NumPy arrays, datetime objects are converted element-wise
+    assert m.datetime64_count([datetime.datetime.today()] * 3) == 3
+
+    np = pytest.importorskip("numpy")
+    a = np.array(['2023-05-01T12:00:00.000000001', '1969-12-31T23:59:59'],
+                 dtype='datetime64[ns]')
+    b = m.datetime64_ns(a)
+    assert b.dtype == np.dtype('datetime64[ns]')
+    assert (b - a == np.timedelta64(1, 'ns')).all()
+
+    # Other units are converted to nanoseconds
+    c = m.datetime64_us(a.astype('datetime64[us]'))
+    assert c.dtype == np.dtype('datetime64[ns]')
+    assert (c - a.astype('datetime64[us]') == np.timedelta64(1, 'us')).all()
@@ -4,6 +4,7 @@
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/shared_ptr.h>
+#include <nanobind/stl/vector.h>
 #include <memory>
 #include <cstring>
 #include <vector>
@@ -12,6 +13,7 @@
 namespace nb = nanobind;
 using namespace nb::literals;
 
+static int native_vec_alive = 0, buffer_alive = 0, config_alive = 0;
 static int default_constructed = 0, value_constructed = 0, copy_constructed = 0,
            move_constructed = 0, copy_assigned = 0, move_assigned = 0,
            destructed = 0;
@@ -73,6 +75,16 @@ struct StaticProperties {
     static int value;
 };
 
+/// Hashable value type bound with nb::hashable()
+struct Key {
+    int a, b;
+    bool operator==(const Key &k) const { return a == k.a && b == k.b; }
+};
+
+template <> struct std::hash<Key> {
+    size_t operator()(const Key &k) const { return (size_t) (k.a * 31 + k.b); }
+};
+
 struct StaticProperties2 : StaticProperties { };
 
 int StaticProperties::value = 23;
@@ -477,4 +489,253 @@ NB_MODULE(test_classes_ext, m) {
     m.def("polymorphic_factory_2", []() { return (PolymorphicBase *) new AnotherPolymorphicSubclass(); });
     m.def("factory", []() { return (Base *) new Subclass(); });
     m.def("factory_2", []() { return (Base *) new AnotherSubclass(); });
+
+    // Methods whose creation is deferred until first use
+    struct LazyBase { int value = 1; };
+    struct LazyDerived : LazyBase { };
+
+    {
+        nb::lazy_functions guard;
+        nb::module_ lazy = m.def_submodule("lazy");
+
+        auto lazy_base = nb::class_<LazyBase>(lazy, "LazyBase");
+
+        nb::class_<LazyDerived, LazyBase>(lazy, "LazyDerived")
+            .def(nb::init<>())
+            .def("derived_value", [](const LazyDerived &d) { return d.value + 10; });
+
+        lazy_base
+            .def(nb::init<>())
+            .def("get", [](const LazyBase &b) { return b.value; })
+            .def("get", [](const LazyBase &b, int i) { return b.value + i; }, "i"_a)
+            .def_static("static_get", [](int i) { return i; }, "i"_a = 5);
+
+        lazy.def("lazy_derived", []() { return new LazyDerived(); });
+    }
+
+    // Instances allocated from the instance pool
+    struct alignas(32) PooledVec { double x, y, z; };
+
+    nb::class_<PooledVec>(m, "PooledVec", nb::pooled())
+        .def(nb::init<double, double, double>())
+        .def_rw("x", &PooledVec::x)
+        .def_rw("z", &PooledVec::z)
+        .def("aligned", [](const PooledVec &v) { return ((uintptr_t) &v) % 32 == 0; })
+        .def("__add__", [](const PooledVec &a, const PooledVec &b) {
+            return PooledVec{ a.x + b.x, a.y + b.y, a.z + b.z };
+        });
+
+    m.def("set_tracemalloc", &nb::set_tracemalloc);
+#if defined(Py_LIMITED_API) || defined(PYPY_VERSION)
+    m.attr("has_tracemalloc") = false;
+#else
+    m.attr("has_tracemalloc") = true;
+#endif
+
+    // Instances that are not registered in the instance map
+    struct Anonymous { int value; };
+    static Anonymous anonymous { 5 };
+
+    nb::class_<Anonymous>(m, "Anonymous", nb::no_identity())
+        .def(nb::init<int>())
+        .def_rw("value", &Anonymous::value)
+        .def("copy", [](const Anonymous &a) { return a; })
+        .def("self", [](Anonymous &a) -> Anonymous & { return a; },
+             nb::rv_policy::reference);
+
+    m.def("anonymous_ref", []() -> Anonymous & { return anonymous; },
+          nb::rv_policy::reference);
+
+    // Instances that are copied and pickled via memcpy()
+    struct TrivialVec { double x; int32_t n; };
+
+    nb::class_<TrivialVec>(m, "TrivialVec", nb::trivial_pickle())
+        .def(nb::init<double, int32_t>())
+        .def_rw("x", &TrivialVec::x)
+        .def_rw("n", &TrivialVec::n);
+
+    // Operators that are dispatched via type slots
+    struct Vec2 {
+        double x, y;
+        Vec2 operator+(const Vec2 &v) const { return { x + v.x, y + v.y }; }
+        Vec2 operator-(const Vec2 &v) const { return { x - v.x, y - v.y }; }
+        Vec2 operator*(double s) const { return { x * s, y * s }; }
+        Vec2 operator-() const { return { -x, -y }; }
+        Vec2 &operator+=(const Vec2 &v) {
+            x += v.x;
+            y += v.y;
+            return *this;
+        }
+        bool operator==(const Vec2 &v) const { return x == v.x && y == v.y; }
+        bool operator!=(const Vec2 &v) const { return !operator==(v); }
+        bool operator<(const Vec2 &v) const {
+            if (x != x || v.x != v.x)
+                throw std::domain_error("Vec2: NaN comparison");
+            return x < v.x;
+        }
+        bool operator!() const { return x == 0 && y == 0; }
+    };
+
+    nb::class_<Vec2>(m, "Vec2")
+        .def(nb::init<double, double>(), "x"_a, "y"_a)
+        .def_rw("x", &Vec2::x)
+        .def_rw("y", &Vec2::y)
+        .def(nb::self + nb::self)
+        .def(nb::self * double())
+        .def(-nb::self)
+        .def(nb::self += nb::self)
+        .def(nb::self == nb::self)
+        .def(nb::self != nb::self)
+        .def(nb::self < nb::self)
+        .def(!nb::self)
+        // An earlier overload takes precedence over the operator
+        .def("__sub__", [](const Vec2 &, const Vec2 &) { return -1.0; },
+             nb::is_operator())
+        .def(nb::self - nb::self);
+
+    // Native implicit conversions
+    struct NativeVec {
+        double x, y, z;
+        NativeVec(double x, double y, double z) : x(x), y(y), z(z) { native_vec_alive++; }
+        NativeVec(const NativeVec &v) : x(v.x), y(v.y), z(v.z) { native_vec_alive++; }
+        ~NativeVec() { native_vec_alive--; }
+    };
+
+    nb::class_<NativeVec>(m, "NativeVec")
+        .def(nb::init<double, double, double>());
+
+    nb::implicitly_convertible<NativeVec>(
+        [](PyObject *src, void *out) noexcept -> bool {
+            if (!PyFloat_CheckExact(src))
+                return false;
+            double v = PyFloat_AsDouble(src);
+            new (out) NativeVec(v, v, v);
+            return true;
+        });
+
+    nb::implicitly_convertible<NativeVec>(
+        [](PyObject *src, void *out) noexcept -> bool {
+            if (!PyTuple_CheckExact(src) || PyTuple_Size(src) != 3)
+                return false;
+            double v[3];
+            for (int i = 0; i < 3; ++i) {
+                v[i] = PyFloat_AsDouble(PyTuple_GetItem(src, i));
+                if (v[i] == -1.0 && PyErr_Occurred()) {
+                    PyErr_Clear();
+                    return false;
+                }
+            }
+            new (out) NativeVec(v[0], v[1], v[2]);
+            return true;
+        });
+
+    m.def("native_vec_sum", [](const NativeVec &v) { return v.x + v.y + v.z; });
+    m.def("native_vec_alive", []() { return native_vec_alive; });
+    m.def("native_vec_sum_list", [](const std::vector<NativeVec> &l) {
+        double sum = 0;
+        for (const NativeVec &v : l)
+            sum += v.x + v.y + v.z;
+        return sum;
+    });
+
+    // Instances with an inline keep_alive slot
+    struct Buffer {
+        int data[4] { 1, 2, 3, 4 };
+        Buffer() { buffer_alive++; }
+        ~Buffer() { buffer_alive--; }
+    };
+    struct BufferView { const int *data; };
+
+    nb::class_<Buffer>(m, "Buffer")
+        .def(nb::init<>());
+
+    nb::class_<BufferView>(m, "BufferView", nb::inline_keep_alive())
+        .def("get", [](const BufferView &v, int i) { return v.data[i]; })
+        .def("attach", [](BufferView &, nb::handle) { }, nb::keep_alive<1, 2>());
+
+    m.def("buffer_view", [](const Buffer &b) { return BufferView{ b.data }; },
+          nb::keep_alive<0, 1>());
+    m.def("buffer_alive", []() { return buffer_alive; });
+    // Direct accessors for scalar fields
+    struct Record {
+        bool flag = false;
+        int8_t i8 = -1;
+        uint16_t u16 = 2;
+        int32_t i32 = -3;
+        uint64_t u64 = 4;
+        float f32 = 5.5f;
+        double f64 = 6.5;
+        const int fixed = 7;
+        std::string name = "record";
+    };
+
+    static Record global_record;
+
+    nb::class_<Record>(m, "Record")
+        .def(nb::init<>())
+        .def_rw("flag", &Record::flag, "A boolean field")
+        .def_rw("i8", &Record::i8)
+        .def_rw("u16", &Record::u16)
+        .def_rw("i32", &Record::i32)
+        .def_rw("u64", &Record::u64)
+        .def_rw("f32", &Record::f32)
+        .def_rw("f64", &Record::f64)
+        .def_ro("fixed", &Record::fixed)
+        .def_ro("i32_ro", &Record::i32)
+        .def_rw("name", &Record::name);
+
+    m.def("global_record", []() -> Record & { return global_record; },
+          nb::rv_policy::reference);
+    m.def("global_record_i32", []() { return global_record.i32; });
+
+    // Instances that cache the wrappers of their members
+    struct Leaf { int x = 1; };
+    struct Section { Leaf leaf; int y = 2; };
+    struct Config {
+        Section section;
+        Config() { config_alive++; }
+        ~Config() { config_alive--; }
+    };
+
+    nb::class_<Leaf>(m, "Leaf", nb::member_cache())
+        .def_rw("x", &Leaf::x);
+
+    nb::class_<Section>(m, "Section", nb::member_cache())
+        .def_rw("leaf", &Section::leaf)
+        .def_rw("y", &Section::y);
+
+    nb::class_<Config>(m, "Config", nb::member_cache())
+        .def(nb::init<>())
+        .def_rw("section", &Config::section);
+
+    m.def("config_alive", []() { return config_alive; });
+
+    // Return values constructed in the instance storage
+    struct Pinned {
+        int value;
+        double data[64] { };
+        Pinned(int value) : value(value) { value_constructed++; }
+        Pinned(const Pinned &) = delete;
+        Pinned(Pinned &&) = delete;
+        ~Pinned() { destructed++; }
+    };
+
+    nb::class_<Pinned>(m, "Pinned")
+        .def_ro("value", &Pinned::value);
+
+    nb::class_<Key>(m, "Key", nb::hashable())
+        .def(nb::init<int, int>())
+        .def_rw("a", &Key::a);
+
+    // Only used to test reassigning __new__, which cannot be undone
+    struct Replaced { int value; };
+    nb::class_<Replaced>(m, "Replaced")
+        .def(nb::init<int>())
+        .def_ro("value", &Replaced::value);
+
+    m.def("make_pinned", [](int value) {
+        if (value < 0)
+            throw std::runtime_error("negative value");
+        return Pinned(value);
+    });
 }
@@ -1,7 +1,7 @@
 import sys
 import test_classes_ext as t
 import pytest
-from common import skip_on_pypy, collect
+from common import skip_on_pypy, collect, is_pypy
 
 
 @pytest.fixture
@@ -88,8 +88,7 @@ def test05_rv_policy(clean):
     assert t.Struct.create_move().value() == 11
     assert_stats(
         value_constructed=1,
-        move_constructed=1,
-        destructed=2
+        destructed=1
     )
 
     # ------
@@ -631,3 +630,563 @@ def test34_trampoline_optimization():
             assert t.go(d2) == 'Rufus says woof'
         finally:
             t.Dog.name = old
+
+def test35_bound_method_reuse():
+    # Bound method objects are recycled via a freelist; they must not retain
+    # references to their instance or mix up instances
+    s1, s2 = t.Struct(1), t.Struct(2)
+    rc = sys.getrefcount(s1)
+    for _ in range(100):
+        m1 = getattr(s1, 'value')
+        m2 = getattr(s2, 'value')
+        assert m1() == 1 and m2() == 2
+        del m1, m2
+    assert sys.getrefcount(s1) == rc
+    methods = [getattr(s, 'value') for s in (s1, s2) * 20]
+    assert [m() for m in methods] == [1, 2] * 20
+    del methods
+    assert sys.getrefcount(s1) == rc
+    # Non-vectorcall invocation copies the arguments into a temporary buffer
+    f = getattr(s1, 'set_value')
+    f(*(5,))
+    f(**{'value': 6})
+    assert s1.value() == 6
+
+
+def test36_lazy_methods():
+    # Bypass the metaclass, which would create the deferred methods
+    type_dict = type.__dict__['__dict__'].__get__
+    assert 'get' not in type_dict(t.lazy.LazyBase)
+    assert 'derived_value' not in type_dict(t.lazy.LazyDerived)
+
+    d = t.lazy.lazy_derived()
+    assert 'get' in type_dict(t.lazy.LazyBase)
+    assert d.derived_value() == 11
+    assert d.get() == 1
+    assert d.get(i=2) == 3
+    assert t.lazy.LazyBase.static_get() == 5
+    assert t.lazy.LazyBase().get(1) == 2
+
+    class Sub(t.lazy.LazyBase):
+        pass
+
+    assert Sub().get() == 1
+
+
+def test37_method_map():
+    s1, s2 = t.Struct(1), t.Struct(2)
+    assert s1.value.starmap([(), ()]) == [1, 1]
+    assert t.Struct.value.map([s1, s2]) == [1, 2]
+    s1.set_value.map([5, 6])
+    assert s1.value() == 6
+
+
+def test38_pooled():
+    vecs = [t.PooledVec(i, 0, -i) for i in range(1000)]
+    assert all(v.aligned() for v in vecs)
+    assert [v.x for v in vecs[::100]] == [float(i) for i in range(0, 1000, 100)]
+    del vecs[::2]
+    s = t.PooledVec(0, 0, 0)
+    for v in vecs:
+        s = s + v
+    assert s.x == -s.z == sum(range(1, 1000, 2))
+    assert s.aligned()
+
+
+def test39_no_identity():
+    a = t.anonymous_ref()
+    b = t.anonymous_ref()
+    assert a is not b
+    a.value = 6
+    assert b.value == 6
+    a.value = 5
+
+    c = t.Anonymous(3)
+    assert c.self() is not c
+    assert c.self().value == 3
+    d = c.copy()
+    d.value = 4
+    assert c.value == 3 and d.value == 4
+    del a, b, c, d
+
+
+def test40_cast_cache():
+    # Alternate between cached successful and failed base class lookups
+    # involving Python subclasses that are created and destroyed again
+    for i in range(10):
+        class Dachshund(t.Dog):
+            def name(self):
+                return 'Dachshund'
+
+        d = Dachshund('yap')
+        for _ in range(3):
+            assert t.go(d) == 'Dachshund says yap'
+            with pytest.raises(TypeError):
+                t.go(t.Anonymous(i))
+        del d, Dachshund
+        collect()
+
+
+def test41_implicitly_convertible_native():
+    assert t.native_vec_sum(t.NativeVec(1, 2, 3)) == 6
+    assert t.native_vec_sum(2.0) == 6
+    assert t.native_vec_sum((1, 2.5, 3)) == 6.5
+    assert t.native_vec_alive() == 0
+    with pytest.raises(TypeError):
+        t.native_vec_sum((1, "2", 3))
+    with pytest.raises(TypeError):
+        t.native_vec_sum(1)
+    assert t.native_vec_alive() == 0
+
+    # Many temporaries exceed the inline storage of the cleanup list
+    for n in (0, 5, 100, 10000):
+        assert t.native_vec_sum_list([(1, 2, i) for i in range(n)]) == \
+            3 * n + n * (n - 1) / 2
+        assert t.native_vec_alive() == 0
+    assert t.native_vec_sum_list([(1, 2, 3), 1.0, t.NativeVec(1, 1, 1)]) == 12
+    with pytest.raises(TypeError):
+        t.native_vec_sum_list([(1, 2, 3)] * 20 + ["x"])
+    assert t.native_vec_alive() == 0
+
+
+def test42_inline_keep_alive():
+    import weakref
+
+    class Patient:
+        pass
+
+    v = t.buffer_view(t.Buffer())
+    collect()
+    assert t.buffer_alive() == 1
+    assert [v.get(i) for i in range(4)] == [1, 2, 3, 4]
+
+    # Additional patients spill into the global keep_alive map
+    p1, p2 = Patient(), Patient()
+    w1, w2 = weakref.ref(p1), weakref.ref(p2)
+    v.attach(p1)
+    v.attach(p2)
+    v.attach(p2)
+    del p1, p2
+    collect()
+    assert w1() is not None and w2() is not None
+    del v
+    collect()
+    assert t.buffer_alive() == 0
+    assert w1() is None and w2() is None
+
+
+def test43_member_descriptor():
+    r = t.Record()
+    assert type(t.Record.__dict__['i32']).__name__ == 'nb_member'
+    assert type(t.Record.__dict__['name']) is property
+    assert t.Record.flag.__doc__ == 'A boolean field'
+    assert t.Record.flag.__name__ == 'flag'
+
+    assert (r.flag, r.i8, r.u16, r.i32, r.u64, r.f32, r.f64, r.fixed) == \
+        (False, -1, 2, -3, 4, 5.5, 6.5, 7)
+
+    r.flag = True
+    r.i8 = -128
+    r.u16 = 65535
+    r.i32 = 123
+    r.u64 = 2**64 - 1
+    r.f32 = 1  # integers are converted
+    r.f64 = 0.25
+    assert (r.flag, r.i8, r.u16, r.i32, r.u64, r.f32, r.f64) == \
+        (True, -128, 65535, 123, 2**64 - 1, 1.0, 0.25)
+    assert r.i32_ro == 123
+
+    for name, value in (('flag', 1), ('i8', 128), ('u16', -1),
+                        ('i32', 1.5), ('f64', 'x')):
+        with pytest.raises(TypeError) as excinfo:
+            setattr(r, name, value)
+        assert 'expects a value of type' in str(excinfo.value)
+    assert (r.flag, r.i8, r.u16, r.i32) == (True, -128, 65535, 123)
+
+    with pytest.raises(AttributeError):
+        r.fixed = 1
+    with pytest.raises(AttributeError):
+        r.i32_ro = 1
+    with pytest.raises(AttributeError):
+        del r.i32
+
+    with pytest.raises(TypeError):
+        t.Record.__dict__['i32'].__get__(t.Struct())
+
+    # Python subclasses and indirect (non-owning) instances
+    class Sub(t.Record):
+        pass
+
+    s = Sub()
+    s.i32 = 5
+    assert s.i32 == 5
+
+    g = t.global_record()
+    g.i32 = 42
+    assert t.global_record_i32() == 42
+    assert t.global_record().i32 == 42
+
+
+def test44_trampoline_override_cache():
+    class Beagle(t.Animal):
+        def name(self):
+            return "Beagle"
+        def what(self):
+            return "woof"
+
+    b1, b2 = Beagle(), Beagle()
+    assert t.go(b1) == 'Beagle says woof'
+    assert t.go(b2) == 'Beagle says woof'
+
+    # Modifying the type invalidates the cached overrides of all instances
+    Beagle.what = lambda self: "howl"
+    assert t.go(b1) == 'Beagle says howl'
+    assert t.go(b2) == 'Beagle says howl'
+
+    del Beagle.name
+    assert t.go(b1) == 'Animal says howl'
+
+    del Beagle.what
+    with pytest.raises(RuntimeError) as excinfo:
+        t.go(b2)
+    assert 'tried to call a pure virtual function' in str(excinfo.value)
+
+    # Modifying a base type also invalidates the caches of its subclasses
+    class Puppy(Beagle):
+        pass
+
+    class Hound(t.Animal):
+        def what(self):
+            return "bay"
+
+    p, h = Puppy(), Hound()
+    Beagle.what = lambda self: "yip"
+    assert t.go(p) == 'Animal says yip'
+    assert t.go(h) == 'Animal says bay'
+
+    for i in range(100):
+        Beagle.what = lambda self, i=i: str(i)
+        assert t.go(p) == 'Animal says %i' % i
+        assert t.go(h) == 'Animal says bay'
+
+    # Unrelated attributes don't affect the cached overrides
+    for i in range(100):
+        Beagle.counter = i
+        assert t.go(p) == 'Animal says 99'
+    Beagle.__doc__ = 'A dog'
+    assert t.go(p) == 'Animal says 99'
+
+
+def test45_trivial_pickle():
+    import copy
+    import pickle
+
+    # Pickle looks up the subclass by name, but it must not outlive the test
+    global TrivialVecSub
+
+    class TrivialVecSub(t.TrivialVec):
+        pass
+
+    v = t.TrivialVec(1.5, 3)
+    for w in (copy.copy(v), copy.deepcopy(v),
+              pickle.loads(pickle.dumps(v, protocol=2)),
+              pickle.loads(pickle.dumps(v, protocol=5))):
+        assert type(w) is t.TrivialVec and w is not v
+        assert w.x == 1.5 and w.n == 3
+
+    try:
+        s = TrivialVecSub(2.5, 4)
+        s.tag = [1, 2]
+        for w in (copy.copy(s), copy.deepcopy(s),
+                  pickle.loads(pickle.dumps(s))):
+            assert type(w) is TrivialVecSub
+            assert w.x == 2.5 and w.n == 4 and w.tag == [1, 2]
+        assert copy.copy(s).tag is s.tag
+        assert copy.deepcopy(s).tag is not s.tag
+    finally:
+        del TrivialVecSub
+        s = w = None
+        collect()
+
+    with pytest.raises(TypeError):
+        t.TrivialVec._nb_unpickle(b"123")
+
+
+def test46_operator_slots():
+    a, b = t.Vec2(1, 2), t.Vec2(3, 5)
+    c = a + b
+    assert (c.x, c.y) == (4, 7)
+    c = a * 2
+    assert (c.x, c.y) == (2, 4)
+    c = -a
+    assert (c.x, c.y) == (-1, -2)
+    assert a == t.Vec2(1, 2) and not (a == b)
+    assert a != b and not (a != t.Vec2(1, 2))
+    assert a < b and not (b < a)
+    assert bool(a) and not bool(t.Vec2(0, 0))
+    assert a - b == -1.0
+
+    # In-place operators return a copy, as with the generic dispatch
+    d = t.Vec2(1, 2)
+    e = d
+    d += b
+    assert (d.x, d.y) == (4, 7) and (e.x, e.y) == (4, 7) and d is not e
+
+    # Mismatched operands fall back to overload resolution
+    with pytest.raises(TypeError):
+        a + 1
+    assert not (a == 1) and a != "a"
+    with pytest.raises(TypeError):
+        a < 1
+    with pytest.raises(ValueError, match="NaN"):
+        t.Vec2(float("nan"), 0) < a
+
+    # Uninitialized instances aren't passed to the operator
+    u = t.Vec2.__new__(t.Vec2)
+    with pytest.raises(TypeError):
+        u + a
+    with pytest.raises(TypeError):
+        a + u
+
+    # Subclasses may override operators
+    class Sub(t.Vec2):
+        def __add__(self, other):
+            return "add"
+
+        def __eq__(self, other):
+            return "eq"
+
+    s1, s2 = Sub(1, 2), Sub(3, 4)
+    assert s1 + s2 == "add"
+    assert (s1 == s2) == "eq"
+    assert s1 < s2
+    c = -s1
+    assert type(c) is t.Vec2 and (c.x, c.y) == (-1, -2)
+
+
+def test47_member_cache():
+    c = t.Config()
+    s = c.section
+    assert c.section is s and c.section.leaf is s.leaf
+    c.section.leaf.x = 5
+    assert c.section.leaf.x == 5 and s.leaf.x == 5
+
+    # Wrappers that outlive the owner keep it alive
+    leaf = c.section.leaf
+    del c, s
+    collect()
+    assert t.config_alive() == 1
+    assert leaf.x == 5
+    del leaf
+    collect()
+    assert t.config_alive() == 0
+
+    # Cached wrappers don't keep the owner alive
+    c = t.Config()
+    c.section.leaf.x = 3
+    del c
+    collect()
+    assert t.config_alive() == 0
+
+    # .. even when they are also referenced from another garbage cycle
+    c = t.Config()
+    lst = [c.section, c.section.leaf]
+    lst.append(lst)
+    del c, lst
+    collect()
+    assert t.config_alive() == 0
+
+
+def test48_inplace_return(clean):
+    # Non-movable types returned by value are constructed in place
+    p = t.make_pinned(5)
+    assert p.value == 5
+    del p
+    assert_stats(
+        value_constructed=1,
+        destructed=1
+    )
+
+    with pytest.raises(RuntimeError, match='negative value'):
+        t.make_pinned(-1)
+    assert_stats(
+        value_constructed=1,
+        destructed=1
+    )
+
+
+def test49_type_vectorcall():
+    # Instances are constructed via the vectorcall protocol of the type
+    v = t.Vec2(1, y=2)
+    assert (v.x, v.y) == (1, 2)
+    v = t.Vec2(y=4, x=3)
+    assert (v.x, v.y) == (3, 4)
+    assert [s.value() for s in map(t.Struct, [1, 2])] == [1, 2]
+    assert t.Struct(*range(1)).value() == 0
+
+    with pytest.raises(TypeError, match='incompatible function arguments'):
+        t.Vec2(1, z=2)
+
+    with pytest.raises(TypeError, match='no constructor defined'):
+        t.Pinned()
+
+    # Python subclasses can still override __init__
+    class Sub(t.Struct):
+        def __init__(self, x):
+            super().__init__(x * 2)
+
+    assert Sub(3).value() == 6
+
+    # Reassigning __init__ on the bound type is honored
+    init, calls = t.Struct.__dict__['__init__'], []
+
+    def traced_init(self, *args):
+        calls.append(args)
+        init(self, *args)
+
+    t.Struct.__init__ = traced_init
+    try:
+        assert t.Struct(3).value() == 3 and calls == [(3,)]
+    finally:
+        t.Struct.__init__ = init
+    assert t.Struct(4).value() == 4 and calls == [(3,)]
+
+    # .. and so is reassigning __new__
+    assert t.Replaced(5).value == 5
+    sentinel = object()
+    t.Replaced.__new__ = staticmethod(lambda cls, *args: sentinel)
+    assert t.Replaced(5) is sentinel
+
+
+def test50_hashable():
+    a, b, c = t.Key(1, 2), t.Key(1, 2), t.Key(2, 1)
+    assert a == b and not (a != b) and a != c and a is not b
+    assert hash(a) == hash(b) == 33 and hash(c) == 63
+    assert len({a, b, c}) == 2
+    d = {a: 'x'}
+    assert d[b] == 'x' and c not in d
+
+    # Instances of other types never compare equal
+    assert a != (1, 2) and not (a == 1)
+    with pytest.raises(TypeError):
+        a < b
+
+    # Hashes reflect the current value
+    a.a = 2
+    assert a != b and hash(a) == 64
+    assert hash(t.Key(0, -1)) == -2
+
+
+def test51_trampoline_override_kinds():
+    class Callable:
+        def __call__(self):
+            return "meow"
+
+    # Plain functions are called directly, other overrides via attribute lookup
+    class Kitten(t.Animal):
+        name = staticmethod(lambda: "Kitten")
+        what = Callable()
+
+    class Puppy(t.Animal):
+        @classmethod
+        def name(cls):
+            return cls.__name__
+
+        def what(self):
+            return "yip" if isinstance(self, Puppy) else "?"
+
+    assert t.go(Kitten()) == 'Kitten says meow'
+    assert t.go(Puppy()) == 'Puppy says yip'
+
+    # Exceptions propagate from either kind of override
+    Puppy.what = lambda self: 1 / 0
+    with pytest.raises(ZeroDivisionError):
+        t.go(Puppy())
+
+    # The type's version tag detects modifications that bypass nanobind
+    if not is_pypy:
+        import ctypes, gc
+
+        class Cat(t.Animal):
+            def name(self):
+                return "Cat"
+
+            def what(self):
+                return "meow"
+
+        c = Cat()
+        assert t.go(c) == 'Cat says meow'
+        gc.get_referents(Cat.__dict__)[0]['what'] = lambda self: "purr"
+        ctypes.pythonapi.PyType_Modified(ctypes.py_object(Cat))
+        assert t.go(c) == 'Cat says purr'
+
+    class Parrot(t.Animal):
+        def __getattribute__(self, name):
+            if name == 'what':
+                return lambda: 'squawk'
+            return object.__getattribute__(self, name)
+
+        def what(self):
+            return 'unused'
+
+    assert t.go(Parrot()) == 'Animal says squawk'
+
+    # Instance attributes take precedence over the class
+    class Kitty(t.Animal):
+        def name(self):
+            return 'Kitty'
+
+        def what(self):
+            return 'w'
+
+    a = Kitty()
+    assert t.go(a) == 'Kitty says w'
+    a.name = lambda: 'inst'
+    assert t.go(a) == 'inst says w'
+    del a.name
+    assert t.go(a) == 'Kitty says w'
+
+    # Modifying a base class invalidates the cached function
+    class Bird(t.Animal):
+        def what(self):
+            return 'tweet'
+
+    class Canary(Bird):
+        pass
+
+    c = Canary()
+    assert t.go(c) == 'Animal says tweet'
+    Bird.what = lambda self: 'chirp'
+    assert t.go(c) == 'Animal says chirp'
+
+
+@pytest.mark.skipif(not t.has_tracemalloc, reason="tracemalloc integration unavailable")
+def test52_tracemalloc(clean):
+    import tracemalloc
+
+    def traced(f):
+        tracemalloc.start()
+        try:
+            objs = f()
+            snapshot = tracemalloc.take_snapshot()
+        finally:
+            tracemalloc.stop()
+        stats = snapshot.filter_traces(
+            [tracemalloc.Filter(True, __file__)]).statistics("filename")
+        del objs
+        collect()
+        return sum(s.size for s in stats)
+
+    def create():
+        return ([t.PooledVec(i, 0, -i) for i in range(1000)],
+                [t.Struct.create_take() for i in range(1000)])
+
+    before = traced(create)
+    t.set_tracemalloc(True)
+    try:
+        after = traced(create)
+    finally:
+        t.set_tracemalloc(False)
+
+    # External 'Struct' payloads (4 bytes) and pooled 'PooledVec' instances
+    assert after >= before + 1000 * (4 + 32)
@@ -111,6 +111,26 @@ NB_MODULE(test_eigen_ext, m) {
     });
     m.def("sparse_copy_r", [](const SparseMatrixR &m) -> SparseMatrixR { return m; });
     m.def("sparse_copy_c", [](const SparseMatrixC &m) -> SparseMatrixC { return m; });
+    m.def("sparse_sum_map_c", [](const Eigen::Map<SparseMatrixC> &m) { return m.sum(); });
+    m.def("sparse_sum_map_r", [](const Eigen::Map<SparseMatrixR> &m) { return m.sum(); });
+
+    struct SparseHolder {
+        SparseMatrixC m;
+        const SparseMatrixC &get() const { return m; }
+    };
+
+    nb::class_<SparseHolder>(m, "SparseHolder")
+        .def("__init__", [mat](SparseHolder *h) {
+            new (h) SparseHolder{ Eigen::SparseView<Eigen::MatrixXf>(mat) };
+        })
+        .def("get", &SparseHolder::get, nb::rv_policy::reference_internal)
+        .def("get_copy", &SparseHolder::get)
+        .def("map", [](SparseHolder &h) {
+            return Eigen::Map<SparseMatrixC>(h.m.rows(), h.m.cols(), h.m.nonZeros(),
+                                             h.m.outerIndexPtr(), h.m.innerIndexPtr(),
+                                             h.m.valuePtr());
+        }, nb::rv_policy::reference_internal);
+
     m.def("sparse_r_uncompressed", []() -> SparseMatrixR {
         SparseMatrixR m(2,2);
         m.coeffRef(0,0) = 1.0f;
@@ -150,4 +170,13 @@ NB_MODULE(test_eigen_ext, m) {
     nb::class_<ClassWithEigenMember>(m, "ClassWithEigenMember")
         .def(nb::init<>())
         .def_rw("member", &ClassWithEigenMember::member);
+
+    // Returned temporaries hand their storage to NumPy
+    static uintptr_t moved_address = 0;
+    m.def("moved", []() {
+        Eigen::MatrixXf result = Eigen::MatrixXf::Ones(100, 100);
+        moved_address = (uintptr_t) result.data();
+        return result;
+    });
+    m.def("moved_address", []() { return moved_address; });
 }
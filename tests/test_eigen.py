@@ -272,3 +272,67 @@ def test11_prop():
         gc.collect()
         gc.collect()
         assert np.all(member == ref)
+
+
+@needs_numpy_and_eigen
+def test12_sparse_zero_copy():
+    pytest.importorskip("scipy")
+    import scipy.sparse
+
+    h = t.SparseHolder()
+    ref = h.get_copy().toarray()
+
+    # reference_internal: the arrays reference the C++ storage
+    m = h.get()
+    m.data[0] = 100
+    assert h.get_copy().toarray()[1, 0] == 100
+    assert t.sparse_sum_map_c(h.map()) == ref.sum() - ref[1, 0] + 100
+
+    # The holder is kept alive by the arrays
+    del h
+    gc.collect()
+    assert m.toarray()[1, 0] == 100
+
+    # Maps reference the SciPy arrays
+    c = scipy.sparse.csc_matrix(ref.astype(np.float32))
+    assert t.sparse_sum_map_c(c) == ref.sum()
+    assert t.sparse_sum_map_r(c) == ref.sum()
+
+
+@needs_numpy_and_eigen
+def test13_small_fixed():
+    # Tuples, lists, and 1D buffers are loaded without an ndarray import
+    c = np.array([1, 3, 5], dtype=np.int32)
+    assert np.all(t.addV3i_1((1, 2, 3), np.array([0, 1, 2], dtype=np.int32)) == c)
+    assert np.all(t.addV3i_4([1, 2, 3], np.array([0, 1, 2], dtype=np.int32)) == c)
+    assert np.all(t.addV3i_1(np.int64([1, 2, 3]), np.int32([0, 1, 2])) == c)
+
+    # Sequences still require implicit conversion, and must have the right size
+    with pytest.raises(TypeError) as e:
+        t.addV3i_1(c, [0, 1, 2])
+    assert 'incompatible function arguments' in str(e)
+    with pytest.raises(TypeError) as e:
+        t.addV3i_1((1, 2), c)
+    assert 'incompatible function arguments' in str(e)
+    with pytest.raises(TypeError) as e:
+        t.addV3i_1((1, 2, 'x'), c)
+    assert 'incompatible function arguments' in str(e)
+
+    # Nested sequences are accepted for matrices
+    a = [[i * 4 + j for j in range(4)] for i in range(4)]
+    ref = np.array(a, dtype=np.uint32)
+    r = t.addM4u_1(a, ref)
+    assert r.dtype == np.uint32 and r.shape == (4, 4)
+    assert np.all(r == 2 * ref)
+
+    # Results are regular writable NumPy arrays
+    r = t.addV3i_1((1, 2, 3), c)
+    assert type(r) is np.ndarray and r.dtype == np.int32 and r.shape == (3,)
+    assert r.flags.writeable and r.flags.c_contiguous
+
+
+@needs_numpy_and_eigen
+def test14_move_zero_copy():
+    a = t.moved()
+    assert a.shape == (100, 100) and np.all(a == 1)
+    assert a.__array_interface__['data'][0] == t.moved_address()
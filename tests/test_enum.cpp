@@ -5,6 +5,8 @@ namespace nb = nanobind;
 enum class Enum  : uint32_t { A, B, C = (uint32_t) -1 };
 enum class SEnum : int32_t { A, B, C = (int32_t) -1 };
 enum ClassicEnum { Item1, Item2 };
+enum class Flags : uint32_t { None = 0, Read = 1, Write = 2, Exec = 4,
+                              High = 1u << 31 };
 
 struct EnumProperty { Enum get_enum() { return Enum::A; } };
 
@@ -70,6 +72,18 @@ NB_MODULE(test_enum_ext, m) {
     m.def("from_enum", [](Enum value) { return (uint32_t) value; });
     m.def("to_enum", [](uint32_t value) { return (Enum) value; });
     m.def("from_enum", [](SEnum value) { return (int32_t) value; });
+    m.def("to_senum", [](int32_t value) { return (SEnum) value; });
+    m.def("to_color", [](uint8_t value) { return (Color) value; });
+
+    nb::enum_<Flags>(m, "Flags", nb::is_flag())
+        .value("None_", Flags::None)
+        .value("Read", Flags::Read, "Read access")
+        .value("Write", Flags::Write)
+        .value("Exec", Flags::Exec)
+        .value("High", Flags::High);
+
+    m.def("from_flags", [](Flags value) { return (uint32_t) value; });
+    m.def("to_flags", [](uint32_t value) { return (Flags) value; });
 
     // test for issue #39
     nb::class_<EnumProperty>(m, "EnumProperty")
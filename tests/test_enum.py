@@ -147,3 +147,45 @@ def test08_enum_comparisons():
     assert t.SEnum.B > t.Enum.A
     assert t.Enum.A <= t.SEnum.A and t.Enum.A >= t.SEnum.A
     assert t.Enum.A != t.SEnum.A
+
+
+def test09_enum_from_cpp_identity():
+    # Dense enumerations return the unique instance of each entry
+    for i, name in enumerate(("Black", "Red", "Green", "Yellow", "Blue",
+                              "Magenta", "Cyan", "White")):
+        assert t.to_color(i) is getattr(t.Color, name)
+    for i, name in ((-1, "C"), (0, "A"), (1, "B")):
+        assert t.to_senum(i) is getattr(t.SEnum, name)
+        assert t.to_senum(i) == getattr(t.SEnum, name)
+    assert t.to_senum(2) != t.SEnum.B and int(t.to_senum(2)) == 2
+
+    # Sparse enumerations fall back to a dictionary lookup
+    assert t.to_enum(0xffffffff) is t.Enum.C
+    assert t.Enum.C.__name__ == 'C'
+    assert repr(t.to_enum(1)) == 'test_enum_ext.Enum.B'
+    assert getattr(t.Color, "@dense")[3] == ("Yellow", None, t.Color.Yellow)
+
+
+def test10_enum_flags():
+    F = t.Flags
+    rw = F.Read | F.Write
+    assert type(rw) is F and t.from_flags(rw) == 3 and int(rw) == 3
+    assert repr(rw) == 'test_enum_ext.Flags.Read|Write' and rw.__doc__ is None
+    assert F.Read.__doc__ == 'Read access'
+
+    # Combinations are cached, entries are unique
+    assert F.Read | F.Write is rw and t.to_flags(3) is rw
+    assert rw & F.Write is F.Write and rw ^ F.Read is F.Write
+    assert F.Read & F.Write is F.None_ and rw == t.to_flags(3)
+    assert hash(rw) == 3 and {rw: 1}[t.to_flags(3)] == 1
+
+    # Inversion is relative to the union of all entries
+    assert ~F.Read == F.Write | F.Exec | F.High
+    assert ~(F.Read | F.Write | F.Exec | F.High) is F.None_
+    assert (F.High | F.Exec).__name__ == 'Exec|High'
+    assert t.to_flags(9).__name__ == 'Read|0x8'
+
+    # Mixing with integers uses integer arithmetic
+    assert F.Read | 2 == 3 and type(F.Read | 2) is int
+    with pytest.raises(TypeError):
+        F.Read + F.Write
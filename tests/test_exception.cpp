@@ -17,6 +17,11 @@ public:
     virtual const char *what() const noexcept { return "MyError3"; }
 };
 
+class MyError4 : public std::exception {
+public:
+    virtual const char *what() const noexcept { return "MyError4"; }
+};
+
 NB_MODULE(test_exception_ext, m) {
     m.def("raise_generic", [] { throw std::exception(); });
     m.def("raise_bad_alloc", [] { throw std::bad_alloc(); });
@@ -49,4 +54,16 @@ NB_MODULE(test_exception_ext, m) {
 
     nb::exception<MyError3>(m, "MyError3");
     m.def("raise_my_error_3", [] { throw MyError3(); });
+
+    m.def("raise_my_error_4", [] { throw MyError4(); });
+    m.def("register_my_error_4", [] {
+        nb::register_exception_translator(
+            [](const std::exception_ptr &p, void * /* unused */) {
+                try {
+                    std::rethrow_exception(p);
+                } catch (const MyError4 &e) {
+                    PyErr_SetString(PyExc_KeyError, e.what());
+                }
+            });
+    });
 }
@@ -93,3 +93,24 @@ def test19_raise_my_error_3():
     with pytest.raises(t.MyError3) as excinfo:
         assert t.raise_my_error_3()
     assert str(excinfo.value) == 'MyError3'
+
+def test20_translator_cache():
+    # Repeated translation of the same exception type
+    for _ in range(3):
+        with pytest.raises(IndexError):
+            t.raise_my_error_2()
+        with pytest.raises(RuntimeError):
+            t.raise_my_error_1()
+
+    for _ in range(3):
+        with pytest.raises(RuntimeError) as excinfo:
+            t.raise_my_error_4()
+        assert str(excinfo.value) == 'MyError4'
+
+    # Newly registered translators take precedence over cached lookups
+    t.register_my_error_4()
+    for _ in range(3):
+        with pytest.raises(KeyError):
+            t.raise_my_error_4()
+        with pytest.raises(IndexError):
+            t.raise_my_error_2()
@@ -1,6 +1,14 @@
 #include <nanobind/nanobind.h>
+#include <nanobind/async.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/function.h>
+#include <nanobind/stl/future.h>
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 namespace nb = nanobind;
 using namespace nb::literals;
@@ -14,6 +22,8 @@ struct my_call_guard {
 
 int test_31(int i) noexcept { return i; }
 
+static float test_54_fptr(float x) noexcept { return x * 2.f; }
+
 NB_MODULE(test_functions_ext, m) {
     m.doc() = "function testcase";
 
@@ -223,4 +233,205 @@ NB_MODULE(test_functions_ext, m) {
     m.def("test_cast_str", [](nb::handle h) {
         return nb::cast<const char *>(h);
     });
+
+    // Overload chains exercising the adaptive overload cache
+    m.def("test_36", [](bool) { return 1; });
+    m.def("test_36", [](float) { return 2; });
+    m.def("test_36", [](int8_t) { return 3; });
+    m.def("test_36", [](int64_t) { return 4; });
+    m.def("test_36", [](float, float) { return 5; });
+
+    m.def("test_37", [](bool, int k) { return k; }, "x"_a, "k"_a = 1);
+    m.def("test_37", [](float, int k) { return 10 + k; }, "x"_a, "k"_a = 2);
+
+    // Functions whose creation is deferred until first access
+    {
+        nb::lazy_functions guard;
+        nb::module_ lazy = m.def_submodule("lazy");
+
+        lazy.def("test_40", [](int a, int b) { return a + b; }, "a"_a, "b"_a = 2);
+        lazy.def("test_40", [s = std::string("captured")]() { return s; });
+        lazy.def("test_41", []() { return 41; });
+    }
+
+    // Functions returning awaitables
+    m.def("test_42", nb::async_([](int a, std::string s) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return s + std::to_string(a);
+    }));
+    m.def("test_42_void", nb::async_([]() { }));
+    m.def("test_42_fail", nb::async_([]() -> int {
+        throw std::runtime_error("async failure");
+    }));
+    m.def("test_43", [](int a) {
+        return std::async(std::launch::async, [a]() { return a * 2; });
+    });
+    m.def("test_43_fail", []() {
+        std::promise<float> p;
+        p.set_exception(std::make_exception_ptr(std::runtime_error("future failure")));
+        return p.get_future();
+    });
+
+    // Functions that release the GIL while running
+    m.def("test_44", []() -> bool { return PyGILState_Check(); });
+    m.def("test_44_release", [](const std::string &s) {
+        return std::make_pair(s + "!", (bool) PyGILState_Check());
+    }, nb::release_gil());
+    m.def("test_44_value", [](std::string s, int i) {
+        return std::make_pair(s + std::to_string(i), (bool) PyGILState_Check());
+    }, nb::release_gil());
+
+    {
+        nb::release_gil_default guard;
+        nb::module_ gil = m.def_submodule("gil");
+
+        gil.def("test_45", []() -> bool { return PyGILState_Check(); });
+        gil.def("test_45_keep", []() -> bool { return PyGILState_Check(); },
+                nb::release_gil(false));
+        gil.def("test_45_handle", [](nb::handle) -> bool {
+            return PyGILState_Check();
+        });
+        gil.def("test_45_ndarray", [](nb::ndarray<>) -> bool {
+            return PyGILState_Check();
+        });
+        gil.def("test_45_pair", [](std::pair<nb::object, int>) -> bool {
+            return PyGILState_Check();
+        });
+    }
+
+    // Release a Python callable on a thread that doesn't hold the GIL
+    m.def("test_46", [](std::function<int()> f) {
+        std::thread t([g = std::move(f)]() mutable { g = nullptr; });
+        t.join(); // the GIL remains held when releases are deferred
+    });
+    m.def("set_deferred_decref", &nb::set_deferred_decref);
+    m.def("internals_stats", &nb::internals_stats);
+
+    m.def("test_48", [](nb::handle o, nb::dict d) {
+        static const nb::interned key("value");
+        d[key] = o.attr(key);
+        o.attr(key) = 2;
+        return nb::borrow(key.ptr());
+    });
+
+    m.def("test_48_local", [](const char *value) {
+        nb::interned key(value);
+        return nb::borrow(key.ptr());
+    });
+
+    m.def("test_49", [](nb::callable f, int n) {
+        nb::prepared_call call(f, { "b" });
+        nb::list result;
+        for (int i = 0; i < n; ++i)
+            result.append(call(i, i * 2));
+        return result;
+    });
+
+    m.def("test_49_method", [](nb::handle o, int n) {
+        nb::prepared_call call(o, "append");
+        for (int i = 0; i < n; ++i)
+            call(i);
+        return nb::prepared_call(o, "count")(1);
+    });
+
+    m.def("test_49_fail", [](nb::callable f) {
+        return nb::prepared_call(f, { "a", "b" })(1);
+    });
+
+    // The invalid result of a failed try_call() propagates the Python error
+    m.def("test_50", [](nb::callable f, int value) {
+        return f.try_call(value);
+    });
+
+    m.def("test_50_status", [](nb::callable f) {
+        nb::prepared_call call(f, { "b" });
+        int failures = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (!call.try_call(i, i).is_valid()) {
+                PyErr_Clear();
+                failures++;
+            }
+        }
+        return failures;
+    });
+
+    // Zero-copy views of C++ buffers
+    m.def("test_51_view", [](nb::bytes b) {
+        return nb::memoryview(b.c_str(), b.size(), b);
+    });
+
+    m.def("test_51_string", [](size_t size) {
+        std::string s(size, 'x');
+        return nb::memoryview(std::move(s));
+    });
+
+    m.def("test_51_vector", [](size_t size) {
+        std::vector<char> v(size, 'y');
+        return nb::memoryview(std::move(v), false);
+    });
+
+    // Cooperative interruption of functions that release the GIL
+    static std::atomic<nb::interrupt_token *> test_52_token { nullptr };
+
+    auto test_52_poll = [](nb::interrupt_token &token, double timeout) {
+        auto end = std::chrono::steady_clock::now() +
+                   std::chrono::duration<double>(timeout);
+        test_52_token = &token;
+        bool requested;
+        while (!(requested = token.requested())) {
+            if (std::chrono::steady_clock::now() > end)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        test_52_token = nullptr;
+        return requested;
+    };
+
+    m.def("test_52", [test_52_poll](double timeout) {
+        nb::interrupt_token token;
+        return test_52_poll(token, timeout);
+    }, nb::release_gil());
+
+    // Poll on a worker thread while the GIL was released by hand
+    m.def("test_52_worker", [test_52_poll](double timeout) {
+        nb::interrupt_token token;
+        nb::gil_scoped_release guard;
+        bool requested = false;
+        std::thread worker(
+            [&]() { requested = test_52_poll(token, timeout); });
+        worker.join();
+        return requested;
+    });
+
+    m.def("test_52_cancel", []() {
+        nb::interrupt_token *token = test_52_token;
+        if (token)
+            token->cancel();
+    });
+
+    m.def("test_52_scoped", []() {
+        nb::interrupt_token a, b;
+        a.cancel();
+        return b.requested();
+    });
+
+    // Names of bound functions in the perf map
+    m.def("test_53", &nb::set_perf_map);
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+    m.attr("has_perf_map") = true;
+#else
+    m.attr("has_perf_map") = false;
+#endif
+
+    // C entry points for native callers
+    m.def("test_54", [](double a, long long b) noexcept {
+        return a * (double) b;
+    }, nb::cfunc());
+    m.def("test_54_noargs", []() noexcept -> unsigned char { return 54; },
+          nb::cfunc());
+    m.def("test_54_ptr", [](const void *p, int i) noexcept -> void * {
+        return (void *) ((const char *) p + i);
+    }, nb::cfunc());
+    m.def("test_54_fptr", &test_54_fptr, nb::cfunc());
+    m.def("test_54_plain", [](double a) { return a; });
 }
@@ -322,3 +322,303 @@ def test37_test_str():
     assert t.test_cast_str('abc') == 'abc'
     with pytest.raises(RuntimeError):
         assert t.test_cast_str(123)
+
+
+def test38_overload_cache():
+    for _ in range(3):
+        assert t.test_36(True) == 1
+        assert t.test_36(1.5) == 2
+        assert t.test_36(5) == 3
+        assert t.test_36(500) == 4
+        assert t.test_36(5) == 3
+        assert t.test_36(1.0, 2.0) == 5
+        assert t.test_36(1, 2) == 5
+        assert t.test_36(1.0, 2.0) == 5
+        with pytest.raises(TypeError):
+            t.test_36("x")
+
+    for _ in range(3):
+        assert t.test_37(True) == 1
+        assert t.test_37(1.5) == 12
+        assert t.test_37(1) == 12
+        assert t.test_37(False, k=5) == 5
+        assert t.test_37(x=1.5, k=5) == 15
+        assert t.test_37(True) == 1
+
+
+def test39_kwargs_lookup():
+    # Keyword names that are not interned are matched by value
+    j, k = ''.join(['j']), ''.join(['k'])
+    assert t.test_02(**{k: 5, j: 3}) == -2
+    assert t.test_37(**{''.join(['x']): 1.5, k: 4}) == 14
+    with pytest.raises(TypeError):
+        t.test_02(**{''.join(['l']): 5})
+    with pytest.raises(TypeError):
+        t.test_02(3, j=5)
+
+
+def test40_lazy_functions():
+    lazy = t.lazy
+    assert 'test_40' not in lazy.__dict__
+    assert 'test_40' in dir(lazy) and 'test_41' in dir(lazy)
+    assert lazy.test_40(1) == 3
+    assert lazy.test_40(a=1, b=3) == 4
+    assert lazy.test_40() == "captured"
+    assert 'test_40' in lazy.__dict__
+    assert 'test_41' not in lazy.__dict__
+    from test_functions_ext.lazy import test_41
+    assert test_41() == 41
+    with pytest.raises(AttributeError) as excinfo:
+        lazy.test_42
+    assert "has no attribute 'test_42'" in str(excinfo.value)
+
+
+def test41_map():
+    assert t.test_03.map([]) == []
+    assert t.test_03.starmap([(1, 2), [3, 4]]) == [t.test_03(1, 2), t.test_03(3, 4)]
+    assert t.test_05.map([1, 1.5]) == [1, 2]
+    assert t.test_02.starmap([(), (1,), (2, 3)]) == [t.test_02(), t.test_02(1), t.test_02(2, 3)]
+    assert t.test_12.map(iter(["a", "b"])) == ["a", "b"]
+
+    with pytest.raises(TypeError) as excinfo:
+        t.test_03.starmap([(1, 2), (1, "x")])
+    assert "incompatible function arguments" in str(excinfo.value)
+
+    with pytest.raises(RuntimeError) as excinfo:
+        t.test_06.starmap([()])
+    assert str(excinfo.value) == "oops!"
+
+
+def test42_async():
+    import asyncio
+
+    async def main():
+        r = await asyncio.gather(*[t.test_42(i, "x") for i in range(5)])
+        assert r == ["x%i" % i for i in range(5)]
+        assert await t.test_42_void() is None
+        with pytest.raises(RuntimeError) as excinfo:
+            await t.test_42_fail()
+        assert str(excinfo.value) == "async failure"
+
+    asyncio.run(main())
+
+    with pytest.raises(RuntimeError):
+        t.test_42(1, "x")  # no running event loop
+
+
+def test43_future():
+    import asyncio
+
+    async def main():
+        assert await t.test_43(21) == 42
+        with pytest.raises(RuntimeError) as excinfo:
+            await t.test_43_fail()
+        assert str(excinfo.value) == "future failure"
+
+    asyncio.run(main())
+    assert t.test_43.__doc__.startswith("test_43(arg: int, /) -> asyncio.Future[int]")
+
+
+def test44_release_gil():
+    assert t.test_44()
+    assert t.test_44_release("x") == ("x!", False)
+    assert t.test_44_value("x", 5) == ("x5", False)
+
+    with pytest.raises(TypeError):
+        t.test_44_release(1)
+
+    assert not t.gil.test_45()
+    assert t.gil.test_45_keep()
+    assert t.gil.test_45_handle(1)
+    assert t.gil.test_45_pair(("x", 1))
+
+    import array
+    assert t.gil.test_45_ndarray(array.array('d', [1, 2]))
+
+
+def test46_deferred_decref():
+    import weakref
+
+    f = lambda: 1
+    ref = weakref.ref(f)
+    t.set_deferred_decref(True)
+    try:
+        t.test_46(f)
+        del f
+        t.test_01()  # the dispatcher releases queued references
+        assert ref() is None
+    finally:
+        t.set_deferred_decref(False)
+
+
+def test47_internals_stats():
+    s = t.internals_stats()
+    for k in ("inst_c2p", "keep_alive", "type_c2p", "funcs", "descrs"):
+        m = s[k]
+        assert set(m) == {"size", "capacity", "load_factor", "max_probe"}
+        assert m["size"] <= m["capacity"] or m["capacity"] == 0
+        assert m["max_probe"] <= m["size"]
+    assert s["funcs"]["size"] > 0
+    assert 0 < s["funcs"]["load_factor"] <= 1
+    assert s["descrs"]["size"] > 0
+    assert set(s["inst_seq"]) == {"chains", "instances", "max_length"}
+    assert s["ndarray_handles"] >= 0
+
+
+def test48_interned():
+    class C:
+        value = 1
+
+    c, d = C(), {}
+    key = t.test_48(c, d)
+    assert key == "value" and d == {"value": 1} and c.value == 2
+    assert t.test_48(c, d) is key and d == {"value": 2}
+
+    # Short-lived keys may reuse the address of an earlier one
+    assert [t.test_48_local(s) for s in ("a", "b", "a")] == ["a", "b", "a"]
+
+
+def test49_prepared_call():
+    assert t.test_49(lambda a, b: (a, b), 3) == [(0, 0), (1, 2), (2, 4)]
+    assert t.test_49(lambda *a, **k: (a, k), 1) == [((0,), {"b": 0})]
+
+    items = []
+    assert t.test_49_method(items, 4) == 1
+    assert items == [0, 1, 2, 3]
+
+    with pytest.raises(RuntimeError, match="expected at least 2 arguments"):
+        t.test_49_fail(lambda a, b: None)
+    with pytest.raises(TypeError):
+        t.test_49(lambda a: None, 1)
+
+
+def test50_try_call():
+    def f(value):
+        if value < 0:
+            raise ValueError("negative")
+        return value
+
+    assert t.test_50(f, 1) == 1
+    with pytest.raises(ValueError, match="negative"):
+        t.test_50(f, -1)
+
+    def g(a, b):
+        if a % 2:
+            raise KeyError(a)
+
+    assert t.test_50_status(g) == 2
+
+
+def test51_memoryview():
+    import gc
+
+    b = b"hello world"
+    v = t.test_51_view(b)
+    assert isinstance(v, memoryview)
+    assert v.readonly and v.format == "B" and v.nbytes == 11
+    assert v.tobytes() == b"hello world"
+    with pytest.raises(TypeError):
+        v[0] = 1
+
+    # The view keeps the owner alive
+    del b
+    gc.collect()
+    assert bytes(v[:5]) == b"hello"
+
+    v = t.test_51_string(1 << 20)
+    assert v.nbytes == 1 << 20 and v[0] == ord("x") and v[-1] == ord("x")
+
+    v = t.test_51_vector(4)
+    assert not v.readonly
+    v[1] = ord("z")
+    assert v.tobytes() == b"yzyy"
+
+
+def test52_interrupt_token():
+    import os, signal, threading, time
+
+    assert t.test_52(0.01) is False
+    assert t.test_52_worker(0.01) is False
+
+    triggers = [t.test_52_cancel]
+    if sys.platform != 'win32':
+        triggers.append(lambda: os.kill(os.getpid(), signal.SIGINT))
+
+    for func in (t.test_52, t.test_52_worker):
+        for trigger in triggers:
+            timer = threading.Timer(0.1, trigger)
+            timer.start()
+            start = time.time()
+            with pytest.raises(KeyboardInterrupt):
+                func(5)
+            assert time.time() - start < 3
+            timer.join()
+
+        # Observed interruptions don't leak into subsequent calls
+        assert func(0.01) is False
+
+    # Cancellation only affects the cancelled token
+    assert t.test_52_scoped() is False
+
+
+@pytest.mark.skipif(not t.has_perf_map, reason="perf maps are unsupported")
+def test53_perf_map():
+    import os
+
+    path = "/tmp/perf-%i.map" % os.getpid()
+    existed = os.path.exists(path)
+
+    t.test_53(True)
+    try:
+        # Calls are routed through the stubs, including exceptions
+        assert t.test_02(5, 3) == 2
+        assert t.test_05(1) == 1 and t.test_05(1.5) == 2
+        with pytest.raises(RuntimeError, match="oops!"):
+            t.test_06()
+
+        with open(path) as f:
+            names = set(line.split(" ", 2)[2] for line in f.read().splitlines())
+    finally:
+        t.test_53(False)
+        if not existed:
+            os.unlink(path)
+
+    assert "nb::test_functions_ext.test_02" in names
+    assert "nb::test_functions_ext.test_05" in names
+    assert "nb::test_functions_ext.test_05 (overload 2)" in names
+
+
+def test54_cfunc():
+    import ctypes
+
+    def entry(f):
+        cap = f.__nb_cfunc__
+        get_name = ctypes.pythonapi.PyCapsule_GetName
+        get_name.restype, get_name.argtypes = ctypes.c_char_p, [ctypes.py_object]
+        get_ptr = ctypes.pythonapi.PyCapsule_GetPointer
+        get_ptr.restype = ctypes.c_void_p
+        get_ptr.argtypes = [ctypes.py_object, ctypes.c_char_p]
+        name = get_name(cap)
+        return name.decode(), get_ptr(cap, name)
+
+    # The capsule name is the C signature of the entry point
+    sig, ptr = entry(t.test_54)
+    assert sig == "double (double, long long)"
+    f = ctypes.CFUNCTYPE(ctypes.c_double, ctypes.c_double, ctypes.c_longlong)(ptr)
+    assert f(1.5, 4) == 6.0 and t.test_54(1.5, 4) == 6.0
+
+    sig, ptr = entry(t.test_54_noargs)
+    assert sig == "unsigned char (void)"
+    assert ctypes.CFUNCTYPE(ctypes.c_ubyte)(ptr)() == 54
+
+    sig, ptr = entry(t.test_54_ptr)
+    assert sig == "void * (const void *, int)"
+    f = ctypes.CFUNCTYPE(ctypes.c_void_p, ctypes.c_void_p, ctypes.c_int)(ptr)
+    assert f(1000, 24) == 1024
+
+    sig, ptr = entry(t.test_54_fptr)
+    assert sig == "float (float)"
+    assert ctypes.CFUNCTYPE(ctypes.c_float, ctypes.c_float)(ptr)(1.5) == 3.0
+
+    assert not hasattr(t.test_54_plain, "__nb_cfunc__")
+    assert not hasattr(t.test_05, "__nb_cfunc__")
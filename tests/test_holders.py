@@ -89,11 +89,11 @@ def test05_uniqueptr_from_cpp(clean):
     with pytest.warns(RuntimeWarning, match='nanobind: attempted to access an uninitialized instance of type \'test_holders_ext.Example\'!'):
         with pytest.raises(TypeError) as excinfo:
             assert a.value == 1
-        assert 'incompatible function arguments' in str(excinfo.value)
+        assert 'uninitialized instance' in str(excinfo.value)
     with pytest.warns(RuntimeWarning, match='nanobind: attempted to access an uninitialized instance of type \'test_holders_ext.Example\'!'):
         with pytest.raises(TypeError) as excinfo:
             assert b.value == 2
-        assert 'incompatible function arguments' in str(excinfo.value)
+        assert 'uninitialized instance' in str(excinfo.value)
     del a, b
     del wa, wb
     collect()
@@ -127,7 +127,7 @@ def test06_uniqueptr_from_py(clean):
     with pytest.warns(RuntimeWarning, match='nanobind: attempted to access an uninitialized instance of type \'test_holders_ext.Example\'!'):
         with pytest.raises(TypeError) as excinfo:
             assert a.value == 1
-        assert 'incompatible function arguments' in str(excinfo.value)
+        assert 'uninitialized instance' in str(excinfo.value)
     a2 = wa.get()
     assert a2.value == 1 and a is a2
     del a, a2
@@ -345,3 +345,39 @@ def test13_shared_from_this_create_derived_in_cpp(clean):
     del e, w
     collect()
     assert t.stats() == (1, 1)
+
+
+def test14_sharedptr_from_python_reuse(clean):
+    # Repeated conversions of an instance share one shared_ptr control block
+    e = t.Example(7)
+    assert t.same_owner(e, e)
+    w1 = t.SharedWrapper(e)
+    w2 = t.SharedWrapper(e)
+    w2.ptr = w1.ptr
+    assert w1.ptr is e and w2.ptr is e
+    del e
+    collect()
+    assert t.stats() == (1, 0)
+    del w1
+    collect()
+    assert t.stats() == (1, 0)
+    del w2
+    collect()
+    assert t.stats() == (1, 1)
+
+    # A new control block is created once the cached one has expired
+    e = t.Example(8)
+    w = t.SharedWrapper(e)
+    del w
+    collect()
+    w = t.SharedWrapper(e)
+    assert t.same_owner(e, w.ptr)
+    del e, w
+    collect()
+    assert t.stats() == (2, 2)
+
+    f = t.Example.make_shared(9)
+    assert t.same_owner(f, f)
+    del f
+    collect()
+    assert t.stats() == (3, 3)
@@ -47,7 +47,8 @@ NB_MODULE(test_intrusive_ext, m) {
     nb::class_<Object>(
         m, "Object",
         nb::intrusive_ptr<Object>(
-            [](Object *o, PyObject *po) noexcept { o->set_self_py(po); }));
+            [](Object *o, PyObject *po) noexcept { o->set_self_py(po); },
+            [](Object *o) noexcept { return o->self_py(); }));
 
     nb::class_<Test, Object, PyTest>(m, "Test")
         .def(nb::init<>())
@@ -67,4 +68,7 @@ NB_MODULE(test_intrusive_ext, m) {
     m.def("get_value_1", [](Test *o) { ref<Test> x(o); return x->value(1); });
     m.def("get_value_2", [](ref<Test> x) { return x->value(2); });
     m.def("get_value_3", [](const ref<Test> &x) { return x->value(3); });
+
+    m.def("identity_raw", [](Test *o) { return o; });
+    m.def("identity_ref", [](ref<Test> o) { return o; });
 }
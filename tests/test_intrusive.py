@@ -56,3 +56,16 @@ def test04_subclass(clean):
     del o
     collect()
     assert t.stats() == (1, 1)
+
+
+def test05_identity(clean):
+    class MyTest(t.Test):
+        pass
+
+    for o in (t.Test(), t.Test.create_raw(), t.Test.create_ref(), MyTest()):
+        assert t.identity_raw(o) is o
+        assert t.identity_ref(o) is o
+        assert t.identity_raw(t.identity_ref(o)) is o
+    del o
+    collect()
+    assert t.stats() == (4, 4)
@@ -1,8 +1,28 @@
 #include <nanobind/make_iterator.h>
+#include <nanobind/ndarray_iterator.h>
 #include <nanobind/stl/unordered_map.h>
 #include <nanobind/stl/string.h>
+#include <chrono>
+#include <optional>
+#include <thread>
 
 namespace nb = nanobind;
+using namespace nb::literals;
+
+/// Counts from 0 upwards, dereferencing the value 13 throws an exception
+struct CountingIterator {
+    int value;
+
+    int operator*() const {
+        if (value == 13)
+            throw std::runtime_error("unlucky number");
+        return value;
+    }
+
+    CountingIterator &operator++() { ++value; return *this; }
+    bool operator==(const CountingIterator &o) const { return value == o.value; }
+    bool operator!=(const CountingIterator &o) const { return value != o.value; }
+};
 
 NB_MODULE(test_make_iterator_ext, m) {
     struct StringMap {
@@ -35,8 +55,58 @@ NB_MODULE(test_make_iterator_ext, m) {
                                            map.end());
         }, nb::keep_alive<0, 1>());
 
+    struct IntRange { int n; };
+
+    nb::class_<IntRange>(m, "IntRange")
+        .def(nb::init<int>())
+        .def("__iter__",
+             [](const IntRange &r) {
+                 return nb::make_iterator(nb::type<IntRange>(), "iterator",
+                                          CountingIterator{ 0 },
+                                          CountingIterator{ r.n });
+             }, nb::keep_alive<0, 1>())
+        .def("chunks",
+             [](const IntRange &r, size_t chunk_size) {
+                 return nb::make_chunked_iterator(nb::type<IntRange>(),
+                                                  "chunk_iterator",
+                                                  CountingIterator{ 0 },
+                                                  CountingIterator{ r.n },
+                                                  chunk_size);
+             }, nb::keep_alive<0, 1>());
+
     nb::handle mod = m;
     m.def("iterator_passthrough", [mod](nb::iterator s) -> nb::iterator {
         return nb::make_iterator(mod, "pt_iterator", std::begin(s), std::end(s));
     });
+
+    // Streams the integers 0..n-1 (and fails at 13 if requested)
+    m.def("int_stream", [mod](int n, size_t chunk_size, size_t buffers, bool fail,
+                              bool gil) {
+        auto producer = [i = 0, n, fail, gil](int32_t *out, size_t size) mutable {
+            std::optional<nb::gil_scoped_acquire> guard;
+            if (gil) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                guard.emplace();
+            }
+            size_t count = 0;
+            for (; count < size && i < n; ++count, ++i) {
+                if (fail && i == 13)
+                    throw std::runtime_error("unlucky number");
+                out[count] = i;
+            }
+            return count;
+        };
+
+        return nb::make_ndarray_iterator<int32_t>(mod, "int_stream_iterator",
+                                                  producer, chunk_size,
+                                                  buffers);
+    }, "n"_a, "chunk_size"_a, "buffers"_a = 2, "fail"_a = false,
+       "gil"_a = false);
+
+    m.def("int_array_list", [](nb::ndarray<const int32_t, nb::shape<nb::any>> a) {
+        nb::list result;
+        for (size_t i = 0; i < a.shape(0); ++i)
+            result.append(a.data()[i]);
+        return result;
+    });
 }
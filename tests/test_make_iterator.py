@@ -33,3 +33,72 @@ def test04_passthrough_iterator():
     for d in data:
         m = t.StringMap(d)
         assert list(t.iterator_passthrough(m.values())) == list(m.values())
+
+
+def test05_native_next():
+    it = iter(t.IntRange(3))
+    assert iter(it) is it
+    assert next(it) == 0
+    assert it.__next__() == 1
+    assert list(it) == [2]
+
+    # Exhausted iterators remain exhausted
+    with pytest.raises(StopIteration):
+        next(it)
+    assert list(it) == []
+
+    # C++ exceptions are translated
+    with pytest.raises(RuntimeError, match='unlucky number'):
+        list(t.IntRange(20))
+
+
+def test06_chunked_iterator():
+    assert list(t.IntRange(0).chunks(4)) == []
+    assert list(t.IntRange(10).chunks(4)) == [[0, 1, 2, 3], [4, 5, 6, 7], [8, 9]]
+    assert list(t.IntRange(8).chunks(4)) == [[0, 1, 2, 3], [4, 5, 6, 7]]
+    assert list(t.IntRange(3).chunks(1)) == [[0], [1], [2]]
+
+    it = t.IntRange(20).chunks(10)
+    assert next(it) == list(range(10))
+    with pytest.raises(RuntimeError, match='unlucky number'):
+        next(it)
+
+    with pytest.raises(ValueError):
+        t.IntRange(3).chunks(0)
+
+
+def test07_ndarray_iterator():
+    def chunks(*args, **kwargs):
+        return [t.int_array_list(a) for a in t.int_stream(*args, **kwargs)]
+
+    assert chunks(0, 4) == []
+    assert chunks(10, 4) == [[0, 1, 2, 3], [4, 5, 6, 7], [8, 9]]
+    assert chunks(8, 4, buffers=1) == [[0, 1, 2, 3], [4, 5, 6, 7]]
+    assert sum(chunks(10000, 64, buffers=3), []) == list(range(10000))
+
+    with pytest.raises(RuntimeError, match='unlucky number'):
+        chunks(20, 10, fail=True)
+
+    # Buffers are reused once the arrays are released
+    it = t.int_stream(100, 10)
+    held = [next(it), next(it)]
+    with pytest.raises(RuntimeError, match='all buffers are referenced'):
+        next(it)
+    assert t.int_array_list(held[1]) == list(range(10, 20))
+    del held
+    assert t.int_array_list(next(it)) == list(range(20, 30))
+
+    # Arrays remain valid after the iterator is destroyed
+    it = t.int_stream(100, 10)
+    a = next(it)
+    del it
+    assert t.int_array_list(a) == list(range(10))
+
+    # Destroying the iterator lets a producer that needs the GIL finish
+    it = t.int_stream(100, 10, buffers=4, gil=True)
+    a = next(it)
+    del it
+    assert t.int_array_list(a) == list(range(10))
+
+    with pytest.raises(ValueError):
+        t.int_stream(10, 0)
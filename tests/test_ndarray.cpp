@@ -1,6 +1,13 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/vectorize.h>
+#include <nanobind/parallel.h>
+#include <nanobind/stl/pair.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include <vector>
 
 namespace nb = nanobind;
@@ -9,6 +16,8 @@ using namespace nb::literals;
 
 int destruct_count = 0;
 
+static float fma3(float a, float b, int32_t c) { return a * b + (float) c; }
+
 NB_MODULE(test_ndarray_ext, m) {
     m.def("get_shape", [](const nb::ndarray<> &t) {
         nb::list l;
@@ -133,6 +142,76 @@ NB_MODULE(test_ndarray_ext, m) {
 
         return nb::ndarray<float, nb::shape<2, 4>>(f, 2, shape, deleter);
     });
+    m.def("release_in_threads", [](size_t n) {
+        float *f = new float[8] { };
+        size_t shape[1] = { 8 };
+
+        nb::capsule deleter(f, [](void *data) noexcept {
+            destruct_count++;
+            delete[] (float *) data;
+        });
+
+        nb::ndarray<float> a(f, 1, shape, deleter);
+        deleter.reset();
+
+        // Copy and destroy the array on worker threads, which don't hold the GIL
+        nb::gil_scoped_release guard;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < n; ++i)
+            threads.emplace_back([a]() { nb::ndarray<float> b = a; });
+        a = nb::ndarray<float>();
+        for (std::thread &t : threads)
+            t.join();
+    });
+
+    m.def("return_dlpack_versioned", [](bool readonly, int32_t device_type) {
+        struct tensor_versioned {
+            uint32_t major, minor;
+            void *manager_ctx;
+            void (*deleter)(tensor_versioned *);
+            uint64_t flags;
+            nb::dlpack::dltensor dltensor;
+            float data[8];
+            int64_t shape[2];
+        };
+
+        tensor_versioned *t = new tensor_versioned();
+        t->major = 1;
+        t->deleter = [](tensor_versioned *t2) {
+            destruct_count++;
+            delete t2;
+        };
+        t->flags = readonly ? 1 : 0;
+        t->dltensor.data = t->data;
+        t->dltensor.device.device_type = device_type;
+        t->dltensor.ndim = 2;
+        t->dltensor.dtype = nb::dtype<float>();
+        t->shape[0] = 2;
+        t->shape[1] = 4;
+        t->dltensor.shape = t->shape;
+
+        return nb::steal(PyCapsule_New(t, "dltensor_versioned", [](PyObject *o) {
+            tensor_versioned *t2 = (tensor_versioned *)
+                PyCapsule_GetPointer(o, "dltensor_versioned");
+            if (t2)
+                t2->deleter(t2);
+            else
+                PyErr_Clear();
+        }));
+    });
+
+    m.def("get_shape_ro", [](const nb::ndarray<nb::ro> &t) {
+        nb::list l;
+        for (size_t i = 0; i < t.ndim(); ++i)
+            l.append(t.shape(i));
+        return l;
+    });
+
+    m.def("get_ndim_on_stream", [](nb::handle h, intptr_t stream) {
+        nb::ndarray_stream guard(stream);
+        return nb::cast<nb::ndarray<>>(h).ndim();
+    });
+
     m.def("passthrough", [](nb::ndarray<> a) { return a; });
 
     m.def("ret_numpy", []() {
@@ -181,4 +260,189 @@ NB_MODULE(test_ndarray_ext, m) {
         "noop_2d_f_contig",
         [](nb::ndarray<float, nb::shape<nb::any, nb::any>, nb::f_contig>) { return; });
 
+    m.def("vectorize_add",
+          nb::vectorize([](double a, double b) { return a + b; }));
+
+    m.def("vectorize_fma", nb::vectorize(fma3, 4), "a"_a, "b"_a, "c"_a);
+
+    m.def("ret_vector", [](size_t n) {
+        std::vector<double> v(n);
+        for (size_t i = 0; i < n; ++i)
+            v[i] = (double) i;
+        return nb::vector_ndarray<double>(std::move(v));
+    });
+
+    m.def("ret_vector_numpy", [](size_t n) {
+        return nb::vector_ndarray<float, nb::numpy>(std::vector<float>(n, 1.f));
+    });
+
+    m.def("sum_vector", [](const nb::vector_ndarray<int32_t> &v) {
+        int64_t sum = 0;
+        for (int32_t value : v.value)
+            sum += value;
+        return sum;
+    });
+
+    m.def("convert_i16", [](nb::ndarray<int16_t, nb::shape<nb::any>> a) {
+        std::vector<int16_t> result(a.data(), a.data() + a.shape(0));
+        return result;
+    });
+
+    m.def("convert_f32_f",
+          [](nb::ndarray<float, nb::f_contig, nb::shape<nb::any, nb::any>> a) {
+              std::vector<float> result(a.data(), a.data() + a.size());
+              return std::make_pair(result, a.stride(1));
+          });
+
+    m.def("convert_bool", [](nb::ndarray<bool, nb::shape<nb::any>> a) {
+        nb::list result;
+        for (size_t i = 0; i < a.shape(0); ++i)
+            result.append(a(i));
+        return result;
+    });
+
+    m.def("sum_f16", [](nb::ndarray<nb::float16, nb::shape<nb::any>> a) {
+        float result = 0;
+        for (size_t i = 0; i < a.shape(0); ++i)
+            result += (float) a(i);
+        return result;
+    });
+
+    m.def("ret_f16", [](size_t n) {
+        nb::float16 *data = new nb::float16[n];
+        for (size_t i = 0; i < n; ++i)
+            data[i] = nb::float16(i * 0.5f);
+        nb::capsule deleter(data, [](void *p) noexcept {
+            delete[] (nb::float16 *) p;
+        });
+        size_t shape[1] = { n };
+        return nb::ndarray<nb::float16, nb::shape<nb::any>>(data, 1, shape, deleter);
+    });
+
+    m.def("convert_bf16", [](nb::ndarray<nb::bfloat16, nb::shape<nb::any>> a) {
+        nb::list result;
+        for (size_t i = 0; i < a.shape(0); ++i)
+            result.append(a(i));
+        return result;
+    });
+
+    m.def("half_roundtrip", [](nb::float16 h) { return h; });
+
+    m.def("mmap_f32", [](const char *path, std::vector<size_t> shape,
+                         uint64_t offset, bool cow) {
+        return nb::ndarray_mmap<float>(
+            path, shape.size(), shape.data(), offset,
+            cow ? nb::mmap_mode::copy_on_write : nb::mmap_mode::read_only,
+            nb::mmap_advice::sequential);
+    });
+
+    m.def("mmap_fill", [](const char *path, size_t size, float value) {
+        size_t shape[1] = { size };
+        auto a = nb::ndarray_mmap<float, nb::shape<nb::any>>(
+            path, 1, shape, 0, nb::mmap_mode::copy_on_write);
+        for (size_t i = 0; i < size; ++i)
+            a(i) = value;
+        return a;
+    });
+
+    m.def("string_table", [](const std::vector<std::string> &strings) {
+        return nb::string_table<>(strings);
+    });
+
+    m.def("string_table_unpack", [](const nb::string_table<> &table) {
+        std::vector<std::string> result;
+        for (size_t i = 0; i < table.size(); ++i)
+            result.emplace_back(table.data.data() + table.offsets[i],
+                                table.data.data() + table.offsets[i + 1]);
+        return result;
+    });
+
+    nb::ndarray_shm_pickle(m);
+    m.def("shm_iota", [](size_t size) {
+        size_t shape[1] = { size };
+        auto a = nb::ndarray_shm<nb::buffer, float, nb::shape<nb::any>>(1, shape);
+        for (size_t i = 0; i < size; ++i)
+            a(i) = (float) i;
+        return a;
+    });
+
+    m.def("alloc_iota", [](size_t rows, size_t cols) {
+        size_t shape[2] = { rows, cols };
+        auto a = nb::ndarray_alloc<float, nb::shape<nb::any, nb::any>>(2, shape);
+        for (size_t i = 0; i < rows * cols; ++i)
+            a.data()[i] = (float) i;
+        return std::make_pair(a, (uintptr_t) a.data());
+    });
+
+    m.def("view_sum_c", [](nb::ndarray<float, nb::shape<nb::any, 3>, nb::c_contig> a) {
+        auto v = a.view();
+        float result = 0;
+        for (size_t i = 0; i < v.shape(0); ++i)
+            for (size_t j = 0; j < v.shape(1); ++j)
+                result += v(i, j) * (float) (j + 1);
+        return result;
+    });
+
+    m.def("view_scale_f", [](nb::ndarray<float, nb::f_contig, nb::shape<nb::any, nb::any>> a,
+                             float scale) {
+        auto v = a.view();
+        for (size_t j = 0; j < v.shape(1); ++j)
+            for (size_t i = 0; i < v.shape(0); ++i)
+                v(i, j) *= scale;
+    });
+
+    m.def("view_row_sums", [](nb::ndarray<> a) {
+        auto v = a.view<double, nb::shape<nb::any, nb::any>>();
+        nb::list result;
+        for (size_t i = 0; i < v.shape(0); ++i) {
+            auto row = v.row(i);
+            double sum = 0;
+            for (size_t j = 0; j < row.shape(0); ++j)
+                sum += row(j);
+            result.append(sum);
+        }
+        return result;
+    });
+
+    m.def("parallel_square", [](nb::ndarray<float, nb::shape<nb::any>, nb::c_contig> a) {
+        float *data = a.data();
+        nb::parallel_for(a, [data](size_t start, size_t end) {
+            for (size_t i = start; i < end; ++i)
+                data[i] *= data[i];
+        }, 16);
+    });
+
+    m.def("parallel_fail", [](size_t size, size_t at) {
+        nb::parallel_for(size, [at](size_t start, size_t end) {
+            if (start <= at && at < end)
+                throw std::runtime_error("parallel_fail");
+        });
+    });
+
+    m.def("parallel_sleep", [](size_t size) {
+        nb::parallel_for(size, [](size_t start, size_t end) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(end - start));
+        });
+    });
+
+    m.def("parallel_nested", [](size_t size) {
+        std::atomic<size_t> count { 0 }, holds_gil { 0 };
+        nb::parallel_for(size, [&](size_t start, size_t end) {
+            holds_gil += (size_t) PyGILState_Check();
+            nb::parallel_for(size, [&](size_t start2, size_t end2) {
+                count += (end - start) * (end2 - start2);
+            });
+        });
+        return std::make_pair(count.load(), holds_gil.load());
+    });
+
+    m.def("set_parallel_threads", &nb::set_parallel_threads);
+    m.def("parallel_threads", &nb::parallel_threads);
+
+    m.def("sum_f32", [](nb::ndarray<float, nb::c_contig, nb::ro> a) {
+        double result = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+            result += a.data()[i];
+        return result;
+    });
 }
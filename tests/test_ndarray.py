@@ -2,6 +2,8 @@ import test_ndarray_ext as t
 import pytest
 import warnings
 import importlib
+import os
+import sys
 from common import collect
 
 try:
@@ -415,3 +417,429 @@ def test21_single_and_empty_dimension_fortran_order_pytorch():
     t.noop_2d_f_contig(a)
     a = torch.ones((100,1), dtype=torch.float32).t().contiguous().t()
     t.noop_2d_f_contig(a)
+
+
+def test22_vectorize_scalar():
+    assert t.vectorize_add(1, 2.5) == 3.5
+    assert t.vectorize_fma(2, 3, c=1) == 7
+    assert 'float | ndarray[dtype=float64]' in t.vectorize_add.__doc__
+
+
+@needs_numpy
+def test23_vectorize_broadcast():
+    a = np.arange(6, dtype=np.float64).reshape(2, 3)
+    b = np.array([10, 20, 30], dtype=np.float64)
+    assert np.all(t.vectorize_add(a, b) == a + b)
+    assert np.all(t.vectorize_add(a, 1) == a + 1)
+    assert np.all(t.vectorize_add(a.T, b[:2]) == a.T + b[:2])
+    assert np.all(t.vectorize_add(b[::2], 1) == b[::2] + 1)
+    assert t.vectorize_add(a, b).shape == (2, 3)
+    assert t.vectorize_add(np.zeros((0, 3)), b).shape == (0, 3)
+
+    with pytest.raises(ValueError) as excinfo:
+        t.vectorize_add(a, np.zeros(2))
+    assert 'could not be broadcast' in str(excinfo.value)
+
+
+@needs_numpy
+def test24_vectorize_threads():
+    a = np.linspace(0, 1, 1000000, dtype=np.float32)
+    c = np.arange(1000000, dtype=np.int32)
+    r = t.vectorize_fma(a, 2, c)
+    assert r.dtype == np.float32
+    assert np.allclose(r, a * 2 + c)
+
+
+def test25_vector_ndarray():
+    import array
+    x = t.ret_vector(5)
+    assert t.get_shape(x) == [5]
+    assert t.get_itemsize(t.ret_vector(2)) == 8
+    assert t.sum_vector(array.array('i', [1, 2, 3])) == 6
+    assert t.sum_vector(array.array('h', [1, 2])) == 3
+    with pytest.raises(TypeError):
+        t.sum_vector([1, 2])
+    assert 'ndarray[dtype=float64, shape=(*)]' in t.ret_vector.__doc__
+
+
+@needs_numpy
+def test26_vector_ndarray_numpy():
+    x = t.ret_vector_numpy(4)
+    assert x.dtype == np.float32 and x.shape == (4,)
+    assert np.all(x == 1)
+    assert not x.flags.owndata
+
+
+def test27_import_route_cache():
+    import array
+
+    # Repeated imports use the cached route of each type
+    for _ in range(3):
+        assert t.get_shape(array.array('f', [1, 2, 3])) == [3]
+        assert t.get_shape(memoryview(bytearray(b'1234'))) == [4]
+        with pytest.raises(TypeError):
+            t.get_shape([1, 2])
+
+    # __dlpack__ takes precedence, other protocols remain available
+    class Buffer(bytearray):
+        def __dlpack__(self):
+            if len(self) == 2:
+                raise RuntimeError('unsupported')
+            return t.return_dlpack()
+
+    assert t.get_shape(Buffer(b'12')) == [2]
+    assert t.get_shape(Buffer(b'123')) == [2, 4]
+    assert t.get_shape(Buffer(b'12')) == [2]
+    assert t.get_shape(Buffer(b'123')) == [2, 4]
+
+    # Failures of mutable types are not cached
+    class Late:
+        pass
+
+    with pytest.raises(TypeError):
+        t.get_shape(Late())
+    Late.__dlpack__ = lambda self: t.return_dlpack()
+    assert t.get_shape(Late()) == [2, 4]
+
+    # Cached routes are forgotten when the type is modified
+    class Grows(bytearray):
+        pass
+
+    assert t.get_shape(Grows(b'12')) == [2]
+    Grows.__dlpack__ = lambda self: t.return_dlpack()
+    assert t.get_shape(Grows(b'12')) == [2, 4]
+
+
+def test28_convert_host_memory():
+    import array
+
+    assert t.convert_i16(array.array('q', [1, -2, 3])) == [1, -2, 3]
+    assert t.convert_i16(array.array('d', [1.5, -2.5, 1e10])) == [1, -2, 32767]
+    assert t.convert_i16(memoryview(array.array('q', [1, 2, 3]))[::-1]) == [3, 2, 1]
+    assert t.convert_bool(array.array('f', [0, 2, -1])) == [False, True, True]
+    with pytest.raises(TypeError):
+        t.convert_i16(memoryview(array.array('q', [1, 2])).cast('B').cast('q', (1, 2)))
+
+    # C -> F order with a dtype conversion
+    data = array.array('d', range(6))
+    m = memoryview(data).cast('B').cast('d', (2, 3))
+    assert t.convert_f32_f(m) == ([0, 3, 1, 4, 2, 5], 2)
+
+    # Larger arrays are processed in blocks
+    data = array.array('f', range(100 * 70))
+    m = memoryview(data).cast('B').cast('f', (100, 70))
+    values, stride = t.convert_f32_f(m)
+    assert stride == 100
+    assert values == [float(i * 70 + j) for j in range(70) for i in range(100)]
+
+
+def test29_many_dimensions():
+    # Arrays with more dimensions than the inline storage of handles
+    for ndim in (1, 4, 5, 8):
+        m = memoryview(bytearray(2 ** ndim)).cast('B', (2,) * ndim)
+        assert t.get_shape(m) == [2] * ndim
+        assert t.check_order(m) == 'C'
+        assert t.get_size(t.passthrough(m)) == 2 ** ndim
+
+
+def test30_dlpack_versioned():
+    class Producer:
+        def __init__(self, readonly=False, device=1):
+            self.readonly, self.device, self.kwargs = readonly, device, []
+
+        def __dlpack__(self, **kwargs):
+            self.kwargs.append(kwargs)
+            return t.return_dlpack_versioned(self.readonly, self.device)
+
+        def __dlpack_device__(self):
+            return (self.device, 0)
+
+    collect()
+    dc = t.destruct_count()
+    p = Producer()
+    assert t.get_shape(p) == [2, 4]
+    assert p.kwargs == [{'max_version': (1, 0)}]
+    assert t.get_shape(t.return_dlpack_versioned(False, 1)) == [2, 4]
+    collect()
+    assert t.destruct_count() - dc == 2
+
+    # Read-only tensors require the nb::ro annotation
+    p = Producer(readonly=True)
+    with pytest.raises(TypeError):
+        t.get_shape(p)
+    assert t.get_shape_ro(p) == [2, 4]
+    assert 'writable=False' in t.get_shape_ro.__doc__
+    assert t.get_shape_ro(memoryview(b'1234')) == [4]
+    collect()
+    assert t.destruct_count() - dc == 4
+
+    # The consumer stream is only passed for arrays in device memory
+    p = Producer(device=2)
+    assert t.get_ndim_on_stream(p, 5) == 2
+    assert p.kwargs == [{'max_version': (1, 0), 'stream': 5}]
+    t.get_shape(p)
+    assert p.kwargs[-1] == {'max_version': (1, 0)}
+
+    p = Producer()
+    assert t.get_ndim_on_stream(p, 5) == 2
+    assert p.kwargs == [{'max_version': (1, 0)}]
+
+    # Producers that only implement the legacy protocol also receive the stream
+    class Legacy:
+        def __init__(self):
+            self.kwargs = []
+
+        def __dlpack__(self, stream=None):
+            self.kwargs.append(stream)
+            return t.return_dlpack()
+
+        def __dlpack_device__(self):
+            return (2, 0)
+
+    p = Legacy()
+    assert t.get_ndim_on_stream(p, 7) == 2
+    assert t.get_ndim_on_stream(p, 7) == 2
+    assert p.kwargs == [7, 7]
+
+
+def test31_array_interface():
+    import ctypes
+
+    data = (ctypes.c_float * 8)(*range(8))
+
+    class Interface:
+        def __init__(self, **kwargs):
+            self.iface = {
+                'shape': (2, 4),
+                'typestr': '<f4',
+                'data': (ctypes.addressof(data), False),
+                'version': 3,
+                **kwargs
+            }
+
+    class HostArray(Interface):
+        @property
+        def __array_interface__(self):
+            return self.iface
+
+    class CudaArray(Interface):
+        @property
+        def __cuda_array_interface__(self):
+            return self.iface
+
+    a = HostArray()
+    assert t.get_shape(a) == [2, 4]
+    assert t.check_order(a) == 'C'
+    assert t.check_device(a) == 'cpu'
+    assert t.check_float(a)
+    assert t.convert_f32_f(a) == ([0, 4, 1, 5, 2, 6, 3, 7], 2)
+
+    a = HostArray(shape=(4, 2), strides=(4, 16))
+    assert t.check_order(a) == 'F'
+    assert t.convert_f32_f(a) == ([0, 1, 2, 3, 4, 5, 6, 7], 4)
+
+    ints = (ctypes.c_int32 * 4)(10, 20, 30, 40)
+    a = HostArray(shape=(3,), typestr='<i4', offset=4,
+                  data=(ctypes.addressof(ints), False))
+    assert t.convert_i16(a) == [20, 30, 40]
+
+    assert t.get_shape(HostArray(shape=(1, 1, 1, 1, 2, 4))) == [1, 1, 1, 1, 2, 4]
+    assert t.check_device(CudaArray()) == 'cuda'
+    assert t.get_shape(CudaArray(shape=(8,))) == [8]
+
+    # Read-only memory, masks, and unsupported types are rejected
+    for a in (HostArray(data=(ctypes.addressof(data), True)),
+              CudaArray(mask=object()), HostArray(typestr='<M8'),
+              HostArray(strides=(3, 1)), HostArray(shape=(1, 1, 1, 1, 2, 'x'))):
+        with pytest.raises(TypeError):
+            t.get_shape(a)
+    assert t.get_shape_ro(HostArray(data=(ctypes.addressof(data), True))) == [2, 4]
+
+
+def test32_half_precision():
+    import array, ctypes, struct
+
+    values = [0.5, -1.25, 65504.0, 0.125]
+    data = ctypes.create_string_buffer(struct.pack('<4e', *values), 8)
+
+    class HostArray:
+        @property
+        def __array_interface__(self):
+            return {
+                'shape': (4,),
+                'typestr': '<f2',
+                'data': (ctypes.addressof(data), False),
+                'version': 3
+            }
+
+    assert t.sum_f16(HostArray()) == sum(values)
+    assert 'dtype=float16' in t.sum_f16.__doc__
+    assert 'dtype=bfloat16' in t.convert_bf16.__doc__
+
+    assert t.sum_f16(t.ret_f16(4)) == 3
+
+    # Implicit conversions (round to nearest, ties to even)
+    assert t.sum_f16(array.array('d', [1, 2048, 1])) == 2050
+    assert t.convert_bf16(array.array('f', [1, -2.5, 1 + 2 ** -8, 1 + 3 * 2 ** -8])) == \
+        [1, -2.5, 1, 1 + 2 ** -6]
+    assert t.convert_bf16(array.array('i', [1, 257])) == [1, 256]
+
+    assert t.half_roundtrip(0.1) == 0.0999755859375
+    assert t.half_roundtrip(1e6) == float('inf')
+
+
+def test33_mmap(tmp_path):
+    import struct
+
+    path = tmp_path / 'data.bin'
+    path.write_bytes(b'hdr!' + struct.pack('<6f', *range(6)))
+
+    assert t.get_shape_ro(t.mmap_f32(str(path), [2, 3], 4, False)) == [2, 3]
+    assert t.sum_f32(t.mmap_f32(str(path), [2, 3], 4, False)) == 15
+    assert t.sum_f32(t.mmap_f32(str(path), [2], 12, False)) == 5
+
+    # Read-only mappings are exported with the DLPack read-only flag
+    a = t.mmap_f32(str(path), [2, 3], 4, False)
+    assert 'dltensor_versioned' in repr(a)
+    with pytest.raises(TypeError):
+        t.get_shape(a)
+    assert t.get_shape(t.mmap_f32(str(path), [2, 3], 4, True)) == [2, 3]
+
+    # Private mappings don't modify the file
+    assert t.sum_f32(t.mmap_fill(str(path), 4, 2)) == 8
+    assert path.read_bytes() == b'hdr!' + struct.pack('<6f', *range(6))
+
+    with pytest.raises(RuntimeError, match='too small'):
+        t.mmap_f32(str(path), [7], 4, False)
+    with pytest.raises(RuntimeError, match='overflow'):
+        t.mmap_f32(str(path), [2**32, 2**32], 4, False)
+    with pytest.raises(FileNotFoundError):
+        t.mmap_f32(str(tmp_path / 'missing.bin'), [1], 0, False)
+
+
+def test34_alloc():
+    a, ptr = t.alloc_iota(3, 5)
+    assert ptr % 64 == 0
+    assert t.get_shape(a) == [3, 5]
+    a, ptr = t.alloc_iota(3, 5)
+    assert t.sum_f32(a) == sum(range(15))
+
+    # Large and empty arrays
+    a, ptr = t.alloc_iota(1024, 2048)
+    assert ptr % 64 == 0
+    assert t.sum_f32(a) == sum(range(1024 * 2048))
+    a, ptr = t.alloc_iota(0, 5)
+    assert t.get_shape(a) == [0, 5]
+
+
+def test35_view():
+    import array
+
+    data = array.array('f', range(6))
+    m = memoryview(data).cast('B').cast('f', (2, 3))
+    assert t.view_sum_c(m) == 0 + 2 + 6 + 3 + 8 + 15
+
+    data = array.array('f', range(6))
+    t.view_scale_f(memoryview(data).cast('B').cast('f', (6, 1)), 2)
+    assert list(data) == [0, 2, 4, 6, 8, 10]
+
+    data = array.array('d', range(12))
+    m = memoryview(data).cast('B').cast('d', (3, 4))
+    assert t.view_row_sums(m) == [6, 22, 38]
+    assert t.view_row_sums(m[::2]) == [6, 38]
+
+
+def test36_parallel_for():
+    import array, threading, _thread, time
+
+    threads = t.parallel_threads()
+    assert threads >= 1
+    try:
+        for count in (1, 2, 4):
+            t.set_parallel_threads(count)
+            assert t.parallel_threads() == count
+            data = array.array('f', range(1000))
+            t.parallel_square(data)
+            assert list(data) == [float(i * i) for i in range(1000)]
+
+            with pytest.raises(RuntimeError, match='parallel_fail'):
+                t.parallel_fail(1000, 517)
+
+            # Nested loops run serially, and no loop holds the GIL
+            assert t.parallel_nested(100) == (10000, 0)
+            assert t.parallel_nested(1) == (1, 0)
+
+        # KeyboardInterrupt cancels the remaining work
+        timer = threading.Timer(0.1, _thread.interrupt_main)
+        timer.start()
+        start = time.time()
+        with pytest.raises(KeyboardInterrupt):
+            t.parallel_sleep(20000) # 5 seconds using 4 threads
+        assert time.time() - start < 3
+        timer.join()
+    finally:
+        t.set_parallel_threads(0)
+
+
+@pytest.mark.skipif(sys.platform == 'win32',
+                    reason='shared memory arrays require POSIX')
+def test37_shm():
+    import pickle, subprocess
+
+    a = t.shm_iota(5)
+    assert t.get_shape(a) == [5]
+    assert t.sum_f32(a) == 10
+
+    # The pickled array only references the shared memory segment
+    data = pickle.dumps(a)
+    assert len(data) < 200
+
+    # Another process maps the same memory and modifies it
+    code = ('import pickle, sys, test_ndarray_ext; '
+            'b = memoryview(pickle.loads(sys.stdin.buffer.read())); '
+            'b[4] = 14.0; print(sum(b.tolist()))')
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    out = subprocess.run([sys.executable, '-c', code], input=data, env=env,
+                         check=True, capture_output=True)
+    assert float(out.stdout) == 20
+    assert t.sum_f32(a) == 20
+
+    # The segment remains available while the producer holds the array
+    b = pickle.loads(data)
+    assert memoryview(b).tolist() == [0, 1, 2, 3, 14]
+
+    # Releasing the producer unlinks it, while existing mappings remain valid
+    del a
+    with pytest.raises(FileNotFoundError):
+        pickle.loads(data)
+    assert memoryview(b).tolist() == [0, 1, 2, 3, 14]
+
+    # Other arrays are returned as DLPack capsules, which cannot be pickled
+    with pytest.raises(TypeError):
+        pickle.dumps(t.alloc_iota(1, 2)[0])
+
+
+def test38_string_table():
+    import array
+
+    strings = ['ab', '', 'cde', '\u00e9t\u00e9']
+    offsets, data = t.string_table(strings)
+    assert t.get_shape(offsets) == [5]
+    assert t.string_table_unpack(t.string_table(strings)) == strings
+    assert t.string_table_unpack(t.string_table([])) == []
+
+    data = array.array('B', b'abc')
+    assert t.string_table_unpack((array.array('q', [0, 1, 3]), data)) == ['a', 'bc']
+    for offsets in ([1, 3], [0, 2, 1, 3], [0, 4]):
+        with pytest.raises(TypeError):
+            t.string_table_unpack((array.array('q', offsets), data))
+
+
+def test39_release_in_threads():
+    collect()
+    dc = t.destruct_count()
+    t.release_in_threads(8)
+    for _ in range(1000): # give the interpreter a chance to run pending calls
+        pass
+    collect()
+    assert t.destruct_count() - dc == 1
@@ -0,0 +1,26 @@
+#include <nanobind/nanobind.h>
+#include <stdexcept>
+
+namespace nb = nanobind;
+
+struct Value { float value; };
+
+NB_MODULE(test_profile_ext, m) {
+    nb::class_<Value>(m, "Value")
+        .def(nb::init_implicit<float>())
+        .def_rw("value", &Value::value);
+
+    m.def("f", [](int i) { return i; });
+    m.def("f", [](const Value &v) { return v.value; });
+
+    m.def("raise_error", []() { throw std::runtime_error("oops"); });
+
+    nb::reserve_bindings(2, 2);
+
+    struct Outer { };
+    struct Inner { };
+    nb::class_<Outer> outer(m, "Outer");
+    nb::class_<Inner>(outer, "Inner")
+        .def(nb::init<>())
+        .def("g", [](const Inner &) { return 1; });
+}
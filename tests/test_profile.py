@@ -0,0 +1,54 @@
+import test_profile_ext as t
+import nanobind_profile as p
+import pytest
+
+def find(name):
+    return [e for e in p.profile_dump() if e['name'] == name]
+
+def test01_counters():
+    p.profile_reset()
+    assert find('f') == []
+
+    for i in range(5):
+        assert t.f(i) == i
+    assert t.f(t.Value(1.5)) == 1.5
+    assert t.f(2.5) == 2.5
+
+    entries = sorted(find('f'), key=lambda e: e['overload'])
+    assert len(entries) == 2
+    e0, e1 = entries
+
+    assert e0['signature'] == 'f(arg: int, /) -> int'
+    assert e0['calls'] == 5
+    assert e1['calls'] == 2
+    assert e1['implicit_conversions'] == 1
+    assert e0['misses'] == (2, 1)
+    assert e1['misses'] == (1, 0)
+    assert e0['time'] >= 0 and e1['time'] >= 0
+
+    p.profile_reset()
+    assert find('f') == []
+
+def test02_exceptions():
+    p.profile_reset()
+    for _ in range(3):
+        with pytest.raises(RuntimeError):
+            t.raise_error()
+    e, = find('raise_error')
+    assert e['exceptions'] == 3
+    assert e['calls'] == 3
+
+def test03_import():
+    records = p.import_dump()
+    names = [(e['kind'], e['name']) for e in records]
+    assert ('class', 'test_profile_ext.Value') in names
+    assert ('class', 'test_profile_ext.Outer.Inner') in names
+    assert ('function', 'test_profile_ext.f') in names
+    assert ('function', 'test_profile_ext.Outer.Inner.g') in names
+    assert names.count(('function', 'test_profile_ext.f')) == 2
+    assert names.index(('class', 'test_profile_ext.Outer')) < \
+           names.index(('class', 'test_profile_ext.Outer.Inner'))
+    assert all(e['time'] >= 0 for e in records)
+
+    p.import_reset()
+    assert p.import_dump() == []
@@ -0,0 +1,34 @@
+#include <nanobind/stl/span.h>
+#include <numeric>
+
+namespace nb = nanobind;
+
+NB_MODULE(test_span_ext, m) {
+    m.def("sum", [](std::span<const double> s) {
+        return std::accumulate(s.begin(), s.end(), 0.0);
+    });
+
+    m.def("sum_int", [](std::span<const int32_t> s) {
+        return std::accumulate(s.begin(), s.end(), (int64_t) 0);
+    });
+
+    m.def("address", [](std::span<const double> s) {
+        return (uintptr_t) s.data();
+    });
+
+    m.def("fill", [](std::span<float> s, float value) {
+        for (float &f : s)
+            f = value;
+    });
+
+    m.def("norm3", [](std::span<const float, 3> v) {
+        return v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+    });
+
+    m.def("iota", [](size_t n) {
+        static std::vector<int> v;
+        v.resize(n);
+        std::iota(v.begin(), v.end(), 0);
+        return std::span<const int>(v);
+    });
+}
@@ -0,0 +1,67 @@
+import array
+import sys
+
+import pytest
+
+t = pytest.importorskip("test_span_ext")
+
+
+def buffer_address(a):
+    return a.buffer_info()[0]
+
+
+def test01_zero_copy():
+    a = array.array("d", [1.0, 2.0, 3.5])
+    assert t.sum(a) == 6.5
+    assert t.address(a) == buffer_address(a)
+    assert t.sum(memoryview(a)) == 6.5
+    assert t.sum_int(array.array("i", [1, 2, 3])) == 6
+
+
+def test02_sequence_fallback():
+    assert t.sum([1.0, 2.0, 3.5]) == 6.5
+    assert t.sum((1, 2)) == 3
+    assert t.sum([]) == 0
+    assert t.sum_int(list(range(100))) == 4950
+
+    with pytest.raises(TypeError):
+        t.sum(["a"])
+    with pytest.raises(TypeError):
+        t.sum(1.0)
+
+
+def test03_mutable():
+    a = array.array("f", [1, 2, 3])
+    t.fill(a, 4)
+    assert a.tolist() == [4, 4, 4]
+
+    # Writes to temporaries would be lost
+    with pytest.raises(TypeError):
+        t.fill([1.0, 2.0], 4)
+    with pytest.raises(TypeError):
+        t.fill(array.array("d", [1, 2]), 4)
+    with pytest.raises(TypeError):
+        t.fill(memoryview(a).toreadonly(), 4)
+
+
+def test04_fixed_extent():
+    assert t.norm3(array.array("f", [1, 2, 3])) == 14
+    assert t.norm3([1, 2, 3]) == 14
+    with pytest.raises(TypeError):
+        t.norm3([1, 2])
+    with pytest.raises(TypeError):
+        t.norm3(array.array("f", [1, 2, 3, 4]))
+
+
+def test05_from_cpp():
+    assert t.iota(4) == [0, 1, 2, 3]
+    assert t.iota(0) == []
+
+
+def test06_signature():
+    assert t.sum.__doc__ == (
+        "sum(arg: ndarray[dtype=float64, shape=(*), order='C', device='cpu'] "
+        "| Sequence[float], /) -> float")
+    assert t.fill.__doc__ == (
+        "fill(arg0: ndarray[dtype=float32, shape=(*), order='C', device='cpu'], "
+        "arg1: float, /) -> None")
@@ -12,6 +12,8 @@
 #include <nanobind/stl/unordered_set.h>
 #include <nanobind/stl/set.h>
 #include <nanobind/stl/filesystem.h>
+#include <nanobind/stl/lazy_view.h>
+#include <thread>
 
 NB_MAKE_OPAQUE(std::vector<float, std::allocator<float>>)
 
@@ -229,6 +231,10 @@ NB_MODULE(test_stl_ext, m) {
     });
 
     m.def("identity_list", [](std::list<int> &x) { return x; });
+    m.def("identity_list_or_vec", [](std::list<int> &x) -> nb::object { return nb::cast(x); });
+    m.def("identity_list_or_vec", [](std::vector<double> &x) -> nb::object { return nb::cast(x); });
+    m.def("identity_variant_vec",
+          [](std::variant<std::vector<int>, std::vector<std::string>> &x) { return x; });
 
     PyType_Slot slots[] = {
         { Py_tp_traverse, (void *) funcwrapper_tp_traverse },
@@ -243,6 +249,12 @@ NB_MODULE(test_stl_ext, m) {
     // ----- test35 ------
     m.def("identity_string", [](std::string& x) { return x; });
     m.def("identity_string_view", [](std::string_view& x) { return x; });
+    m.def("interned_string", [](int i) { return "value_" + std::to_string(i); },
+          nb::intern_strings());
+    m.def("interned_strings", [](int n) {
+        return std::vector<std::string>((size_t) n, "item");
+    }, nb::intern_strings());
+    m.def("string_view_size", [](std::string_view x) { return x.size(); });
 
     // ----- test36-test42 ------
     m.def("optional_copyable", [](std::optional<Copyable> &) {}, nb::arg("x").none());
@@ -336,6 +348,8 @@ NB_MODULE(test_stl_ext, m) {
     // test58
     m.def("array_out", [](){ return std::array<int, 3>{1, 2, 3}; });
     m.def("array_in", [](std::array<int, 3> x) { return x[0] + x[1] + x[2]; });
+    m.def("vec_double_in", [](const std::vector<double> &x) { return x; });
+    m.def("vec_int8_in", [](const std::vector<int8_t> &x) { return x; });
 
     // ----- test60-test64 ------
     m.def("set_return_value", []() {
@@ -400,6 +414,35 @@ NB_MODULE(test_stl_ext, m) {
         },
         nb::arg("x"));
 
+    // test71
+    m.def("gil_held", [](int x) { return PyGILState_Check() ? x : -x; });
+    m.def("gil_held", [](double x) { return x; });
+    m.def("gil_held_single", [](int x) { return PyGILState_Check() ? x : -x; },
+          nb::direct_call());
+    m.def("gil_held_indirect", [](int x) { return PyGILState_Check() ? x : -x; });
+    m.def("call_function_nogil", [](std::function<int(int)> &f, int x) {
+        nb::gil_scoped_release guard;
+        return f(x);
+    });
+
+    // test72
+    m.def("deferred_calls", [](nb::deferred_callback<void(int)> cb, int threads,
+                               int n, bool flush) {
+        {
+            nb::gil_scoped_release guard;
+            std::vector<std::thread> workers;
+            for (int i = 0; i < threads; ++i)
+                workers.emplace_back([&cb, i, n] {
+                    for (int j = 0; j < n; ++j)
+                        cb(i * n + j);
+                });
+            for (std::thread &w : workers)
+                w.join();
+        }
+        if (flush)
+            cb.flush();
+    });
+
     // test66
     m.def("replace_extension", [](std::filesystem::path p, std::string ext) {
         return p.replace_extension(ext);
@@ -413,4 +456,43 @@ NB_MODULE(test_stl_ext, m) {
     nb::class_<ClassWithMovableField>(m, "ClassWithMovableField")
         .def(nb::init<>())
         .def_rw("movable", &ClassWithMovableField::movable);
+
+    // test70
+    struct LazyContainers {
+        std::vector<std::string> names { "a", "b", "c" };
+        std::map<std::string, int> ids { { "a", 1 }, { "b", 2 } };
+        std::set<int> keys { 3, 5 };
+        std::vector<Copyable> items = std::vector<Copyable>(2);
+    };
+
+    using LC = LazyContainers;
+    nb::class_<LC>(m, "LazyContainers")
+        .def(nb::init<>())
+        .def("names", [](const LC &c) { return nb::lazy_view(c.names); })
+        .def("ids", [](const LC &c) { return nb::lazy_view(c.ids); })
+        .def("keys", [](const LC &c) { return nb::lazy_view(c.keys); })
+        .def("items", [](const LC &c) { return nb::lazy_view(c.items); });
+
+    // test73
+    m.def("variant_index",
+          [](const std::variant<double, int, std::string, Copyable, Movable *, bool> &v) {
+              return v.index();
+          });
+
+    // test75
+    struct MovableList {
+        std::vector<Movable> items;
+        MovableList(size_t capacity) { items.reserve(capacity); }
+    };
+
+    nb::class_<MovableList>(m, "MovableList")
+        .def(nb::init<size_t>())
+        .def("append", [](MovableList &l, int v) { l.items.emplace_back(v); })
+        .def("copy", [](const MovableList &l) -> const std::vector<Movable> & {
+            return l.items;
+        })
+        .def("reference", [](MovableList &l) -> std::vector<Movable> & {
+            return l.items;
+        }, nb::rv_policy::reference_internal)
+        .def("take", [](MovableList &l) { return std::move(l.items); });
 }
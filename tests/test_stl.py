@@ -30,11 +30,11 @@ def assert_stats(**kwargs):
 # ------------------------------------------------------------------
 
 def test01_movable_return(clean):
+    # Constructed in place, the return value isn't moved
     assert t.return_movable().value == 5
     assert_stats(
         default_constructed=1,
-        move_constructed=1,
-        destructed=2)
+        destructed=1)
 
 
 def test02_movable_return_ptr(clean):
@@ -87,11 +87,11 @@ def test06_movable_in_rvalue_ref(clean):
 
 
 def test07_copyable_return(clean):
+    # Constructed in place, the return value isn't copied
     assert t.return_copyable().value == 5
     assert_stats(
         default_constructed=1,
-        copy_constructed=1,
-        destructed=2)
+        destructed=1)
 
 
 def test08_copyable_return_ptr(clean):
@@ -752,3 +752,194 @@ def test66_replace_extension():
     assert t.parent_path(PseudoStrPath()) == Path("foo")
     assert t.parent_path(PseudoBytesPath()) == Path("foo")
 
+
+
+def test67_vector_array_from_buffer():
+    import array
+
+    a = array.array('d', [1.0, 2.5, 3.0])
+    assert t.vec_double_in(a) == [1.0, 2.5, 3.0]
+    assert t.vec_double_in(memoryview(a)[::2]) == [1.0, 3.0]
+    assert t.vec_double_in(array.array('i', [1, -2])) == [1.0, -2.0]
+    assert t.vec_double_in(array.array('f', [])) == []
+
+    # Integer conversions are checked for overflow
+    assert t.vec_int8_in(b'\x01\x7f') == [1, 127]
+    assert t.vec_int8_in(array.array('q', [-128, 127])) == [-128, 127]
+    with pytest.raises(TypeError):
+        t.vec_int8_in(b'\x80')
+    with pytest.raises(TypeError):
+        t.vec_int8_in(array.array('i', [1000]))
+    with pytest.raises(TypeError):
+        t.vec_int8_in(array.array('d', [1.0]))
+
+    assert t.array_in(array.array('i', [1, 2, 3])) == 6
+    assert t.array_in(array.array('b', [1, 2, 3])) == 6
+
+    # Buffers that aren't sequences can only be converted via the bulk path
+    import pickle
+    assert t.vec_int8_in(pickle.PickleBuffer(bytearray(b'\x01\x02'))) == [1, 2]
+    with pytest.raises(TypeError):
+        t.array_in(array.array('i', [1, 2]))
+
+
+def test68_interned_strings():
+    a, b = t.interned_string(1), t.interned_string(1)
+    assert a == 'value_1' and a is b
+    assert t.interned_string(2) == 'value_2'
+    items = t.interned_strings(3)
+    assert items == ['item'] * 3
+    assert items[0] is items[1] is items[2]
+
+    # Other functions don't use the cache
+    assert t.identity_string('x' * 10) is not t.identity_string('x' * 10)
+
+
+def test69_string_view_bytes_like():
+    assert t.string_view_size('abc') == 3
+    assert t.string_view_size(b'abcd') == 4
+    assert t.string_view_size(bytearray(b'ab')) == 2
+    assert t.string_view_size(memoryview(b'abcde')[1:]) == 4
+    with pytest.raises(TypeError):
+        t.string_view_size(memoryview(b'abcde')[::2])
+
+
+def test70_lazy_view(clean):
+    c = t.LazyContainers()
+    names = c.names()
+    assert len(names) == 3 and names[0] == 'a' and names[-1] == 'c'
+    assert list(names) == ['a', 'b', 'c']
+    assert 'b' in names and 'd' not in names and 1 not in names
+    with pytest.raises(IndexError):
+        names[3]
+
+    ids = c.ids()
+    assert len(ids) == 2 and ids['b'] == 2
+    assert sorted(ids) == ['a', 'b']
+    assert 'a' in ids and 'c' not in ids and 1 not in ids
+    with pytest.raises(KeyError):
+        ids['c']
+
+    keys = c.keys()
+    assert len(keys) == 2 and sorted(keys) == [3, 5]
+    assert 3 in keys and 4 not in keys and 'x' not in keys
+
+    # Elements are converted on access and refer to the container
+    items = c.items()
+    assert items[1].value == 5
+    assert_stats(default_constructed=2)
+
+    # The views keep the owner alive
+    item = items[0]
+    del c, names, ids, keys, items
+    collect()
+    assert item.value == 5
+    del item
+    assert_stats(default_constructed=2, destructed=2)
+
+    assert 'Sequence[str]' in t.LazyContainers.names.__doc__
+    assert 'Mapping[str, int]' in t.LazyContainers.ids.__doc__
+
+
+def test71_std_function_direct():
+    # Bound functions with a matching signature are called without the GIL
+    assert t.call_function_nogil(t.gil_held_single, 3) == -3
+    assert t.call_function_nogil(t.return_function(), 3) == 8
+
+    # Overloaded functions, functions without nb::direct_call(), and Python
+    # callables take the regular path
+    assert t.call_function_nogil(t.gil_held, 3) == 3
+    assert t.call_function_nogil(t.gil_held_indirect, 3) == 3
+    assert t.call_function_nogil(lambda x: x + 1, 3) == 4
+
+
+def test72_deferred_callback():
+    out = []
+    t.deferred_calls(out.append, 4, 100, True)
+    assert sorted(out) == list(range(400))
+
+    # Calls of each thread are performed in order
+    for i in range(4):
+        seq = [v for v in out if v // 100 == i]
+        assert seq == sorted(seq)
+
+    # Without flush(), the interpreter drains the queue shortly after
+    out = []
+    t.deferred_calls(out.append, 2, 10, False)
+    for _ in range(1000):
+        if len(out) == 20:
+            break
+    assert sorted(out) == list(range(20))
+    assert 'Callable[[int], None]' in t.deferred_calls.__doc__
+
+
+def test73_std_variant_dispatch(clean):
+    # Exact builtin and bound types select the matching alternative, even
+    # when an earlier alternative could also convert them
+    assert t.variant_index(1.5) == 0
+    assert t.variant_index(5) == 1
+    assert t.variant_index("x") == 2
+    assert t.variant_index(t.Copyable()) == 3
+    assert t.variant_index(t.Movable()) == 4
+    assert t.variant_index(True) == 5
+
+    # Other types still try the alternatives in order
+    class MyFloat:
+        def __float__(self):
+            return 2.0
+    assert t.variant_index(MyFloat()) == 0
+    with pytest.raises(TypeError):
+        t.variant_index([])
+
+
+def test74_iterable_in():
+    import collections
+
+    # Sequences and iterators are converted element by element
+    assert t.identity_list(range(4)) == [0, 1, 2, 3]
+    assert t.identity_list(collections.deque([1, 2])) == [1, 2]
+    assert t.identity_list(i * i for i in range(4)) == [0, 1, 4, 9]
+    assert t.identity_list(iter([])) == []
+    assert t.vec_double_in(i for i in range(3)) == [0.0, 1.0, 2.0]
+    assert t.array_in(range(1, 4)) == 6
+    assert t.array_in(i for i in range(1, 4)) == 6
+
+    for v in (range(2), range(4), (i for i in range(4))):
+        with pytest.raises(TypeError):
+            t.array_in(v)
+
+    with pytest.raises(TypeError):
+        t.identity_list(i if i < 2 else "x" for i in range(4))
+    with pytest.raises(TypeError):
+        t.identity_list({1: 2})
+
+    # Overloaded functions must not pass on partially consumed iterators
+    assert t.identity_list_or_vec(collections.deque([0, 1.5])) == [0.0, 1.5]
+    with pytest.raises(TypeError):
+        t.identity_list_or_vec(x for x in (0, 1.5, 2))
+
+    # The same applies to the alternatives of a variant
+    assert t.identity_variant_vec(['a', 'b']) == ['a', 'b']
+    with pytest.raises(TypeError):
+        t.identity_variant_vec(s for s in ['a', 'b', 'c'])
+
+
+def test75_vec_return_bulk(clean):
+    l = t.MovableList(1000)
+    for i in range(1000):
+        l.append(i)
+    assert [x.value for x in l.copy()] == list(range(1000))
+    assert_stats(value_constructed=1000, copy_constructed=1000,
+                 destructed=1000)
+
+    # Other policies wrap the individual elements
+    r = l.reference()
+    assert all(x.value == i for i, x in enumerate(r))
+    del r
+
+    m = l.take()
+    assert [x.value for x in m] == list(range(1000))
+    assert len(l.reference()) == 0
+    del l, m
+    assert_stats(value_constructed=1000, copy_constructed=1000,
+                 move_constructed=1000, destructed=3000)
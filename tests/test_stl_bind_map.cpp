@@ -21,6 +21,12 @@ public:
     int value;
 };
 
+// implicitly convertible value type (conversions need a cleanup list)
+struct El {
+    El(int value = 0) : value(value) {}
+    int value;
+};
+
 template <class Map>
 Map *times_ten(int n) {
     auto *m = new Map();
@@ -73,4 +79,9 @@ NB_MODULE(test_bind_map_ext, m) {
     nb::bind_map<std::unordered_map<int, std::unordered_map<int, E_nc>>>(m, "UmapUmapENC");
     m.def("get_numnc", &times_hundred<std::unordered_map<int, std::unordered_map<int, E_nc>>>);
 
+    nb::class_<El>(m, "El")
+        .def(nb::init_implicit<int>())
+        .def_rw("value", &El::value);
+    nb::bind_map<std::map<std::string, El>>(m, "MapStringEl");
+
 }
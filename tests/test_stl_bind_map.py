@@ -210,3 +210,51 @@ def test_map_delitem():
     del um["ua"]
     assert sorted(list(um)) == ["ub"]
     assert sorted(list(um.items())) == [("ub", 2.6)]
+
+
+def test_map_dict_conversion():
+    d = {"k%i" % i: i * 0.5 for i in range(1000)}
+
+    for cls in (t.MapStringDouble, t.UnorderedMapStringDouble):
+        m = cls.from_dict(d)
+        assert type(m) is cls and len(m) == 1000
+        assert m.to_dict() == d
+        assert cls(d).to_dict() == d
+
+        m.update({"k0": 10, "new": 1})
+        assert m["k0"] == 10 and m["new"] == 1 and len(m) == 1001
+
+        # Incompatible entries leave the map unchanged
+        with pytest.raises(TypeError):
+            m.update({"k1": 1, "k2": "x"})
+        assert m["k1"] == 0.5
+        with pytest.raises(TypeError):
+            cls.from_dict({"a": "b"})
+
+    assert t.MapStringDoubleConst.from_dict({"a": 1}).to_dict() == {"a": 1.0}
+
+    # Entries may require implicit conversions
+    m = t.MapStringEl.from_dict({"a": 1, "b": t.El(2)})
+    assert m["a"].value == 1 and m["b"].value == 2
+
+
+def test_map_slots():
+    for cls in (t.MapStringDouble, t.UnorderedMapStringDouble):
+        m = cls()
+        m["a"] = 1
+        m["b"] = 2.5
+        assert len(m) == 2 and m["a"] == 1 and m["b"] == 2.5
+        assert "a" in m and "c" not in m and 1 not in m
+        assert sorted(m) == ["a", "b"]
+        del m["a"]
+        assert len(m) == 1 and "a" not in m
+        with pytest.raises(KeyError):
+            m["a"]
+        with pytest.raises(KeyError):
+            del m["a"]
+        with pytest.raises(TypeError):
+            m["a"] = "x"
+        with pytest.raises(TypeError):
+            m[1] = 1.0
+        assert len(m) == 1
+
@@ -1,3 +1,5 @@
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include <nanobind/stl/bind_vector.h>
@@ -19,6 +21,47 @@ NB_MODULE(test_bind_vector_ext, m) {
     nb::bind_vector<std::vector<El>>(m, "VectorEl");
     nb::bind_vector<std::vector<std::vector<El>>>(m, "VectorVectorEl");
 
+    // Record array export of standard-layout structures
+    struct Trade {
+        double price;
+        int64_t qty;
+        uint32_t venue;
+        bool buy;
+        uint16_t hidden; // not bound, exported as padding
+    };
+
+    nb::class_<Trade>(m, "Trade")
+        .def(nb::init<>())
+        .def_rw("price", &Trade::price)
+        .def_rw("qty", &Trade::qty)
+        .def_rw("venue", &Trade::venue)
+        .def_rw("buy", &Trade::buy);
+    nb::bind_vector<std::vector<Trade>>(m, "VectorTrade");
+    m.def("make_trades", [](size_t n) {
+        std::vector<Trade> result;
+        for (size_t i = 0; i < n; ++i)
+            result.push_back({ 1.5 * (double) i, (int64_t) i - 1,
+                               (uint32_t) (10 + i), i % 2 == 0, 0 });
+        return result;
+    });
+    // Fields of base classes, read-only fields
+    struct QuoteBase { double bid; int32_t size; };
+    struct Quote : QuoteBase { };
+    nb::class_<QuoteBase>(m, "QuoteBase")
+        .def_rw("bid", &QuoteBase::bid)
+        .def_ro("size", &QuoteBase::size);
+    nb::class_<Quote, QuoteBase>(m, "Quote");
+    nb::bind_vector<std::vector<Quote>>(m, "VectorQuote");
+    m.def("make_quotes", [](size_t n) { return std::vector<Quote>(n); });
+
+    struct Opaque { int value; };
+    nb::class_<Opaque>(m, "Opaque").def(nb::init<>());
+    nb::bind_vector<std::vector<Opaque>>(m, "VectorOpaque");
+    m.def("trade_layout", []() {
+        return nb::make_tuple(sizeof(Trade), offsetof(Trade, qty),
+                              offsetof(Trade, venue), offsetof(Trade, buy));
+    });
+
     struct E_nc {
         explicit E_nc(int i) : value{i} {}
         E_nc(const E_nc &) = delete;
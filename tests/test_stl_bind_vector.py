@@ -138,3 +138,129 @@ def test05_vector_slicing():
     check_del(slice(200, 10, 1))
     check_del(slice(200, 10, -1))
     check_del(slice(200, 10, -3))
+
+
+def test06_vector_buffer():
+    import array
+    v = t.VectorInt([1, 2, 3])
+
+    # The buffer references the vector contents
+    m = memoryview(v)
+    assert m.format == 'I' and m.itemsize == 4 and m.shape == (3,)
+    assert m.tolist() == [1, 2, 3]
+    m[1] = 5
+    del m
+    assert list(v) == [1, 5, 3]
+    assert memoryview(t.VectorInt()).tolist() == []
+
+    # Bulk construction and extension from buffers
+    a = array.array('I', [4, 5, 6])
+    assert list(t.VectorInt(a)) == [4, 5, 6]
+    assert list(t.VectorInt(array.array('h', [7, 8]))) == [7, 8]
+    v.extend(a)
+    v.extend(array.array('I'))
+    assert list(v) == [1, 5, 3, 4, 5, 6]
+
+    # Lossy conversions fall back to the element-wise path, which fails
+    with pytest.raises(TypeError):
+        v.extend(array.array('i', [7, -1]))
+    assert list(v) == [1, 5, 3, 4, 5, 6]
+
+    assert type(v.__dlpack__()).__name__ == 'PyCapsule'
+    assert v.__dlpack_device__() == (1, 0)
+    assert not hasattr(t.VectorBool(), '__dlpack__')
+
+    # Exported contents can't be reallocated or resized
+    m, c = memoryview(v), v.__dlpack__()
+    for resize in (lambda: v.append(1), lambda: v.extend(a),
+                   lambda: v.extend(v), lambda: v.insert(0, 1), v.pop,
+                   v.clear, lambda: v.remove(1), lambda: v.__delitem__(0)):
+        with pytest.raises(BufferError):
+            resize()
+    with pytest.raises(BufferError):
+        del v[0]
+    with pytest.raises(BufferError):
+        del v[1:3]
+    v[0] = 7
+    assert m.tolist() == [7, 5, 3, 4, 5, 6]
+    del m
+    with pytest.raises(BufferError):
+        v.append(1)
+    del c
+    v.append(1)
+    assert list(v) == [7, 5, 3, 4, 5, 6, 1]
+
+
+def test07_vector_record_buffer():
+    import struct
+    v = t.make_trades(3)
+    size, off_qty, off_venue, off_buy = t.trade_layout()
+
+    # Bound fields in the order of their offsets, the rest is padding
+    m = memoryview(v)
+    fmt = 'T{d:price:q:qty:I:venue:?:buy:%ix}' % (size - off_buy - 1)
+    assert m.format == fmt
+    assert m.itemsize == size and m.shape == (3,) and m.strides == (size,)
+    assert m.nbytes == 3 * size and not m.readonly
+
+    # The buffer references the vector contents
+    b = m.cast('B')
+    assert struct.unpack_from('=d', b, size) == (1.5,)
+    assert struct.unpack_from('=q', b, size + off_qty) == (0,)
+    assert struct.unpack_from('=I', b, size + off_venue) == (11,)
+    assert b[size + off_buy] == 0 and b[2 * size + off_buy] == 1
+    b[2 * size + off_buy] = 0
+    struct.pack_into('=q', b, off_qty, 42)
+    with pytest.raises(BufferError):
+        v.append(v[0])
+    del b, m
+    assert v[2].buy is False and v[0].qty == 42
+    v.append(v[0])
+
+    assert memoryview(t.VectorTrade()).shape == (0,)
+
+    # Fields of bound base classes are included, def_ro() makes it read-only
+    import ctypes
+    q = t.make_quotes(2)
+    m = memoryview(q)
+    assert m.format == 'T{d:bid:i:size:4x}' and m.itemsize == 16
+    assert m.readonly
+    with pytest.raises((BufferError, TypeError)):
+        (ctypes.c_char * 32).from_buffer(q)
+    del m
+
+    # Element types without bound fields cannot be exported
+    with pytest.raises(BufferError, match='no fields'):
+        memoryview(t.VectorOpaque([t.Opaque()]))
+    assert not hasattr(v, '__dlpack__')
+
+
+def test08_vector_slots():
+    # Integer indices take a direct path, other keys the bound methods
+    v = t.VectorInt([1, 2, 3])
+    assert len(v) == 3 and v[0] == 1 and v[-1] == 3
+    assert list(v) == [1, 2, 3] and list(v[::-1]) == [3, 2, 1]
+    v[1] = 5
+    v[-1] = True
+    assert list(v) == [1, 5, 1]
+    del v[0]
+    assert list(v) == [5, 1]
+    assert 5 in v and 7 not in v and "x" not in v
+    with pytest.raises(IndexError):
+        v[2]
+    with pytest.raises(IndexError):
+        v[-3] = 1
+    with pytest.raises(IndexError):
+        del v[2]
+    with pytest.raises(TypeError):
+        v[0] = "x"
+    with pytest.raises(TypeError):
+        v[1.0]
+    assert list(v) == [5, 1]
+
+    # Elements of non-scalar types reference the vector
+    vv = t.VectorVectorEl([t.VectorEl([t.El(1)])])
+    inner = vv[0]
+    del vv
+    assert inner[0].a == 1
+
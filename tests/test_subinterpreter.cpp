@@ -0,0 +1,18 @@
+#include <nanobind/nanobind.h>
+
+namespace nb = nanobind;
+
+struct Counter {
+    int value = 0;
+    void increment() { value++; }
+};
+
+NB_MODULE(test_subinterpreter_ext, m) {
+    nb::class_<Counter>(m, "Counter")
+        .def(nb::init<>())
+        .def("increment", &Counter::increment)
+        .def_rw("value", &Counter::value);
+
+    m.def("make_counter", [](int value) { return Counter{ value }; });
+    m.def("is_counter", [](nb::handle h) { return nb::isinstance<Counter>(h); });
+}
@@ -0,0 +1,64 @@
+import test_subinterpreter_ext as t
+import importlib
+import os
+import sys
+import pytest
+
+try:
+    import _interpreters as interpreters
+except ImportError:
+    try:
+        import _xxsubinterpreters as interpreters
+    except ImportError:
+        interpreters = None
+
+needs_subinterpreters = pytest.mark.skipif(
+    interpreters is None or not hasattr(interpreters, 'run_string'),
+    reason='subinterpreters are not supported by this Python version')
+
+
+def run(code):
+    interp = interpreters.create()
+    try:
+        prefix = 'import sys\nsys.path.insert(0, %r)\n' % os.path.dirname(t.__file__)
+        result = interpreters.run_string(interp, prefix + code)
+        # Python 3.13+ reports failures via a return value
+        assert result is None
+    finally:
+        interpreters.destroy(interp)
+
+
+def test01_main_interpreter():
+    c = t.make_counter(5)
+    c.increment()
+    assert c.value == 6
+    assert t.is_counter(c)
+    assert not t.is_counter(5)
+
+
+def test02_reinitialize():
+    # The module body can only run once per interpreter
+    module = sys.modules.pop('test_subinterpreter_ext')
+    try:
+        with pytest.raises(ImportError) as excinfo:
+            importlib.import_module('test_subinterpreter_ext')
+        assert 'once per interpreter' in str(excinfo.value)
+    finally:
+        sys.modules['test_subinterpreter_ext'] = module
+
+
+@needs_subinterpreters
+def test03_subinterpreter():
+    for i in range(2):
+        run(
+            'import test_subinterpreter_ext as t\n'
+            'c = t.Counter()\n'
+            'c.increment()\n'
+            'assert c.value == 1\n'
+            'assert t.is_counter(c)\n'
+            'assert t.make_counter(3).value == 3\n'
+        )
+
+    # The main interpreter still uses its own type objects
+    assert t.is_counter(t.Counter())
+    assert t.Counter is type(t.make_counter(1))